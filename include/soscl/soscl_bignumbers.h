@@ -38,6 +38,7 @@ extern "C" {
 #define SOSCL_HALFWORD_BITS 32
 #define SOSCL_DOUBLE_WORD_BITS 128
 #define SOSCL_WORD_BYTES 8
+#define SOSCL_BYTE_BITS 8
 #endif//SOSCL_WORD64
 
   int soscl_bignum_max(word_type a,word_type b);
@@ -62,6 +63,7 @@ extern "C" {
   int soscl_bignum_modsquare(word_type *r,word_type *a,word_type *modulus,int modulus_size);
   int soscl_bignum_modmult(word_type *r,word_type *a,word_type *b,word_type *modulus,int modulus_size);
   int soscl_bignum_modinv(word_type *r,word_type *a,word_type *modulus,int word_size);
+  int soscl_bignum_modinv_batch(word_type *r,word_type *a,int count,word_type *modulus,int word_size);
   int soscl_bignum_modadd(word_type *r,word_type *a,word_type *b,word_type *modulus,int word_size);
   int soscl_bignum_mod(word_type *r,word_type *a,int a_word_size,word_type *modulus,int word_size);
   int soscl_bignum_div(word_type *remainder,word_type *quotient,word_type *a,int a_word_size,word_type *b,int b_word_size);
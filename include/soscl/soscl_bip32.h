@@ -0,0 +1,51 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_bip32.h
+//BIP32 hierarchical deterministic key derivation on secp256k1
+
+#ifndef _SOSCL_BIP32_H
+#define _SOSCL_BIP32_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+
+#define SOSCL_BIP32_KEY_BYTESIZE SOSCL_SECP256K1_BYTESIZE
+#define SOSCL_BIP32_CHAIN_CODE_BYTESIZE 32
+//indexes from 2^31 are the hardened ones
+#define SOSCL_BIP32_HARDENED 0x80000000
+//the master key HMAC key
+#define SOSCL_BIP32_SEED_KEY "Bitcoin seed"
+
+  //an extended key: the public key is always present, the private one only if has_private is SOSCL_TRUE
+  typedef struct _soscl_t_bip32_key
+  {
+    uint8_t d[SOSCL_BIP32_KEY_BYTESIZE];
+    uint8_t x[SOSCL_BIP32_KEY_BYTESIZE];
+    uint8_t y[SOSCL_BIP32_KEY_BYTESIZE];
+    uint8_t chain_code[SOSCL_BIP32_CHAIN_CODE_BYTESIZE];
+    int has_private;
+    uint32_t depth;
+    uint32_t child_number;
+  } soscl_type_bip32_key;
+
+  int soscl_bip32_master_key(soscl_type_bip32_key *key,uint8_t *seed,int seed_length);
+  int soscl_bip32_derive(soscl_type_bip32_key *child,soscl_type_bip32_key *parent,uint32_t index);
+  int soscl_bip32_derive_batch(soscl_type_bip32_key *children,soscl_type_bip32_key *parent,uint32_t *indexes,int count);
+  int soscl_bip32_neuter(soscl_type_bip32_key *public_key,soscl_type_bip32_key *key);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//_SOSCL_BIP32_H
@@ -34,6 +34,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 //to define when a TRNG is present
 #undef SOSCL_TRNG_PRESENT
+//to define for using the generated straight-line field arithmetic (src/publickey/ecc/generated) with secp256r1, secp384r1 and secp521r1
+#undef SOSCL_ECC_GENERATED_FIELD
+//to define for the file and POSIX mmap functions of the ECDSA key store (soscl_ecdsa_keystore_map)
+#ifdef UBUNTU
+#define SOSCL_ECDSA_KEYSTORE_MMAP
+#endif
+//to define for the x86 SHA extensions (SHA-NI) SHA-256 block function, selected by CPUID at init time
+#if defined(UBUNTU) && defined(SOSCL_WORD32) && (defined(__x86_64__) || defined(__i386__))
+#define SOSCL_SHA256_SHANI
+#endif
+//to define for the AVX2/AVX-512 multi-buffer hash engines, selected at init time
+#if defined(UBUNTU) && defined(SOSCL_WORD32) && (defined(__x86_64__) || defined(__i386__))
+#define SOSCL_HASH_MULTIBUFFER_AVX
+#endif
+//to define for the AVX2/AVX-512 multi-buffer ECC field operations, selected at init time
+#if defined(UBUNTU) && defined(SOSCL_WORD32) && (defined(__x86_64__) || defined(__i386__))
+#define SOSCL_ECC_MULTIBUFFER_AVX
+#endif
 
 #define SOSCL_BYTE_MASK 0xFF
 #define SOSCL_BYTE_SHIFT 8
@@ -30,8 +30,7 @@ extern "C" {
 #endif
 
   // we use the SECG terminology (when applicable)
-  //8 up to now, but only secp256r1, secp384r1 and secp521r1 are available
-  //others are placeholders
+  //8 up to now, all of them available
 #define SOSCL_SECP224R1 0
 #define SOSCL_SECP256R1 1
 #define SOSCL_SECP256K1 2//the bitcoin curve
@@ -62,7 +61,7 @@ extern "C" {
 #define SOSCL_BP512R1_BITSIZE 512
 
 #ifdef SOSCL_WORD32
-#define SOSCL_SECP224R1_WORDSIZE 8
+#define SOSCL_SECP224R1_WORDSIZE 7
 #define SOSCL_SECP256R1_WORDSIZE 8
 #define SOSCL_SECP256K1_WORDSIZE 8
 #define SOSCL_BP256R1_WORDSIZE 8
@@ -73,9 +72,27 @@ extern "C" {
 #endif//SOSCL_WORD32
 
 #define SOSCL_ECC_INVERSE_2_OPTIMIZATION 1
+  //field elements representation: standard (special form p, fast reduction) or Montgomery (x.R mod p)
+#define SOSCL_ECC_DOMAIN_STANDARD 0
+#define SOSCL_ECC_DOMAIN_MONTGOMERY 1
 #define SOSCL_ECDSA_SIGNATURE_COMPUTATION 0xFF
 #define SOSCL_ECDSA_SIGNATURE_VERIFICATION 0x00
 
+  struct _soscl_t_curve;
+
+  //field arithmetic of a curve, all numbers being in the curve field domain
+  //one table per curve reduction and per backend (C, asm, hardware...)
+  typedef struct _soscl_t_ecc_field_ops
+  {
+    int (*mult)(word_type *r,word_type *a,word_type *b,struct _soscl_t_curve *curve_params);
+    int (*square)(word_type *r,word_type *a,struct _soscl_t_curve *curve_params);
+    int (*add)(word_type *r,word_type *a,word_type *b,struct _soscl_t_curve *curve_params);
+    void (*sub)(word_type *r,word_type *a,word_type *b,struct _soscl_t_curve *curve_params);
+    int (*inv)(word_type *r,word_type *a,struct _soscl_t_curve *curve_params);
+    //r=c mod p, c being c_size words large
+    void (*reduce)(word_type *r,word_type *c,int c_size,struct _soscl_t_curve *curve_params);
+  } soscl_type_ecc_field_ops;
+
   typedef struct _soscl_t_curve
   {
     word_type *a;
@@ -89,6 +106,12 @@ extern "C" {
     int curve_wsize;
     int curve_bsize;
     int curve;
+    //Montgomery domain only: inverse_2 is then also in the domain
+    int domain;
+    word_type *r2;//R^2 mod p
+    word_type p_inv;//-p^-1 mod 2^SOSCL_WORD_BITS
+    word_type *a_domain;//a in the field domain, NULL for a=-3 curves
+    soscl_type_ecc_field_ops *field_ops;//NULL for the generic arithmetic
   } soscl_type_curve;
   
   typedef struct _soscl_t_word_jacobian_point
@@ -117,14 +140,28 @@ extern "C" {
   } soscl_type_ecdsa_signature;
   
   void soscl_ecc_msbit_and_size(int *msb,int *msw,soscl_type_curve *curve_params);
+  void soscl_ecc_regular_scalar(word_type *kr,word_type *k,int size,int msb,word_type *work,soscl_type_curve *curve_params);
   void soscl_ecc_set_msbit_curve(word_type *array,int *array_size,int np, int words_tmp,soscl_type_curve *curve_params);
   
+  soscl_type_ecc_field_ops *soscl_ecc_default_field_ops(soscl_type_curve *curve_params);
+  int soscl_ecc_set_field_ops(soscl_type_curve *curve_params,soscl_type_ecc_field_ops *field_ops);
+  void soscl_ecc_mod(word_type *b,word_type *c,int c_size,word_type *p,int p_size);
+  void soscl_ecc_modcurve(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
   int soscl_ecc_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
   void soscl_ecc_modsub(word_type *p_result, word_type *p_left, word_type *p_right,soscl_type_curve *curve_params);
   int soscl_ecc_modleftshift(word_type *a,word_type *b,word_type c,word_type size,soscl_type_curve *curve_params);
   int soscl_ecc_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
   int soscl_ecc_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params);
+  int soscl_ecc_modsquare_n(word_type *r,word_type *a,int n,soscl_type_curve *curve_params);
+  int soscl_ecc_modsqrt(word_type *r,word_type *a,soscl_type_curve *curve_params);
+  int soscl_ecc_to_domain(word_type *r,word_type *a,soscl_type_curve *curve_params);
+  int soscl_ecc_from_domain(word_type *r,word_type *a,soscl_type_curve *curve_params);
+  int soscl_ecc_field_one(word_type *r,soscl_type_curve *curve_params);
+  int soscl_ecc_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params);
+  int soscl_ecc_modinv_batch(word_type *r,word_type *a,int count,soscl_type_curve *curve_params);
+  void soscl_ecc_mod224r1(word_type *r,word_type *number,int number_size,word_type *p);
   void soscl_ecc_mod256r1(word_type *r, word_type *number,int number_size,word_type *p);
+  void soscl_ecc_mod256k1(word_type *r,word_type *number,int number_size,word_type *p);
   void soscl_ecc_mod384r1(word_type *r,word_type *number,int number_size,word_type *p);
   int soscl_ecc_infinite_affine(word_type *x,word_type *y,int size);
   int soscl_ecc_infinite_jacobian(soscl_type_ecc_word_jacobian_point q,soscl_type_curve *curve_params);
@@ -136,8 +173,11 @@ extern "C" {
   int soscl_ecc_add_affine_affine(soscl_type_ecc_word_affine_point q3,soscl_type_ecc_word_affine_point q1,soscl_type_ecc_word_affine_point q2,soscl_type_curve *curve_params);
   int soscl_ecc_add_jacobian_jacobian(soscl_type_ecc_word_jacobian_point T3,soscl_type_ecc_word_jacobian_point X1,soscl_type_ecc_word_jacobian_point X2,soscl_type_curve *curve_params);
   int soscl_ecc_convert_jacobian_to_affine(soscl_type_ecc_word_affine_point a,soscl_type_ecc_word_jacobian_point q,soscl_type_curve *curve_params);
+  int soscl_ecc_batch_to_affine(soscl_type_ecc_word_affine_point *a,soscl_type_ecc_word_jacobian_point *q,int n,soscl_type_curve *curve_params);
   int soscl_ecc_convert_affine_to_jacobian(soscl_type_ecc_word_jacobian_point q,soscl_type_ecc_word_affine_point X1,soscl_type_curve *curve_params);
   int soscl_ecc_mult_coz(soscl_type_ecc_word_affine_point *q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point ,soscl_type_curve *curve_params);
+  int soscl_ecc_mult_coz_affine_x(word_type *x,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params);
+  int soscl_ecc_mult_coz_jacobian(soscl_type_ecc_word_jacobian_point q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params);
   int soscl_ecc_equal_jacobian(soscl_type_ecc_word_jacobian_point q1,soscl_type_ecc_word_jacobian_point q2,soscl_type_curve *curve_params);
 
 #ifdef __cplusplus
@@ -0,0 +1,40 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//soscl_ecc_complete.h
+//complete (exception-free) point addition and doubling, homogeneous projective coordinates, a=-3 curves
+
+#ifndef _SOSCL_ECCCOMPLETE_H
+#define _SOSCL_ECCCOMPLETE_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+
+  //X:Y:Z corresponds to X/Z:Y/Z (and not X/Z^2:Y/Z^3 as for jacobian points)
+  //the infinity point is 0:1:0
+  typedef soscl_type_ecc_word_jacobian_point soscl_type_ecc_word_projective_point;
+
+  void soscl_ecc_projective_copy(soscl_type_ecc_word_projective_point q,soscl_type_ecc_word_projective_point p,int curve_wsize);
+  void soscl_ecc_projective_set_infinite(soscl_type_ecc_word_projective_point q,soscl_type_curve *curve_params);
+  int soscl_ecc_add_complete(soscl_type_ecc_word_projective_point q3,soscl_type_ecc_word_projective_point q1,soscl_type_ecc_word_projective_point q2,soscl_type_curve *curve_params);
+  int soscl_ecc_double_complete(soscl_type_ecc_word_projective_point q3,soscl_type_ecc_word_projective_point q1,soscl_type_curve *curve_params);
+  int soscl_ecc_convert_affine_to_projective(soscl_type_ecc_word_projective_point q,soscl_type_ecc_word_affine_point a,soscl_type_curve *curve_params);
+  int soscl_ecc_convert_projective_to_affine(soscl_type_ecc_word_affine_point a,soscl_type_ecc_word_projective_point q,soscl_type_curve *curve_params);
+  int soscl_ecc_mult_complete(soscl_type_ecc_word_affine_point q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//SOSCL_ECCCOMPLETE
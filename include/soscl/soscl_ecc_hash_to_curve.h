@@ -0,0 +1,41 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_hash_to_curve.h
+//hashing to the NIST curves (RFC 9380)
+
+#ifndef _SOSCL_ECC_HASH_TO_CURVE_H
+#define _SOSCL_ECC_HASH_TO_CURVE_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+
+//RFC 9380 5.3.1 limits
+#define SOSCL_ECC_H2C_DST_MAX_BYTESIZE 255
+#define SOSCL_ECC_H2C_EXPAND_MAX_BYTESIZE 65535
+//L=ceil((ceil(log2(p))+k)/8), k being the security level
+#define SOSCL_ECC_H2C_P256_L 48
+#define SOSCL_ECC_H2C_P384_L 72
+#define SOSCL_ECC_H2C_P521_L 98
+#define SOSCL_ECC_H2C_MAX_L SOSCL_ECC_H2C_P521_L
+
+  int soscl_ecc_expand_message_xmd(uint8_t *output,int output_length,uint8_t *msg,int msg_length,uint8_t *dst,int dst_length,int algo);
+  int soscl_ecc_hash_to_field(word_type *u,int count,uint8_t *msg,int msg_length,uint8_t *dst,int dst_length,soscl_type_curve *curve_params);
+  int soscl_ecc_map_to_curve_sswu(soscl_type_ecc_word_jacobian_point q,word_type *u,soscl_type_curve *curve_params);
+  int soscl_ecc_hash_to_curve(soscl_type_ecc_uint8_t_affine_point q,uint8_t *msg,int msg_length,uint8_t *dst,int dst_length,soscl_type_curve *curve_params);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//_SOSCL_ECC_HASH_TO_CURVE_H
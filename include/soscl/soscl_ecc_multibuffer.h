@@ -0,0 +1,38 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//soscl_ecc_multibuffer.h
+//multi-buffer scalar multiplication: q[i]=k[i].P[i] for independent pairs, computed in lockstep
+
+#ifndef _SOSCL_ECCMULTIBUFFER_H
+#define _SOSCL_ECCMULTIBUFFER_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+
+  //field operations engines: 4 pairs computed together with the C loops and AVX2, 8 with AVX-512
+#define SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_C 0
+#define SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX2 1
+#define SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX512 2
+
+  //k[i] is k+i*size, k[i] mod n must not be 0
+  int soscl_ecc_mult_multi(soscl_type_ecc_word_affine_point *q,word_type *k,word_type size,soscl_type_ecc_word_affine_point *points,int count,soscl_type_curve *curve_params);
+  int soscl_ecc_mult_multi_set_implementation(int implementation);
+  void soscl_ecc_mult_multi_select_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//SOSCL_ECCMULTIBUFFER
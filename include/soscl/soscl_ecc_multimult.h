@@ -0,0 +1,39 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//soscl_ecc_multimult.h
+//multi-scalar multiplication: sum of k[i].P[i]
+
+#ifndef _SOSCL_ECCMULTIMULT_H
+#define _SOSCL_ECCMULTIMULT_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+
+//up to this number of points, Straus is used, Pippenger above
+#define SOSCL_ECC_MULTIMULT_STRAUS_MAX 64
+//Straus window is 2 bits: P, 2P, 3P
+#define SOSCL_ECC_MULTIMULT_STRAUS_TABLE 3
+//number of points whose tables are normalised with one single inversion
+#define SOSCL_ECC_MULTIMULT_STRAUS_BATCH 8
+
+  int soscl_ecc_multi_mult_workspace_size(int count,soscl_type_curve *curve_params);
+  int soscl_ecc_multi_mult_jacobian(soscl_type_ecc_word_jacobian_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,word_type *workspace,int workspace_size,soscl_type_curve *curve_params);
+  int soscl_ecc_multi_mult(soscl_type_ecc_word_affine_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,word_type *workspace,int workspace_size,soscl_type_curve *curve_params);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//SOSCL_ECCMULTIMULT
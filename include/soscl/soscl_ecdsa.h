@@ -21,13 +21,16 @@ extern "C" {
 #include "soscl/soscl_types.h"
 #include "soscl/soscl_bignumbers.h"
 #include "soscl/soscl_ecc.h"
+#include "soscl/soscl_hash_sha256.h"
+#include "soscl/soscl_hash_sha512.h"
 
   //configuration value structure
   /*
- 31...                 4 3 2 1 0
+ 31...               5 4 3 2 1 0
 +-------------------------------+
-|.....................|i|i|h|h|h|
+|...................|n|i|i|h|h|h|
 +-------------------------------+
+n bit for the signature nonce: random or deterministic (RFC 6979)
 i bits for input type (2 bits for input type)
 h bits for hash type (3 bits because of many hash functions)
 
@@ -42,9 +45,89 @@ the configuration is used to provide some information about the message type and
 #define SOSCL_HASH_MASK 7//so 3 bits: the value is the hash ID as defined in the soscl_hash_<hash-function>.h
 #define SOSCL_HASH_SHIFT 0//so bits 0,1 and 2
 #define SOSCL_INPUT_SHIFT 3// so bits 3 and 4
+#define SOSCL_RANDOM_NONCE 0//k is drawn from the rng
+#define SOSCL_DETERMINISTIC_NONCE 1//k is derived from the secret key and the hash digest, as in RFC 6979
+#define SOSCL_NONCE_MASK 1
+#define SOSCL_NONCE_SHIFT 5
+
+//algo 3.48 in GtECC with w=2, so 2^w=4, so i=0..3, j=0..3
+//the array for storing the precomputed values is 16-point large
+#define SOSCL_ECDSA_WINDOW_WIDTH 2
+#define SOSCL_ECDSA_ARRAY_SIZE (1<<SOSCL_ECDSA_WINDOW_WIDTH)*(1<<SOSCL_ECDSA_WINDOW_WIDTH)
+
+  //one signature to be verified by soscl_ecdsa_verify_batch
+  typedef struct _soscl_t_ecdsa_verify_item
+  {
+    soscl_type_ecc_uint8_t_affine_point q;
+    soscl_type_ecdsa_signature signature;
+    uint8_t *input;
+    int inputlength;
+  } soscl_type_ecdsa_verify_item;
+
+  //one message to be signed by soscl_ecdsa_sign_batch, signature being the output
+  typedef struct _soscl_t_ecdsa_sign_item
+  {
+    uint8_t *input;
+    int inputlength;
+    soscl_type_ecdsa_signature signature;
+  } soscl_type_ecdsa_sign_item;
+
+  //pool of precomputed (r,k^-1) pairs, for offline/online signing
+  //the pool is not locked: the caller serializes the refills and the signatures
+  typedef struct _soscl_t_ecdsa_nonce_pool
+  {
+    word_type *entries;//caller storage, capacity*SOSCL_ECDSA_NONCE_POOL_ENTRY_WSIZE words
+    int capacity;
+    int head;//oldest entry
+    int count;//available entries
+    int low_water;
+    int generated;
+    int consumed;
+    soscl_type_curve *curve_params;
+  } soscl_type_ecdsa_nonce_pool;
+
+  typedef struct _soscl_t_ecdsa_nonce_pool_stats
+  {
+    int available;
+    int capacity;
+    int low_water;//lowest number of available entries since the previous stats call
+    int generated;//total number of entries produced
+    int consumed;//total number of entries used
+  } soscl_type_ecdsa_nonce_pool_stats;
+
+#define SOSCL_ECDSA_NONCE_POOL_ENTRY_WSIZE(curve_params) (2*(curve_params)->curve_wsize)
+
+  //incremental signature/verification: the message is hashed chunk by chunk, so that its size is not bounded by memory
+  //the context only holds the running hash, the digest being processed by the final call
+  typedef struct _soscl_t_ecdsa_stream
+  {
+    int algo;
+    union
+    {
+      soscl_sha256_ctx_t ctx256;
+      soscl_sha512_ctx_t ctx512;//also used for sha384
+    } hash;
+    soscl_type_curve *curve_params;
+    int configuration;
+  } soscl_type_ecdsa_stream;
 
 int soscl_ecdsa_signature(soscl_type_ecdsa_signature signature,uint8_t *d,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input, int inputlength, soscl_type_curve *curve_params,int configuration);
 int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point Q,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration);
+int soscl_ecdsa_table_precompute(soscl_type_ecc_word_affine_point *table,soscl_type_ecc_uint8_t_affine_point q,soscl_type_curve *curve_params);
+int soscl_ecdsa_verification_table(soscl_type_ecc_word_affine_point *table,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration);
+int soscl_ecdsa_verify_batch(soscl_type_ecdsa_verify_item *items,int count,int *results,int(*soscl_hash)(uint8_t*,uint8_t*,int),soscl_type_curve *curve_params,int configuration);
+int soscl_ecdsa_sign_batch(soscl_type_ecdsa_sign_item *items,int count,uint8_t *secret_d,int(*soscl_hash)(uint8_t*,uint8_t*,int),soscl_type_curve *curve_params,int configuration);
+int soscl_ecdsa_nonce_pool_init(soscl_type_ecdsa_nonce_pool *pool,word_type *storage,int capacity,soscl_type_curve *curve_params);
+int soscl_ecdsa_nonce_pool_refill(soscl_type_ecdsa_nonce_pool *pool,int nb);
+int soscl_ecdsa_signature_pool(soscl_type_ecdsa_signature signature,uint8_t *d,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_ecdsa_nonce_pool *pool,int configuration);
+int soscl_ecdsa_nonce_pool_stats(soscl_type_ecdsa_nonce_pool *pool,soscl_type_ecdsa_nonce_pool_stats *stats);
+int soscl_ecdsa_nonce_pool_wipe(soscl_type_ecdsa_nonce_pool *pool);
+int soscl_ecdsa_sign_init(soscl_type_ecdsa_stream *ctx,soscl_type_curve *curve_params,int configuration);
+int soscl_ecdsa_sign_update(soscl_type_ecdsa_stream *ctx,uint8_t *data,int data_byte_len);
+int soscl_ecdsa_sign_final(soscl_type_ecdsa_stream *ctx,soscl_type_ecdsa_signature signature,uint8_t *d);
+int soscl_ecdsa_verify_init(soscl_type_ecdsa_stream *ctx,soscl_type_curve *curve_params,int configuration);
+int soscl_ecdsa_verify_update(soscl_type_ecdsa_stream *ctx,uint8_t *data,int data_byte_len);
+int soscl_ecdsa_verify_final(soscl_type_ecdsa_stream *ctx,soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature);
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,76 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecdsa_cache.h
+//bounded cache of successful ECDSA verifications
+
+#ifndef _SOSCL_ECDSA_CACHE_H
+#define _SOSCL_ECDSA_CACHE_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+#include "soscl/soscl_ecdsa.h"
+
+  /*
+an entry is the SHA-256 of (curve, input type, digest, qx, qy, r, s): only successful verifications are stored,
+so a hit means the same tuple has already been verified, and no scalar multiplication is needed
+the cache is split into stripes (sets), the stripe being selected by the first key bytes:
+- the lookups and insertions only lock the selected stripe, through the caller lock/unlock functions (NULL when not shared),
+- each stripe holds ways entries, the least recently used one being evicted
+the verification itself is done outside of the lock
+  */
+#define SOSCL_ECDSA_CACHE_KEY_BYTESIZE 32
+
+  typedef struct _soscl_t_ecdsa_cache_entry
+  {
+    uint8_t key[SOSCL_ECDSA_CACHE_KEY_BYTESIZE];
+    uint64_t last_use;//0 for an empty entry
+  } soscl_type_ecdsa_cache_entry;
+
+  typedef struct _soscl_t_ecdsa_cache_stripe
+  {
+    //64 bits, so that the ticks and counters never wrap
+    uint64_t tick;
+    uint64_t hits;
+    uint64_t misses;
+  } soscl_type_ecdsa_cache_stripe;
+
+  typedef struct _soscl_t_ecdsa_cache
+  {
+    soscl_type_ecdsa_cache_entry *entries;//caller storage, nb_stripes*ways entries
+    soscl_type_ecdsa_cache_stripe *stripes;//caller storage, nb_stripes
+    int nb_stripes;
+    int ways;
+    void (*lock)(void *lock_arg,int stripe);
+    void (*unlock)(void *lock_arg,int stripe);
+    void *lock_arg;
+  } soscl_type_ecdsa_cache;
+
+  typedef struct _soscl_t_ecdsa_cache_stats
+  {
+    uint64_t hits;
+    uint64_t misses;
+    int used;
+    int capacity;
+  } soscl_type_ecdsa_cache_stats;
+
+  int soscl_ecdsa_cache_init(soscl_type_ecdsa_cache *cache,soscl_type_ecdsa_cache_entry *entries,soscl_type_ecdsa_cache_stripe *stripes,int nb_stripes,int ways,void (*lock)(void*,int),void (*unlock)(void*,int),void *lock_arg);
+  int soscl_ecdsa_verification_cached(soscl_type_ecdsa_cache *cache,soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration);
+  int soscl_ecdsa_cache_stats(soscl_type_ecdsa_cache *cache,soscl_type_ecdsa_cache_stats *stats);
+  int soscl_ecdsa_cache_flush(soscl_type_ecdsa_cache *cache);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//_SOSCL_ECDSA_CACHE_H
@@ -0,0 +1,93 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecdsa_keystore.h
+//persistent store of validated ECDSA public keys with their precomputed verification tables
+
+#ifndef _SOSCL_ECDSA_KEYSTORE_H
+#define _SOSCL_ECDSA_KEYSTORE_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+#include "soscl/soscl_ecdsa.h"
+
+  /*
+the store is a single image, meant to be written once to a file and mapped read-only by the verifiers:
++------------------------------------+
+| header (soscl_type_ecdsa_keystore_header)
++------------------------------------+
+| G part: P,2P,3P (x,y)              | 3*2 numbers
++------------------------------------+
+| entry 0: qx,qy, then jP+iQ (x,y)   | 2+12*2 numbers
+| ...                                | sorted by qx then qy
+| entry count-1                      |
++------------------------------------+
+the numbers are curve_wsize native words, the table points being in the curve field domain,
+so the image is only valid for the architecture (word size, endianness) and the curve it is tagged with
+the header digest is an unkeyed SHA-256 of everything after the header: it detects a corrupted image,
+not a forged one, since whoever can write the image can also recompute the digest
+the image decides which signatures are accepted, so the file shall be trusted like code:
+written by the party installing the keys only, and read-only for the verifiers
+  */
+#define SOSCL_ECDSA_KEYSTORE_MAGIC 0x53434b53//"SCKS"
+#define SOSCL_ECDSA_KEYSTORE_VERSION 2
+#define SOSCL_ECDSA_KEYSTORE_ENDIANNESS 0x01020304
+//table points stored once (G part) and per key (Q part)
+#define SOSCL_ECDSA_KEYSTORE_G_POINTS ((1<<SOSCL_ECDSA_WINDOW_WIDTH)-1)
+#define SOSCL_ECDSA_KEYSTORE_Q_POINTS (SOSCL_ECDSA_ARRAY_SIZE-(1<<SOSCL_ECDSA_WINDOW_WIDTH))
+#define SOSCL_ECDSA_KEYSTORE_DIGEST_BYTESIZE 32
+
+  typedef struct _soscl_t_ecdsa_keystore_header
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t word_bits;
+    uint32_t endianness;
+    uint32_t curve;
+    uint32_t domain;
+    uint32_t curve_wsize;
+    uint32_t count;
+    uint32_t table_points;
+    uint32_t entry_wsize;
+    uint32_t reserved[2];
+    uint8_t digest[SOSCL_ECDSA_KEYSTORE_DIGEST_BYTESIZE];
+  } soscl_type_ecdsa_keystore_header;
+
+  //an opened store: pointers into the image, nothing is copied
+  typedef struct _soscl_t_ecdsa_keystore
+  {
+    const soscl_type_ecdsa_keystore_header *header;
+    const word_type *g_table;
+    const word_type *entries;
+    soscl_type_curve *curve_params;
+    //set by soscl_ecdsa_keystore_map only
+    void *mapping;
+    int mapping_size;
+  } soscl_type_ecdsa_keystore;
+
+  int soscl_ecdsa_keystore_size(int count,soscl_type_curve *curve_params);
+  int soscl_ecdsa_keystore_build(uint8_t *image,int image_size,soscl_type_ecc_uint8_t_affine_point *keys,int count,soscl_type_curve *curve_params);
+  int soscl_ecdsa_keystore_open(soscl_type_ecdsa_keystore *store,const uint8_t *image,int image_size,soscl_type_curve *curve_params);
+  int soscl_ecdsa_keystore_find(soscl_type_ecdsa_keystore *store,soscl_type_ecc_uint8_t_affine_point q);
+  int soscl_ecdsa_keystore_verification(soscl_type_ecdsa_keystore *store,int index,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,int configuration);
+#ifdef SOSCL_ECDSA_KEYSTORE_MMAP
+  int soscl_ecdsa_keystore_save(char *filename,uint8_t *image,int image_size);
+  int soscl_ecdsa_keystore_map(soscl_type_ecdsa_keystore *store,char *filename,soscl_type_curve *curve_params);
+  int soscl_ecdsa_keystore_unmap(soscl_type_ecdsa_keystore *store);
+#endif//SOSCL_ECDSA_KEYSTORE_MMAP
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//_SOSCL_ECDSA_KEYSTORE_H
@@ -0,0 +1,65 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecies.h
+//ECIES hybrid encryption (SEC1 v2 5.1), streaming interface
+
+#ifndef _SOSCL_ECIES_H
+#define _SOSCL_ECIES_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+#include "soscl/soscl_ecc.h"
+#include "soscl/soscl_hash.h"
+#include "soscl/soscl_hmac.h"
+
+  /*
+encryption: R=k.G (ephemeral key), Z=x(k.Q), K=EK||MK=KDF(Z,SharedInfo1), C=M^EK, tag=HMAC(MK,C||SharedInfo2)
+- the KDF is the ANSI X9.63 one: K=H(Z||1||SharedInfo1)||H(Z||2||SharedInfo1)||..., with H being SHA-256 or SHA-512
+- the symmetric layer is the SEC1 XOR encryption scheme: EK is as long as the message, so the message length is given at initialization;
+  the keystream blocks are derived on the fly, and MK (the hash length bytes following EK) is derived at initialization
+- the tag is the full HMAC output (hash length)
+- R is sent compressed (curve_bsize+1 bytes) when it can be decompressed, i.e. p=3 mod 4,
+  and uncompressed (04||x||y, 2*curve_bsize+1 bytes) otherwise (P-224); the decryption accepts both encodings
+the update functions accept in-place buffers (output==input)
+the decryption releases the plaintext before the tag is checked: it shall be discarded if soscl_ecies_decrypt_final fails
+  */
+#define SOSCL_ECIES_EPHEMERAL_COMPRESSED(curve_params) (3==((curve_params)->p[0]&3))
+#define SOSCL_ECIES_EPHEMERAL_BYTESIZE(curve_params) (SOSCL_ECIES_EPHEMERAL_COMPRESSED(curve_params)?(curve_params)->curve_bsize+1:2*(curve_params)->curve_bsize+1)
+#define SOSCL_ECIES_EPHEMERAL_MAX_BYTESIZE (2*SOSCL_SECP521R1_BYTESIZE+1)
+
+  typedef struct _soscl_t_ecies
+  {
+    soscl_type_curve *curve_params;
+    int algo;//SOSCL_SHA256_ID or SOSCL_SHA512_ID
+    int decrypt;
+    uint8_t z[SOSCL_SECP521R1_BYTESIZE];//shared secret, the largest curve size
+    uint8_t *shared_info;//SharedInfo1, kept by reference until the final call
+    int shared_info_length;
+    int length;//message length
+    int offset;//processed bytes
+    uint8_t keystream[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];//current EK block
+    soscl_type_hmac_state mac;
+  } soscl_type_ecies;
+
+  int soscl_ecies_encrypt_init(soscl_type_ecies *ctx,uint8_t *ephemeral,soscl_type_ecc_uint8_t_affine_point q,int length,uint8_t *shared_info1,int shared_info1_length,soscl_type_curve *curve_params,int algo);
+  int soscl_ecies_encrypt_update(soscl_type_ecies *ctx,uint8_t *output,uint8_t *input,int input_length);
+  int soscl_ecies_encrypt_final(soscl_type_ecies *ctx,uint8_t *tag,uint8_t *shared_info2,int shared_info2_length);
+  int soscl_ecies_decrypt_init(soscl_type_ecies *ctx,uint8_t *ephemeral,int ephemeral_length,uint8_t *d,int length,uint8_t *shared_info1,int shared_info1_length,soscl_type_curve *curve_params,int algo);
+  int soscl_ecies_decrypt_update(soscl_type_ecies *ctx,uint8_t *output,uint8_t *input,int input_length);
+  int soscl_ecies_decrypt_final(soscl_type_ecies *ctx,uint8_t *tag,uint8_t *shared_info2,int shared_info2_length);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//_SOSCL_ECIES_H
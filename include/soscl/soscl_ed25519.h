@@ -0,0 +1,37 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//soscl_ed25519.h
+//Ed25519 signatures (RFC 8032), on the curve25519 field arithmetic of soscl_fe25519.h
+
+#ifndef _SOSCL_ED25519_H
+#define _SOSCL_ED25519_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+
+#define SOSCL_ED25519_SECRET_KEY_BYTESIZE 32
+#define SOSCL_ED25519_PUBLIC_KEY_BYTESIZE 32
+#define SOSCL_ED25519_SIGNATURE_BYTESIZE 64
+
+  int soscl_ed25519_public_key(uint8_t *public_key,uint8_t *secret_key);
+  int soscl_ed25519_sign(uint8_t *signature,uint8_t *message,int message_length,uint8_t *secret_key,uint8_t *public_key);
+  int soscl_ed25519_verify(uint8_t *signature,uint8_t *message,int message_length,uint8_t *public_key);
+  //u-coordinate of scalar.B on the birationally equivalent Montgomery curve, for the X25519 public keys
+  int soscl_ed25519_scalarmult_base_u(uint8_t *u,uint8_t *scalar);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//SOSCL_ED25519
@@ -0,0 +1,75 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//soscl_fe25519.h
+//curve25519 field arithmetic (p=2^255-19), shared by X25519 and Ed25519
+//unsaturated limbs: radix 2^25.5 (10 signed limbs of 26 and 25 bits) for 32 bits words, radix 2^51 (5 limbs) for 64 bits words
+//so that the carries are delayed: the additions and subtractions do not carry (32 bits) or only once (64 bits)
+
+#ifndef _SOSCL_FE25519_H
+#define _SOSCL_FE25519_H
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+#include "soscl/soscl_config.h"
+#include "soscl/soscl_types.h"
+
+#define SOSCL_FE25519_BYTESIZE 32
+#ifdef SOSCL_WORD32
+#define SOSCL_FE25519_LIMBS 10
+  typedef int32_t soscl_type_fe25519[SOSCL_FE25519_LIMBS];
+#endif//SOSCL_WORD32
+#ifdef SOSCL_WORD64
+#define SOSCL_FE25519_LIMBS 5
+  typedef uint64_t soscl_type_fe25519[SOSCL_FE25519_LIMBS];
+#endif//SOSCL_WORD64
+
+  //Ed25519 affine point, in the form used by the mixed additions: (y+x,y-x,2.d.x.y)
+  typedef struct _soscl_t_ge25519_precomp
+  {
+    soscl_type_fe25519 yplusx;
+    soscl_type_fe25519 yminusx;
+    soscl_type_fe25519 xy2d;
+  } soscl_type_ge25519_precomp;
+
+  //fixed-base tables, from soscl_ed25519_table.c
+#define SOSCL_ED25519_BASE_POSITIONS 32
+#define SOSCL_ED25519_BASE_MULTIPLES 8
+  extern const soscl_type_fe25519 soscl_fe25519_d;
+  extern const soscl_type_fe25519 soscl_fe25519_d2;
+  extern const soscl_type_fe25519 soscl_fe25519_sqrtm1;
+  extern const soscl_type_ge25519_precomp soscl_ed25519_base[SOSCL_ED25519_BASE_POSITIONS][SOSCL_ED25519_BASE_MULTIPLES];
+  extern const soscl_type_ge25519_precomp soscl_ed25519_bi[SOSCL_ED25519_BASE_MULTIPLES];
+
+  void soscl_fe25519_zero(soscl_type_fe25519 h);
+  void soscl_fe25519_one(soscl_type_fe25519 h);
+  void soscl_fe25519_copy(soscl_type_fe25519 h,const soscl_type_fe25519 f);
+  void soscl_fe25519_frombytes(soscl_type_fe25519 h,const uint8_t *s);
+  void soscl_fe25519_tobytes(uint8_t *s,const soscl_type_fe25519 h);
+  void soscl_fe25519_add(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g);
+  void soscl_fe25519_sub(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g);
+  void soscl_fe25519_neg(soscl_type_fe25519 h,const soscl_type_fe25519 f);
+  void soscl_fe25519_mul(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g);
+  void soscl_fe25519_sq(soscl_type_fe25519 h,const soscl_type_fe25519 f);
+  void soscl_fe25519_sq2(soscl_type_fe25519 h,const soscl_type_fe25519 f);
+  void soscl_fe25519_mul_small(soscl_type_fe25519 h,const soscl_type_fe25519 f,uint32_t c);
+  void soscl_fe25519_invert(soscl_type_fe25519 h,const soscl_type_fe25519 f);
+  void soscl_fe25519_pow22523(soscl_type_fe25519 h,const soscl_type_fe25519 f);
+  void soscl_fe25519_cswap(soscl_type_fe25519 f,soscl_type_fe25519 g,unsigned int b);
+  void soscl_fe25519_cmov(soscl_type_fe25519 f,const soscl_type_fe25519 g,unsigned int b);
+  int soscl_fe25519_isnegative(const soscl_type_fe25519 f);
+  int soscl_fe25519_iszero(const soscl_type_fe25519 f);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif//SOSCL_FE25519
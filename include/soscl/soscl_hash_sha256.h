@@ -32,6 +32,13 @@ extern "C" {
 #define SOSCL_SHA256_H_SIZE 8
   //the nb of bytes for storing the size in the last block
 #define SOSCL_SHA256_BYTE_SIZE_BLOCKSIZE 8
+  //block function implementations
+#define SOSCL_SHA256_IMPLEMENTATION_C 0
+#define SOSCL_SHA256_IMPLEMENTATION_SHANI 1
+  //multi-buffer engines
+#define SOSCL_SHA256_MULTI_IMPLEMENTATION_SERIAL 0
+#define SOSCL_SHA256_MULTI_IMPLEMENTATION_AVX2 1
+#define SOSCL_SHA256_MULTI_IMPLEMENTATION_AVX512 2
   struct soscl_sha256_ctx
   {
     // intermediate state and then final hash
@@ -48,7 +55,18 @@ typedef struct soscl_sha256_ctx soscl_sha256_ctx_t;
   int soscl_sha256_init(soscl_sha256_ctx_t *context);
   int soscl_sha256_core(soscl_sha256_ctx_t *context, uint8_t *data, int data_byte_len);
   void soscl_sha256_block(soscl_sha256_ctx_t *context,uint8_t *m);
+  void soscl_sha256_blocks(soscl_sha256_ctx_t *context,uint8_t *m,int nb_blocks);
+  int soscl_sha256_set_implementation(int implementation);
+  void soscl_sha256_select_implementation(void);
+  extern const word_type soscl_sha256_k[SOSCL_SHA256_ROUNDS_NUMBER];
+#ifdef SOSCL_SHA256_SHANI
+  int soscl_sha256_shani_available(void);
+  void soscl_sha256_shani_blocks(word_type *hash,uint8_t *m,int nb_blocks);
+#endif
   int soscl_sha256_finish(uint8_t *hash, soscl_sha256_ctx_t *context);
+  int soscl_sha256_multi(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count);
+  int soscl_sha256_multi_set_implementation(int implementation);
+  void soscl_sha256_multi_select_implementation(void);
 
   int soscl_hmac_sha256(uint8_t *mac,int mac_byte_len, uint8_t *message,int message_byte_len, uint8_t *key,int key_byte_len);
   int soscl_hmac_sha256_init(soscl_sha256_ctx_t *context , uint8_t *key, int key_byte_len);
@@ -36,6 +36,7 @@ typedef struct soscl_sha512_ctx soscl_sha384_ctx_t;
   int soscl_sha384_init(soscl_sha384_ctx_t *context);
   int soscl_sha384_core(soscl_sha384_ctx_t *context, uint8_t *data, int data_byte_len);
   int soscl_sha384_finish(uint8_t *hash, soscl_sha384_ctx_t *context);
+  int soscl_sha384_multi(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count);
   int soscl_hmac_sha384(uint8_t *mac,int mac_byte_len, uint8_t *message,int message_byte_len, uint8_t *key,int key_byte_len);
   int soscl_hmac_sha384_init(soscl_sha384_ctx_t *context , uint8_t *key, int key_byte_len);
   int soscl_hmac_sha384_core(soscl_sha384_ctx_t *context, uint8_t *data, int byte_len);
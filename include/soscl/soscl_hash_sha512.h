@@ -30,6 +30,10 @@ extern "C" {
 #define SOSCL_SHA512_H_SIZE 8
   //the nb of bytes for storing the size in the last block
 #define SOSCL_SHA512_BYTE_SIZE_BLOCKSIZE 16
+  //multi-buffer engines, also used by SHA-384
+#define SOSCL_SHA512_MULTI_IMPLEMENTATION_SERIAL 0
+#define SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX2 1
+#define SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX512 2
   struct soscl_sha512_ctx
 {
     // Initial, intermediate and then final hash.
@@ -47,6 +51,10 @@ typedef struct soscl_sha512_ctx soscl_sha512_ctx_t;
   int soscl_sha512_core(soscl_sha512_ctx_t *context,uint8_t *data,int data_byteLen);
   void soscl_sha512_block(soscl_sha512_ctx_t *ctx,uint8_t *m);
   int soscl_sha512_finish(uint8_t *hash,soscl_sha512_ctx_t *context);
+  int soscl_sha512_multi(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count);
+  int soscl_sha512_multi_set_implementation(int implementation);
+  void soscl_sha512_multi_select_implementation(void);
+  extern const double_word_type soscl_sha512_k[SOSCL_SHA512_ROUNDS_NUMBER];
   int soscl_hmac_sha512(uint8_t *mac,int mac_byte_len, uint8_t *message,int message_byte_len, uint8_t *key,int key_byte_len);
   int soscl_hmac_sha512_init(soscl_sha512_ctx_t *context , uint8_t *key, int key_byte_len);
   int soscl_hmac_sha512_core(soscl_sha512_ctx_t *context, uint8_t *data, int byte_len);
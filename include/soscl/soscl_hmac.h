@@ -14,12 +14,36 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #ifndef _SOSCL_HMAC_DEFS_H
 #define _SOSCL_HMAC_DEFS_H
+#include <soscl/soscl_hash_sha256.h>
+#include <soscl/soscl_hash_sha384.h>
+#include <soscl/soscl_hash_sha512.h>
 
 int soscl_hmac_init(void *context,int algo,uint8_t *key, int key_byte_len);
 int soscl_hmac_core(void *context,uint8_t *data, int data_byte_len);
 int soscl_hmac_finish(void *context,uint8_t *mac, int mac_byte_len, uint8_t *key, int key_byte_len);
 int soscl_hmac(uint8_t *mac,int mac_byte_len,uint8_t *message,int message_byte_len,uint8_t *key,int key_byte_len,int algo);
 
+//hmac with a precomputed key: the hash states after k0^ipad and k0^opad are kept,
+//so that each mac only hashes the message and the inner digest (no re-keying)
+typedef union _soscl_t_hmac_hash_ctx
+{
+  soscl_sha256_ctx_t ctx256;
+  soscl_sha512_ctx_t ctx512;//also used for sha384
+} soscl_type_hmac_hash_ctx;
+
+typedef struct _soscl_t_hmac_state
+{
+  int algo;
+  soscl_type_hmac_hash_ctx inner;
+  soscl_type_hmac_hash_ctx outer;
+  soscl_type_hmac_hash_ctx ctx;//running mac computation
+} soscl_type_hmac_state;
+
+int soscl_hmac_state_init(soscl_type_hmac_state *state,int algo,uint8_t *key,int key_byte_len);
+int soscl_hmac_state_start(soscl_type_hmac_state *state);
+int soscl_hmac_state_core(soscl_type_hmac_state *state,uint8_t *data,int data_byte_len);
+int soscl_hmac_state_finish(soscl_type_hmac_state *state,uint8_t *mac,int mac_byte_len);
+
 //sha-specific hmac routines are declared in the respective sha include files
 
 #endif//SOSCL_HMAC_DEFS_H
@@ -32,4 +32,5 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #define SOSCL_RNG_ERROR                 -13
 #define SOSCL_RESEED_REQUIRED           -14
 #define SOSCL_IGNORED                   -15
+#define SOSCL_NONCE_POOL_EMPTY          -16
 #endif //SOSCL_RETDEFS_H
@@ -31,55 +31,97 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #define GAMMA0(x) (ROTR(x,7)^ROTR(x,18)^SHR(x,3))
 #define GAMMA1(x) (ROTR(x,17)^ROTR(x,19)^SHR(x,10))
 
-static const word_type k[SOSCL_SHA256_ROUNDS_NUMBER]={0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2};
+const word_type soscl_sha256_k[SOSCL_SHA256_ROUNDS_NUMBER]={0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2};
 
 static const word_type initial_h[SOSCL_SHA256_H_SIZE]={0x6A09E667,0xBB67AE85,0x3C6EF372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19};
 
-void soscl_sha256_block(soscl_sha256_ctx_t *ctx,uint8_t *m)
+//portable block function
+static void soscl_sha256_blocks_c(word_type *hash,uint8_t *m,int nb_blocks)
 {
   int i;
   word_type w[SOSCL_SHA256_ROUNDS_NUMBER];
   word_type a,b,c,d,e,f,g,h,t1,t2;
-  soscl_bignum_direct_b2w(w,m,16);
-  for(i=16;i<SOSCL_SHA256_ROUNDS_NUMBER;i++)
-    w[i]=GAMMA1(w[i-2])+w[i-7]+GAMMA0(w[i-15])+w[i-16];
-  //2.
-  a=ctx->h[0];
-  b=ctx->h[1];
-  c=ctx->h[2];
-  d=ctx->h[3];
-  e=ctx->h[4];
-  f=ctx->h[5];
-  g=ctx->h[6];
-  h=ctx->h[7];
-  //3.
-  for(i=0;i<SOSCL_SHA256_ROUNDS_NUMBER;i++)
+  for(;nb_blocks>0;nb_blocks--,m+=SOSCL_SHA256_BYTE_BLOCKSIZE)
     {
-      t1=h+SIGMA1(e)+CH(e,f,g)+k[i]+w[i];
-      t2=SIGMA0(a)+MAJ(a,b,c);
-      h=g;
-      g=f;
-      f=e;
-      e=d+t1;
-      d=c;
-      c=b;
-      b=a;
-      a=t1+t2;
-      //      printf("%08x %08x %08x %08x %08x %08x %08x %08x\n",a,b,c,d,e,f,g,h);
+      soscl_bignum_direct_b2w(w,m,16);
+      for(i=16;i<SOSCL_SHA256_ROUNDS_NUMBER;i++)
+	w[i]=GAMMA1(w[i-2])+w[i-7]+GAMMA0(w[i-15])+w[i-16];
+      //2.
+      a=hash[0];
+      b=hash[1];
+      c=hash[2];
+      d=hash[3];
+      e=hash[4];
+      f=hash[5];
+      g=hash[6];
+      h=hash[7];
+      //3.
+      for(i=0;i<SOSCL_SHA256_ROUNDS_NUMBER;i++)
+	{
+	  t1=h+SIGMA1(e)+CH(e,f,g)+soscl_sha256_k[i]+w[i];
+	  t2=SIGMA0(a)+MAJ(a,b,c);
+	  h=g;
+	  g=f;
+	  f=e;
+	  e=d+t1;
+	  d=c;
+	  c=b;
+	  b=a;
+	  a=t1+t2;
+	}
+      //4.
+      hash[0]+=a;
+      hash[1]+=b;
+      hash[2]+=c;
+      hash[3]+=d;
+      hash[4]+=e;
+      hash[5]+=f;
+      hash[6]+=g;
+      hash[7]+=h;
     }
-  //4.
-  ctx->h[0]+=a;
-  ctx->h[1]+=b;
-  ctx->h[2]+=c;
-  ctx->h[3]+=d;
-  ctx->h[4]+=e;
-  ctx->h[5]+=f;
-  ctx->h[6]+=g;
-  ctx->h[7]+=h;
-  /*  printf("h\n");
-  for(i=0;i<8;i++)
-    printf("%08x ",ctx->h[i]);
-    printf("\n");*/
+}
+
+//block function in use, the portable one until soscl_sha256_select_implementation is called
+static void (*soscl_sha256_blocks_function)(word_type *hash,uint8_t *m,int nb_blocks)=soscl_sha256_blocks_c;
+
+int soscl_sha256_set_implementation(int implementation)
+{
+  switch(implementation)
+    {
+    case SOSCL_SHA256_IMPLEMENTATION_C:
+      soscl_sha256_blocks_function=soscl_sha256_blocks_c;
+      return(SOSCL_OK);
+    case SOSCL_SHA256_IMPLEMENTATION_SHANI:
+#ifdef SOSCL_SHA256_SHANI
+      if(SOSCL_TRUE!=soscl_sha256_shani_available())
+	return(SOSCL_INVALID_MODE);
+      soscl_sha256_blocks_function=soscl_sha256_shani_blocks;
+      return(SOSCL_OK);
+#else
+      return(SOSCL_INVALID_MODE);
+#endif
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+//selects the fastest block function supported by the CPU, called by soscl_init
+void soscl_sha256_select_implementation(void)
+{
+  if(SOSCL_OK!=soscl_sha256_set_implementation(SOSCL_SHA256_IMPLEMENTATION_SHANI))
+    soscl_sha256_set_implementation(SOSCL_SHA256_IMPLEMENTATION_C);
+}
+
+//processes nb_blocks consecutive 64-byte blocks
+void soscl_sha256_blocks(soscl_sha256_ctx_t *ctx,uint8_t *m,int nb_blocks)
+{
+  if(nb_blocks>0)
+    soscl_sha256_blocks_function(ctx->h,m,nb_blocks);
+}
+
+void soscl_sha256_block(soscl_sha256_ctx_t *ctx,uint8_t *m)
+{
+  soscl_sha256_blocks_function(ctx->h,m,1);
 }
 
 int soscl_sha256_init(soscl_sha256_ctx_t *ctx)
@@ -98,7 +140,7 @@ int soscl_sha256_init(soscl_sha256_ctx_t *ctx)
 //and performing the block process for full blocks
 int soscl_sha256_core(soscl_sha256_ctx_t *ctx,uint8_t *data,int data_byte_len)
 {
-  int block_buffer_index,block_remain,data_index=0;
+  int block_buffer_index,block_remain,data_index=0,nb_blocks;
   if (NULL==ctx || NULL==data)
     return(SOSCL_INVALID_INPUT);
   //currently used nb of bytes in the block buffer
@@ -120,11 +162,11 @@ int soscl_sha256_core(soscl_sha256_ctx_t *ctx,uint8_t *data,int data_byte_len)
       soscl_sha256_block(ctx,ctx->block_buffer);
       //block has been fully processed,so block buffer is empty
       block_buffer_index=0;
-      //processing full blocks as long as data are available
-      for (data_index=block_remain; data_index+SOSCL_SHA256_BYTE_BLOCKSIZE-1<data_byte_len; data_index+=SOSCL_SHA256_BYTE_BLOCKSIZE)
-	{
-	  soscl_sha256_block(ctx,&(data[data_index]));
-	}
+      //processing full blocks as long as data are available, in a single call
+      data_index=block_remain;
+      nb_blocks=(data_byte_len-data_index)/SOSCL_SHA256_BYTE_BLOCKSIZE;
+      soscl_sha256_blocks(ctx,&(data[data_index]),nb_blocks);
+      data_index+=nb_blocks*SOSCL_SHA256_BYTE_BLOCKSIZE;
       //but 'data' may not be completed yet
     }
   //copying the remaining 'data' bytes to the block buffer
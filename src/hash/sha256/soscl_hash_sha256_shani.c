@@ -0,0 +1,109 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// soscl_hash_sha256_shani.c
+// implements the SHA-256 block function with the x86 SHA extensions (SHA-NI)
+// the functions are compiled for the sha and sse4.1 targets only, so the rest of the library
+// keeps the default compiler flags; they must only be called when soscl_sha256_shani_available says so
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_hash.h>
+#include <soscl/soscl_hash_sha256.h>
+
+#ifdef SOSCL_SHA256_SHANI
+#include <cpuid.h>
+#include <immintrin.h>
+
+//cpuid leaf 1, ecx
+#define SOSCL_CPUID_SSSE3 (1<<9)
+#define SOSCL_CPUID_SSE41 (1<<19)
+//cpuid leaf 7, ebx
+#define SOSCL_CPUID_SHA (1<<29)
+
+int soscl_sha256_shani_available(void)
+{
+  unsigned int eax,ebx,ecx,edx;
+  if(!__get_cpuid(1,&eax,&ebx,&ecx,&edx))
+    return(SOSCL_FALSE);
+  if((ecx&(SOSCL_CPUID_SSSE3|SOSCL_CPUID_SSE41))!=(SOSCL_CPUID_SSSE3|SOSCL_CPUID_SSE41))
+    return(SOSCL_FALSE);
+  if(__get_cpuid_max(0,NULL)<7)
+    return(SOSCL_FALSE);
+  __cpuid_count(7,0,eax,ebx,ecx,edx);
+  if(ebx&SOSCL_CPUID_SHA)
+    return(SOSCL_TRUE);
+  return(SOSCL_FALSE);
+}
+
+//4 rounds: the message words w are added to the 4 round constants, then 2 sha256rnds2
+#define SOSCL_SHANI_ROUNDS(w,i)						\
+  tmp=_mm_add_epi32(w,_mm_loadu_si128((const __m128i*)&soscl_sha256_k[i])); \
+  state1=_mm_sha256rnds2_epu32(state1,state0,tmp);			\
+  tmp=_mm_shuffle_epi32(tmp,0x0E);					\
+  state0=_mm_sha256rnds2_epu32(state0,state1,tmp)
+
+//message schedule: w0=W[t-16..t-13], w1=W[t-12..t-9], w2=W[t-8..t-5], w3=W[t-4..t-1]
+//w0 is replaced by W[t..t+3]
+#define SOSCL_SHANI_SCHEDULE(w0,w1,w2,w3)				\
+  w0=_mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0,w1),_mm_alignr_epi8(w3,w2,4)),w3)
+
+__attribute__((target("sha,sse4.1")))
+void soscl_sha256_shani_blocks(word_type *h,uint8_t *m,int nb_blocks)
+{
+  __m128i state0,state1,abef,cdgh,tmp;
+  __m128i w0,w1,w2,w3;
+  //big endian words
+  const __m128i mask=_mm_set_epi64x(0x0c0d0e0f08090a0bULL,0x0405060700010203ULL);
+  int i;
+  //the instructions use the ABEF/CDGH state layout
+  tmp=_mm_loadu_si128((const __m128i*)&h[0]);
+  state1=_mm_loadu_si128((const __m128i*)&h[4]);
+  tmp=_mm_shuffle_epi32(tmp,0xB1);
+  state1=_mm_shuffle_epi32(state1,0x1B);
+  state0=_mm_alignr_epi8(tmp,state1,8);
+  state1=_mm_blend_epi16(state1,tmp,0xF0);
+  for(;nb_blocks>0;nb_blocks--,m+=SOSCL_SHA256_BYTE_BLOCKSIZE)
+    {
+      abef=state0;
+      cdgh=state1;
+      w0=_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)m),mask);
+      w1=_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(m+16)),mask);
+      w2=_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(m+32)),mask);
+      w3=_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(m+48)),mask);
+      SOSCL_SHANI_ROUNDS(w0,0);
+      SOSCL_SHANI_ROUNDS(w1,4);
+      SOSCL_SHANI_ROUNDS(w2,8);
+      SOSCL_SHANI_ROUNDS(w3,12);
+      for(i=16;i<SOSCL_SHA256_ROUNDS_NUMBER;i+=16)
+	{
+	  SOSCL_SHANI_SCHEDULE(w0,w1,w2,w3);
+	  SOSCL_SHANI_ROUNDS(w0,i);
+	  SOSCL_SHANI_SCHEDULE(w1,w2,w3,w0);
+	  SOSCL_SHANI_ROUNDS(w1,i+4);
+	  SOSCL_SHANI_SCHEDULE(w2,w3,w0,w1);
+	  SOSCL_SHANI_ROUNDS(w2,i+8);
+	  SOSCL_SHANI_SCHEDULE(w3,w0,w1,w2);
+	  SOSCL_SHANI_ROUNDS(w3,i+12);
+	}
+      state0=_mm_add_epi32(state0,abef);
+      state1=_mm_add_epi32(state1,cdgh);
+    }
+  //back to the ABCD/EFGH layout
+  tmp=_mm_shuffle_epi32(state0,0x1B);
+  state1=_mm_shuffle_epi32(state1,0xB1);
+  state0=_mm_blend_epi16(tmp,state1,0xF0);
+  state1=_mm_alignr_epi8(state1,tmp,8);
+  _mm_storeu_si128((__m128i*)&h[0],state0);
+  _mm_storeu_si128((__m128i*)&h[4],state1);
+}
+#endif//SOSCL_SHA256_SHANI
@@ -0,0 +1,385 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+// soscl_hash_sha512_multi.c
+// implements the multi-buffer SHA-512 and SHA-384
+// same scheduling than the multi-buffer SHA-256, with 64-bit lanes: 4 lanes with AVX2, 8 with AVX-512
+// SHA-384 only differs by the initial value and the output truncation
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_hash.h>
+#include <soscl/soscl_hash_sha512.h>
+#include <soscl/soscl_hash_sha384.h>
+
+#ifdef SOSCL_HASH_MULTIBUFFER_AVX
+#include <immintrin.h>
+
+#define SOSCL_SHA512_MULTI_MAX_LANES 8
+
+//lane scheduling
+typedef struct
+{
+  uint8_t *msg;
+  int len;
+  //index of the message in the batch, -1 for an idle lane
+  int index;
+  int block;
+  int nb_blocks;
+  uint8_t pad[SOSCL_SHA512_BYTE_BLOCKSIZE];
+} soscl_sha512_lane_t;
+
+//processes one block per lane; the state is transposed: state[word*lanes+lane]
+typedef void (*soscl_sha512_lanes_function_t)(uint64_t *state,uint8_t **blocks);
+
+#define SOSCL_MB_ROTR64_256(x,n) _mm256_or_si256(_mm256_srli_epi64(x,n),_mm256_slli_epi64(x,64-(n)))
+
+//loads the 16 big endian words of 4 blocks, transposed: w[i] holds the word i of the 4 blocks
+__attribute__((target("avx2")))
+static void soscl_sha512_x4_load(__m256i *w,uint8_t **blocks)
+{
+  const __m256i mask=_mm256_set_epi64x(0x08090a0b0c0d0e0fULL,0x0001020304050607ULL,0x08090a0b0c0d0e0fULL,0x0001020304050607ULL);
+  __m256i r[4],t[4];
+  int quarter,l;
+  for(quarter=0;quarter<4;quarter++)
+    {
+      for(l=0;l<4;l++)
+	r[l]=_mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(blocks[l]+32*quarter)),mask);
+      t[0]=_mm256_unpacklo_epi64(r[0],r[1]);
+      t[1]=_mm256_unpackhi_epi64(r[0],r[1]);
+      t[2]=_mm256_unpacklo_epi64(r[2],r[3]);
+      t[3]=_mm256_unpackhi_epi64(r[2],r[3]);
+      w[4*quarter]=_mm256_permute2x128_si256(t[0],t[2],0x20);
+      w[4*quarter+1]=_mm256_permute2x128_si256(t[1],t[3],0x20);
+      w[4*quarter+2]=_mm256_permute2x128_si256(t[0],t[2],0x31);
+      w[4*quarter+3]=_mm256_permute2x128_si256(t[1],t[3],0x31);
+    }
+}
+
+//one round; the caller rotates the variables, so h receives the new a and d the new e
+#define SOSCL_MB_ROUND64_256(a,b,c,d,e,f,g,h,i)				\
+  t1=_mm256_xor_si256(_mm256_xor_si256(SOSCL_MB_ROTR64_256(e,14),SOSCL_MB_ROTR64_256(e,18)),SOSCL_MB_ROTR64_256(e,41)); \
+  t1=_mm256_add_epi64(_mm256_add_epi64(h,t1),_mm256_xor_si256(_mm256_and_si256(e,f),_mm256_andnot_si256(e,g))); \
+  t1=_mm256_add_epi64(t1,_mm256_add_epi64(_mm256_set1_epi64x((long long)soscl_sha512_k[i]),w[(i)&15])); \
+  t2=_mm256_xor_si256(_mm256_xor_si256(SOSCL_MB_ROTR64_256(a,28),SOSCL_MB_ROTR64_256(a,34)),SOSCL_MB_ROTR64_256(a,39)); \
+  t2=_mm256_add_epi64(t2,_mm256_or_si256(_mm256_and_si256(a,b),_mm256_and_si256(c,_mm256_or_si256(a,b)))); \
+  d=_mm256_add_epi64(d,t1);						\
+  h=_mm256_add_epi64(t1,t2)
+
+#define SOSCL_MB_SCHEDULE64_256(i)					\
+  t1=w[((i)-15)&15];							\
+  t2=w[((i)-2)&15];							\
+  t1=_mm256_xor_si256(_mm256_xor_si256(SOSCL_MB_ROTR64_256(t1,1),SOSCL_MB_ROTR64_256(t1,8)),_mm256_srli_epi64(t1,7)); \
+  t2=_mm256_xor_si256(_mm256_xor_si256(SOSCL_MB_ROTR64_256(t2,19),SOSCL_MB_ROTR64_256(t2,61)),_mm256_srli_epi64(t2,6)); \
+  w[(i)&15]=_mm256_add_epi64(_mm256_add_epi64(w[(i)&15],w[((i)-7)&15]),_mm256_add_epi64(t1,t2))
+
+//8 rounds, with the message schedule from round 16
+#define SOSCL_MB_8ROUNDS(ROUND,SCHEDULE,i)		\
+  if((i)>=16) {SCHEDULE((i));}				\
+  ROUND(a,b,c,d,e,f,g,h,(i));				\
+  if((i)>=16) {SCHEDULE((i)+1);}			\
+  ROUND(h,a,b,c,d,e,f,g,(i)+1);				\
+  if((i)>=16) {SCHEDULE((i)+2);}			\
+  ROUND(g,h,a,b,c,d,e,f,(i)+2);				\
+  if((i)>=16) {SCHEDULE((i)+3);}			\
+  ROUND(f,g,h,a,b,c,d,e,(i)+3);				\
+  if((i)>=16) {SCHEDULE((i)+4);}			\
+  ROUND(e,f,g,h,a,b,c,d,(i)+4);				\
+  if((i)>=16) {SCHEDULE((i)+5);}			\
+  ROUND(d,e,f,g,h,a,b,c,(i)+5);				\
+  if((i)>=16) {SCHEDULE((i)+6);}			\
+  ROUND(c,d,e,f,g,h,a,b,(i)+6);				\
+  if((i)>=16) {SCHEDULE((i)+7);}			\
+  ROUND(b,c,d,e,f,g,h,a,(i)+7)
+
+__attribute__((target("avx2")))
+static void soscl_sha512_x4_block(uint64_t *state,uint8_t **blocks)
+{
+  __m256i w[16],s[8],a,b,c,d,e,f,g,h,t1,t2;
+  int i;
+  soscl_sha512_x4_load(w,blocks);
+  for(i=0;i<8;i++)
+    s[i]=_mm256_loadu_si256((__m256i*)&state[4*i]);
+  a=s[0];b=s[1];c=s[2];d=s[3];e=s[4];f=s[5];g=s[6];h=s[7];
+  for(i=0;i<SOSCL_SHA512_ROUNDS_NUMBER;i+=8)
+    {
+      SOSCL_MB_8ROUNDS(SOSCL_MB_ROUND64_256,SOSCL_MB_SCHEDULE64_256,i);
+    }
+  s[0]=_mm256_add_epi64(s[0],a);
+  s[1]=_mm256_add_epi64(s[1],b);
+  s[2]=_mm256_add_epi64(s[2],c);
+  s[3]=_mm256_add_epi64(s[3],d);
+  s[4]=_mm256_add_epi64(s[4],e);
+  s[5]=_mm256_add_epi64(s[5],f);
+  s[6]=_mm256_add_epi64(s[6],g);
+  s[7]=_mm256_add_epi64(s[7],h);
+  for(i=0;i<8;i++)
+    _mm256_storeu_si256((__m256i*)&state[4*i],s[i]);
+}
+
+//CH, MAJ and the 3-input xor are single ternary logic instructions
+#define SOSCL_MB_CH64_512(e,f,g) _mm512_ternarylogic_epi64(e,f,g,0xCA)
+#define SOSCL_MB_MAJ64_512(a,b,c) _mm512_ternarylogic_epi64(a,b,c,0xE8)
+#define SOSCL_MB_XOR3_64_512(x,y,z) _mm512_ternarylogic_epi64(x,y,z,0x96)
+
+#define SOSCL_MB_ROUND64_512(a,b,c,d,e,f,g,h,i)				\
+  t1=SOSCL_MB_XOR3_64_512(_mm512_ror_epi64(e,14),_mm512_ror_epi64(e,18),_mm512_ror_epi64(e,41)); \
+  t1=_mm512_add_epi64(_mm512_add_epi64(h,t1),SOSCL_MB_CH64_512(e,f,g));	\
+  t1=_mm512_add_epi64(t1,_mm512_add_epi64(_mm512_set1_epi64((long long)soscl_sha512_k[i]),w[(i)&15])); \
+  t2=SOSCL_MB_XOR3_64_512(_mm512_ror_epi64(a,28),_mm512_ror_epi64(a,34),_mm512_ror_epi64(a,39)); \
+  t2=_mm512_add_epi64(t2,SOSCL_MB_MAJ64_512(a,b,c));			\
+  d=_mm512_add_epi64(d,t1);						\
+  h=_mm512_add_epi64(t1,t2)
+
+#define SOSCL_MB_SCHEDULE64_512(i)					\
+  t1=w[((i)-15)&15];							\
+  t2=w[((i)-2)&15];							\
+  t1=SOSCL_MB_XOR3_64_512(_mm512_ror_epi64(t1,1),_mm512_ror_epi64(t1,8),_mm512_srli_epi64(t1,7)); \
+  t2=SOSCL_MB_XOR3_64_512(_mm512_ror_epi64(t2,19),_mm512_ror_epi64(t2,61),_mm512_srli_epi64(t2,6)); \
+  w[(i)&15]=_mm512_add_epi64(_mm512_add_epi64(w[(i)&15],w[((i)-7)&15]),_mm512_add_epi64(t1,t2))
+
+__attribute__((target("avx2,avx512f")))
+static void soscl_sha512_x8_block(uint64_t *state,uint8_t **blocks)
+{
+  __m512i w[16],s[8],a,b,c,d,e,f,g,h,t1,t2;
+  __m256i low[16],high[16];
+  int i;
+  //lanes 0-3 and 4-7
+  soscl_sha512_x4_load(low,blocks);
+  soscl_sha512_x4_load(high,blocks+4);
+  for(i=0;i<16;i++)
+    w[i]=_mm512_inserti64x4(_mm512_castsi256_si512(low[i]),high[i],1);
+  for(i=0;i<8;i++)
+    s[i]=_mm512_loadu_si512((void*)&state[8*i]);
+  a=s[0];b=s[1];c=s[2];d=s[3];e=s[4];f=s[5];g=s[6];h=s[7];
+  for(i=0;i<SOSCL_SHA512_ROUNDS_NUMBER;i+=8)
+    {
+      SOSCL_MB_8ROUNDS(SOSCL_MB_ROUND64_512,SOSCL_MB_SCHEDULE64_512,i);
+    }
+  s[0]=_mm512_add_epi64(s[0],a);
+  s[1]=_mm512_add_epi64(s[1],b);
+  s[2]=_mm512_add_epi64(s[2],c);
+  s[3]=_mm512_add_epi64(s[3],d);
+  s[4]=_mm512_add_epi64(s[4],e);
+  s[5]=_mm512_add_epi64(s[5],f);
+  s[6]=_mm512_add_epi64(s[6],g);
+  s[7]=_mm512_add_epi64(s[7],h);
+  for(i=0;i<8;i++)
+    _mm512_storeu_si512((void*)&state[8*i],s[i]);
+}
+
+//engine in use, NULL when the messages are hashed one after the other
+static soscl_sha512_lanes_function_t soscl_sha512_lanes_function=NULL;
+static int soscl_sha512_lanes=1;
+
+//the next block of a lane: either directly the message, or the padding block built in the lane
+static uint8_t *soscl_sha512_lane_block(soscl_sha512_lane_t *lane)
+{
+  int offset,remain,i;
+  double_word_type bitlen;
+  offset=lane->block*SOSCL_SHA512_BYTE_BLOCKSIZE;
+  if(offset+SOSCL_SHA512_BYTE_BLOCKSIZE<=lane->len)
+    return(lane->msg+offset);
+  soscl_memset(lane->pad,0,SOSCL_SHA512_BYTE_BLOCKSIZE);
+  remain=lane->len-offset;
+  if(remain>=0)
+    {
+      soscl_memcpy(lane->pad,lane->msg+offset,remain);
+      lane->pad[remain]=0x80;
+    }
+  //the 16-byte length field, its upper half being 0
+  if(lane->block==lane->nb_blocks-1)
+    {
+      bitlen=(double_word_type)lane->len*8;
+      for(i=SOSCL_SHA512_BYTE_BLOCKSIZE-1;i>=SOSCL_SHA512_BYTE_BLOCKSIZE-SOSCL_SHA512_BYTE_SIZE_BLOCKSIZE/2;i--,bitlen>>=8)
+	lane->pad[i]=(uint8_t)bitlen;
+    }
+  return(lane->pad);
+}
+
+static void soscl_sha512_lane_assign(soscl_sha512_lane_t *lane,uint64_t *state,int l,int index,uint8_t *msgs[],int lens[],double_word_type *iv)
+{
+  int i;
+  lane->index=index;
+  if(index<0)
+    return;
+  lane->msg=msgs[index];
+  lane->len=lens[index];
+  lane->block=0;
+  //the length is coded on 16 bytes, after at least one padding byte
+  lane->nb_blocks=(lane->len+SOSCL_SHA512_BYTE_SIZE_BLOCKSIZE)/SOSCL_SHA512_BYTE_BLOCKSIZE+1;
+  for(i=0;i<SOSCL_SHA512_H_SIZE;i++)
+    state[i*soscl_sha512_lanes+l]=(uint64_t)iv[i];
+}
+
+static void soscl_sha512_multi_lanes(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count,double_word_type *iv,int hash_byte_size)
+{
+  soscl_sha512_lane_t lanes[SOSCL_SHA512_MULTI_MAX_LANES];
+  uint64_t state[SOSCL_SHA512_H_SIZE*SOSCL_SHA512_MULTI_MAX_LANES];
+  uint8_t *blocks[SOSCL_SHA512_MULTI_MAX_LANES];
+  uint8_t idle[SOSCL_SHA512_BYTE_BLOCKSIZE];
+  int l,i,next,active;
+  soscl_memset(idle,0,SOSCL_SHA512_BYTE_BLOCKSIZE);
+  soscl_memset(state,0,sizeof(state));
+  for(next=0,active=0,l=0;l<soscl_sha512_lanes;l++)
+    if(next<count)
+      {
+	soscl_sha512_lane_assign(&lanes[l],state,l,next++,msgs,lens,iv);
+	active++;
+      }
+    else
+      lanes[l].index=-1;
+  while(active>0)
+    {
+      for(l=0;l<soscl_sha512_lanes;l++)
+	if(lanes[l].index<0)
+	  blocks[l]=idle;
+	else
+	  blocks[l]=soscl_sha512_lane_block(&lanes[l]);
+      soscl_sha512_lanes_function(state,blocks);
+      for(l=0;l<soscl_sha512_lanes;l++)
+	{
+	  if(lanes[l].index<0)
+	    continue;
+	  lanes[l].block++;
+	  if(lanes[l].block<lanes[l].nb_blocks)
+	    continue;
+	  //message finished: (truncated) hash output and lane refill
+	  for(i=0;i<hash_byte_size;i++)
+	    hashes[lanes[l].index][i]=(uint8_t)(state[(i/8)*soscl_sha512_lanes+l]>>(56-8*(i%8)));
+	  if(next<count)
+	    soscl_sha512_lane_assign(&lanes[l],state,l,next++,msgs,lens,iv);
+	  else
+	    {
+	      lanes[l].index=-1;
+	      active--;
+	    }
+	}
+    }
+  soscl_memset(state,0,sizeof(state));
+  soscl_memset(lanes,0,sizeof(lanes));
+}
+#endif//SOSCL_HASH_MULTIBUFFER_AVX
+
+int soscl_sha512_multi_set_implementation(int implementation)
+{
+  switch(implementation)
+    {
+    case SOSCL_SHA512_MULTI_IMPLEMENTATION_SERIAL:
+#ifdef SOSCL_HASH_MULTIBUFFER_AVX
+      soscl_sha512_lanes_function=NULL;
+      soscl_sha512_lanes=1;
+#endif
+      return(SOSCL_OK);
+    case SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX2:
+#ifdef SOSCL_HASH_MULTIBUFFER_AVX
+      if(!__builtin_cpu_supports("avx2"))
+	return(SOSCL_INVALID_MODE);
+      soscl_sha512_lanes_function=soscl_sha512_x4_block;
+      soscl_sha512_lanes=4;
+      return(SOSCL_OK);
+#else
+      return(SOSCL_INVALID_MODE);
+#endif
+    case SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX512:
+#ifdef SOSCL_HASH_MULTIBUFFER_AVX
+      if(!__builtin_cpu_supports("avx512f"))
+	return(SOSCL_INVALID_MODE);
+      soscl_sha512_lanes_function=soscl_sha512_x8_block;
+      soscl_sha512_lanes=8;
+      return(SOSCL_OK);
+#else
+      return(SOSCL_INVALID_MODE);
+#endif
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+//selects the widest engine supported by the CPU, called by soscl_init
+void soscl_sha512_multi_select_implementation(void)
+{
+  if(SOSCL_OK==soscl_sha512_multi_set_implementation(SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX512))
+    return;
+  if(SOSCL_OK==soscl_sha512_multi_set_implementation(SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX2))
+    return;
+  soscl_sha512_multi_set_implementation(SOSCL_SHA512_MULTI_IMPLEMENTATION_SERIAL);
+}
+
+static int soscl_sha512_multi_check(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count)
+{
+  int i;
+  if(NULL==hashes)
+    return(SOSCL_INVALID_OUTPUT);
+  if(NULL==msgs || NULL==lens || count<0)
+    return(SOSCL_INVALID_INPUT);
+  for(i=0;i<count;i++)
+    {
+      if(NULL==hashes[i])
+	return(SOSCL_INVALID_OUTPUT);
+      if(NULL==msgs[i] || lens[i]<0)
+	return(SOSCL_INVALID_INPUT);
+    }
+  return(SOSCL_OK);
+}
+
+//hashes[i]=SHA-512(msgs[i]), i<count; each hashes[i] is SOSCL_SHA512_BYTE_HASHSIZE long
+int soscl_sha512_multi(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count)
+{
+  int i,ret;
+  ret=soscl_sha512_multi_check(hashes,msgs,lens,count);
+  if(SOSCL_OK!=ret)
+    return(ret);
+#ifdef SOSCL_HASH_MULTIBUFFER_AVX
+  //a single message does not fill the lanes
+  if(NULL!=soscl_sha512_lanes_function && count>1)
+    {
+      soscl_sha512_ctx_t iv;
+      soscl_sha512_init(&iv);
+      soscl_sha512_multi_lanes(hashes,msgs,lens,count,iv.h,SOSCL_SHA512_BYTE_HASHSIZE);
+      return(SOSCL_OK);
+    }
+#endif
+  for(i=0;i<count;i++)
+    {
+      ret=soscl_sha512(hashes[i],msgs[i],lens[i]);
+      if(SOSCL_OK!=ret)
+	return(ret);
+    }
+  return(SOSCL_OK);
+}
+
+//hashes[i]=SHA-384(msgs[i]), i<count; each hashes[i] is SOSCL_SHA384_BYTE_HASHSIZE long
+int soscl_sha384_multi(uint8_t *hashes[],uint8_t *msgs[],int lens[],int count)
+{
+  int i,ret;
+  ret=soscl_sha512_multi_check(hashes,msgs,lens,count);
+  if(SOSCL_OK!=ret)
+    return(ret);
+#ifdef SOSCL_HASH_MULTIBUFFER_AVX
+  if(NULL!=soscl_sha512_lanes_function && count>1)
+    {
+      soscl_sha384_ctx_t iv;
+      soscl_sha384_init(&iv);
+      soscl_sha512_multi_lanes(hashes,msgs,lens,count,iv.h,SOSCL_SHA384_BYTE_HASHSIZE);
+      return(SOSCL_OK);
+    }
+#endif
+  for(i=0;i<count;i++)
+    {
+      ret=soscl_sha384(hashes[i],msgs[i],lens[i]);
+      if(SOSCL_OK!=ret)
+	return(ret);
+    }
+  return(SOSCL_OK);
+}
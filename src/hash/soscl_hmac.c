@@ -357,3 +357,129 @@ int soscl_hmac_sha512_finish(uint8_t *mac, int mac_byte_len, soscl_sha512_ctx_t
   _soscl_hmac_algo=SOSCL_SHA512_ID;
   return(soscl_hmac_finish(context,mac,mac_byte_len,key,key_byte_len));
 }
+
+//hash primitives on an explicit context, used by the precomputed key functions
+static int soscl_hmac_state_hash_init(soscl_type_hmac_hash_ctx *ctx,int algo)
+{
+  switch(algo)
+    {
+    case SOSCL_SHA256_ID:
+      return(soscl_sha256_init(&ctx->ctx256));
+    case SOSCL_SHA384_ID:
+      return(soscl_sha384_init(&ctx->ctx512));
+    case SOSCL_SHA512_ID:
+      return(soscl_sha512_init(&ctx->ctx512));
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+static int soscl_hmac_state_hash_core(soscl_type_hmac_hash_ctx *ctx,int algo,uint8_t *data,int data_byte_len)
+{
+  switch(algo)
+    {
+    case SOSCL_SHA256_ID:
+      return(soscl_sha256_core(&ctx->ctx256,data,data_byte_len));
+    case SOSCL_SHA384_ID:
+      return(soscl_sha384_core(&ctx->ctx512,data,data_byte_len));
+    case SOSCL_SHA512_ID:
+      return(soscl_sha512_core(&ctx->ctx512,data,data_byte_len));
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+static int soscl_hmac_state_hash_finish(uint8_t *hash,soscl_type_hmac_hash_ctx *ctx,int algo)
+{
+  switch(algo)
+    {
+    case SOSCL_SHA256_ID:
+      return(soscl_sha256_finish(hash,&ctx->ctx256));
+    case SOSCL_SHA384_ID:
+      return(soscl_sha384_finish(hash,&ctx->ctx512));
+    case SOSCL_SHA512_ID:
+      return(soscl_sha512_finish(hash,&ctx->ctx512));
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+//FIPS 198.1 steps 1 to 4 and 7 are done once, for the key
+int soscl_hmac_state_init(soscl_type_hmac_state *state,int algo,uint8_t *key,int key_byte_len)
+{
+  uint8_t k0[SOSCL_HASH_BYTE_BLOCK_MAXSIZE];
+  int i,hashsize,blocksize,ret;
+  if(NULL==state || NULL==key)
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_SHA256_ID!=algo && SOSCL_SHA384_ID!=algo && SOSCL_SHA512_ID!=algo)
+    return(SOSCL_INVALID_INPUT);
+  state->algo=algo;
+  hashsize=hash_size[algo];
+  blocksize=block_size[algo];
+  //steps 1 to 3
+  if(key_byte_len>blocksize)
+    {
+      soscl_sha(k0,key,key_byte_len,algo);
+      key_byte_len=hashsize;
+    }
+  else
+    soscl_memcpy(k0,key,key_byte_len);
+  for(i=key_byte_len;i<blocksize;i++)
+    k0[i]=0x00;
+  //step 4 and the k0^ipad block of step 6
+  for(i=0;i<blocksize;i++)
+    k0[i]^=0x36;
+  ret=soscl_hmac_state_hash_init(&state->inner,algo);
+  if(SOSCL_OK==ret)
+    ret=soscl_hmac_state_hash_core(&state->inner,algo,k0,blocksize);
+  //step 7 and the k0^opad block of step 9
+  for(i=0;i<blocksize;i++)
+    k0[i]^=0x36^0x5C;
+  if(SOSCL_OK==ret)
+    ret=soscl_hmac_state_hash_init(&state->outer,algo);
+  if(SOSCL_OK==ret)
+    ret=soscl_hmac_state_hash_core(&state->outer,algo,k0,blocksize);
+  soscl_memset(k0,0,blocksize);
+  return(ret);
+}
+
+//starts a new mac with the precomputed key
+int soscl_hmac_state_start(soscl_type_hmac_state *state)
+{
+  if(NULL==state)
+    return(SOSCL_INVALID_INPUT);
+  soscl_memcpy(&state->ctx,&state->inner,sizeof(soscl_type_hmac_hash_ctx));
+  return(SOSCL_OK);
+}
+
+int soscl_hmac_state_core(soscl_type_hmac_state *state,uint8_t *data,int data_byte_len)
+{
+  if(NULL==state || (NULL==data && 0!=data_byte_len))
+    return(SOSCL_INVALID_INPUT);
+  return(soscl_hmac_state_hash_core(&state->ctx,state->algo,data,data_byte_len));
+}
+
+//steps 6 (end), 8 and 9: the outer hash resumes from the precomputed k0^opad state
+int soscl_hmac_state_finish(soscl_type_hmac_state *state,uint8_t *mac,int mac_byte_len)
+{
+  uint8_t digest[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int ret,hashsize;
+  if(NULL==state)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==mac)
+    return(SOSCL_INVALID_OUTPUT);
+  hashsize=hash_size[state->algo];
+  if(mac_byte_len>hashsize)
+    return(SOSCL_ERROR);
+  ret=soscl_hmac_state_hash_finish(digest,&state->ctx,state->algo);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  soscl_memcpy(&state->ctx,&state->outer,sizeof(soscl_type_hmac_hash_ctx));
+  ret=soscl_hmac_state_hash_core(&state->ctx,state->algo,digest,hashsize);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  ret=soscl_hmac_state_hash_finish(digest,&state->ctx,state->algo);
+  //mac length can be shorter (truncated) than hash length
+  soscl_memcpy(mac,digest,mac_byte_len);
+  return(ret);
+}
@@ -55,6 +55,25 @@ void test_hash(void)
     printf("OK\n");
   else
   printf("NOK\n");*/
+  if(SOSCL_OK==test_sha256_nist_kat())
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("SHA-256 multi-buffer ");
+  if(SOSCL_OK==test_sha256_multi())
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("SHA-384/SHA-512 ");
+  if(SOSCL_OK==test_sha512_nist_kat())
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("SHA-384/SHA-512 multi-buffer ");
+  if(SOSCL_OK==test_sha512_multi())
+    printf("OK\n");
+  else
+    printf("NOK\n");
 }
 #endif//hash
 
@@ -75,6 +94,46 @@ void test_ecdsa(void)
     printf("OK\n");
   else
     printf("NOK\n");
+  printf("ECDSA batch verification ");
+  if(SOSCL_OK==test_ecdsa_batch_verification(4))
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA batch signature ");
+  if(SOSCL_OK==test_ecdsa_sign_batch(3))
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA nonce pool ");
+  if(SOSCL_OK==test_ecdsa_nonce_pool(3))
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA RFC 6979 ");
+  if(SOSCL_OK==test_ecdsa_rfc6979())
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA verification x1=r+n ");
+  if(SOSCL_OK==test_ecdsa_verification_r_plus_n())
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA key store ");
+  if(SOSCL_OK==test_ecdsa_keystore(3))
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA stream ");
+  if(SOSCL_OK==test_ecdsa_stream())
+    printf("OK\n");
+  else
+    printf("NOK\n");
+  printf("ECDSA verification cache ");
+  if(SOSCL_OK==test_ecdsa_cache())
+    printf("OK\n");
+  else
+    printf("NOK\n");
 }
 #endif//ECDSA
 
@@ -100,6 +159,76 @@ void test_ecc(void)
     printf(" OK\n");
   else
     printf(" NOK\n");
+  printf("ECC batch to affine");
+  if(SOSCL_OK==test_ecc_batch_to_affine())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECDH");
+  if(SOSCL_OK==test_ecc_ecdh())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC point compression");
+  if(SOSCL_OK==test_ecc_point_compression())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC multi mult");
+  if(SOSCL_OK==test_ecc_multi_mult())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC brainpool");
+  if(SOSCL_OK==test_ecc_brainpool())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC complete formulas");
+  if(SOSCL_OK==test_ecc_complete())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC field operations");
+  if(SOSCL_OK==test_ecc_field_ops())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC generated field arithmetic");
+  if(SOSCL_OK==test_ecc_field_generated())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC multi-buffer mult");
+  if(SOSCL_OK==test_ecc_mult_multi())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC X25519");
+  if(SOSCL_OK==test_x25519())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC Ed25519");
+  if(SOSCL_OK==test_ed25519())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC hash to curve");
+  if(SOSCL_OK==test_ecc_hash_to_curve())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECIES");
+  if(SOSCL_OK==test_ecies())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
+  printf("ECC BIP32");
+  if(SOSCL_OK==test_bip32())
+    printf(" OK\n");
+  else
+    printf(" NOK\n");
 }
 #endif//ECC
 
@@ -19,6 +19,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <soscl/soscl_hash_sha256.h>
 #include <soscl/soscl_hash_sha384.h>
 #include <soscl/soscl_hash_sha512.h>
+#include <soscl/soscl_ecc_multibuffer.h>
 
 #include <soscl/soscl_stack.h>
 #include <soscl/soscl_rng.h>
@@ -45,6 +46,10 @@ int soscl_init(word_type *soscl_stack, int soscl_stack_word_len)
   block_size[SOSCL_SHA384_ID]=SOSCL_SHA384_BYTE_BLOCKSIZE;
   hash_size[SOSCL_SHA512_ID]=SOSCL_SHA512_BYTE_HASHSIZE;
   block_size[SOSCL_SHA512_ID]=SOSCL_SHA512_BYTE_BLOCKSIZE;
+  soscl_sha256_select_implementation();
+  soscl_sha256_multi_select_implementation();
+  soscl_sha512_multi_select_implementation();
+  soscl_ecc_mult_multi_select_implementation();
 
   _soscl_init=SOSCL_DONE;
   return(SOSCL_OK);
@@ -662,14 +662,51 @@ int soscl_bignum_modinv(word_type *x,word_type *a,word_type *b,int word_size)
   return(SOSCL_OK);
 }
 
+//Montgomery's trick: count inversions for the price of one inversion and 3.(count-1) multiplications
+//a and r are count consecutive numbers of word_size words; r and a shall not overlap
+//all the a values shall be invertible
+int soscl_bignum_modinv_batch(word_type *r,word_type *a,int count,word_type *modulus,int word_size)
+{
+  int i,ret;
+  word_type *work,*inv,*tmp;
+  if(count<=0)
+    return(SOSCL_INVALID_INPUT);
+  if(soscl_stack_alloc(&work,word_size*2)!=SOSCL_OK)
+    return(SOSCL_STACK_OVERFLOW);
+  inv=work;
+  tmp=inv+word_size;
+  //1. prefix products: r_i=a_0*...*a_i
+  soscl_bignum_memcpy(r,a,word_size);
+  for(i=1;i<count;i++)
+    if(SOSCL_OK!=(ret=soscl_bignum_modmult(r+i*word_size,r+(i-1)*word_size,a+i*word_size,modulus,word_size)))
+      goto soscl_label_modinv_batch_end;
+  //2. one single inversion of the whole product
+  if(SOSCL_OK!=(ret=soscl_bignum_modinv(inv,r+(count-1)*word_size,modulus,word_size)))
+    goto soscl_label_modinv_batch_end;
+  //3. backward, inv=(a_0*...*a_i)^-1
+  for(i=count-1;i>0;i--)
+    {
+      soscl_bignum_modmult(tmp,inv,a+i*word_size,modulus,word_size);
+      soscl_bignum_modmult(r+i*word_size,inv,r+(i-1)*word_size,modulus,word_size);
+      soscl_bignum_memcpy(inv,tmp,word_size);
+    }
+  soscl_bignum_memcpy(r,inv,word_size);
+  ret=SOSCL_OK;
+ soscl_label_modinv_batch_end:
+  if(soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
 //word-array conversion to byte-array
  int soscl_bignum_w2b(uint8_t *a,int byte_len,word_type *b,int word_size)
 {
   int i,j,k;
   //byte array is parsed in reverse order compared to word array
-  for(i=0,j=byte_len-1;i<word_size;i++)
+  //the byte array may be shorter than the word array (e.g. 66 bytes for 17 words in p521)
+  for(i=0,j=byte_len-1;i<word_size && j>=0;i++)
     //parse each word,8 by 8 bits,and store in the byte array
-    for(k=0;k<SOSCL_WORD_BITS;j--,k+=SOSCL_BYTE_BITS)
+    for(k=0;k<SOSCL_WORD_BITS && j>=0;j--,k+=SOSCL_BYTE_BITS)
       a[j]=(uint8_t)(b[i]>>k);
   //remaining bytes,if any,are cleared
   for(;j>=0;j--)
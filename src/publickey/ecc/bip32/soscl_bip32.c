@@ -0,0 +1,251 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_bip32.c
+// implements the BIP32 key derivation (master key, private and public child key derivations)
+// the batch derivation hashes all the children from the same HMAC midstate, and gets all the public keys affine coordinates with one single inversion
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_hash.h>
+#include <soscl/soscl_hash_sha512.h>
+#include <soscl/soscl_hmac.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_keygeneration.h>
+#include <soscl/soscl_bip32.h>
+
+extern soscl_type_curve soscl_secp256k1;
+
+//I=HMAC-SHA512(Key="Bitcoin seed",Data=S), the private key being IL and the chain code IR
+int soscl_bip32_master_key(soscl_type_bip32_key *key,uint8_t *seed,int seed_length)
+{
+  uint8_t i[SOSCL_SHA512_BYTE_HASHSIZE];
+  word_type il[SOSCL_SECP256K1_WORDSIZE];
+  soscl_type_ecc_uint8_t_affine_point q;
+  int ret;
+  if(NULL==seed || seed_length<0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==key)
+    return(SOSCL_INVALID_OUTPUT);
+  ret=soscl_hmac_sha512(i,SOSCL_SHA512_BYTE_HASHSIZE,seed,seed_length,(uint8_t*)SOSCL_BIP32_SEED_KEY,sizeof(SOSCL_BIP32_SEED_KEY)-1);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  //IL shall be in [1,n-1]
+  soscl_bignum_b2w(il,SOSCL_SECP256K1_WORDSIZE,i,SOSCL_BIP32_KEY_BYTESIZE);
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(il,SOSCL_SECP256K1_WORDSIZE) || soscl_bignum_memcmp(il,soscl_secp256k1.n,SOSCL_SECP256K1_WORDSIZE)>=0)
+    {
+      ret=SOSCL_ERROR;
+      goto soscl_label_bip32_master_end;
+    }
+  soscl_memcpy(key->d,i,SOSCL_BIP32_KEY_BYTESIZE);
+  soscl_memcpy(key->chain_code,i+SOSCL_BIP32_KEY_BYTESIZE,SOSCL_BIP32_CHAIN_CODE_BYTESIZE);
+  q.x=key->x;
+  q.y=key->y;
+  ret=soscl_ecc_publickeygeneration(q,key->d,&soscl_secp256k1);
+  key->has_private=SOSCL_TRUE;
+  key->depth=0;
+  key->child_number=0;
+ soscl_label_bip32_master_end:
+  soscl_memset(i,0,sizeof(i));
+  soscl_bignum_set_zero(il,SOSCL_SECP256K1_WORDSIZE);
+  if(SOSCL_OK!=ret)
+    soscl_memset(key,0,sizeof(soscl_type_bip32_key));
+  return(ret);
+}
+
+//serP(K): compressed point
+static void soscl_bip32_serp(uint8_t *output,uint8_t *x,uint8_t *y)
+{
+  output[0]=(uint8_t)(0x02|(y[SOSCL_BIP32_KEY_BYTESIZE-1]&1));
+  soscl_memcpy(output+1,x,SOSCL_BIP32_KEY_BYTESIZE);
+}
+
+//children[i]=CKDpriv(parent,indexes[i]) if the parent has a private key, CKDpub(parent,indexes[i]) otherwise
+//1. I=HMAC-SHA512(c_par,0x00||k_par||i) (hardened) or HMAC-SHA512(c_par,serP(K_par)||i), from the midstate of the c_par key
+//2. k_i=IL+k_par mod n, K_i=k_i.G (private) or K_i=IL.G+K_par (public), in jacobian coordinates
+//3. all the K_i z coordinates inverted at once
+//if IL>=n or k_i=0 for one child (probability below 2^-127), SOSCL_ERROR is returned, and the next index shall be used, as in BIP32
+//children may be the parent itself when count is 1
+int soscl_bip32_derive_batch(soscl_type_bip32_key *children,soscl_type_bip32_key *parent,uint32_t *indexes,int count)
+{
+  soscl_type_hmac_state mac;
+  uint8_t data[1+SOSCL_BIP32_KEY_BYTESIZE+4];
+  uint8_t serp[1+SOSCL_BIP32_KEY_BYTESIZE];
+  uint8_t i_hash[SOSCL_SHA512_BYTE_HASHSIZE];
+  word_type *work,*k,*xj,*yj,*zj,*zinv,*kpar,*xpar,*ypar,*t;
+  soscl_type_ecc_word_jacobian_point pointj;
+  soscl_type_ecc_word_affine_point g,qpar;
+  soscl_type_curve *curve_params;
+  int ret,i,curve_wsize,curve_bsize,has_private;
+  uint32_t depth,index;
+  if(NULL==parent || NULL==indexes || count<=0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==children)
+    return(SOSCL_INVALID_OUTPUT);
+  has_private=parent->has_private;
+  //hardened derivation needs the private key
+  if(SOSCL_TRUE!=has_private)
+    for(i=0;i<count;i++)
+      if(0!=(indexes[i]&SOSCL_BIP32_HARDENED))
+	return(SOSCL_INVALID_INPUT);
+  curve_params=&soscl_secp256k1;
+  curve_wsize=curve_params->curve_wsize;
+  curve_bsize=curve_params->curve_bsize;
+  //the chain code key is processed once
+  ret=soscl_hmac_state_init(&mac,SOSCL_SHA512_ID,parent->chain_code,SOSCL_BIP32_CHAIN_CODE_BYTESIZE);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  if (soscl_stack_alloc(&work,(5*count+4)*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  k=work;
+  xj=k+count*curve_wsize;
+  yj=xj+count*curve_wsize;
+  zj=yj+count*curve_wsize;
+  zinv=zj+count*curve_wsize;
+  kpar=zinv+count*curve_wsize;
+  xpar=kpar+curve_wsize;
+  ypar=xpar+curve_wsize;
+  t=ypar+curve_wsize;
+  //the parent fields are read before any child is written
+  depth=parent->depth;
+  soscl_bip32_serp(serp,parent->x,parent->y);
+  if(SOSCL_TRUE==has_private)
+    soscl_bignum_b2w(kpar,curve_wsize,parent->d,curve_bsize);
+  soscl_bignum_b2w(xpar,curve_wsize,parent->x,curve_bsize);
+  soscl_bignum_b2w(ypar,curve_wsize,parent->y,curve_bsize);
+  soscl_ecc_to_domain(xpar,xpar,curve_params);
+  soscl_ecc_to_domain(ypar,ypar,curve_params);
+  qpar.x=xpar;
+  qpar.y=ypar;
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  for(i=0;i<count;i++)
+    {
+      index=indexes[i];
+      //1. I
+      if(0!=(index&SOSCL_BIP32_HARDENED))
+	{
+	  data[0]=0x00;
+	  soscl_bignum_w2b(data+1,curve_bsize,kpar,curve_wsize);
+	}
+      else
+	soscl_memcpy(data,serp,sizeof(serp));
+      data[1+SOSCL_BIP32_KEY_BYTESIZE]=(uint8_t)(index>>24);
+      data[2+SOSCL_BIP32_KEY_BYTESIZE]=(uint8_t)(index>>16);
+      data[3+SOSCL_BIP32_KEY_BYTESIZE]=(uint8_t)(index>>8);
+      data[4+SOSCL_BIP32_KEY_BYTESIZE]=(uint8_t)index;
+      ret=soscl_hmac_state_start(&mac);
+      if(SOSCL_OK==ret)
+	ret=soscl_hmac_state_core(&mac,data,sizeof(data));
+      if(SOSCL_OK==ret)
+	ret=soscl_hmac_state_finish(&mac,i_hash,SOSCL_SHA512_BYTE_HASHSIZE);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_bip32_derive_end;
+      //2. k_i and K_i
+      soscl_bignum_b2w(k+i*curve_wsize,curve_wsize,i_hash,curve_bsize);
+      soscl_memcpy(children[i].chain_code,i_hash+SOSCL_BIP32_KEY_BYTESIZE,SOSCL_BIP32_CHAIN_CODE_BYTESIZE);
+      if(soscl_bignum_memcmp(k+i*curve_wsize,curve_params->n,curve_wsize)>=0)
+	{
+	  ret=SOSCL_ERROR;
+	  goto soscl_label_bip32_derive_end;
+	}
+      if(SOSCL_TRUE==has_private)
+	{
+	  soscl_bignum_modadd(k+i*curve_wsize,k+i*curve_wsize,kpar,curve_params->n,curve_wsize);
+	  if(SOSCL_OK==soscl_bignum_cmp_with_zero(k+i*curve_wsize,curve_wsize))
+	    {
+	      ret=SOSCL_ERROR;
+	      goto soscl_label_bip32_derive_end;
+	    }
+	}
+      pointj.x=xj+i*curve_wsize;
+      pointj.y=yj+i*curve_wsize;
+      pointj.z=zj+i*curve_wsize;
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(k+i*curve_wsize,curve_wsize))
+	{
+	  //IL=0 (public derivation only): K_i=K_par
+	  soscl_bignum_memcpy(pointj.x,xpar,curve_wsize);
+	  soscl_bignum_memcpy(pointj.y,ypar,curve_wsize);
+	  ret=soscl_ecc_field_one(pointj.z,curve_params);
+	}
+      else
+	{
+	  ret=soscl_ecc_mult_coz_jacobian(pointj,k+i*curve_wsize,curve_wsize,g,curve_params);
+	  if(SOSCL_OK==ret && SOSCL_TRUE!=has_private)
+	    ret=soscl_ecc_add_jacobian_affine(pointj,pointj,qpar,curve_params);
+	}
+      if(SOSCL_OK!=ret)
+	goto soscl_label_bip32_derive_end;
+      //K_i shall not be the infinity point
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(pointj.z,curve_wsize))
+	{
+	  ret=SOSCL_ERROR;
+	  goto soscl_label_bip32_derive_end;
+	}
+    }
+  //3. one single inversion for all the children
+  ret=soscl_ecc_modinv_batch(zinv,zj,count,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_bip32_derive_end;
+  for(i=0;i<count;i++)
+    {
+      //x=X/Z^2, y=Y/Z^3
+      soscl_ecc_modsquare(t,zinv+i*curve_wsize,curve_params);
+      soscl_ecc_modmult(xj+i*curve_wsize,xj+i*curve_wsize,t,curve_params);
+      soscl_ecc_modmult(t,t,zinv+i*curve_wsize,curve_params);
+      soscl_ecc_modmult(yj+i*curve_wsize,yj+i*curve_wsize,t,curve_params);
+      soscl_ecc_from_domain(xj+i*curve_wsize,xj+i*curve_wsize,curve_params);
+      soscl_ecc_from_domain(yj+i*curve_wsize,yj+i*curve_wsize,curve_params);
+      soscl_bignum_w2b(children[i].x,curve_bsize,xj+i*curve_wsize,curve_wsize);
+      soscl_bignum_w2b(children[i].y,curve_bsize,yj+i*curve_wsize,curve_wsize);
+      if(SOSCL_TRUE==has_private)
+	soscl_bignum_w2b(children[i].d,curve_bsize,k+i*curve_wsize,curve_wsize);
+      else
+	soscl_memset(children[i].d,0,SOSCL_BIP32_KEY_BYTESIZE);
+      children[i].has_private=has_private;
+      children[i].depth=depth+1;
+      children[i].child_number=indexes[i];
+    }
+ soscl_label_bip32_derive_end:
+  //the private keys shall not remain on the stack
+  soscl_bignum_set_zero(work,(5*count+4)*curve_wsize);
+  soscl_memset(data,0,sizeof(data));
+  soscl_memset(i_hash,0,sizeof(i_hash));
+  soscl_memset(&mac,0,sizeof(mac));
+  if(SOSCL_OK!=ret)
+    soscl_memset(children,0,count*(int)sizeof(soscl_type_bip32_key));
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+int soscl_bip32_derive(soscl_type_bip32_key *child,soscl_type_bip32_key *parent,uint32_t index)
+{
+  return(soscl_bip32_derive_batch(child,parent,&index,1));
+}
+
+//N((k,c))=(K,c)
+int soscl_bip32_neuter(soscl_type_bip32_key *public_key,soscl_type_bip32_key *key)
+{
+  if(NULL==key)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==public_key)
+    return(SOSCL_INVALID_OUTPUT);
+  if(public_key!=key)
+    soscl_memcpy(public_key,key,sizeof(soscl_type_bip32_key));
+  soscl_memset(public_key->d,0,SOSCL_BIP32_KEY_BYTESIZE);
+  public_key->has_private=SOSCL_FALSE;
+  return(SOSCL_OK);
+}
@@ -0,0 +1,290 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_complete.c
+// complete addition formulas in homogeneous projective coordinates, for a=-3 curves
+// Renes, Costello, Batina, "Complete addition formulas for prime order elliptic curves", algorithms 4 and 6
+// the same operation sequence is executed for any input, including the infinity point (0:1:0) and P+P
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_init.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_complete.h>
+
+void soscl_ecc_projective_copy(soscl_type_ecc_word_projective_point q,soscl_type_ecc_word_projective_point p,int curve_wsize)
+{
+  soscl_bignum_memcpy(q.x,p.x,curve_wsize);
+  soscl_bignum_memcpy(q.y,p.y,curve_wsize);
+  soscl_bignum_memcpy(q.z,p.z,curve_wsize);
+}
+
+//(0:1:0), in the field domain
+void soscl_ecc_projective_set_infinite(soscl_type_ecc_word_projective_point q,soscl_type_curve *curve_params)
+{
+  soscl_bignum_set_zero(q.x,curve_params->curve_wsize);
+  soscl_ecc_field_one(q.y,curve_params);
+  soscl_bignum_set_zero(q.z,curve_params->curve_wsize);
+}
+
+//RCB algorithm 4: q3=q1+q2, 12M+2mb+29a, no exception
+//q3 may be q1 or q2
+int soscl_ecc_add_complete(soscl_type_ecc_word_projective_point q3,soscl_type_ecc_word_projective_point q1,soscl_type_ecc_word_projective_point q2,soscl_type_curve *curve_params)
+{
+  word_type *work,*t0,*t1,*t2,*t3,*t4,*x3,*y3,*z3,*b;
+  int curve_wsize;
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  //the formulas below are specific to a=-3
+  if(NULL!=curve_params->a_domain)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work, curve_wsize*9)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  t0=work;
+  t1=t0+curve_wsize;
+  t2=t1+curve_wsize;
+  t3=t2+curve_wsize;
+  t4=t3+curve_wsize;
+  x3=t4+curve_wsize;
+  y3=x3+curve_wsize;
+  z3=y3+curve_wsize;
+  b=z3+curve_wsize;
+  soscl_ecc_to_domain(b,curve_params->b,curve_params);
+  soscl_ecc_modmult(t0,q1.x,q2.x,curve_params);
+  soscl_ecc_modmult(t1,q1.y,q2.y,curve_params);
+  soscl_ecc_modmult(t2,q1.z,q2.z,curve_params);
+  soscl_ecc_modadd(t3,q1.x,q1.y,curve_params);
+  soscl_ecc_modadd(t4,q2.x,q2.y,curve_params);
+  soscl_ecc_modmult(t3,t3,t4,curve_params);
+  soscl_ecc_modadd(t4,t0,t1,curve_params);
+  soscl_ecc_modsub(t3,t3,t4,curve_params);
+  soscl_ecc_modadd(t4,q1.y,q1.z,curve_params);
+  soscl_ecc_modadd(x3,q2.y,q2.z,curve_params);
+  soscl_ecc_modmult(t4,t4,x3,curve_params);
+  soscl_ecc_modadd(x3,t1,t2,curve_params);
+  soscl_ecc_modsub(t4,t4,x3,curve_params);
+  soscl_ecc_modadd(x3,q1.x,q1.z,curve_params);
+  soscl_ecc_modadd(y3,q2.x,q2.z,curve_params);
+  soscl_ecc_modmult(x3,x3,y3,curve_params);
+  soscl_ecc_modadd(y3,t0,t2,curve_params);
+  soscl_ecc_modsub(y3,x3,y3,curve_params);
+  soscl_ecc_modmult(z3,b,t2,curve_params);
+  soscl_ecc_modsub(x3,y3,z3,curve_params);
+  soscl_ecc_modadd(z3,x3,x3,curve_params);
+  soscl_ecc_modadd(x3,x3,z3,curve_params);
+  soscl_ecc_modsub(z3,t1,x3,curve_params);
+  soscl_ecc_modadd(x3,t1,x3,curve_params);
+  soscl_ecc_modmult(y3,b,y3,curve_params);
+  soscl_ecc_modadd(t1,t2,t2,curve_params);
+  soscl_ecc_modadd(t2,t1,t2,curve_params);
+  soscl_ecc_modsub(y3,y3,t2,curve_params);
+  soscl_ecc_modsub(y3,y3,t0,curve_params);
+  soscl_ecc_modadd(t1,y3,y3,curve_params);
+  soscl_ecc_modadd(y3,t1,y3,curve_params);
+  soscl_ecc_modadd(t1,t0,t0,curve_params);
+  soscl_ecc_modadd(t0,t1,t0,curve_params);
+  soscl_ecc_modsub(t0,t0,t2,curve_params);
+  soscl_ecc_modmult(t1,t4,y3,curve_params);
+  soscl_ecc_modmult(t2,t0,y3,curve_params);
+  soscl_ecc_modmult(y3,x3,z3,curve_params);
+  soscl_ecc_modadd(y3,y3,t2,curve_params);
+  soscl_ecc_modmult(x3,x3,t3,curve_params);
+  soscl_ecc_modsub(x3,x3,t1,curve_params);
+  soscl_ecc_modmult(z3,t4,z3,curve_params);
+  soscl_ecc_modmult(t1,t3,t0,curve_params);
+  soscl_ecc_modadd(z3,z3,t1,curve_params);
+  soscl_bignum_memcpy(q3.x,x3,curve_wsize);
+  soscl_bignum_memcpy(q3.y,y3,curve_wsize);
+  soscl_bignum_memcpy(q3.z,z3,curve_wsize);
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//RCB algorithm 6: q3=2.q1, 8M+3S+2mb+21a, no exception
+//q3 may be q1
+int soscl_ecc_double_complete(soscl_type_ecc_word_projective_point q3,soscl_type_ecc_word_projective_point q1,soscl_type_curve *curve_params)
+{
+  word_type *work,*t0,*t1,*t2,*t3,*x3,*y3,*z3,*b;
+  int curve_wsize;
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL!=curve_params->a_domain)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work, curve_wsize*8)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  t0=work;
+  t1=t0+curve_wsize;
+  t2=t1+curve_wsize;
+  t3=t2+curve_wsize;
+  x3=t3+curve_wsize;
+  y3=x3+curve_wsize;
+  z3=y3+curve_wsize;
+  b=z3+curve_wsize;
+  soscl_ecc_to_domain(b,curve_params->b,curve_params);
+  soscl_ecc_modsquare(t0,q1.x,curve_params);
+  soscl_ecc_modsquare(t1,q1.y,curve_params);
+  soscl_ecc_modsquare(t2,q1.z,curve_params);
+  soscl_ecc_modmult(t3,q1.x,q1.y,curve_params);
+  soscl_ecc_modadd(t3,t3,t3,curve_params);
+  soscl_ecc_modmult(z3,q1.x,q1.z,curve_params);
+  soscl_ecc_modadd(z3,z3,z3,curve_params);
+  soscl_ecc_modmult(y3,b,t2,curve_params);
+  soscl_ecc_modsub(y3,y3,z3,curve_params);
+  soscl_ecc_modadd(x3,y3,y3,curve_params);
+  soscl_ecc_modadd(y3,x3,y3,curve_params);
+  soscl_ecc_modsub(x3,t1,y3,curve_params);
+  soscl_ecc_modadd(y3,t1,y3,curve_params);
+  soscl_ecc_modmult(y3,x3,y3,curve_params);
+  soscl_ecc_modmult(x3,x3,t3,curve_params);
+  soscl_ecc_modadd(t3,t2,t2,curve_params);
+  soscl_ecc_modadd(t2,t2,t3,curve_params);
+  soscl_ecc_modmult(z3,b,z3,curve_params);
+  soscl_ecc_modsub(z3,z3,t2,curve_params);
+  soscl_ecc_modsub(z3,z3,t0,curve_params);
+  soscl_ecc_modadd(t3,z3,z3,curve_params);
+  soscl_ecc_modadd(z3,z3,t3,curve_params);
+  soscl_ecc_modadd(t3,t0,t0,curve_params);
+  soscl_ecc_modadd(t0,t3,t0,curve_params);
+  soscl_ecc_modsub(t0,t0,t2,curve_params);
+  soscl_ecc_modmult(t0,t0,z3,curve_params);
+  soscl_ecc_modadd(y3,y3,t0,curve_params);
+  soscl_ecc_modmult(t0,q1.y,q1.z,curve_params);
+  soscl_ecc_modadd(t0,t0,t0,curve_params);
+  soscl_ecc_modmult(z3,t0,z3,curve_params);
+  soscl_ecc_modsub(x3,x3,z3,curve_params);
+  soscl_ecc_modmult(z3,t0,t1,curve_params);
+  soscl_ecc_modadd(z3,z3,z3,curve_params);
+  soscl_ecc_modadd(z3,z3,z3,curve_params);
+  soscl_bignum_memcpy(q3.x,x3,curve_wsize);
+  soscl_bignum_memcpy(q3.y,y3,curve_wsize);
+  soscl_bignum_memcpy(q3.z,z3,curve_wsize);
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//x:y -> x:y:1, the affine 0:0 being the infinity point
+int soscl_ecc_convert_affine_to_projective(soscl_type_ecc_word_projective_point q,soscl_type_ecc_word_affine_point a,soscl_type_curve *curve_params)
+{
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  if(SOSCL_TRUE==soscl_ecc_infinite_affine(a.x,a.y,curve_wsize))
+    {
+      soscl_ecc_projective_set_infinite(q,curve_params);
+      return(SOSCL_OK);
+    }
+  soscl_bignum_memcpy(q.x,a.x,curve_wsize);
+  soscl_bignum_memcpy(q.y,a.y,curve_wsize);
+  soscl_ecc_field_one(q.z,curve_params);
+  return(SOSCL_OK);
+}
+
+//x:y:z corresponds to x/z:y/z, the infinity point being converted into 0:0
+int soscl_ecc_convert_projective_to_affine(soscl_type_ecc_word_affine_point a,soscl_type_ecc_word_projective_point q,soscl_type_curve *curve_params)
+{
+  word_type *work;
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(q.z,curve_wsize))
+    {
+      soscl_bignum_set_zero(a.x,curve_wsize);
+      soscl_bignum_set_zero(a.y,curve_wsize);
+      return(SOSCL_OK);
+    }
+  if (soscl_stack_alloc(&work, curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  soscl_ecc_modinv(work,q.z,curve_params);
+  soscl_ecc_modmult(a.x,q.x,work,curve_params);
+  soscl_ecc_modmult(a.y,q.y,work,curve_params);
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//exchanges a and b if bit is 1, without branch
+static void soscl_ecc_complete_cswap(soscl_type_ecc_word_projective_point a,soscl_type_ecc_word_projective_point b,word_type bit,int curve_wsize)
+{
+  word_type mask,t;
+  int i;
+  mask=(word_type)0-bit;
+  for(i=0;i<curve_wsize;i++)
+    {
+      t=mask&(a.x[i]^b.x[i]);
+      a.x[i]^=t;
+      b.x[i]^=t;
+      t=mask&(a.y[i]^b.y[i]);
+      a.y[i]^=t;
+      b.y[i]^=t;
+      t=mask&(a.z[i]^b.z[i]);
+      a.z[i]^=t;
+      b.z[i]^=t;
+    }
+}
+
+//q=k.point, Montgomery ladder on the complete formulas
+//every bit of the size-word scalar costs one addition and one doubling, whatever its value
+int soscl_ecc_mult_complete(soscl_type_ecc_word_affine_point q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params)
+{
+  word_type *work,bit;
+  soscl_type_ecc_word_projective_point r0,r1;
+  soscl_type_ecc_word_affine_point a;
+  int i,curve_wsize,ret;
+  if(NULL==curve_params || NULL==k)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL!=curve_params->a_domain)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work, curve_wsize*6)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  r0.x=work;
+  r0.y=r0.x+curve_wsize;
+  r0.z=r0.y+curve_wsize;
+  r1.x=r0.z+curve_wsize;
+  r1.y=r1.x+curve_wsize;
+  r1.z=r1.y+curve_wsize;
+  //r1=point, in the field domain
+  a.x=r1.x;
+  a.y=r1.y;
+  soscl_ecc_to_domain(a.x,point.x,curve_params);
+  soscl_ecc_to_domain(a.y,point.y,curve_params);
+  soscl_ecc_convert_affine_to_projective(r1,a,curve_params);
+  soscl_ecc_projective_set_infinite(r0,curve_params);
+  //invariant: r1-r0=point
+  ret=SOSCL_OK;
+  for(i=(int)size*SOSCL_WORD_BITS-1;i>=0;i--)
+    {
+      bit=(word_type)soscl_word_bit(k,i);
+      soscl_ecc_complete_cswap(r0,r1,bit,curve_wsize);
+      ret|=soscl_ecc_add_complete(r1,r0,r1,curve_params);
+      ret|=soscl_ecc_double_complete(r0,r0,curve_params);
+      soscl_ecc_complete_cswap(r0,r1,bit,curve_wsize);
+    }
+  if(SOSCL_OK!=ret)
+    ret=SOSCL_ERROR;
+  else
+    ret=soscl_ecc_convert_projective_to_affine(q,r0,curve_params);
+  if(SOSCL_OK==ret)
+    {
+      soscl_ecc_from_domain(q.x,q.x,curve_params);
+      soscl_ecc_from_domain(q.y,q.y,curve_params);
+    }
+  soscl_memset(work,0,curve_wsize*6*(int)sizeof(word_type));
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
@@ -0,0 +1,550 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ed25519.c
+// Ed25519 signatures (RFC 8032)
+// the group formulas and the fixed-base/double-scalar multiplications follow the ref10 ones (extended twisted Edwards coordinates)
+// the scalars are reduced mod L with the soscl big numbers
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_hash_sha512.h>
+#include <soscl/soscl_fe25519.h>
+#include <soscl/soscl_ed25519.h>
+
+//L=2^252+27742317777372353535851937790883648493, the base point order
+#ifdef SOSCL_WORD32
+#define SOSCL_ED25519_WORDSIZE 8
+static word_type soscl_ed25519_l[SOSCL_ED25519_WORDSIZE]={0x5cf5d3ed,0x5812631a,0xa2f79cd6,0x14def9de,0x00000000,0x00000000,0x00000000,0x10000000};
+#endif//SOSCL_WORD32
+#ifdef SOSCL_WORD64
+#define SOSCL_ED25519_WORDSIZE 4
+static word_type soscl_ed25519_l[SOSCL_ED25519_WORDSIZE]={0x5812631a5cf5d3edULL,0x14def9dea2f79cd6ULL,0x0000000000000000ULL,0x1000000000000000ULL};
+#endif//SOSCL_WORD64
+
+//(X:Y:Z), x=X/Z, y=Y/Z
+typedef struct _soscl_t_ge25519_p2
+{
+  soscl_type_fe25519 X;
+  soscl_type_fe25519 Y;
+  soscl_type_fe25519 Z;
+} soscl_type_ge25519_p2;
+
+//(X:Y:Z:T), XY=ZT
+typedef struct _soscl_t_ge25519_p3
+{
+  soscl_type_fe25519 X;
+  soscl_type_fe25519 Y;
+  soscl_type_fe25519 Z;
+  soscl_type_fe25519 T;
+} soscl_type_ge25519_p3;
+
+//((X:Z),(Y:T)), the additions and doublings output
+typedef struct _soscl_t_ge25519_p1p1
+{
+  soscl_type_fe25519 X;
+  soscl_type_fe25519 Y;
+  soscl_type_fe25519 Z;
+  soscl_type_fe25519 T;
+} soscl_type_ge25519_p1p1;
+
+//(Y+X,Y-X,Z,2.d.T), the additions second operand
+typedef struct _soscl_t_ge25519_cached
+{
+  soscl_type_fe25519 YplusX;
+  soscl_type_fe25519 YminusX;
+  soscl_type_fe25519 Z;
+  soscl_type_fe25519 T2d;
+} soscl_type_ge25519_cached;
+
+//little-endian bytes to words, the soscl_bignum_b2w being big-endian
+static void soscl_ed25519_b2w(word_type *w,int word_size,uint8_t *b,int byte_size)
+{
+  int i;
+  soscl_bignum_set_zero(w,word_size);
+  for(i=0;i<byte_size;i++)
+    w[i/SOSCL_WORD_BYTES]|=((word_type)b[i])<<((i%SOSCL_WORD_BYTES)*SOSCL_BYTE_BITS);
+}
+
+static void soscl_ed25519_w2b(uint8_t *b,int byte_size,word_type *w)
+{
+  int i;
+  for(i=0;i<byte_size;i++)
+    b[i]=(uint8_t)(w[i/SOSCL_WORD_BYTES]>>((i%SOSCL_WORD_BYTES)*SOSCL_BYTE_BITS));
+}
+
+//s=h mod L, h being a SHA-512 digest
+static int soscl_ed25519_reduce(word_type *s,uint8_t *h)
+{
+  word_type w[2*2*SOSCL_ED25519_WORDSIZE];
+  int ret;
+  soscl_ed25519_b2w(w,2*2*SOSCL_ED25519_WORDSIZE,h,SOSCL_SHA512_BYTE_HASHSIZE);
+  ret=soscl_bignum_mod(s,w,2*2*SOSCL_ED25519_WORDSIZE,soscl_ed25519_l,SOSCL_ED25519_WORDSIZE);
+  soscl_bignum_set_zero(w,2*2*SOSCL_ED25519_WORDSIZE);
+  return(ret);
+}
+
+static void soscl_ge25519_p3_0(soscl_type_ge25519_p3 *h)
+{
+  soscl_fe25519_zero(h->X);
+  soscl_fe25519_one(h->Y);
+  soscl_fe25519_one(h->Z);
+  soscl_fe25519_zero(h->T);
+}
+
+static void soscl_ge25519_p1p1_to_p2(soscl_type_ge25519_p2 *r,soscl_type_ge25519_p1p1 *p)
+{
+  soscl_fe25519_mul(r->X,p->X,p->T);
+  soscl_fe25519_mul(r->Y,p->Y,p->Z);
+  soscl_fe25519_mul(r->Z,p->Z,p->T);
+}
+
+static void soscl_ge25519_p1p1_to_p3(soscl_type_ge25519_p3 *r,soscl_type_ge25519_p1p1 *p)
+{
+  soscl_fe25519_mul(r->X,p->X,p->T);
+  soscl_fe25519_mul(r->Y,p->Y,p->Z);
+  soscl_fe25519_mul(r->Z,p->Z,p->T);
+  soscl_fe25519_mul(r->T,p->X,p->Y);
+}
+
+static void soscl_ge25519_p3_to_cached(soscl_type_ge25519_cached *r,soscl_type_ge25519_p3 *p)
+{
+  soscl_fe25519_add(r->YplusX,p->Y,p->X);
+  soscl_fe25519_sub(r->YminusX,p->Y,p->X);
+  soscl_fe25519_copy(r->Z,p->Z);
+  soscl_fe25519_mul(r->T2d,p->T,soscl_fe25519_d2);
+}
+
+//r=2p
+static void soscl_ge25519_p2_dbl(soscl_type_ge25519_p1p1 *r,soscl_type_ge25519_p2 *p)
+{
+  soscl_type_fe25519 t0;
+  soscl_fe25519_sq(r->X,p->X);
+  soscl_fe25519_sq(r->Z,p->Y);
+  soscl_fe25519_sq2(r->T,p->Z);
+  soscl_fe25519_add(r->Y,p->X,p->Y);
+  soscl_fe25519_sq(t0,r->Y);
+  soscl_fe25519_add(r->Y,r->Z,r->X);
+  soscl_fe25519_sub(r->Z,r->Z,r->X);
+  soscl_fe25519_sub(r->X,t0,r->Y);
+  soscl_fe25519_sub(r->T,r->T,r->Z);
+}
+
+static void soscl_ge25519_p3_dbl(soscl_type_ge25519_p1p1 *r,soscl_type_ge25519_p3 *p)
+{
+  soscl_type_ge25519_p2 q;
+  soscl_fe25519_copy(q.X,p->X);
+  soscl_fe25519_copy(q.Y,p->Y);
+  soscl_fe25519_copy(q.Z,p->Z);
+  soscl_ge25519_p2_dbl(r,&q);
+}
+
+//r=p+q when sign=0, p-q when sign=1 (q being given as (y+x,y-x,2.d.x.y) or (Y+X,Y-X,2.d.T), z is q.Z or NULL for 1)
+static void soscl_ge25519_add_core(soscl_type_ge25519_p1p1 *r,soscl_type_ge25519_p3 *p,const soscl_type_fe25519 yplusx,const soscl_type_fe25519 yminusx,const soscl_type_fe25519 t2d,const soscl_type_fe25519 z,int sign)
+{
+  soscl_type_fe25519 t0;
+  soscl_fe25519_add(r->X,p->Y,p->X);
+  soscl_fe25519_sub(r->Y,p->Y,p->X);
+  soscl_fe25519_mul(r->Z,r->X,sign?yminusx:yplusx);
+  soscl_fe25519_mul(r->Y,r->Y,sign?yplusx:yminusx);
+  soscl_fe25519_mul(r->T,t2d,p->T);
+  if(NULL==z)
+    soscl_fe25519_add(t0,p->Z,p->Z);
+  else
+    {
+      soscl_fe25519_mul(r->X,p->Z,z);
+      soscl_fe25519_add(t0,r->X,r->X);
+    }
+  soscl_fe25519_sub(r->X,r->Z,r->Y);
+  soscl_fe25519_add(r->Y,r->Z,r->Y);
+  if(sign)
+    {
+      soscl_fe25519_sub(r->Z,t0,r->T);
+      soscl_fe25519_add(r->T,t0,r->T);
+    }
+  else
+    {
+      soscl_fe25519_add(r->Z,t0,r->T);
+      soscl_fe25519_sub(r->T,t0,r->T);
+    }
+}
+
+//p+q, q in the cached form
+static void soscl_ge25519_add(soscl_type_ge25519_p1p1 *r,soscl_type_ge25519_p3 *p,soscl_type_ge25519_cached *q,int sign)
+{
+  soscl_ge25519_add_core(r,p,q->YplusX,q->YminusX,q->T2d,q->Z,sign);
+}
+
+//p+q, q affine (mixed addition)
+static void soscl_ge25519_madd(soscl_type_ge25519_p1p1 *r,soscl_type_ge25519_p3 *p,const soscl_type_ge25519_precomp *q,int sign)
+{
+  soscl_ge25519_add_core(r,p,q->yplusx,q->yminusx,q->xy2d,NULL,sign);
+}
+
+static void soscl_ge25519_p3_tobytes(uint8_t *s,soscl_type_ge25519_p3 *h)
+{
+  soscl_type_fe25519 recip,x,y;
+  soscl_fe25519_invert(recip,h->Z);
+  soscl_fe25519_mul(x,h->X,recip);
+  soscl_fe25519_mul(y,h->Y,recip);
+  soscl_fe25519_tobytes(s,y);
+  s[SOSCL_FE25519_BYTESIZE-1]^=(uint8_t)(soscl_fe25519_isnegative(x)<<7);
+}
+
+//h=-A, A being decoded from s (RFC 8032 5.1.3): non canonical y and x=0 with the sign bit set are rejected
+static int soscl_ge25519_frombytes_negate(soscl_type_ge25519_p3 *h,uint8_t *s)
+{
+  soscl_type_fe25519 u,v,v3,vxx,check;
+  uint8_t t[SOSCL_FE25519_BYTESIZE];
+  int i;
+  soscl_fe25519_frombytes(h->Y,s);
+  soscl_fe25519_tobytes(t,h->Y);
+  t[SOSCL_FE25519_BYTESIZE-1]|=s[SOSCL_FE25519_BYTESIZE-1]&0x80;
+  for(i=0;i<SOSCL_FE25519_BYTESIZE;i++)
+    if(t[i]!=s[i])
+      return(SOSCL_ERROR);
+  soscl_fe25519_one(h->Z);
+  //u=y^2-1, v=d.y^2+1
+  soscl_fe25519_sq(u,h->Y);
+  soscl_fe25519_mul(v,u,soscl_fe25519_d);
+  soscl_fe25519_sub(u,u,h->Z);
+  soscl_fe25519_add(v,v,h->Z);
+  //x=u.v^3.(u.v^7)^((p-5)/8)
+  soscl_fe25519_sq(v3,v);
+  soscl_fe25519_mul(v3,v3,v);
+  soscl_fe25519_sq(h->X,v3);
+  soscl_fe25519_mul(h->X,h->X,v);
+  soscl_fe25519_mul(h->X,h->X,u);
+  soscl_fe25519_pow22523(h->X,h->X);
+  soscl_fe25519_mul(h->X,h->X,v3);
+  soscl_fe25519_mul(h->X,h->X,u);
+  //v.x^2=u, or v.x^2=-u and then x=x.sqrt(-1)
+  soscl_fe25519_sq(vxx,h->X);
+  soscl_fe25519_mul(vxx,vxx,v);
+  soscl_fe25519_sub(check,vxx,u);
+  if(!soscl_fe25519_iszero(check))
+    {
+      soscl_fe25519_add(check,vxx,u);
+      if(!soscl_fe25519_iszero(check))
+	return(SOSCL_ERROR);
+      soscl_fe25519_mul(h->X,h->X,soscl_fe25519_sqrtm1);
+    }
+  if(soscl_fe25519_iszero(h->X) && 0!=(s[SOSCL_FE25519_BYTESIZE-1]>>7))
+    return(SOSCL_ERROR);
+  //the negated point is returned
+  if(soscl_fe25519_isnegative(h->X)==(s[SOSCL_FE25519_BYTESIZE-1]>>7))
+    soscl_fe25519_neg(h->X,h->X);
+  soscl_fe25519_mul(h->T,h->X,h->Y);
+  return(SOSCL_OK);
+}
+
+//t=b.soscl_ed25519_base[pos][], b in [-8,8], in constant time
+static void soscl_ge25519_select(soscl_type_ge25519_precomp *t,int pos,signed char b)
+{
+  soscl_type_ge25519_precomp minust;
+  unsigned int bnegative,babs,j;
+  bnegative=((unsigned int)(int)b)>>31;
+  babs=(unsigned int)(b-(((-bnegative)&(unsigned int)b)<<1));
+  babs&=0xff;
+  soscl_fe25519_one(t->yplusx);
+  soscl_fe25519_one(t->yminusx);
+  soscl_fe25519_zero(t->xy2d);
+  for(j=0;j<SOSCL_ED25519_BASE_MULTIPLES;j++)
+    {
+      //(babs==j+1) without branch
+      unsigned int eq=(((babs^(j+1))-1)>>31)&1;
+      soscl_fe25519_cmov(t->yplusx,soscl_ed25519_base[pos][j].yplusx,eq);
+      soscl_fe25519_cmov(t->yminusx,soscl_ed25519_base[pos][j].yminusx,eq);
+      soscl_fe25519_cmov(t->xy2d,soscl_ed25519_base[pos][j].xy2d,eq);
+    }
+  //-(x,y)=(-x,y): y+x and y-x are swapped, 2dxy is negated
+  soscl_fe25519_copy(minust.yplusx,t->yminusx);
+  soscl_fe25519_copy(minust.yminusx,t->yplusx);
+  soscl_fe25519_neg(minust.xy2d,t->xy2d);
+  soscl_fe25519_cmov(t->yplusx,minust.yplusx,bnegative);
+  soscl_fe25519_cmov(t->yminusx,minust.yminusx,bnegative);
+  soscl_fe25519_cmov(t->xy2d,minust.xy2d,bnegative);
+}
+
+//h=a.B, a[31]<=127, in constant time
+//a is written with 64 signed radix 16 digits, a=sum(e[i].16^i), the odd digits being added first, then multiplied by 16
+static void soscl_ge25519_scalarmult_base(soscl_type_ge25519_p3 *h,uint8_t *a)
+{
+  signed char e[2*SOSCL_FE25519_BYTESIZE],carry;
+  soscl_type_ge25519_p1p1 r;
+  soscl_type_ge25519_p2 s;
+  soscl_type_ge25519_precomp t;
+  int i;
+  for(i=0;i<SOSCL_FE25519_BYTESIZE;i++)
+    {
+      e[2*i]=(signed char)(a[i]&15);
+      e[2*i+1]=(signed char)((a[i]>>4)&15);
+    }
+  //e[i] in [-8,7], e[63] in [-8,8]
+  for(carry=0,i=0;i<2*SOSCL_FE25519_BYTESIZE-1;i++)
+    {
+      e[i]+=carry;
+      carry=(signed char)((e[i]+8)>>4);
+      e[i]-=(signed char)(carry*16);
+    }
+  e[2*SOSCL_FE25519_BYTESIZE-1]+=carry;
+  soscl_ge25519_p3_0(h);
+  for(i=1;i<2*SOSCL_FE25519_BYTESIZE;i+=2)
+    {
+      soscl_ge25519_select(&t,i/2,e[i]);
+      soscl_ge25519_madd(&r,h,&t,0);
+      soscl_ge25519_p1p1_to_p3(h,&r);
+    }
+  //h=16.h
+  soscl_ge25519_p3_dbl(&r,h);
+  soscl_ge25519_p1p1_to_p2(&s,&r);
+  soscl_ge25519_p2_dbl(&r,&s);
+  soscl_ge25519_p1p1_to_p2(&s,&r);
+  soscl_ge25519_p2_dbl(&r,&s);
+  soscl_ge25519_p1p1_to_p2(&s,&r);
+  soscl_ge25519_p2_dbl(&r,&s);
+  soscl_ge25519_p1p1_to_p3(h,&r);
+  for(i=0;i<2*SOSCL_FE25519_BYTESIZE;i+=2)
+    {
+      soscl_ge25519_select(&t,i/2,e[i]);
+      soscl_ge25519_madd(&r,h,&t,0);
+      soscl_ge25519_p1p1_to_p3(h,&r);
+    }
+  soscl_memset(e,0,sizeof(e));
+}
+
+//sliding window signed digits of a: r[i] odd in [-15,15] or 0
+static void soscl_ge25519_slide(signed char *r,uint8_t *a)
+{
+  int i,b,k;
+  for(i=0;i<256;i++)
+    r[i]=(signed char)(1&(a[i>>3]>>(i&7)));
+  for(i=0;i<256;i++)
+    if(r[i])
+      for(b=1;b<=6 && i+b<256;b++)
+	{
+	  if(!r[i+b])
+	    continue;
+	  if(r[i]+(r[i+b]<<b)<=15)
+	    {
+	      r[i]+=(signed char)(r[i+b]<<b);
+	      r[i+b]=0;
+	    }
+	  else
+	    if(r[i]-(r[i+b]<<b)>=-15)
+	      {
+		r[i]-=(signed char)(r[i+b]<<b);
+		for(k=i+b;k<256;k++)
+		  {
+		    if(!r[k])
+		      {
+			r[k]=1;
+			break;
+		      }
+		    r[k]=0;
+		  }
+	      }
+	    else
+	      break;
+	}
+}
+
+//r=a.A+b.B, in variable time (verification only)
+static void soscl_ge25519_double_scalarmult(soscl_type_ge25519_p2 *r,uint8_t *a,soscl_type_ge25519_p3 *A,uint8_t *b)
+{
+  signed char aslide[256],bslide[256];
+  soscl_type_ge25519_cached ai[SOSCL_ED25519_BASE_MULTIPLES];//A,3A,5A,...,15A
+  soscl_type_ge25519_p1p1 t;
+  soscl_type_ge25519_p3 u,a2;
+  int i;
+  soscl_ge25519_slide(aslide,a);
+  soscl_ge25519_slide(bslide,b);
+  soscl_ge25519_p3_to_cached(&ai[0],A);
+  soscl_ge25519_p3_dbl(&t,A);
+  soscl_ge25519_p1p1_to_p3(&a2,&t);
+  for(i=0;i<SOSCL_ED25519_BASE_MULTIPLES-1;i++)
+    {
+      soscl_ge25519_add(&t,&a2,&ai[i],0);
+      soscl_ge25519_p1p1_to_p3(&u,&t);
+      soscl_ge25519_p3_to_cached(&ai[i+1],&u);
+    }
+  soscl_fe25519_zero(r->X);
+  soscl_fe25519_one(r->Y);
+  soscl_fe25519_one(r->Z);
+  for(i=255;i>=0;i--)
+    if(aslide[i] || bslide[i])
+      break;
+  for(;i>=0;i--)
+    {
+      soscl_ge25519_p2_dbl(&t,r);
+      if(aslide[i])
+	{
+	  soscl_ge25519_p1p1_to_p3(&u,&t);
+	  soscl_ge25519_add(&t,&u,&ai[(aslide[i]>0?aslide[i]:-aslide[i])/2],aslide[i]<0);
+	}
+      if(bslide[i])
+	{
+	  soscl_ge25519_p1p1_to_p3(&u,&t);
+	  soscl_ge25519_madd(&t,&u,&soscl_ed25519_bi[(bslide[i]>0?bslide[i]:-bslide[i])/2],bslide[i]<0);
+	}
+      soscl_ge25519_p1p1_to_p2(r,&t);
+    }
+}
+
+//SHA-512(secret_key), the first half being clamped into the secret scalar
+static void soscl_ed25519_expand(uint8_t *az,uint8_t *secret_key)
+{
+  soscl_sha512(az,secret_key,SOSCL_ED25519_SECRET_KEY_BYTESIZE);
+  az[0]&=248;
+  az[31]&=127;
+  az[31]|=64;
+}
+
+int soscl_ed25519_public_key(uint8_t *public_key,uint8_t *secret_key)
+{
+  uint8_t az[SOSCL_SHA512_BYTE_HASHSIZE];
+  soscl_type_ge25519_p3 A;
+  if(NULL==secret_key)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==public_key)
+    return(SOSCL_INVALID_OUTPUT);
+  soscl_ed25519_expand(az,secret_key);
+  soscl_ge25519_scalarmult_base(&A,az);
+  soscl_ge25519_p3_tobytes(public_key,&A);
+  soscl_memset(az,0,sizeof(az));
+  return(SOSCL_OK);
+}
+
+//RFC 8032 5.1.6, public_key may be NULL: it is then computed from secret_key
+int soscl_ed25519_sign(uint8_t *signature,uint8_t *message,int message_length,uint8_t *secret_key,uint8_t *public_key)
+{
+  uint8_t az[SOSCL_SHA512_BYTE_HASHSIZE];
+  uint8_t h[SOSCL_SHA512_BYTE_HASHSIZE];
+  uint8_t pk[SOSCL_ED25519_PUBLIC_KEY_BYTESIZE];
+  word_type r[SOSCL_ED25519_WORDSIZE],k[SOSCL_ED25519_WORDSIZE],a[SOSCL_ED25519_WORDSIZE];
+  soscl_sha512_ctx_t ctx;
+  soscl_type_ge25519_p3 R;
+  int ret;
+  if(NULL==secret_key || (NULL==message && 0!=message_length) || message_length<0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==signature)
+    return(SOSCL_INVALID_OUTPUT);
+  soscl_ed25519_expand(az,secret_key);
+  if(NULL==public_key)
+    {
+      soscl_ge25519_scalarmult_base(&R,az);
+      soscl_ge25519_p3_tobytes(pk,&R);
+      public_key=pk;
+    }
+  //1. r=SHA-512(prefix||M) mod L
+  soscl_sha512_init(&ctx);
+  soscl_sha512_core(&ctx,az+SOSCL_FE25519_BYTESIZE,SOSCL_FE25519_BYTESIZE);
+  soscl_sha512_core(&ctx,message,message_length);
+  soscl_sha512_finish(h,&ctx);
+  ret=soscl_ed25519_reduce(r,h);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ed25519_sign_end;
+  //2. R=r.B
+  soscl_ed25519_w2b(h,SOSCL_FE25519_BYTESIZE,r);
+  soscl_ge25519_scalarmult_base(&R,h);
+  soscl_ge25519_p3_tobytes(signature,&R);
+  //3. k=SHA-512(R||A||M) mod L
+  soscl_sha512_init(&ctx);
+  soscl_sha512_core(&ctx,signature,SOSCL_FE25519_BYTESIZE);
+  soscl_sha512_core(&ctx,public_key,SOSCL_ED25519_PUBLIC_KEY_BYTESIZE);
+  soscl_sha512_core(&ctx,message,message_length);
+  soscl_sha512_finish(h,&ctx);
+  ret=soscl_ed25519_reduce(k,h);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ed25519_sign_end;
+  //4. S=r+k.s mod L
+  soscl_ed25519_b2w(a,SOSCL_ED25519_WORDSIZE,az,SOSCL_FE25519_BYTESIZE);
+  ret=soscl_bignum_modmult(k,k,a,soscl_ed25519_l,SOSCL_ED25519_WORDSIZE);
+  if(SOSCL_OK==ret)
+    ret=soscl_bignum_modadd(k,k,r,soscl_ed25519_l,SOSCL_ED25519_WORDSIZE);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ed25519_sign_end;
+  soscl_ed25519_w2b(signature+SOSCL_FE25519_BYTESIZE,SOSCL_FE25519_BYTESIZE,k);
+ soscl_label_ed25519_sign_end:
+  //the secret scalar and the nonce shall not remain on the stack
+  soscl_memset(az,0,sizeof(az));
+  soscl_memset(h,0,sizeof(h));
+  soscl_bignum_set_zero(r,SOSCL_ED25519_WORDSIZE);
+  soscl_bignum_set_zero(a,SOSCL_ED25519_WORDSIZE);
+  return(ret);
+}
+
+//RFC 8032 5.1.7, with the cofactorless equation [S]B=R+[k]A, as in ref10
+//S shall be below L, A shall be a canonical encoding of a curve point
+int soscl_ed25519_verify(uint8_t *signature,uint8_t *message,int message_length,uint8_t *public_key)
+{
+  uint8_t h[SOSCL_SHA512_BYTE_HASHSIZE];
+  uint8_t rcheck[SOSCL_FE25519_BYTESIZE];
+  word_type s[SOSCL_ED25519_WORDSIZE],k[SOSCL_ED25519_WORDSIZE];
+  soscl_sha512_ctx_t ctx;
+  soscl_type_ge25519_p3 A;
+  soscl_type_ge25519_p2 R;
+  soscl_type_ge25519_p3 R3;
+  int ret,i;
+  uint8_t diff;
+  if(NULL==signature || NULL==public_key || (NULL==message && 0!=message_length) || message_length<0)
+    return(SOSCL_INVALID_INPUT);
+  soscl_ed25519_b2w(s,SOSCL_ED25519_WORDSIZE,signature+SOSCL_FE25519_BYTESIZE,SOSCL_FE25519_BYTESIZE);
+  if(soscl_bignum_memcmp(s,soscl_ed25519_l,SOSCL_ED25519_WORDSIZE)>=0)
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ge25519_frombytes_negate(&A,public_key))
+    return(SOSCL_INVALID_INPUT);
+  //k=SHA-512(R||A||M) mod L
+  soscl_sha512_init(&ctx);
+  soscl_sha512_core(&ctx,signature,SOSCL_FE25519_BYTESIZE);
+  soscl_sha512_core(&ctx,public_key,SOSCL_ED25519_PUBLIC_KEY_BYTESIZE);
+  soscl_sha512_core(&ctx,message,message_length);
+  soscl_sha512_finish(h,&ctx);
+  ret=soscl_ed25519_reduce(k,h);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  soscl_ed25519_w2b(h,SOSCL_FE25519_BYTESIZE,k);
+  //R'=k.(-A)+S.B, compared to R through its encoding
+  soscl_ge25519_double_scalarmult(&R,h,&A,signature+SOSCL_FE25519_BYTESIZE);
+  soscl_fe25519_copy(R3.X,R.X);
+  soscl_fe25519_copy(R3.Y,R.Y);
+  soscl_fe25519_copy(R3.Z,R.Z);
+  soscl_ge25519_p3_tobytes(rcheck,&R3);
+  for(diff=0,i=0;i<SOSCL_FE25519_BYTESIZE;i++)
+    diff|=rcheck[i]^signature[i];
+  if(0!=diff)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//the Edwards (x,y) maps to the Montgomery u=(1+y)/(1-y), i.e. (Z+Y)/(Z-Y)
+int soscl_ed25519_scalarmult_base_u(uint8_t *u,uint8_t *scalar)
+{
+  soscl_type_ge25519_p3 A;
+  soscl_type_fe25519 n,d;
+  if(NULL==scalar)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==u)
+    return(SOSCL_INVALID_OUTPUT);
+  if(0!=(scalar[SOSCL_FE25519_BYTESIZE-1]&0x80))
+    return(SOSCL_INVALID_INPUT);
+  soscl_ge25519_scalarmult_base(&A,scalar);
+  soscl_fe25519_add(n,A.Z,A.Y);
+  soscl_fe25519_sub(d,A.Z,A.Y);
+  soscl_fe25519_invert(d,d);
+  soscl_fe25519_mul(n,n,d);
+  soscl_fe25519_tobytes(u,n);
+  return(SOSCL_OK);
+}
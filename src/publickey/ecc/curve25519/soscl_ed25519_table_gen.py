@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+#SiFive Open Source Cryptographic Library
+#soscl_ed25519_table_gen.py
+# generates the curve25519 field constants and the Ed25519 base point tables,
+# for the radix 2^25.5 (32 bits words) and radix 2^51 (64 bits words) representations
+# usage: python3 soscl_ed25519_table_gen.py [output directory]
+# the generated file is checked in, re-run the script after any change
+
+import os
+import sys
+
+LICENSE = '''//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+'''
+
+P = 2**255 - 19
+D = -121665 * pow(121666, P - 2, P) % P
+SQRTM1 = pow(2, (P - 1) // 4, P)
+#number of positions (radix 2^8 digits of the scalar) and of multiples per position
+POSITIONS = 32
+MULTIPLES = 8
+
+def inv(x):
+  return pow(x, P - 2, P)
+
+def add(a, b):
+  x1, y1 = a
+  x2, y2 = b
+  t = D * x1 * x2 * y1 * y2
+  return ((x1 * y2 + x2 * y1) * inv(1 + t) % P, (y1 * y2 + x1 * x2) * inv(1 - t) % P)
+
+def mult(k, a):
+  r = (0, 1)
+  while k:
+    if k & 1:
+      r = add(r, a)
+    a = add(a, a)
+    k >>= 1
+  return r
+
+def base():
+  y = 4 * inv(5) % P
+  x2 = (y * y - 1) * inv(D * y * y + 1) % P
+  x = pow(x2, (P + 3) // 8, P)
+  if (x * x - x2) % P:
+    x = x * SQRTM1 % P
+  if x & 1:
+    x = P - x
+  return (x, y)
+
+#limbs offsets: 26 and 25 bits alternately for 32 bits words, 51 bits for 64 bits words
+def limbs32(v):
+  offsets = [0, 26, 51, 77, 102, 128, 153, 179, 204, 230, 255]
+  return [(v >> offsets[i]) & ((1 << (offsets[i + 1] - offsets[i])) - 1) for i in range(10)]
+
+def limbs64(v):
+  return [(v >> (51 * i)) & ((1 << 51) - 1) for i in range(5)]
+
+def fe(v, word):
+  if 32 == word:
+    return '{' + ','.join('%d' % l for l in limbs32(v)) + '}'
+  return '{' + ','.join('0x%013xULL' % l for l in limbs64(v)) + '}'
+
+#(y+x,y-x,2.d.x.y)
+def precomp(a, word):
+  x, y = a
+  return '{' + fe((y + x) % P, word) + ',' + fe((y - x) % P, word) + ',' + fe(2 * D * x * y % P, word) + '}'
+
+def section(word):
+  out = []
+  b = base()
+  out.append('const soscl_type_fe25519 soscl_fe25519_d=%s;' % fe(D, word))
+  out.append('const soscl_type_fe25519 soscl_fe25519_d2=%s;' % fe(2 * D % P, word))
+  out.append('const soscl_type_fe25519 soscl_fe25519_sqrtm1=%s;' % fe(SQRTM1, word))
+  out.append('')
+  out.append('//soscl_ed25519_base[i][j]=(j+1).256^i.B')
+  out.append('const soscl_type_ge25519_precomp soscl_ed25519_base[SOSCL_ED25519_BASE_POSITIONS][SOSCL_ED25519_BASE_MULTIPLES]={')
+  rows = []
+  for i in range(POSITIONS):
+    bi = mult(256 ** i, b)
+    row = []
+    m = bi
+    for j in range(MULTIPLES):
+      row.append('  ' + precomp(m, word))
+      m = add(m, bi)
+    rows.append(' {\n' + ',\n'.join(row) + '\n }')
+  out.append(',\n'.join(rows))
+  out.append('};')
+  out.append('')
+  out.append('//soscl_ed25519_bi[i]=(2i+1).B, for the double scalar multiplication')
+  out.append('const soscl_type_ge25519_precomp soscl_ed25519_bi[SOSCL_ED25519_BASE_MULTIPLES]={')
+  b2 = add(b, b)
+  m = b
+  row = []
+  for j in range(MULTIPLES):
+    row.append(' ' + precomp(m, word))
+    m = add(m, b2)
+  out.append(',\n'.join(row))
+  out.append('};')
+  return '\n'.join(out)
+
+def generate():
+  out = [LICENSE.rstrip('\n')]
+  out.append('//soscl_ed25519_table.c')
+  out.append('// curve25519 field constants and Ed25519 base point tables, generated by soscl_ed25519_table_gen.py: do not edit')
+  out.append('')
+  out.append('#include <soscl/soscl_config.h>')
+  out.append('#include <soscl/soscl_types.h>')
+  out.append('#include <soscl/soscl_fe25519.h>')
+  out.append('')
+  out.append('#ifdef SOSCL_WORD32')
+  out.append(section(32))
+  out.append('#endif//SOSCL_WORD32')
+  out.append('')
+  out.append('#ifdef SOSCL_WORD64')
+  out.append(section(64))
+  out.append('#endif//SOSCL_WORD64')
+  return '\n'.join(out) + '\n'
+
+if __name__ == '__main__':
+  directory = sys.argv[1] if len(sys.argv) > 1 else os.path.dirname(os.path.abspath(__file__))
+  with open(os.path.join(directory, 'soscl_ed25519_table.c'), 'w', newline='\r\n') as f:
+    f.write(generate())
@@ -0,0 +1,468 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_fe25519.c
+// curve25519 field arithmetic, p=2^255-19
+// 32 bits words: radix 2^25.5, the carries follow the ref10 ones, add and sub do not carry
+// 64 bits words: radix 2^51, add and sub carry once, so that every limb stays below 2^52
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_fe25519.h>
+
+#ifdef SOSCL_WORD32
+//limb i weight is 2^ceil(25.5*i)
+static const int soscl_fe25519_bits[SOSCL_FE25519_LIMBS]={26,25,26,25,26,25,26,25,26,25};
+#endif//SOSCL_WORD32
+#ifdef SOSCL_WORD64
+static const int soscl_fe25519_bits[SOSCL_FE25519_LIMBS]={51,51,51,51,51};
+#define SOSCL_FE25519_MASK51 ((((uint64_t)1)<<51)-1)
+#endif//SOSCL_WORD64
+
+//bits [offset,offset+bits[ of the 32 bytes little-endian number s
+static uint64_t soscl_fe25519_load(const uint8_t *s,int offset,int bits)
+{
+  uint64_t v;
+  int i,byte;
+  byte=offset/SOSCL_BYTE_BITS;
+  for(v=0,i=0;i*SOSCL_BYTE_BITS<offset%SOSCL_BYTE_BITS+bits && byte+i<SOSCL_FE25519_BYTESIZE;i++)
+    v|=((uint64_t)s[byte+i])<<(i*SOSCL_BYTE_BITS);
+  return((v>>(offset%SOSCL_BYTE_BITS))&((((uint64_t)1)<<bits)-1));
+}
+
+//s=limbs, each limb being canonical (limbs[i] < 2^bits[i])
+static void soscl_fe25519_store(uint8_t *s,uint64_t *limbs)
+{
+  uint64_t acc;
+  int i,j,accbits;
+  for(acc=0,accbits=0,i=0,j=0;i<SOSCL_FE25519_LIMBS;i++)
+    {
+      acc|=limbs[i]<<accbits;
+      accbits+=soscl_fe25519_bits[i];
+      while(accbits>=SOSCL_BYTE_BITS)
+	{
+	  s[j++]=(uint8_t)acc;
+	  acc>>=SOSCL_BYTE_BITS;
+	  accbits-=SOSCL_BYTE_BITS;
+	}
+    }
+  //the 255th bit
+  s[j]=(uint8_t)acc;
+}
+
+void soscl_fe25519_zero(soscl_type_fe25519 h)
+{
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=0;
+}
+
+void soscl_fe25519_one(soscl_type_fe25519 h)
+{
+  soscl_fe25519_zero(h);
+  h[0]=1;
+}
+
+void soscl_fe25519_copy(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=f[i];
+}
+
+//the 255th bit is ignored
+void soscl_fe25519_frombytes(soscl_type_fe25519 h,const uint8_t *s)
+{
+  int i,offset;
+  for(i=0,offset=0;i<SOSCL_FE25519_LIMBS;offset+=soscl_fe25519_bits[i],i++)
+    h[i]=soscl_fe25519_load(s,offset,soscl_fe25519_bits[i]);
+}
+
+//f=1 or f=0: constant time swap
+void soscl_fe25519_cswap(soscl_type_fe25519 f,soscl_type_fe25519 g,unsigned int b)
+{
+  int i;
+#ifdef SOSCL_WORD32
+  int32_t x,mask;
+  mask=-(int32_t)b;
+#endif//SOSCL_WORD32
+#ifdef SOSCL_WORD64
+  uint64_t x,mask;
+  mask=-(uint64_t)b;
+#endif//SOSCL_WORD64
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    {
+      x=mask&(f[i]^g[i]);
+      f[i]^=x;
+      g[i]^=x;
+    }
+}
+
+//f=g if b=1, f unchanged if b=0, in constant time
+void soscl_fe25519_cmov(soscl_type_fe25519 f,const soscl_type_fe25519 g,unsigned int b)
+{
+  int i;
+#ifdef SOSCL_WORD32
+  int32_t mask;
+  mask=-(int32_t)b;
+#endif//SOSCL_WORD32
+#ifdef SOSCL_WORD64
+  uint64_t mask;
+  mask=-(uint64_t)b;
+#endif//SOSCL_WORD64
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    f[i]^=mask&(f[i]^g[i]);
+}
+
+#ifdef SOSCL_WORD32
+//h=t, |t[i]|<2^62, with the ref10 carries order: two interleaved chains starting at limbs 0 and 4
+static void soscl_fe25519_carry(soscl_type_fe25519 h,int64_t *t)
+{
+  static const int order[12]={0,4,1,5,2,6,3,7,4,8,9,0};
+  int64_t c;
+  int i,j,b;
+  for(i=0;i<12;i++)
+    {
+      j=order[i];
+      b=soscl_fe25519_bits[j];
+      c=(t[j]+(((int64_t)1)<<(b-1)))>>b;
+      t[j]-=c*(((int64_t)1)<<b);
+      if(SOSCL_FE25519_LIMBS-1==j)
+	t[0]+=c*19;
+      else
+	t[j+1]+=c;
+    }
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=(int32_t)t[i];
+}
+
+void soscl_fe25519_add(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g)
+{
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=f[i]+g[i];
+}
+
+void soscl_fe25519_sub(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g)
+{
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=f[i]-g[i];
+}
+
+void soscl_fe25519_neg(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=-f[i];
+}
+
+//the f[i].g[j] weight is 2^(ceil(25.5i)+ceil(25.5j)), i.e. twice the limb i+j one when i and j are odd
+//2^255=19 mod p for the limbs beyond 9
+void soscl_fe25519_mul(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g)
+{
+  int64_t t[SOSCL_FE25519_LIMBS],p;
+  int32_t g19[SOSCL_FE25519_LIMBS];
+  int i,j;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    {
+      t[i]=0;
+      g19[i]=19*g[i];
+    }
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    for(j=0;j<SOSCL_FE25519_LIMBS;j++)
+      {
+	p=(int64_t)f[i]*((i+j<SOSCL_FE25519_LIMBS)?g[j]:g19[j]);
+	if(i&j&1)
+	  p*=2;
+	t[(i+j)%SOSCL_FE25519_LIMBS]+=p;
+      }
+  soscl_fe25519_carry(h,t);
+}
+
+//same as the multiplication, the symmetric products being computed once
+//h=2.f^2 when twice is 1, before the carries
+static void soscl_fe25519_sq_core(soscl_type_fe25519 h,const soscl_type_fe25519 f,int twice)
+{
+  int64_t t[SOSCL_FE25519_LIMBS],p;
+  int i,j;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    t[i]=0;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    for(j=i;j<SOSCL_FE25519_LIMBS;j++)
+      {
+	p=(int64_t)f[i]*f[j];
+	if(i+j>=SOSCL_FE25519_LIMBS)
+	  p*=19;
+	if(i&j&1)
+	  p*=2;
+	if(i!=j)
+	  p*=2;
+	t[(i+j)%SOSCL_FE25519_LIMBS]+=p;
+      }
+  if(twice)
+    for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+      t[i]*=2;
+  soscl_fe25519_carry(h,t);
+}
+
+void soscl_fe25519_mul_small(soscl_type_fe25519 h,const soscl_type_fe25519 f,uint32_t c)
+{
+  int64_t t[SOSCL_FE25519_LIMBS];
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    t[i]=(int64_t)f[i]*c;
+  soscl_fe25519_carry(h,t);
+}
+
+//canonical encoding, as in ref10
+void soscl_fe25519_tobytes(uint8_t *s,const soscl_type_fe25519 h)
+{
+  int64_t t[SOSCL_FE25519_LIMBS],q,c;
+  uint64_t limbs[SOSCL_FE25519_LIMBS];
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    t[i]=h[i];
+  //q=1 when h>=p, q=0 otherwise
+  q=(19*t[SOSCL_FE25519_LIMBS-1]+(((int64_t)1)<<24))>>25;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    q=(t[i]+q)>>soscl_fe25519_bits[i];
+  //h-q.p=h+19q-q.2^255, the q.2^255 term being the last carry, which is dropped
+  t[0]+=19*q;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    {
+      c=t[i]>>soscl_fe25519_bits[i];
+      t[i]-=c*(((int64_t)1)<<soscl_fe25519_bits[i]);
+      if(i<SOSCL_FE25519_LIMBS-1)
+	t[i+1]+=c;
+      limbs[i]=(uint64_t)t[i];
+    }
+  soscl_fe25519_store(s,limbs);
+}
+#endif//SOSCL_WORD32
+
+#ifdef SOSCL_WORD64
+//one carry pass: the limbs are below 2^51, but h[0] which is below 2^51+19*2^13
+static void soscl_fe25519_reduce(soscl_type_fe25519 h)
+{
+  uint64_t c;
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS-1;i++)
+    {
+      h[i+1]+=h[i]>>51;
+      h[i]&=SOSCL_FE25519_MASK51;
+    }
+  c=h[SOSCL_FE25519_LIMBS-1]>>51;
+  h[SOSCL_FE25519_LIMBS-1]&=SOSCL_FE25519_MASK51;
+  h[0]+=19*c;
+}
+
+//h=t, t[i]<2^115
+static void soscl_fe25519_carry(soscl_type_fe25519 h,double_word_type *t)
+{
+  double_word_type c;
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS-1;i++)
+    {
+      t[i+1]+=t[i]>>51;
+      h[i]=(uint64_t)t[i]&SOSCL_FE25519_MASK51;
+    }
+  c=(t[SOSCL_FE25519_LIMBS-1]>>51)*19+h[0];
+  h[SOSCL_FE25519_LIMBS-1]=(uint64_t)t[SOSCL_FE25519_LIMBS-1]&SOSCL_FE25519_MASK51;
+  h[0]=(uint64_t)c&SOSCL_FE25519_MASK51;
+  h[1]+=(uint64_t)(c>>51);
+}
+
+void soscl_fe25519_add(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g)
+{
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=f[i]+g[i];
+  soscl_fe25519_reduce(h);
+}
+
+//h=f+2p-g, the limbs of 2p being above the g ones
+void soscl_fe25519_sub(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g)
+{
+  int i;
+  h[0]=f[0]+0xfffffffffffdaULL-g[0];
+  for(i=1;i<SOSCL_FE25519_LIMBS;i++)
+    h[i]=f[i]+0xffffffffffffeULL-g[i];
+  soscl_fe25519_reduce(h);
+}
+
+void soscl_fe25519_neg(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  soscl_type_fe25519 zero;
+  soscl_fe25519_zero(zero);
+  soscl_fe25519_sub(h,zero,f);
+}
+
+//2^255=19 mod p for the limbs beyond 4
+void soscl_fe25519_mul(soscl_type_fe25519 h,const soscl_type_fe25519 f,const soscl_type_fe25519 g)
+{
+  double_word_type t[SOSCL_FE25519_LIMBS];
+  uint64_t g19[SOSCL_FE25519_LIMBS];
+  int i,j;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    {
+      t[i]=0;
+      g19[i]=19*g[i];
+    }
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    for(j=0;j<SOSCL_FE25519_LIMBS;j++)
+      t[(i+j)%SOSCL_FE25519_LIMBS]+=(double_word_type)f[i]*((i+j<SOSCL_FE25519_LIMBS)?g[j]:g19[j]);
+  soscl_fe25519_carry(h,t);
+}
+
+static void soscl_fe25519_sq_core(soscl_type_fe25519 h,const soscl_type_fe25519 f,int twice)
+{
+  double_word_type t[SOSCL_FE25519_LIMBS];
+  uint64_t m;
+  int i,j;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    t[i]=0;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    for(j=i;j<SOSCL_FE25519_LIMBS;j++)
+      {
+	m=(i+j<SOSCL_FE25519_LIMBS)?f[j]:19*f[j];
+	if(i!=j)
+	  m*=2;
+	t[(i+j)%SOSCL_FE25519_LIMBS]+=(double_word_type)f[i]*m;
+      }
+  if(twice)
+    for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+      t[i]*=2;
+  soscl_fe25519_carry(h,t);
+}
+
+void soscl_fe25519_mul_small(soscl_type_fe25519 h,const soscl_type_fe25519 f,uint32_t c)
+{
+  double_word_type t[SOSCL_FE25519_LIMBS];
+  int i;
+  for(i=0;i<SOSCL_FE25519_LIMBS;i++)
+    t[i]=(double_word_type)f[i]*c;
+  soscl_fe25519_carry(h,t);
+}
+
+//canonical encoding
+void soscl_fe25519_tobytes(uint8_t *s,const soscl_type_fe25519 h)
+{
+  uint64_t t[SOSCL_FE25519_LIMBS],q;
+  int i;
+  soscl_fe25519_copy(t,h);
+  soscl_fe25519_reduce(t);
+  //t<2^255+2^18<2p, q=1 when t>=p, i.e. when t+19>=2^255
+  q=(t[0]+19)>>51;
+  for(i=1;i<SOSCL_FE25519_LIMBS;i++)
+    q=(t[i]+q)>>51;
+  //t-q.p=t+19q-q.2^255, the q.2^255 term being the last carry, which is dropped
+  t[0]+=19*q;
+  for(i=0;i<SOSCL_FE25519_LIMBS-1;i++)
+    {
+      t[i+1]+=t[i]>>51;
+      t[i]&=SOSCL_FE25519_MASK51;
+    }
+  t[SOSCL_FE25519_LIMBS-1]&=SOSCL_FE25519_MASK51;
+  soscl_fe25519_store(s,t);
+}
+#endif//SOSCL_WORD64
+
+void soscl_fe25519_sq(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  soscl_fe25519_sq_core(h,f,0);
+}
+
+//h=2.f^2, for the doublings
+void soscl_fe25519_sq2(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  soscl_fe25519_sq_core(h,f,1);
+}
+
+//h=f^(2^n)
+static void soscl_fe25519_sqn(soscl_type_fe25519 h,const soscl_type_fe25519 f,int n)
+{
+  int i;
+  soscl_fe25519_sq(h,f);
+  for(i=1;i<n;i++)
+    soscl_fe25519_sq(h,h);
+}
+
+//t1=f^(2^250-1), t0=f^11
+static void soscl_fe25519_pow2250(soscl_type_fe25519 t1,soscl_type_fe25519 t0,const soscl_type_fe25519 f)
+{
+  soscl_type_fe25519 t2,t3;
+  soscl_fe25519_sq(t0,f);
+  soscl_fe25519_sqn(t1,t0,2);
+  soscl_fe25519_mul(t1,f,t1);
+  soscl_fe25519_mul(t0,t0,t1);
+  soscl_fe25519_sq(t2,t0);
+  //2^5-1
+  soscl_fe25519_mul(t1,t1,t2);
+  soscl_fe25519_sqn(t2,t1,5);
+  //2^10-1
+  soscl_fe25519_mul(t1,t2,t1);
+  soscl_fe25519_sqn(t2,t1,10);
+  //2^20-1
+  soscl_fe25519_mul(t2,t2,t1);
+  soscl_fe25519_sqn(t3,t2,20);
+  //2^40-1
+  soscl_fe25519_mul(t2,t3,t2);
+  soscl_fe25519_sqn(t2,t2,10);
+  //2^50-1
+  soscl_fe25519_mul(t1,t2,t1);
+  soscl_fe25519_sqn(t2,t1,50);
+  //2^100-1
+  soscl_fe25519_mul(t2,t2,t1);
+  soscl_fe25519_sqn(t3,t2,100);
+  //2^200-1
+  soscl_fe25519_mul(t2,t3,t2);
+  soscl_fe25519_sqn(t2,t2,50);
+  //2^250-1
+  soscl_fe25519_mul(t1,t2,t1);
+}
+
+//h=f^(p-2)=f^(2^255-21)
+void soscl_fe25519_invert(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  soscl_type_fe25519 t0,t1;
+  soscl_fe25519_pow2250(t1,t0,f);
+  soscl_fe25519_sqn(t1,t1,5);
+  soscl_fe25519_mul(h,t1,t0);
+}
+
+//h=f^((p-5)/8)=f^(2^252-3), for the square roots
+void soscl_fe25519_pow22523(soscl_type_fe25519 h,const soscl_type_fe25519 f)
+{
+  soscl_type_fe25519 t0,t1;
+  soscl_fe25519_pow2250(t1,t0,f);
+  soscl_fe25519_sqn(t1,t1,2);
+  soscl_fe25519_mul(h,t1,f);
+}
+
+//the sign is the canonical encoding lsb
+int soscl_fe25519_isnegative(const soscl_type_fe25519 f)
+{
+  uint8_t s[SOSCL_FE25519_BYTESIZE];
+  soscl_fe25519_tobytes(s,f);
+  return(s[0]&1);
+}
+
+int soscl_fe25519_iszero(const soscl_type_fe25519 f)
+{
+  uint8_t s[SOSCL_FE25519_BYTESIZE],acc;
+  int i;
+  soscl_fe25519_tobytes(s,f);
+  for(acc=0,i=0;i<SOSCL_FE25519_BYTESIZE;i++)
+    acc|=s[i];
+  return(0==acc);
+}
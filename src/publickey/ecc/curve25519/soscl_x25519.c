@@ -0,0 +1,115 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_x25519.c
+// X25519 key agreement (RFC 7748)
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_fe25519.h>
+#include <soscl/soscl_ed25519.h>
+#include <soscl/soscl_x25519.h>
+
+//(A-2)/4, A=486662 being the Montgomery curve coefficient
+#define SOSCL_X25519_A24 121665
+
+static void soscl_x25519_clamp(uint8_t *e,uint8_t *scalar)
+{
+  int i;
+  for(i=0;i<SOSCL_X25519_BYTESIZE;i++)
+    e[i]=scalar[i];
+  e[0]&=248;
+  e[31]&=127;
+  e[31]|=64;
+}
+
+static int soscl_x25519_check_zero(uint8_t *shared)
+{
+  uint8_t acc;
+  int i;
+  for(acc=0,i=0;i<SOSCL_X25519_BYTESIZE;i++)
+    acc|=shared[i];
+  if(0==acc)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//RFC 7748 5: Montgomery ladder on the u coordinate, in constant time
+//an all-zero output (low order u) is reported as an error
+int soscl_x25519(uint8_t *shared,uint8_t *scalar,uint8_t *u)
+{
+  uint8_t e[SOSCL_X25519_BYTESIZE];
+  soscl_type_fe25519 x1,x2,z2,x3,z3,a,aa,b,bb,c,d,da,cb,ee;
+  unsigned int swap,bit;
+  int t;
+  if(NULL==scalar || NULL==u)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==shared)
+    return(SOSCL_INVALID_OUTPUT);
+  soscl_x25519_clamp(e,scalar);
+  //the top bit of u is masked by soscl_fe25519_frombytes
+  soscl_fe25519_frombytes(x1,u);
+  soscl_fe25519_one(x2);
+  soscl_fe25519_zero(z2);
+  soscl_fe25519_copy(x3,x1);
+  soscl_fe25519_one(z3);
+  swap=0;
+  for(t=254;t>=0;t--)
+    {
+      bit=(e[t>>3]>>(t&7))&1;
+      swap^=bit;
+      soscl_fe25519_cswap(x2,x3,swap);
+      soscl_fe25519_cswap(z2,z3,swap);
+      swap=bit;
+      soscl_fe25519_add(a,x2,z2);
+      soscl_fe25519_sq(aa,a);
+      soscl_fe25519_sub(b,x2,z2);
+      soscl_fe25519_sq(bb,b);
+      soscl_fe25519_sub(ee,aa,bb);
+      soscl_fe25519_add(c,x3,z3);
+      soscl_fe25519_sub(d,x3,z3);
+      soscl_fe25519_mul(da,d,a);
+      soscl_fe25519_mul(cb,c,b);
+      soscl_fe25519_add(x3,da,cb);
+      soscl_fe25519_sq(x3,x3);
+      soscl_fe25519_sub(z3,da,cb);
+      soscl_fe25519_sq(z3,z3);
+      soscl_fe25519_mul(z3,z3,x1);
+      soscl_fe25519_mul(x2,aa,bb);
+      soscl_fe25519_mul_small(z2,ee,SOSCL_X25519_A24);
+      soscl_fe25519_add(z2,z2,aa);
+      soscl_fe25519_mul(z2,z2,ee);
+    }
+  soscl_fe25519_cswap(x2,x3,swap);
+  soscl_fe25519_cswap(z2,z3,swap);
+  soscl_fe25519_invert(z2,z2);
+  soscl_fe25519_mul(x2,x2,z2);
+  soscl_fe25519_tobytes(shared,x2);
+  soscl_memset(e,0,sizeof(e));
+  return(soscl_x25519_check_zero(shared));
+}
+
+//scalar.9, computed on the birationally equivalent Edwards curve with the Ed25519 fixed-base tables
+int soscl_x25519_public_key(uint8_t *public_key,uint8_t *scalar)
+{
+  uint8_t e[SOSCL_X25519_BYTESIZE];
+  int ret;
+  if(NULL==scalar)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==public_key)
+    return(SOSCL_INVALID_OUTPUT);
+  soscl_x25519_clamp(e,scalar);
+  ret=soscl_ed25519_scalarmult_base_u(public_key,e);
+  soscl_memset(e,0,sizeof(e));
+  return(ret);
+}
@@ -0,0 +1,80 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecdh.c
+// implements the ECDH key agreement (SEC1 v2 3.3.1, NIST SP800-56A 5.7.1.2) for the supported curves
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_init.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_keygeneration.h>
+#include <soscl/soscl_ecdh.h>
+
+//secret=x-coordinate of d.peer (curve_bsize bytes)
+//the peer public key is validated (coordinates in [0,p-1], point on the curve)
+//and d shall be in [1,n-1]
+int soscl_ecdh_shared_secret(uint8_t *secret,soscl_type_ecc_uint8_t_affine_point peer,uint8_t *d,soscl_type_curve *curve_params)
+{
+  word_type *work,*wordd,*xq,*yq,*x;
+  soscl_type_ecc_word_affine_point q;
+  int ret;
+  int wsize,bsize;
+  if(NULL==curve_params || NULL==d || NULL==peer.x || NULL==peer.y)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==secret)
+    return(SOSCL_INVALID_OUTPUT);
+  bsize=curve_params->curve_bsize;
+  wsize=curve_params->curve_wsize;
+  //peer public key validation
+  ret=soscl_ecc_point_on_curve(peer,curve_params);
+  if(SOSCL_STACK_ERROR==ret)
+    return(ret);
+  if(SOSCL_OK!=ret)
+    return(SOSCL_INVALID_INPUT);
+  if (soscl_stack_alloc(&work,4*wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  wordd=work;
+  xq=wordd+wsize;
+  yq=xq+wsize;
+  x=yq+wsize;
+  soscl_bignum_b2w(wordd,wsize,d,bsize);
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(wordd,wsize) || soscl_bignum_memcmp(wordd,curve_params->n,wsize)>=0)
+    {
+      ret=SOSCL_INVALID_INPUT;
+      goto soscl_label_ecdh_end;
+    }
+  soscl_bignum_b2w(xq,wsize,peer.x,bsize);
+  soscl_bignum_b2w(yq,wsize,peer.y,bsize);
+  q.x=xq;
+  q.y=yq;
+  //co-Z ladder on the regularised scalar, only the x-coordinate of the shared point is converted back
+  ret=soscl_ecc_mult_coz_affine_x(x,wordd,wsize,q,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecdh_end;
+  //the curves have a cofactor of 1: the shared point cannot be the infinity point for a valid peer key
+  //this is a safety net against faults
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(x,wsize))
+    {
+      ret=SOSCL_ERROR;
+      goto soscl_label_ecdh_end;
+    }
+  soscl_bignum_w2b(secret,bsize,x,wsize);
+ soscl_label_ecdh_end:
+  soscl_memset(work,0,4*wsize*(int)sizeof(word_type));
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
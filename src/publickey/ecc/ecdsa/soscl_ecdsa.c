@@ -25,6 +25,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <soscl/soscl_rng.h>
 #include <soscl/soscl_hash.h>
 #include <soscl/soscl_sha.h>
+#include <soscl/soscl_hmac.h>
 #include <soscl/soscl_bignumbers.h>
 #include <soscl/soscl_ecc.h>
 #include <soscl/soscl_ecdsa.h>
@@ -35,27 +36,148 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 extern int hash_size[SOSCL_HASH_FUNCTIONS_MAX_NB];
 
-//currently supported curves (no modification expected for other curves, like brainpool ones)
+//currently supported curves (the brainpool ones are also supported, their field elements being in the Montgomery domain)
 extern soscl_type_curve soscl_secp256r1;
 extern soscl_type_curve soscl_secp384r1;
 extern soscl_type_curve soscl_secp521r1;
 
+//draws the nonce k uniformly in [1,n-1]
+//k is masked to the n bitlength, then rejected until it fits, so that no bias is introduced
+static int soscl_ecdsa_nonce(word_type *k,soscl_type_curve *curve_params)
+{
+  int msb,msw,nbbits;
+  //determine the n msW
+  soscl_ecc_msbit_and_size(&msb,&msw,curve_params);
+  //number of significant bits in the n msW (0 means the msW is full)
+  nbbits=msb%SOSCL_WORD_BITS;
+  do
+    {
+      soscl_bignum_set_zero(k,curve_params->curve_wsize);
+      if((int)curve_params->curve_bsize!=soscl_rng_read((uint8_t*)k,curve_params->curve_bsize,SOSCL_RAND_GENERIC))
+	return(SOSCL_ERROR);
+      //"align" k on n, so clear bits beyond n msW msb
+      if(0!=nbbits)
+	k[msw-1]&=(((word_type)1)<<nbbits)-1;
+    }
+  //we loop until the generated value is correct
+  //the accepted range is between 1 and n-1
+  while((soscl_bignum_memcmp(k,curve_params->n,curve_params->curve_wsize)>=0)||(SOSCL_OK==soscl_bignum_cmp_with_zero(k,curve_params->curve_wsize)));
+  return(SOSCL_OK);
+}
+
+//RFC 6979 HMAC-DRBG state for the deterministic nonce
+//the hmac key state is recomputed only when K changes, not for each V=HMAC_K(V)
+typedef struct _soscl_t_ecdsa_rfc6979
+{
+  soscl_type_hmac_state hmac;
+  uint8_t k[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t v[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int hashsize;
+  int rolen;//n byte length
+  int qlen;//n bit length
+  int first;
+} soscl_type_ecdsa_rfc6979;
+
+//K=HMAC_K(V||separator[||x||h]), then V=HMAC_K(V)
+static int soscl_ecdsa_rfc6979_update(soscl_type_ecdsa_rfc6979 *drbg,uint8_t separator,uint8_t *x,uint8_t *h)
+{
+  int ret;
+  ret=soscl_hmac_state_start(&drbg->hmac);
+  ret|=soscl_hmac_state_core(&drbg->hmac,drbg->v,drbg->hashsize);
+  ret|=soscl_hmac_state_core(&drbg->hmac,&separator,1);
+  if(NULL!=x)
+    {
+      ret|=soscl_hmac_state_core(&drbg->hmac,x,drbg->rolen);
+      ret|=soscl_hmac_state_core(&drbg->hmac,h,drbg->rolen);
+    }
+  ret|=soscl_hmac_state_finish(&drbg->hmac,drbg->k,drbg->hashsize);
+  //new K, so new key state
+  ret|=soscl_hmac_state_init(&drbg->hmac,drbg->hmac.algo,drbg->k,drbg->hashsize);
+  ret|=soscl_hmac_state_start(&drbg->hmac);
+  ret|=soscl_hmac_state_core(&drbg->hmac,drbg->v,drbg->hashsize);
+  ret|=soscl_hmac_state_finish(&drbg->hmac,drbg->v,drbg->hashsize);
+  if(SOSCL_OK!=ret)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//RFC 6979 section 3.2 steps a. to f.
+//d is the secret key and e the truncated hash digest (bits2int(h1)), both as words
+static int soscl_ecdsa_rfc6979_init(soscl_type_ecdsa_rfc6979 *drbg,word_type *d,word_type *e,int hash,soscl_type_curve *curve_params)
+{
+  uint8_t x[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t h[SOSCL_SECP521R1_BYTESIZE];
+  word_type z[SOSCL_SECP521R1_WORDSIZE];
+  int msw,ret;
+  if(SOSCL_SHA256_ID!=hash && SOSCL_SHA384_ID!=hash && SOSCL_SHA512_ID!=hash)
+    return(SOSCL_INVALID_INPUT);
+  soscl_ecc_msbit_and_size(&drbg->qlen,&msw,curve_params);
+  drbg->rolen=(drbg->qlen+SOSCL_BYTE_BITS-1)/SOSCL_BYTE_BITS;
+  drbg->hashsize=hash_size[hash];
+  drbg->first=SOSCL_TRUE;
+  //int2octets(x) and bits2octets(h1)
+  soscl_bignum_w2b(x,drbg->rolen,d,curve_params->curve_wsize);
+  soscl_bignum_mod(z,e,curve_params->curve_wsize,curve_params->n,curve_params->curve_wsize);
+  soscl_bignum_w2b(h,drbg->rolen,z,curve_params->curve_wsize);
+  //b. and c.
+  soscl_memset(drbg->v,0x01,drbg->hashsize);
+  soscl_memset(drbg->k,0x00,drbg->hashsize);
+  ret=soscl_hmac_state_init(&drbg->hmac,hash,drbg->k,drbg->hashsize);
+  //d. to g.
+  if(SOSCL_OK==ret)
+    ret=soscl_ecdsa_rfc6979_update(drbg,0x00,x,h);
+  if(SOSCL_OK==ret)
+    ret=soscl_ecdsa_rfc6979_update(drbg,0x01,x,h);
+  soscl_memset(x,0,sizeof(x));
+  return(ret);
+}
+
+//RFC 6979 section 3.2 step h.: next candidate k in [1,n-1]
+static int soscl_ecdsa_rfc6979_nonce(word_type *k,soscl_type_ecdsa_rfc6979 *drbg,soscl_type_curve *curve_params)
+{
+  uint8_t t[SOSCL_SECP521R1_BYTESIZE+SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int tlen,ret;
+  do
+    {
+      //a rejected candidate (or signature) requires K=HMAC_K(V||0x00), V=HMAC_K(V)
+      if(SOSCL_TRUE!=drbg->first)
+	if(SOSCL_OK!=soscl_ecdsa_rfc6979_update(drbg,0x00,NULL,NULL))
+	  return(SOSCL_ERROR);
+      drbg->first=SOSCL_FALSE;
+      for(tlen=0,ret=SOSCL_OK;tlen<drbg->rolen;tlen+=drbg->hashsize)
+	{
+	  ret|=soscl_hmac_state_start(&drbg->hmac);
+	  ret|=soscl_hmac_state_core(&drbg->hmac,drbg->v,drbg->hashsize);
+	  ret|=soscl_hmac_state_finish(&drbg->hmac,drbg->v,drbg->hashsize);
+	  soscl_memcpy(t+tlen,drbg->v,drbg->hashsize);
+	}
+      if(SOSCL_OK!=ret)
+	return(SOSCL_ERROR);
+      //bits2int(T): the qlen leftmost bits
+      soscl_bignum_b2w(k,curve_params->curve_wsize,t,drbg->rolen);
+      if(drbg->rolen*SOSCL_BYTE_BITS>drbg->qlen)
+	soscl_bignum_rightshift(k,k,drbg->rolen*SOSCL_BYTE_BITS-drbg->qlen,curve_params->curve_wsize);
+    }
+  while((soscl_bignum_memcmp(k,curve_params->n,curve_params->curve_wsize)>=0)||(SOSCL_OK==soscl_bignum_cmp_with_zero(k,curve_params->curve_wsize)));
+  soscl_memset(t,0,sizeof(t));
+  return(SOSCL_OK);
+}
+
 //computes a ecdsa signature to be contained in *signature, on the curve *curve_params, using the *soscl_hash hash function for the message *input and the private key *secret_d
 
-//configuration says the input kind: message or message hash; the NIST mode option, the hash function
+//configuration says the input kind: message or message hash; the NIST mode option, the hash function, the nonce kind
 //note: even if the hash function is given as a parameter, the hash identifier is useful for the hash size
 int  soscl_ecdsa_signature(soscl_type_ecdsa_signature signature,uint8_t *secret_d,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input, int input_size, soscl_type_curve *curve_params,int configuration)
 {
   int ret,resu;
-  int nbbits;
   //we use the steps and the identifiers defined in algo 4.29 in GtECC
   word_type *work,*r,*s,*e,*x1,*y1,*w,*d,*k;
   soscl_type_ecc_word_affine_point q;
   soscl_type_ecc_word_affine_point p;
-  int hash,input_type;
+  int hash,input_type,nonce_type;
   uint8_t h[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
   word_type curve_wsize,curve_bsize,curve_bitsize,hashsize;
-  int msb,msw;
+  soscl_type_ecdsa_rfc6979 drbg;
 
   //check parameters
   if(NULL==input || NULL==secret_d || NULL==curve_params)
@@ -71,6 +193,7 @@ int  soscl_ecdsa_signature(soscl_type_ecdsa_signature signature,uint8_t *secret_
   hash=(configuration>>SOSCL_HASH_SHIFT)&SOSCL_HASH_MASK;
   //input_type can be either MSG -hash is required- or HASH,-hash has already been computed-
   input_type=(configuration>>SOSCL_INPUT_SHIFT)&SOSCL_INPUT_MASK;
+  nonce_type=(configuration>>SOSCL_NONCE_SHIFT)&SOSCL_NONCE_MASK;
   //from ECDSA description in ANSI X9.62
   //1. e=hash(m)
   //hash computation only if input format is SOSCL_MSG_INPUT_TYPE
@@ -106,29 +229,28 @@ int  soscl_ecdsa_signature(soscl_type_ecdsa_signature signature,uint8_t *secret_
   w=y1+curve_wsize;
   d=w+curve_wsize;
   k=d+curve_wsize;
+  soscl_bignum_b2w(e,curve_wsize,h,soscl_bignum_min(curve_bsize,hashsize));
+  //hash truncation is done here, if needed
+  soscl_bignum_truncate(e,curve_bitsize,curve_wsize);
+  soscl_bignum_b2w(d,curve_wsize,secret_d,curve_bsize);
+  if(SOSCL_DETERMINISTIC_NONCE==nonce_type)
+    {
+      ret=soscl_ecdsa_rfc6979_init(&drbg,d,e,hash,curve_params);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_ecdsa_signature_end;
+    }
   do
     {
-      //determine the n msW
-      soscl_ecc_msbit_and_size(&msb,&msw,curve_params);
-      //determine the msb position in the n msW
-      nbbits=(msb-1)% SOSCL_WORD_BITS;
-      if(0==nbbits)
-	nbbits=SOSCL_WORD_BITS;
-      //3. randomly generate k [1,k-1]
-      do
+      //3. generate k [1,n-1], randomly or from the RFC 6979 drbg
+      if(SOSCL_DETERMINISTIC_NONCE==nonce_type)
+	resu=soscl_ecdsa_rfc6979_nonce(k,&drbg,curve_params);
+      else
+	resu=soscl_ecdsa_nonce(k,curve_params);
+      if(SOSCL_OK!=resu)
 	{
-	  if((int)curve_bsize!=soscl_rng_read((uint8_t*)k,curve_bsize,SOSCL_RAND_GENERIC))
-	    {
-	      ret=SOSCL_ERROR;
-	      goto soscl_label_ecdsa_signature_end;
-	    }
-	  //"align" k on n,
-	  //so clear bits beyond n msW msb
-	  k[msw-1]&=(word_type)((1<<nbbits)-1);
+	  ret=SOSCL_ERROR;
+	  goto soscl_label_ecdsa_signature_end;
 	}
-      //we loop until the generated value is correct
-      //the accepted range is between 1 and n-1
-      while((soscl_bignum_memcmp(k,curve_params->n,curve_wsize)>=0)||(SOSCL_OK==soscl_bignum_cmp_with_zero(k,curve_wsize)));
       //4 (x1,y1)=k.G
       q.x=x1;
       q.y=y1;
@@ -148,11 +270,7 @@ int  soscl_ecdsa_signature(soscl_type_ecdsa_signature signature,uint8_t *secret_
       //6.1 invert k
       soscl_bignum_modinv(w,k,curve_params->n,curve_wsize);
       //6.2 e+r.d:
-      soscl_bignum_b2w(e,curve_wsize,h,soscl_bignum_min(curve_bsize,hashsize));
-      //hash truncation is done here, if needed
-      soscl_bignum_truncate(e,curve_bitsize,curve_wsize);
       //6.2.1 r.d
-      soscl_bignum_b2w(d,curve_wsize,secret_d,curve_bsize);
       soscl_bignum_modmult(r,r,d,curve_params->n,curve_wsize);
       //6.2.2 e+r.d
       if(SOSCL_OK!=soscl_bignum_modadd(r,r,e,curve_params->n,curve_wsize))
@@ -168,45 +286,28 @@ int  soscl_ecdsa_signature(soscl_type_ecdsa_signature signature,uint8_t *secret_
 	}
       //check the signature is not null: 5. and 6.
     }
-  while((SOSCL_OK==soscl_bignum_cmp_with_zero(s,curve_wsize)) && (SOSCL_OK==soscl_bignum_cmp_with_zero(r,curve_wsize)));
+  while((SOSCL_OK==soscl_bignum_cmp_with_zero(s,curve_wsize)) || (SOSCL_OK==soscl_bignum_cmp_with_zero(r,curve_wsize)));
 
   soscl_bignum_w2b(signature.s,curve_bsize,s,curve_wsize);
   //6 result
   ret=SOSCL_OK;
  soscl_label_ecdsa_signature_end:
+  //k and the secret key shall not remain on the stack
+  soscl_bignum_set_zero(work,8*curve_wsize);
+  soscl_memset(&drbg,0,sizeof(drbg));
   if (soscl_stack_free(&work) != SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(ret);
 }
 
-//verifies the ecdsa signature contained in *signature, on the curve *curve_params, using the *soscl_hash hash function for the message *input and the public key q
-//as defined in ANS X9.62-2005 (which is the reference for the NIST FIPS 186-4
-int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration)
+//e=hash(input) (or input, if already hashed), truncated to the curve length
+//the hash length constraints are the FIPS 186-4 section 6.4 ones
+static int soscl_ecdsa_digest(word_type *e,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration)
 {
-  //algo 3.48 in GtECC with w=2, so 2^w=4, so i=0..3, j=0..3
-  //the array for storing the precomputed values is 16-point large
-#define SOSCL_ECDSA_WINDOW_WIDTH 2
-#define SOSCL_ECDSA_ARRAY_SIZE (1<<SOSCL_ECDSA_WINDOW_WIDTH)*(1<<SOSCL_ECDSA_WINDOW_WIDTH)
-  int ret,i,j,kili;
-  //we use the steps and the identifiers defined in algo 4.30 in GtECC
-  word_type *e,*r,*s,*w,*u1,*u2,*xq,*yq,*x1,*y1,*z1,*work;
-  //variables that contain the precomputed values
-  soscl_type_ecc_word_jacobian_point ipjq[SOSCL_ECDSA_ARRAY_SIZE];
-  word_type *ipjqx[SOSCL_ECDSA_ARRAY_SIZE];
-  word_type *ipjqy[SOSCL_ECDSA_ARRAY_SIZE];
-  word_type *ipjqz[SOSCL_ECDSA_ARRAY_SIZE];
-  soscl_type_ecc_word_affine_point point;
-  soscl_type_ecc_word_jacobian_point pointj;
   //the hash digest has the largest size, to fit any hash function
   uint8_t h[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
-  int hash,input_type,n;
-  
+  int hash,input_type;
   word_type curve_wsize,curve_bsize,hashsize,curve_bitsize;
-  //check parameters pointers validity
-  if(NULL==input || NULL==curve_params)
-    return(SOSCL_INVALID_INPUT);
-
-  //retrieve the configuration
   curve_wsize=curve_params->curve_wsize;
   curve_bsize=curve_params->curve_bsize;
   if(SOSCL_SECP521R1==curve_params->curve)
@@ -215,48 +316,8 @@ int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point q,soscl_type_ec
     curve_bitsize=curve_bsize*8;
   hash=(configuration>>SOSCL_HASH_SHIFT)&SOSCL_HASH_MASK;
   input_type=(configuration>>SOSCL_INPUT_SHIFT)&SOSCL_INPUT_MASK;  
-
-  //temp data allocation
-  if (soscl_stack_alloc(&work, (11+SOSCL_ECDSA_ARRAY_SIZE*3)*(int)curve_wsize) != SOSCL_OK)
-    return(SOSCL_STACK_ERROR);
-  e=work;
-  r=e+curve_wsize;
-  s=r+curve_wsize;
-  w=s+curve_wsize;
-  u1=w+curve_wsize;
-  u2=u1+curve_wsize;
-  xq=u2+curve_wsize;
-  yq=xq+curve_wsize;
-  x1=yq+curve_wsize;
-  y1=x1+curve_wsize;
-  z1=y1+curve_wsize;
-  ipjqx[0]=z1+curve_wsize;
-  ipjqy[0]=ipjqx[0]+curve_wsize;
-  ipjqz[0]=ipjqy[0]+curve_wsize;
-  for(i=1;i<SOSCL_ECDSA_ARRAY_SIZE;i++)
-    {
-      ipjqx[i]=ipjqz[i-1]+curve_wsize;
-      ipjqy[i]=ipjqx[i]+curve_wsize;
-      ipjqz[i]=ipjqy[i]+curve_wsize;
-    }
-  //a. verify r,s are in [1..n-1]
-  soscl_bignum_b2w(s,curve_wsize, signature.s, curve_bsize);
-  soscl_bignum_b2w(r,curve_wsize, signature.r, curve_bsize);
-  if((soscl_bignum_memcmp(r,curve_params->n,curve_wsize)>=0)||(soscl_bignum_memcmp(s,curve_params->n,curve_wsize)>=0))
-    {
-      ret=SOSCL_ERROR;
-      goto soscl_label_ecdsa_verification_end;
-    }
-  if((SOSCL_OK==soscl_bignum_cmp_with_zero(r,curve_wsize))||(SOSCL_OK==soscl_bignum_cmp_with_zero(s,curve_wsize)))
-    {
-      ret=SOSCL_ERROR;
-      goto soscl_label_ecdsa_verification_end;
-    }
-
   //b. h=SHA(m)
   //hash computation only if input format is SOSCL_MSG_INPUT
-
-  //if the message has to be hashed
   if(SOSCL_MSG_INPUT_TYPE==input_type)
     {
       hashsize=hash_size[hash];
@@ -270,56 +331,53 @@ int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point q,soscl_type_ec
       //SOSCL_HASH_FIPS_INPUT_TYPE mode addresses this request
       //otherwise, the input message length shall be a hash function length
       if(SOSCL_HASH_FIPS_INPUT_TYPE!=input_type && SOSCL_OK!=soscl_valid_hash_digest_length((word_type)inputlength))
-	{
-	  ret=SOSCL_INVALID_INPUT;
-	  goto soscl_label_ecdsa_verification_end;
-	}
+	return(SOSCL_INVALID_INPUT);
     }
   //if the hash digest is shorter than the curve length, there is a security issue (see FIPS186-4, section 6.4), except if using SOSCL_HASH_FIPS_INPUT_TYPE mode
   if((hashsize<curve_bsize)&&(!(hashsize==SOSCL_SHA512_BYTE_HASHSIZE && SOSCL_SECP521R1==curve_params->curve)) && (SOSCL_HASH_FIPS_INPUT_TYPE!=input_type))
     return(SOSCL_INVALID_INPUT);
-
   //c. processing the hash digest
   soscl_bignum_b2w(e,curve_wsize,h,soscl_bignum_min(hashsize,curve_bsize));
   //hash truncation is done here, if needed
   soscl_bignum_truncate(e,curve_bitsize,curve_wsize);
+  return(SOSCL_OK);
+}
 
-  //d. w=s^-1 mod n, so u1=e.w mod n and u2=r.w mod n
-  soscl_bignum_modinv(w,s,curve_params->n,curve_wsize);
-  //u1=e*w mod n
-  if(SOSCL_OK!=soscl_bignum_modmult(u1,e,w,curve_params->n,curve_wsize))
-    {
-      ret=SOSCL_ERROR;
-      goto soscl_label_ecdsa_verification_end;
-    }
-  if(SOSCL_OK!=soscl_bignum_modmult(u2,r,w,curve_params->n,curve_wsize))
+//ipjq[i] contains i.P+j.Q, with i=index&3 and j=index>>2
+//the P part (P, 2P, 3P) only depends on the curve, so it is computed once, and can be shared by several verifications
+static void soscl_ecdsa_table_init(soscl_type_ecc_word_jacobian_point *ipjq,word_type *buffer,soscl_type_curve *curve_params)
+{
+  int i,curve_wsize;
+  soscl_type_ecc_word_affine_point point;
+  curve_wsize=curve_params->curve_wsize;
+  for(i=0;i<SOSCL_ECDSA_ARRAY_SIZE;i++)
     {
-      ret=SOSCL_ERROR;
-      goto soscl_label_ecdsa_verification_end;
+      ipjq[i].x=buffer+3*i*curve_wsize;
+      ipjq[i].y=ipjq[i].x+curve_wsize;
+      ipjq[i].z=ipjq[i].y+curve_wsize;
     }
-  soscl_bignum_b2w(xq,curve_wsize,q.x,curve_bsize);
-  soscl_bignum_b2w(yq,curve_wsize,q.y,curve_bsize);
   //point contains the curve base point  
   point.x=curve_params->xg;
   point.y=curve_params->yg;
-  //ipjq structure adapted to the functions APIs
-  for(i=0;i<SOSCL_ECDSA_ARRAY_SIZE;i++)
-    {
-      ipjq[i].x=ipjqx[i];
-      ipjq[i].y=ipjqy[i];
-      ipjq[i].z=ipjqz[i];
-    }
   //1.P
   soscl_ecc_convert_affine_to_jacobian(ipjq[1],point,curve_params);
+  soscl_ecc_to_domain(ipjq[1].x,ipjq[1].x,curve_params);
+  soscl_ecc_to_domain(ipjq[1].y,ipjq[1].y,curve_params);
   //2.P
   soscl_ecc_double_jacobian(ipjq[2],ipjq[1],curve_params);
   //3.P
   soscl_ecc_add_jacobian_jacobian(ipjq[3],ipjq[2],ipjq[1],curve_params);
-  //point contains the public key
-  point.x=xq;
-  point.y=yq;
+}
+
+//completes ipjq with the Q part and normalises it into ipjq_affine[1..15], with one single inversion
+//the P part of ipjq shall already be computed by soscl_ecdsa_table_init
+static void soscl_ecdsa_table_complete(soscl_type_ecc_word_affine_point *ipjq_affine,soscl_type_ecc_word_affine_point q,soscl_type_ecc_word_jacobian_point *ipjq,soscl_type_curve *curve_params)
+{
+  int i,j;
   //1.Q
-  soscl_ecc_convert_affine_to_jacobian(ipjq[4],point,curve_params);
+  soscl_ecc_convert_affine_to_jacobian(ipjq[4],q,curve_params);
+  soscl_ecc_to_domain(ipjq[4].x,ipjq[4].x,curve_params);
+  soscl_ecc_to_domain(ipjq[4].y,ipjq[4].y,curve_params);
   //2.Q
   soscl_ecc_double_jacobian(ipjq[8],ipjq[4],curve_params);
   //3.Q
@@ -328,15 +386,24 @@ int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point q,soscl_type_ec
   for(j=4;j<=12;j+=4)
     for(i=0;i<3;i++)
       soscl_ecc_add_jacobian_jacobian(ipjq[j+1+i],ipjq[j],ipjq[i+1],curve_params);
+  //table normalised with one single inversion, so that the loop uses mixed additions
+  soscl_ecc_batch_to_affine(ipjq_affine+1,ipjq+1,SOSCL_ECDSA_ARRAY_SIZE-1,curve_params);
+  //the P part is reused by the next call (batch verification)
+  for(i=1;i<4;i++)
+    soscl_ecc_field_one(ipjq[i].z,curve_params);
+}
+
+//pointj=u1.P+u2.Q, ipjq_affine[1..15] containing the i.P+j.Q affine points (in the curve field domain)
+static void soscl_ecdsa_double_mult_table(soscl_type_ecc_word_jacobian_point pointj,word_type *u1,word_type *u2,soscl_type_ecc_word_affine_point *ipjq_affine,soscl_type_curve *curve_params)
+{
+  int i,kili,n;
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
   n=curve_wsize*(int)sizeof(word_type)*8;
   //3. r=infinite
-  soscl_bignum_set_one_word(x1,1,curve_wsize);
-  soscl_bignum_set_one_word(y1,1,curve_wsize);
-  soscl_bignum_memset(z1,0,curve_wsize);
-
-  pointj.x=x1;
-  pointj.y=y1;
-  pointj.z=z1;
+  soscl_bignum_set_one_word(pointj.x,1,curve_wsize);
+  soscl_bignum_set_one_word(pointj.y,1,curve_wsize);
+  soscl_bignum_memset(pointj.z,0,curve_wsize);
   //4.
   for(i=n/2-1;i>=0;i--)
     {
@@ -346,24 +413,697 @@ int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point q,soscl_type_ec
       //4.2 two-bit wide at a time
       kili=(soscl_word_bit(u1,i*2)^(soscl_word_bit(u1,i*2+1)<<1))^((soscl_word_bit(u2,i*2)^(soscl_word_bit(u2,i*2+1)<<1))<<2);
       if(0!=kili)
-	soscl_ecc_add_jacobian_jacobian(pointj,pointj,ipjq[kili],curve_params);
+	soscl_ecc_add_jacobian_affine(pointj,pointj,ipjq_affine[kili],curve_params);
     }
-  //4. (x1,y1)=u1.G+u2.Q
-  point.x=x1;
-  point.y=y1;
-  //f
-  soscl_ecc_convert_jacobian_to_affine(point,pointj,curve_params);
-
-  //g. v=x1 mod n (using z1 as v)
-  soscl_bignum_mod(z1,x1,curve_wsize,curve_params->n,curve_wsize);
-  
-  //h. if (r==v) the signature is ok
-  if(0==soscl_bignum_memcmp(r,z1,(word_type)curve_wsize))
-    ret=SOSCL_OK;
-  else
-    ret=SOSCL_ERROR;
+}
+
+//pointj=u1.P+u2.Q, with the P part of ipjq already computed by soscl_ecdsa_table_init
+static void soscl_ecdsa_double_mult(soscl_type_ecc_word_jacobian_point pointj,word_type *u1,word_type *u2,soscl_type_ecc_word_affine_point q,soscl_type_ecc_word_jacobian_point *ipjq,soscl_type_curve *curve_params)
+{
+  int i;
+  soscl_type_ecc_word_affine_point ipjq_affine[SOSCL_ECDSA_ARRAY_SIZE];
+  for(i=1;i<SOSCL_ECDSA_ARRAY_SIZE;i++)
+    {
+      ipjq_affine[i].x=ipjq[i].x;
+      ipjq_affine[i].y=ipjq[i].y;
+    }
+  soscl_ecdsa_table_complete(ipjq_affine,q,ipjq,curve_params);
+  soscl_ecdsa_double_mult_table(pointj,u1,u2,ipjq_affine,curve_params);
+}
+
+//table[i].x and table[i].y (i=1..15) receive the i.P+j.Q affine points used by the verification (i=index&3 and j=index>>2), in the curve field domain
+//q shall be a valid public key (see soscl_ecc_point_on_curve)
+int soscl_ecdsa_table_precompute(soscl_type_ecc_word_affine_point *table,soscl_type_ecc_uint8_t_affine_point q,soscl_type_curve *curve_params)
+{
+  word_type *work,*xq,*yq;
+  int i,curve_wsize;
+  soscl_type_ecc_word_jacobian_point ipjq[SOSCL_ECDSA_ARRAY_SIZE];
+  soscl_type_ecc_word_affine_point point;
+  if(NULL==curve_params || NULL==q.x || NULL==q.y)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==table)
+    return(SOSCL_INVALID_OUTPUT);
+  for(i=1;i<SOSCL_ECDSA_ARRAY_SIZE;i++)
+    if(NULL==table[i].x || NULL==table[i].y)
+      return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work,(2+SOSCL_ECDSA_ARRAY_SIZE*3)*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  xq=work;
+  yq=xq+curve_wsize;
+  soscl_bignum_b2w(xq,curve_wsize,q.x,curve_params->curve_bsize);
+  soscl_bignum_b2w(yq,curve_wsize,q.y,curve_params->curve_bsize);
+  point.x=xq;
+  point.y=yq;
+  soscl_ecdsa_table_init(ipjq,yq+curve_wsize,curve_params);
+  soscl_ecdsa_table_complete(table,point,ipjq,curve_params);
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//r==x mod n for (X:Y:Z), x=X/Z^2 being in jacobian coordinates, without any field inversion:
+//x<p, so x mod n=r means x=r or x=r+n (only possible when r+n<p), i.e. r.Z^2==X or (r+n).Z^2==X
+static int soscl_ecdsa_jacobian_check_r(word_type *r,soscl_type_ecc_word_jacobian_point pointj,soscl_type_curve *curve_params)
+{
+  word_type *work,*z2,*t,carry;
+  int ret,curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  //the infinity point is not a valid result
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(pointj.z,curve_wsize))
+    return(SOSCL_ERROR);
+  if (soscl_stack_alloc(&work,2*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  z2=work;
+  t=z2+curve_wsize;
+  ret=SOSCL_ERROR;
+  if(soscl_bignum_memcmp(r,curve_params->p,curve_wsize)<0)
+    {
+      soscl_ecc_modsquare(z2,pointj.z,curve_params);
+      soscl_ecc_to_domain(t,r,curve_params);
+      soscl_ecc_modmult(t,t,z2,curve_params);
+      if(0==soscl_bignum_memcmp(t,pointj.x,curve_wsize))
+	ret=SOSCL_OK;
+      else
+	{
+	  carry=soscl_bignum_add(t,r,curve_params->n,curve_wsize);
+	  if(0==carry && soscl_bignum_memcmp(t,curve_params->p,curve_wsize)<0)
+	    {
+	      soscl_ecc_to_domain(t,t,curve_params);
+	      soscl_ecc_modmult(t,t,z2,curve_params);
+	      if(0==soscl_bignum_memcmp(t,pointj.x,curve_wsize))
+		ret=SOSCL_OK;
+	    }
+	}
+    }
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//steps a. to d. of the verification: r,s range checks, u1=e.s^-1 mod n and u2=r.s^-1 mod n
+//e and w are temporary numbers
+static int soscl_ecdsa_verification_scalars(word_type *r,word_type *u1,word_type *u2,word_type *e,word_type *w,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration)
+{
+  int ret;
+  word_type curve_wsize,curve_bsize;
+  curve_wsize=curve_params->curve_wsize;
+  curve_bsize=curve_params->curve_bsize;
+  //a. verify r,s are in [1..n-1]
+  soscl_bignum_b2w(w,curve_wsize, signature.s, curve_bsize);
+  soscl_bignum_b2w(r,curve_wsize, signature.r, curve_bsize);
+  if((soscl_bignum_memcmp(r,curve_params->n,curve_wsize)>=0)||(soscl_bignum_memcmp(w,curve_params->n,curve_wsize)>=0))
+    return(SOSCL_ERROR);
+  if((SOSCL_OK==soscl_bignum_cmp_with_zero(r,curve_wsize))||(SOSCL_OK==soscl_bignum_cmp_with_zero(w,curve_wsize)))
+    return(SOSCL_ERROR);
+  //b.+c. e=SHA(m), truncated
+  ret=soscl_ecdsa_digest(e,soscl_hash,input,inputlength,curve_params,configuration);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  //d. w=s^-1 mod n, so u1=e.w mod n and u2=r.w mod n
+  soscl_bignum_modinv(u2,w,curve_params->n,curve_wsize);
+  soscl_bignum_memcpy(w,u2,curve_wsize);
+  //u1=e*w mod n
+  if(SOSCL_OK!=soscl_bignum_modmult(u1,e,w,curve_params->n,curve_wsize))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_bignum_modmult(u2,r,w,curve_params->n,curve_wsize))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//verifies the ecdsa signature contained in *signature, on the curve *curve_params, using the *soscl_hash hash function for the message *input and the public key q
+//as defined in ANS X9.62-2005 (which is the reference for the NIST FIPS 186-4
+int soscl_ecdsa_verification(soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration)
+{
+  int ret;
+  //we use the steps and the identifiers defined in algo 4.30 in GtECC
+  word_type *e,*r,*w,*u1,*u2,*xq,*yq,*x1,*y1,*z1,*work;
+  //variables that contain the precomputed values
+  soscl_type_ecc_word_jacobian_point ipjq[SOSCL_ECDSA_ARRAY_SIZE];
+  soscl_type_ecc_word_affine_point point;
+  soscl_type_ecc_word_jacobian_point pointj;
+  word_type curve_wsize,curve_bsize;
+  //check parameters pointers validity
+  if(NULL==input || NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+
+  //retrieve the configuration
+  curve_wsize=curve_params->curve_wsize;
+  curve_bsize=curve_params->curve_bsize;
+
+  //temp data allocation
+  if (soscl_stack_alloc(&work, (10+SOSCL_ECDSA_ARRAY_SIZE*3)*(int)curve_wsize) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  e=work;
+  r=e+curve_wsize;
+  w=r+curve_wsize;
+  u1=w+curve_wsize;
+  u2=u1+curve_wsize;
+  xq=u2+curve_wsize;
+  yq=xq+curve_wsize;
+  x1=yq+curve_wsize;
+  y1=x1+curve_wsize;
+  z1=y1+curve_wsize;
+  //a.-d.
+  ret=soscl_ecdsa_verification_scalars(r,u1,u2,e,w,signature,soscl_hash,input,inputlength,curve_params,configuration);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecdsa_verification_end;
+  soscl_bignum_b2w(xq,curve_wsize,q.x,curve_bsize);
+  soscl_bignum_b2w(yq,curve_wsize,q.y,curve_bsize);
+  soscl_ecdsa_table_init(ipjq,z1+curve_wsize,curve_params);
+  //point contains the public key
+  point.x=xq;
+  point.y=yq;
+  pointj.x=x1;
+  pointj.y=y1;
+  pointj.z=z1;
+  //e. (x1,y1)=u1.G+u2.Q
+  soscl_ecdsa_double_mult(pointj,u1,u2,point,ipjq,curve_params);
+  //f.+g.+h. x1 mod n==r, checked in jacobian coordinates
+  ret=soscl_ecdsa_jacobian_check_r(r,pointj,curve_params);
  soscl_label_ecdsa_verification_end:
   if (soscl_stack_free(&work) != SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(ret);
 }
+
+//same as soscl_ecdsa_verification, the public key being given by its table computed by soscl_ecdsa_table_precompute
+//the table is only read, so that it may be located in read-only (e.g. memory-mapped) memory
+int soscl_ecdsa_verification_table(soscl_type_ecc_word_affine_point *table,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration)
+{
+  int ret;
+  word_type *e,*r,*w,*u1,*u2,*work;
+  soscl_type_ecc_word_jacobian_point pointj;
+  word_type curve_wsize;
+  if(NULL==input || NULL==curve_params || NULL==table)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work,8*(int)curve_wsize) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  e=work;
+  r=e+curve_wsize;
+  w=r+curve_wsize;
+  u1=w+curve_wsize;
+  u2=u1+curve_wsize;
+  pointj.x=u2+curve_wsize;
+  pointj.y=pointj.x+curve_wsize;
+  pointj.z=pointj.y+curve_wsize;
+  ret=soscl_ecdsa_verification_scalars(r,u1,u2,e,w,signature,soscl_hash,input,inputlength,curve_params,configuration);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecdsa_verification_table_end;
+  soscl_ecdsa_double_mult_table(pointj,u1,u2,table,curve_params);
+  ret=soscl_ecdsa_jacobian_check_r(r,pointj,curve_params);
+ soscl_label_ecdsa_verification_table_end:
+  if (soscl_stack_free(&work) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//verifies count ecdsa signatures at once, all on the same curve *curve_params, with the same hash function and configuration
+//results[i] receives the verification result of items[i] (SOSCL_OK or SOSCL_ERROR)
+//the function returns SOSCL_OK only if all the signatures are valid
+//the costs shared between the signatures are:
+//-the s^-1 mod n inversions, done with one single inversion (Montgomery's trick)
+//-the G multiples of the precomputed table
+//the soscl stack shall be large enough for 4*count numbers, in addition to the single verification needs
+int soscl_ecdsa_verify_batch(soscl_type_ecdsa_verify_item *items,int count,int *results,int(*soscl_hash)(uint8_t*,uint8_t*,int),soscl_type_curve *curve_params,int configuration)
+{
+  int ret,i,valid;
+  word_type *work,*r,*w,*u1,*u2,*e,*xq,*yq,*x1,*y1,*z1;
+  soscl_type_ecc_word_jacobian_point ipjq[SOSCL_ECDSA_ARRAY_SIZE];
+  soscl_type_ecc_word_affine_point point;
+  soscl_type_ecc_word_jacobian_point pointj;
+  word_type curve_wsize,curve_bsize;
+  if(NULL==items || NULL==curve_params || count<=0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==results)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  curve_bsize=curve_params->curve_bsize;
+  //per signature: r, w (s), u1 (e, then u1), u2 (s^-1, then u2)
+  if (soscl_stack_alloc(&work, (4*count+6+SOSCL_ECDSA_ARRAY_SIZE*3)*(int)curve_wsize) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  r=work;
+  w=r+count*curve_wsize;
+  u1=w+count*curve_wsize;
+  u2=u1+count*curve_wsize;
+  e=u2+count*curve_wsize;
+  xq=e+curve_wsize;
+  yq=xq+curve_wsize;
+  x1=yq+curve_wsize;
+  y1=x1+curve_wsize;
+  z1=y1+curve_wsize;
+  //1. range checks and digests
+  for(valid=0,i=0;i<count;i++)
+    {
+      results[i]=SOSCL_ERROR;
+      soscl_bignum_b2w(r+i*curve_wsize,curve_wsize,items[i].signature.r,curve_bsize);
+      soscl_bignum_b2w(w+i*curve_wsize,curve_wsize,items[i].signature.s,curve_bsize);
+      if(NULL==items[i].input || (soscl_bignum_memcmp(r+i*curve_wsize,curve_params->n,curve_wsize)>=0)||(soscl_bignum_memcmp(w+i*curve_wsize,curve_params->n,curve_wsize)>=0)||(SOSCL_OK==soscl_bignum_cmp_with_zero(r+i*curve_wsize,curve_wsize))||(SOSCL_OK==soscl_bignum_cmp_with_zero(w+i*curve_wsize,curve_wsize))||(SOSCL_OK!=soscl_ecdsa_digest(u1+i*curve_wsize,soscl_hash,items[i].input,items[i].inputlength,curve_params,configuration)))
+	{
+	  //the item is rejected, but s=1 keeps the batch inversion valid
+	  soscl_bignum_set_one_word(w+i*curve_wsize,1,curve_wsize);
+	  soscl_bignum_set_zero(u1+i*curve_wsize,curve_wsize);
+	  continue;
+	}
+      results[i]=SOSCL_OK;
+      valid++;
+    }
+  if(0==valid)
+    {
+      ret=SOSCL_ERROR;
+      goto soscl_label_ecdsa_verify_batch_end;
+    }
+  //2. all the s^-1 mod n with one single inversion
+  ret=soscl_bignum_modinv_batch(u2,w,count,curve_params->n,curve_wsize);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecdsa_verify_batch_end;
+  //3. the G part of the table is shared
+  soscl_ecdsa_table_init(ipjq,z1+curve_wsize,curve_params);
+  pointj.x=x1;
+  pointj.y=y1;
+  pointj.z=z1;
+  point.x=xq;
+  point.y=yq;
+  //4. (x1:y1:z1)=u1.G+u2.Q for every valid item
+  for(i=0;i<count;i++)
+    {
+      if(SOSCL_OK!=results[i])
+	continue;
+      //u1=e*s^-1 mod n, u2=r*s^-1 mod n
+      soscl_bignum_memcpy(e,u1+i*curve_wsize,curve_wsize);
+      soscl_bignum_modmult(u1+i*curve_wsize,e,u2+i*curve_wsize,curve_params->n,curve_wsize);
+      soscl_bignum_modmult(u2+i*curve_wsize,r+i*curve_wsize,u2+i*curve_wsize,curve_params->n,curve_wsize);
+      soscl_bignum_b2w(xq,curve_wsize,items[i].q.x,curve_bsize);
+      soscl_bignum_b2w(yq,curve_wsize,items[i].q.y,curve_bsize);
+      soscl_ecdsa_double_mult(pointj,u1+i*curve_wsize,u2+i*curve_wsize,point,ipjq,curve_params);
+      //5. x1 mod n==r, checked in jacobian coordinates
+      if(SOSCL_OK!=soscl_ecdsa_jacobian_check_r(r+i*curve_wsize,pointj,curve_params))
+	results[i]=SOSCL_ERROR;
+    }
+  for(ret=SOSCL_OK,i=0;i<count;i++)
+    if(SOSCL_OK!=results[i])
+      ret=SOSCL_ERROR;
+ soscl_label_ecdsa_verify_batch_end:
+  if (soscl_stack_free(&work) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//signs count messages with the same private key secret_d
+//the costs shared between the signatures are:
+//-the k.G normalisations, done with one single field inversion (Montgomery's trick)
+//-the k^-1 mod n inversions, done with one single inversion
+//an item with a null r or s gets another nonce in the next pass (the next RFC 6979 candidate, for the deterministic nonce)
+//the soscl stack shall be large enough for 7*count+4 numbers, in addition to the k.G needs
+int soscl_ecdsa_sign_batch(soscl_type_ecdsa_sign_item *items,int count,uint8_t *secret_d,int(*soscl_hash)(uint8_t*,uint8_t*,int),soscl_type_curve *curve_params,int configuration)
+{
+  int ret,i,j,pass,pending,hash,nonce_type;
+  word_type *work,*e,*k,*kinv,*x1,*z1,*zinv,*done,*y1,*d,*t,*s;
+  soscl_type_ecc_word_jacobian_point pointj;
+  soscl_type_ecc_word_affine_point g;
+  soscl_type_ecdsa_rfc6979 drbg;
+  word_type curve_wsize,curve_bsize;
+  if(NULL==items || NULL==secret_d || NULL==curve_params || count<=0)
+    return(SOSCL_INVALID_INPUT);
+  for(i=0;i<count;i++)
+    {
+      if(NULL==items[i].input)
+	return(SOSCL_INVALID_INPUT);
+      if(NULL==items[i].signature.r || NULL==items[i].signature.s)
+	return(SOSCL_INVALID_OUTPUT);
+    }
+  curve_wsize=curve_params->curve_wsize;
+  curve_bsize=curve_params->curve_bsize;
+  hash=(configuration>>SOSCL_HASH_SHIFT)&SOSCL_HASH_MASK;
+  nonce_type=(configuration>>SOSCL_NONCE_SHIFT)&SOSCL_NONCE_MASK;
+  //per signature: e, k, k^-1, x1 (then r), z1, z1^-1, done flag
+  if (soscl_stack_alloc(&work,(7*count+4)*(int)curve_wsize) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  e=work;
+  k=e+count*curve_wsize;
+  kinv=k+count*curve_wsize;
+  x1=kinv+count*curve_wsize;
+  z1=x1+count*curve_wsize;
+  zinv=z1+count*curve_wsize;
+  done=zinv+count*curve_wsize;
+  y1=done+count*curve_wsize;
+  d=y1+curve_wsize;
+  t=d+curve_wsize;
+  s=t+curve_wsize;
+  soscl_memset(&drbg,0,sizeof(drbg));
+  soscl_bignum_set_zero(done,count*curve_wsize);
+  soscl_bignum_b2w(d,curve_wsize,secret_d,curve_bsize);
+  //1. e=hash(m), truncated
+  for(i=0;i<count;i++)
+    {
+      ret=soscl_ecdsa_digest(e+i*curve_wsize,soscl_hash,items[i].input,items[i].inputlength,curve_params,configuration);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_ecdsa_sign_batch_end;
+    }
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  pointj.y=y1;
+  for(pending=count,pass=0;pending>0;pass++)
+    {
+      //2. k in [1,n-1] and (x1:y1:z1)=k.G, with no inversion
+      for(i=0;i<count;i++)
+	{
+	  if(0!=done[i])
+	    continue;
+	  if(SOSCL_DETERMINISTIC_NONCE==nonce_type)
+	    {
+	      //the drbg is restarted, and the candidates rejected in the previous passes are skipped
+	      ret=soscl_ecdsa_rfc6979_init(&drbg,d,e+i*curve_wsize,hash,curve_params);
+	      for(j=0;j<=pass && SOSCL_OK==ret;j++)
+		ret=soscl_ecdsa_rfc6979_nonce(k+i*curve_wsize,&drbg,curve_params);
+	    }
+	  else
+	    ret=soscl_ecdsa_nonce(k+i*curve_wsize,curve_params);
+	  if(SOSCL_OK!=ret)
+	    goto soscl_label_ecdsa_sign_batch_end;
+	  pointj.x=x1+i*curve_wsize;
+	  pointj.z=z1+i*curve_wsize;
+	  ret=soscl_ecc_mult_coz_jacobian(pointj,k+i*curve_wsize,curve_wsize,g,curve_params);
+	  if(SOSCL_OK!=ret)
+	    goto soscl_label_ecdsa_sign_batch_end;
+	}
+      //3. all the z1^-1 with one single field inversion, all the k^-1 mod n with one single inversion
+      ret=soscl_ecc_modinv_batch(zinv,z1,count,curve_params);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_ecdsa_sign_batch_end;
+      ret=soscl_bignum_modinv_batch(kinv,k,count,curve_params->n,curve_wsize);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_ecdsa_sign_batch_end;
+      for(i=0;i<count;i++)
+	{
+	  if(0!=done[i])
+	    continue;
+	  //4. r=x1 mod n, with x1=X/Z^2
+	  soscl_ecc_modsquare(t,zinv+i*curve_wsize,curve_params);
+	  soscl_ecc_modmult(t,t,x1+i*curve_wsize,curve_params);
+	  soscl_ecc_from_domain(t,t,curve_params);
+	  soscl_bignum_mod(x1+i*curve_wsize,t,curve_wsize,curve_params->n,curve_wsize);
+	  if(SOSCL_OK==soscl_bignum_cmp_with_zero(x1+i*curve_wsize,curve_wsize))
+	    continue;
+	  //5. s=k^-1.(e+r.d)
+	  soscl_bignum_modmult(t,x1+i*curve_wsize,d,curve_params->n,curve_wsize);
+	  soscl_bignum_modadd(t,t,e+i*curve_wsize,curve_params->n,curve_wsize);
+	  soscl_bignum_modmult(s,kinv+i*curve_wsize,t,curve_params->n,curve_wsize);
+	  if(SOSCL_OK==soscl_bignum_cmp_with_zero(s,curve_wsize))
+	    continue;
+	  soscl_bignum_w2b(items[i].signature.r,curve_bsize,x1+i*curve_wsize,curve_wsize);
+	  soscl_bignum_w2b(items[i].signature.s,curve_bsize,s,curve_wsize);
+	  //k is wiped, k=1 and z1=1 keep the next passes batch inversions valid
+	  soscl_bignum_set_one_word(k+i*curve_wsize,1,curve_wsize);
+	  soscl_ecc_field_one(z1+i*curve_wsize,curve_params);
+	  done[i]=1;
+	  pending--;
+	}
+    }
+  ret=SOSCL_OK;
+ soscl_label_ecdsa_sign_batch_end:
+  //the nonces and the secret key shall not remain on the stack
+  soscl_bignum_set_zero(work,(7*count+4)*(int)curve_wsize);
+  soscl_memset(&drbg,0,sizeof(drbg));
+  if (soscl_stack_free(&work) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//nonce pool: each entry is (r,k^-1), 2*curve_wsize words, stored in a ring buffer
+//an entry is consumed by exactly one signature and wiped right after
+#define SOSCL_ECDSA_POOL_ENTRY(pool,index) ((pool)->entries+((index)%(pool)->capacity)*2*(pool)->curve_params->curve_wsize)
+
+//storage is provided by the caller: capacity*SOSCL_ECDSA_NONCE_POOL_ENTRY_WSIZE(curve) words
+int soscl_ecdsa_nonce_pool_init(soscl_type_ecdsa_nonce_pool *pool,word_type *storage,int capacity,soscl_type_curve *curve_params)
+{
+  if(NULL==pool || NULL==storage || NULL==curve_params || capacity<=0)
+    return(SOSCL_INVALID_INPUT);
+  pool->entries=storage;
+  pool->capacity=capacity;
+  pool->curve_params=curve_params;
+  pool->head=0;
+  pool->count=0;
+  pool->low_water=0;
+  pool->generated=0;
+  pool->consumed=0;
+  soscl_bignum_set_zero(storage,capacity*2*(int)curve_params->curve_wsize);
+  return(SOSCL_OK);
+}
+
+//precomputes up to nb (r,k^-1) pairs, within the pool free room
+//this is the offline part, only one k.G per entry
+//returns the number of entries added, or an error code
+int soscl_ecdsa_nonce_pool_refill(soscl_type_ecdsa_nonce_pool *pool,int nb)
+{
+  int ret,added;
+  word_type *work,*k,*x1,*y1,*entry;
+  soscl_type_ecc_word_affine_point q;
+  soscl_type_ecc_word_affine_point p;
+  soscl_type_curve *curve_params;
+  word_type curve_wsize;
+  if(NULL==pool || NULL==pool->entries || nb<0)
+    return(SOSCL_INVALID_INPUT);
+  curve_params=pool->curve_params;
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work,(3*curve_wsize)) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  k=work;
+  x1=k+curve_wsize;
+  y1=x1+curve_wsize;
+  q.x=x1;
+  q.y=y1;
+  p.x=curve_params->xg;
+  p.y=curve_params->yg;
+  added=0;
+  while(added<nb && pool->count<pool->capacity)
+    {
+      entry=SOSCL_ECDSA_POOL_ENTRY(pool,pool->head+pool->count);
+      if(SOSCL_OK!=soscl_ecdsa_nonce(k,curve_params))
+	{
+	  ret=SOSCL_ERROR;
+	  goto soscl_label_ecdsa_nonce_pool_refill_end;
+	}
+      //(x1,y1)=k.G
+      if(SOSCL_OK!=soscl_ecc_mult_coz(&q,k,curve_wsize,p,curve_params))
+	{
+	  ret=SOSCL_ERROR;
+	  goto soscl_label_ecdsa_nonce_pool_refill_end;
+	}
+      //r=x1 mod n, a null r is discarded
+      soscl_bignum_mod(entry,x1,curve_wsize,curve_params->n,curve_wsize);
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(entry,curve_wsize))
+	continue;
+      soscl_bignum_modinv(entry+curve_wsize,k,curve_params->n,curve_wsize);
+      pool->count++;
+      pool->generated++;
+      added++;
+    }
+  ret=added;
+ soscl_label_ecdsa_nonce_pool_refill_end:
+  //k shall not remain on the stack
+  soscl_bignum_set_zero(work,3*curve_wsize);
+  if (soscl_stack_free(&work) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//online part of the signature: s=k^-1.(e+r.d) mod n, using the oldest pool entry
+//configuration is the same as for soscl_ecdsa_signature
+int soscl_ecdsa_signature_pool(soscl_type_ecdsa_signature signature,uint8_t *secret_d,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_ecdsa_nonce_pool *pool,int configuration)
+{
+  int ret;
+  word_type *work,*e,*d,*t,*s,*entry;
+  soscl_type_curve *curve_params;
+  word_type curve_wsize,curve_bsize;
+  if(NULL==input || NULL==secret_d || NULL==pool || NULL==pool->entries)
+    return(SOSCL_INVALID_INPUT);
+  curve_params=pool->curve_params;
+  curve_wsize=curve_params->curve_wsize;
+  curve_bsize=curve_params->curve_bsize;
+  if (soscl_stack_alloc(&work,(4*curve_wsize)) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  e=work;
+  d=e+curve_wsize;
+  t=d+curve_wsize;
+  s=t+curve_wsize;
+  ret=soscl_ecdsa_digest(e,soscl_hash,input,inputlength,curve_params,configuration);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecdsa_signature_pool_end;
+  soscl_bignum_b2w(d,curve_wsize,secret_d,curve_bsize);
+  do
+    {
+      if(0==pool->count)
+	{
+	  ret=SOSCL_NONCE_POOL_EMPTY;
+	  goto soscl_label_ecdsa_signature_pool_end;
+	}
+      entry=SOSCL_ECDSA_POOL_ENTRY(pool,pool->head);
+      //t=e+r.d
+      soscl_bignum_modmult(t,entry,d,curve_params->n,curve_wsize);
+      soscl_bignum_modadd(t,t,e,curve_params->n,curve_wsize);
+      //s=k^-1.(e+r.d)
+      soscl_bignum_modmult(s,entry+curve_wsize,t,curve_params->n,curve_wsize);
+      soscl_bignum_w2b(signature.r,curve_bsize,entry,curve_wsize);
+      //the entry is consumed, whatever the result
+      soscl_bignum_set_zero(entry,2*curve_wsize);
+      pool->head=(pool->head+1)%pool->capacity;
+      pool->count--;
+      pool->consumed++;
+      if(pool->count<pool->low_water)
+	pool->low_water=pool->count;
+    }
+  //a null s requires another nonce
+  while(SOSCL_OK==soscl_bignum_cmp_with_zero(s,curve_wsize));
+  soscl_bignum_w2b(signature.s,curve_bsize,s,curve_wsize);
+  ret=SOSCL_OK;
+ soscl_label_ecdsa_signature_pool_end:
+  //the secret key and k^-1 shall not remain on the stack
+  soscl_bignum_set_zero(work,4*curve_wsize);
+  if (soscl_stack_free(&work) != SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//pool monitoring: the low water mark is the lowest number of available entries since the previous call
+//generated and consumed are cumulative, so the caller derives the refill rate from two calls
+int soscl_ecdsa_nonce_pool_stats(soscl_type_ecdsa_nonce_pool *pool,soscl_type_ecdsa_nonce_pool_stats *stats)
+{
+  if(NULL==pool || NULL==stats)
+    return(SOSCL_INVALID_INPUT);
+  stats->available=pool->count;
+  stats->capacity=pool->capacity;
+  stats->low_water=pool->low_water;
+  stats->generated=pool->generated;
+  stats->consumed=pool->consumed;
+  //a new observation window starts
+  pool->low_water=pool->count;
+  return(SOSCL_OK);
+}
+
+//drops all the remaining entries
+int soscl_ecdsa_nonce_pool_wipe(soscl_type_ecdsa_nonce_pool *pool)
+{
+  if(NULL==pool || NULL==pool->entries)
+    return(SOSCL_INVALID_INPUT);
+  soscl_bignum_set_zero(pool->entries,pool->capacity*2*(int)pool->curve_params->curve_wsize);
+  pool->head=0;
+  pool->count=0;
+  pool->low_water=0;
+  return(SOSCL_OK);
+}
+
+//incremental signature and verification
+//the message is only seen through the running hash, the final calls processing the digest as a SOSCL_HASH_INPUT_TYPE input
+static int soscl_ecdsa_stream_init(soscl_type_ecdsa_stream *ctx,soscl_type_curve *curve_params,int configuration)
+{
+  if(NULL==ctx || NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  ctx->algo=(configuration>>SOSCL_HASH_SHIFT)&SOSCL_HASH_MASK;
+  ctx->curve_params=curve_params;
+  //the input type is overwritten: the digest is computed here
+  ctx->configuration=(configuration&~(SOSCL_INPUT_MASK<<SOSCL_INPUT_SHIFT))^(SOSCL_HASH_INPUT_TYPE<<SOSCL_INPUT_SHIFT);
+  switch(ctx->algo)
+    {
+    case SOSCL_SHA256_ID:
+      return(soscl_sha256_init(&ctx->hash.ctx256));
+    case SOSCL_SHA384_ID:
+      return(soscl_sha384_init(&ctx->hash.ctx512));
+    case SOSCL_SHA512_ID:
+      return(soscl_sha512_init(&ctx->hash.ctx512));
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+static int soscl_ecdsa_stream_update(soscl_type_ecdsa_stream *ctx,uint8_t *data,int data_byte_len)
+{
+  if(NULL==ctx || (NULL==data && 0!=data_byte_len) || data_byte_len<0)
+    return(SOSCL_INVALID_INPUT);
+  switch(ctx->algo)
+    {
+    case SOSCL_SHA256_ID:
+      return(soscl_sha256_core(&ctx->hash.ctx256,data,data_byte_len));
+    case SOSCL_SHA384_ID:
+      return(soscl_sha384_core(&ctx->hash.ctx512,data,data_byte_len));
+    case SOSCL_SHA512_ID:
+      return(soscl_sha512_core(&ctx->hash.ctx512,data,data_byte_len));
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+//the hash state is wiped once the digest is extracted, so a context cannot be finalized twice
+static int soscl_ecdsa_stream_digest(uint8_t *h,soscl_type_ecdsa_stream *ctx)
+{
+  int ret;
+  switch(ctx->algo)
+    {
+    case SOSCL_SHA256_ID:
+      ret=soscl_sha256_finish(h,&ctx->hash.ctx256);
+      break;
+    case SOSCL_SHA384_ID:
+      ret=soscl_sha384_finish(h,&ctx->hash.ctx512);
+      break;
+    case SOSCL_SHA512_ID:
+      ret=soscl_sha512_finish(h,&ctx->hash.ctx512);
+      break;
+    default:
+      ret=SOSCL_INVALID_INPUT;
+    }
+  soscl_memset(&ctx->hash,0,sizeof(ctx->hash));
+  ctx->algo=0;
+  return(ret);
+}
+
+int soscl_ecdsa_sign_init(soscl_type_ecdsa_stream *ctx,soscl_type_curve *curve_params,int configuration)
+{
+  return(soscl_ecdsa_stream_init(ctx,curve_params,configuration));
+}
+
+int soscl_ecdsa_sign_update(soscl_type_ecdsa_stream *ctx,uint8_t *data,int data_byte_len)
+{
+  return(soscl_ecdsa_stream_update(ctx,data,data_byte_len));
+}
+
+int soscl_ecdsa_sign_final(soscl_type_ecdsa_stream *ctx,soscl_type_ecdsa_signature signature,uint8_t *d)
+{
+  uint8_t h[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int hashsize,ret;
+  if(NULL==ctx || NULL==d)
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_SHA256_ID!=ctx->algo && SOSCL_SHA384_ID!=ctx->algo && SOSCL_SHA512_ID!=ctx->algo)
+    return(SOSCL_INVALID_INPUT);
+  hashsize=hash_size[ctx->algo];
+  ret=soscl_ecdsa_stream_digest(h,ctx);
+  if(SOSCL_OK==ret)
+    ret=soscl_ecdsa_signature(signature,d,NULL,h,hashsize,ctx->curve_params,ctx->configuration);
+  soscl_memset(h,0,hashsize);
+  return(ret);
+}
+
+int soscl_ecdsa_verify_init(soscl_type_ecdsa_stream *ctx,soscl_type_curve *curve_params,int configuration)
+{
+  return(soscl_ecdsa_stream_init(ctx,curve_params,configuration));
+}
+
+int soscl_ecdsa_verify_update(soscl_type_ecdsa_stream *ctx,uint8_t *data,int data_byte_len)
+{
+  return(soscl_ecdsa_stream_update(ctx,data,data_byte_len));
+}
+
+int soscl_ecdsa_verify_final(soscl_type_ecdsa_stream *ctx,soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature)
+{
+  uint8_t h[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int hashsize,ret;
+  if(NULL==ctx)
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_SHA256_ID!=ctx->algo && SOSCL_SHA384_ID!=ctx->algo && SOSCL_SHA512_ID!=ctx->algo)
+    return(SOSCL_INVALID_INPUT);
+  hashsize=hash_size[ctx->algo];
+  ret=soscl_ecdsa_stream_digest(h,ctx);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  return(soscl_ecdsa_verification(q,signature,NULL,h,hashsize,ctx->curve_params,ctx->configuration));
+}
@@ -0,0 +1,217 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecdsa_cache.c
+// cache of successful ECDSA verifications (see soscl_ecdsa_cache.h)
+// the lookup only costs the digest and the key hashes, the verification being done on misses only
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_hash.h>
+#include <soscl/soscl_hash_sha256.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecdsa.h>
+#include <soscl/soscl_ecdsa_cache.h>
+
+extern int hash_size[SOSCL_HASH_FUNCTIONS_MAX_NB];
+
+int soscl_ecdsa_cache_init(soscl_type_ecdsa_cache *cache,soscl_type_ecdsa_cache_entry *entries,soscl_type_ecdsa_cache_stripe *stripes,int nb_stripes,int ways,void (*lock)(void*,int),void (*unlock)(void*,int),void *lock_arg)
+{
+  if(NULL==cache || NULL==entries || NULL==stripes || nb_stripes<1 || ways<1)
+    return(SOSCL_INVALID_INPUT);
+  //both or none
+  if((NULL==lock)!=(NULL==unlock))
+    return(SOSCL_INVALID_INPUT);
+  cache->entries=entries;
+  cache->stripes=stripes;
+  cache->nb_stripes=nb_stripes;
+  cache->ways=ways;
+  cache->lock=lock;
+  cache->unlock=unlock;
+  cache->lock_arg=lock_arg;
+  soscl_memset(entries,0,nb_stripes*ways*(int)sizeof(soscl_type_ecdsa_cache_entry));
+  soscl_memset(stripes,0,nb_stripes*(int)sizeof(soscl_type_ecdsa_cache_stripe));
+  return(SOSCL_OK);
+}
+
+static void soscl_ecdsa_cache_lock(soscl_type_ecdsa_cache *cache,int stripe)
+{
+  if(NULL!=cache->lock)
+    cache->lock(cache->lock_arg,stripe);
+}
+
+static void soscl_ecdsa_cache_unlock(soscl_type_ecdsa_cache *cache,int stripe)
+{
+  if(NULL!=cache->unlock)
+    cache->unlock(cache->lock_arg,stripe);
+}
+
+//key=SHA-256(curve || input type || digest || qx || qy || r || s)
+//the input type is part of the key, because the FIPS one accepts digests the other ones reject
+static void soscl_ecdsa_cache_key(uint8_t *key,soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature,uint8_t *h,int hashsize,soscl_type_curve *curve_params,int input_type)
+{
+  soscl_sha256_ctx_t ctx;
+  uint8_t header[2];
+  int curve_bsize;
+  curve_bsize=curve_params->curve_bsize;
+  header[0]=(uint8_t)curve_params->curve;
+  header[1]=(uint8_t)input_type;
+  soscl_sha256_init(&ctx);
+  soscl_sha256_core(&ctx,header,2);
+  soscl_sha256_core(&ctx,h,hashsize);
+  soscl_sha256_core(&ctx,q.x,curve_bsize);
+  soscl_sha256_core(&ctx,q.y,curve_bsize);
+  soscl_sha256_core(&ctx,signature.r,curve_bsize);
+  soscl_sha256_core(&ctx,signature.s,curve_bsize);
+  soscl_sha256_finish(key,&ctx);
+}
+
+//the stripe is given by the first key bytes, the key being a hash digest
+static int soscl_ecdsa_cache_stripe_index(soscl_type_ecdsa_cache *cache,uint8_t *key)
+{
+  uint32_t v;
+  v=((uint32_t)key[0]<<24)^((uint32_t)key[1]<<16)^((uint32_t)key[2]<<8)^(uint32_t)key[3];
+  return((int)(v%(uint32_t)cache->nb_stripes));
+}
+
+//returns SOSCL_OK if the key is present, and marks it as the most recently used
+static int soscl_ecdsa_cache_lookup(soscl_type_ecdsa_cache *cache,uint8_t *key,int stripe)
+{
+  soscl_type_ecdsa_cache_entry *set;
+  soscl_type_ecdsa_cache_stripe *st;
+  int i,ret;
+  set=cache->entries+stripe*cache->ways;
+  st=cache->stripes+stripe;
+  ret=SOSCL_ERROR;
+  soscl_ecdsa_cache_lock(cache,stripe);
+  for(i=0;i<cache->ways;i++)
+    if(0!=set[i].last_use && 0==soscl_memcmp(set[i].key,key,SOSCL_ECDSA_CACHE_KEY_BYTESIZE))
+      {
+	set[i].last_use=++st->tick;
+	ret=SOSCL_OK;
+	break;
+      }
+  if(SOSCL_OK==ret)
+    st->hits++;
+  else
+    st->misses++;
+  soscl_ecdsa_cache_unlock(cache,stripe);
+  return(ret);
+}
+
+//stores the key in an empty entry, or in place of the least recently used one
+static void soscl_ecdsa_cache_insert(soscl_type_ecdsa_cache *cache,uint8_t *key,int stripe)
+{
+  soscl_type_ecdsa_cache_entry *set;
+  soscl_type_ecdsa_cache_stripe *st;
+  int i,victim;
+  set=cache->entries+stripe*cache->ways;
+  st=cache->stripes+stripe;
+  soscl_ecdsa_cache_lock(cache,stripe);
+  victim=0;
+  for(i=0;i<cache->ways;i++)
+    {
+      //another thread may have inserted it meanwhile
+      if(0!=set[i].last_use && 0==soscl_memcmp(set[i].key,key,SOSCL_ECDSA_CACHE_KEY_BYTESIZE))
+	{
+	  victim=i;
+	  break;
+	}
+      if(set[i].last_use<set[victim].last_use)
+	victim=i;
+    }
+  soscl_memcpy(set[victim].key,key,SOSCL_ECDSA_CACHE_KEY_BYTESIZE);
+  set[victim].last_use=++st->tick;
+  soscl_ecdsa_cache_unlock(cache,stripe);
+}
+
+//same interface as soscl_ecdsa_verification, plus the cache
+//the digest is computed once, and given to the verification as an already hashed input on a miss
+int soscl_ecdsa_verification_cached(soscl_type_ecdsa_cache *cache,soscl_type_ecc_uint8_t_affine_point q,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,soscl_type_curve *curve_params,int configuration)
+{
+  uint8_t h[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t key[SOSCL_ECDSA_CACHE_KEY_BYTESIZE];
+  uint8_t *digest;
+  int hash,input_type,hashsize,stripe,ret;
+  if(NULL==cache || NULL==input || NULL==curve_params || NULL==q.x || NULL==q.y || NULL==signature.r || NULL==signature.s)
+    return(SOSCL_INVALID_INPUT);
+  hash=(configuration>>SOSCL_HASH_SHIFT)&SOSCL_HASH_MASK;
+  input_type=(configuration>>SOSCL_INPUT_SHIFT)&SOSCL_INPUT_MASK;
+  if(SOSCL_MSG_INPUT_TYPE==input_type)
+    {
+      if(NULL==soscl_hash || hash<=0 || hash>=SOSCL_HASH_FUNCTIONS_MAX_NB)
+	return(SOSCL_INVALID_INPUT);
+      hashsize=hash_size[hash];
+      ret=soscl_hash(h,input,inputlength);
+      if(SOSCL_OK!=ret)
+	return(ret);
+      digest=h;
+      input_type=SOSCL_HASH_INPUT_TYPE;
+      configuration=(configuration&~(SOSCL_INPUT_MASK<<SOSCL_INPUT_SHIFT))^(SOSCL_HASH_INPUT_TYPE<<SOSCL_INPUT_SHIFT);
+    }
+  else
+    {
+      if(inputlength<0 || inputlength>SOSCL_HASH_BYTE_DIGEST_MAXSIZE)
+	return(SOSCL_INVALID_INPUT);
+      hashsize=inputlength;
+      digest=input;
+    }
+  soscl_ecdsa_cache_key(key,q,signature,digest,hashsize,curve_params,input_type);
+  stripe=soscl_ecdsa_cache_stripe_index(cache,key);
+  if(SOSCL_OK==soscl_ecdsa_cache_lookup(cache,key,stripe))
+    return(SOSCL_OK);
+  ret=soscl_ecdsa_verification(q,signature,soscl_hash,digest,hashsize,curve_params,configuration);
+  if(SOSCL_OK==ret)
+    soscl_ecdsa_cache_insert(cache,key,stripe);
+  return(ret);
+}
+
+//the counters are not reset
+int soscl_ecdsa_cache_stats(soscl_type_ecdsa_cache *cache,soscl_type_ecdsa_cache_stats *stats)
+{
+  int i,j;
+  if(NULL==cache || NULL==cache->entries)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==stats)
+    return(SOSCL_INVALID_OUTPUT);
+  stats->hits=0;
+  stats->misses=0;
+  stats->used=0;
+  stats->capacity=cache->nb_stripes*cache->ways;
+  for(i=0;i<cache->nb_stripes;i++)
+    {
+      soscl_ecdsa_cache_lock(cache,i);
+      stats->hits+=cache->stripes[i].hits;
+      stats->misses+=cache->stripes[i].misses;
+      for(j=0;j<cache->ways;j++)
+	if(0!=cache->entries[i*cache->ways+j].last_use)
+	  stats->used++;
+      soscl_ecdsa_cache_unlock(cache,i);
+    }
+  return(SOSCL_OK);
+}
+
+//drops all the entries, e.g. when a key is revoked
+int soscl_ecdsa_cache_flush(soscl_type_ecdsa_cache *cache)
+{
+  int i;
+  if(NULL==cache || NULL==cache->entries)
+    return(SOSCL_INVALID_INPUT);
+  for(i=0;i<cache->nb_stripes;i++)
+    {
+      soscl_ecdsa_cache_lock(cache,i);
+      soscl_memset(cache->entries+i*cache->ways,0,cache->ways*(int)sizeof(soscl_type_ecdsa_cache_entry));
+      soscl_ecdsa_cache_unlock(cache,i);
+    }
+  return(SOSCL_OK);
+}
@@ -0,0 +1,339 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecdsa_keystore.c
+// builds and opens the ECDSA public key store (see soscl_ecdsa_keystore.h for the format)
+// the verifications read the precomputed tables from the image, without copying them
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_hash_sha256.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_keygeneration.h>
+#include <soscl/soscl_ecdsa.h>
+#include <soscl/soscl_ecdsa_keystore.h>
+#ifdef SOSCL_ECDSA_KEYSTORE_MMAP
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif//SOSCL_ECDSA_KEYSTORE_MMAP
+
+//numbers per entry: qx,qy and the Q part of the table
+#define SOSCL_ECDSA_KEYSTORE_ENTRY_NUMBERS (2+2*SOSCL_ECDSA_KEYSTORE_Q_POINTS)
+//the image sizes are int
+#define SOSCL_ECDSA_KEYSTORE_MAX_SIZE 0x7fffffff
+
+//table[1..15] pointing to the G part and to the entry Q part
+static void soscl_ecdsa_keystore_table(soscl_type_ecc_word_affine_point *table,word_type *g_table,word_type *entry,int curve_wsize)
+{
+  int i;
+  for(i=1;i<=SOSCL_ECDSA_KEYSTORE_G_POINTS;i++)
+    {
+      table[i].x=g_table+2*(i-1)*curve_wsize;
+      table[i].y=table[i].x+curve_wsize;
+    }
+  for(;i<SOSCL_ECDSA_ARRAY_SIZE;i++)
+    {
+      table[i].x=entry+2*(i-SOSCL_ECDSA_KEYSTORE_G_POINTS)*curve_wsize;
+      table[i].y=table[i].x+curve_wsize;
+    }
+}
+
+//orders two entries (or a qx,qy pair) by qx then qy
+static int soscl_ecdsa_keystore_compare(const word_type *a,const word_type *b,int curve_wsize)
+{
+  int ret;
+  ret=soscl_bignum_memcmp((word_type*)a,(word_type*)b,curve_wsize);
+  if(0==ret)
+    ret=soscl_bignum_memcmp((word_type*)a+curve_wsize,(word_type*)b+curve_wsize,curve_wsize);
+  return(ret);
+}
+
+static void soscl_ecdsa_keystore_swap(word_type *a,word_type *b,int entry_wsize)
+{
+  word_type t;
+  int i;
+  for(i=0;i<entry_wsize;i++)
+    {
+      t=a[i];
+      a[i]=b[i];
+      b[i]=t;
+    }
+}
+
+static void soscl_ecdsa_keystore_sift(word_type *entries,int root,int end,int curve_wsize,int entry_wsize)
+{
+  int child;
+  while((child=2*root+1)<end)
+    {
+      if(child+1<end && soscl_ecdsa_keystore_compare(entries+child*entry_wsize,entries+(child+1)*entry_wsize,curve_wsize)<0)
+	child++;
+      if(soscl_ecdsa_keystore_compare(entries+root*entry_wsize,entries+child*entry_wsize,curve_wsize)>=0)
+	return;
+      soscl_ecdsa_keystore_swap(entries+root*entry_wsize,entries+child*entry_wsize,entry_wsize);
+      root=child;
+    }
+}
+
+//in place heap sort of the entries, so that soscl_ecdsa_keystore_find is a binary search
+static void soscl_ecdsa_keystore_sort(word_type *entries,int count,int curve_wsize,int entry_wsize)
+{
+  int i;
+  for(i=count/2-1;i>=0;i--)
+    soscl_ecdsa_keystore_sift(entries,i,count,curve_wsize,entry_wsize);
+  for(i=count-1;i>0;i--)
+    {
+      soscl_ecdsa_keystore_swap(entries,entries+i*entry_wsize,entry_wsize);
+      soscl_ecdsa_keystore_sift(entries,0,i,curve_wsize,entry_wsize);
+    }
+}
+
+//image size in bytes for count keys, SOSCL_INVALID_INPUT when it does not fit in an int
+int soscl_ecdsa_keystore_size(int count,soscl_type_curve *curve_params)
+{
+  uint64_t size;
+  if(NULL==curve_params || count<0)
+    return(SOSCL_INVALID_INPUT);
+  size=(2*SOSCL_ECDSA_KEYSTORE_G_POINTS+(uint64_t)count*SOSCL_ECDSA_KEYSTORE_ENTRY_NUMBERS)*(uint64_t)curve_params->curve_wsize*sizeof(word_type);
+  size+=sizeof(soscl_type_ecdsa_keystore_header);
+  if(size>SOSCL_ECDSA_KEYSTORE_MAX_SIZE)
+    return(SOSCL_INVALID_INPUT);
+  return((int)size);
+}
+
+//writes the store of the count keys into image (word aligned, soscl_ecdsa_keystore_size bytes)
+//every key shall be a valid curve point, SOSCL_INVALID_INPUT being returned otherwise
+//the entries are sorted: the index of a key is given by soscl_ecdsa_keystore_find
+int soscl_ecdsa_keystore_build(uint8_t *image,int image_size,soscl_type_ecc_uint8_t_affine_point *keys,int count,soscl_type_curve *curve_params)
+{
+  soscl_type_ecdsa_keystore_header *header;
+  soscl_type_ecc_word_affine_point table[SOSCL_ECDSA_ARRAY_SIZE];
+  word_type *g_table,*entry;
+  int i,ret,curve_wsize,entry_wsize,size;
+  if(NULL==curve_params || (NULL==keys && 0!=count) || count<0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==image || 0!=((uintptr_t)image)%sizeof(word_type))
+    return(SOSCL_INVALID_OUTPUT);
+  size=soscl_ecdsa_keystore_size(count,curve_params);
+  if(size<0)
+    return(size);
+  if(image_size<size)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  entry_wsize=SOSCL_ECDSA_KEYSTORE_ENTRY_NUMBERS*curve_wsize;
+  header=(soscl_type_ecdsa_keystore_header*)image;
+  g_table=(word_type*)(image+sizeof(soscl_type_ecdsa_keystore_header));
+  for(i=0;i<count;i++)
+    {
+      if(SOSCL_OK!=soscl_ecc_point_on_curve(keys[i],curve_params))
+	return(SOSCL_INVALID_INPUT);
+      entry=g_table+2*SOSCL_ECDSA_KEYSTORE_G_POINTS*curve_wsize+i*entry_wsize;
+      soscl_bignum_b2w(entry,curve_wsize,keys[i].x,curve_params->curve_bsize);
+      soscl_bignum_b2w(entry+curve_wsize,curve_wsize,keys[i].y,curve_params->curve_bsize);
+      //the G part is the same for all the keys
+      soscl_ecdsa_keystore_table(table,g_table,entry,curve_wsize);
+      ret=soscl_ecdsa_table_precompute(table,keys[i],curve_params);
+      if(SOSCL_OK!=ret)
+	return(ret);
+    }
+  soscl_ecdsa_keystore_sort(g_table+2*SOSCL_ECDSA_KEYSTORE_G_POINTS*curve_wsize,count,curve_wsize,entry_wsize);
+  //without any key, the G part is unused
+  if(0==count)
+    soscl_memset(g_table,0,2*SOSCL_ECDSA_KEYSTORE_G_POINTS*curve_wsize*sizeof(word_type));
+  soscl_memset(header,0,sizeof(soscl_type_ecdsa_keystore_header));
+  header->magic=SOSCL_ECDSA_KEYSTORE_MAGIC;
+  header->version=SOSCL_ECDSA_KEYSTORE_VERSION;
+  header->word_bits=SOSCL_WORD_BITS;
+  header->endianness=SOSCL_ECDSA_KEYSTORE_ENDIANNESS;
+  header->curve=(uint32_t)curve_params->curve;
+  header->domain=(uint32_t)curve_params->domain;
+  header->curve_wsize=(uint32_t)curve_wsize;
+  header->count=(uint32_t)count;
+  header->table_points=SOSCL_ECDSA_ARRAY_SIZE-1;
+  header->entry_wsize=(uint32_t)entry_wsize;
+  return(soscl_sha256(header->digest,(uint8_t*)g_table,size-(int)sizeof(soscl_type_ecdsa_keystore_header)));
+}
+
+//checks the image tags and digest, then points store into it (image shall remain available while store is used)
+//returns SOSCL_INVALID_INPUT for an image built for another format, architecture or curve, SOSCL_ERROR for a corrupted image
+//the digest does not authenticate the image, which shall come from a trusted source (see soscl_ecdsa_keystore.h)
+int soscl_ecdsa_keystore_open(soscl_type_ecdsa_keystore *store,const uint8_t *image,int image_size,soscl_type_curve *curve_params)
+{
+  const soscl_type_ecdsa_keystore_header *header;
+  uint8_t digest[SOSCL_ECDSA_KEYSTORE_DIGEST_BYTESIZE];
+  int curve_wsize,count,empty_size;
+  uint8_t diff;
+  int i;
+  if(NULL==curve_params || NULL==image || 0!=((uintptr_t)image)%sizeof(word_type))
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==store)
+    return(SOSCL_INVALID_OUTPUT);
+  if(image_size<(int)sizeof(soscl_type_ecdsa_keystore_header))
+    return(SOSCL_INVALID_INPUT);
+  header=(const soscl_type_ecdsa_keystore_header*)image;
+  curve_wsize=curve_params->curve_wsize;
+  if(SOSCL_ECDSA_KEYSTORE_MAGIC!=header->magic || SOSCL_ECDSA_KEYSTORE_VERSION!=header->version)
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_WORD_BITS!=header->word_bits || SOSCL_ECDSA_KEYSTORE_ENDIANNESS!=header->endianness)
+    return(SOSCL_INVALID_INPUT);
+  if((uint32_t)curve_params->curve!=header->curve || (uint32_t)curve_params->domain!=header->domain || (uint32_t)curve_wsize!=header->curve_wsize)
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_ECDSA_ARRAY_SIZE-1!=header->table_points || (uint32_t)(SOSCL_ECDSA_KEYSTORE_ENTRY_NUMBERS*curve_wsize)!=header->entry_wsize)
+    return(SOSCL_INVALID_INPUT);
+  //count is bounded by the image size before being used in any size computation
+  empty_size=soscl_ecdsa_keystore_size(0,curve_params);
+  if(image_size<empty_size)
+    return(SOSCL_INVALID_INPUT);
+  if((uint64_t)header->count>(uint64_t)(image_size-empty_size)/((uint64_t)header->entry_wsize*sizeof(word_type)))
+    return(SOSCL_INVALID_INPUT);
+  count=(int)header->count;
+  if(image_size!=soscl_ecdsa_keystore_size(count,curve_params))
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_OK!=soscl_sha256(digest,(uint8_t*)(image+sizeof(soscl_type_ecdsa_keystore_header)),image_size-(int)sizeof(soscl_type_ecdsa_keystore_header)))
+    return(SOSCL_ERROR);
+  for(diff=0,i=0;i<SOSCL_ECDSA_KEYSTORE_DIGEST_BYTESIZE;i++)
+    diff|=digest[i]^header->digest[i];
+  if(0!=diff)
+    return(SOSCL_ERROR);
+  store->header=header;
+  store->g_table=(const word_type*)(image+sizeof(soscl_type_ecdsa_keystore_header));
+  store->entries=store->g_table+2*SOSCL_ECDSA_KEYSTORE_G_POINTS*curve_wsize;
+  store->curve_params=curve_params;
+  store->mapping=NULL;
+  store->mapping_size=0;
+  return(SOSCL_OK);
+}
+
+//returns the index of the public key q in the store, or SOSCL_ERROR if not present
+//binary search, the entries being sorted by soscl_ecdsa_keystore_build
+int soscl_ecdsa_keystore_find(soscl_type_ecdsa_keystore *store,soscl_type_ecc_uint8_t_affine_point q)
+{
+  word_type *work,*xq,*yq;
+  int low,high,middle,cmp,ret,curve_wsize;
+  if(NULL==store || NULL==store->header || NULL==q.x || NULL==q.y)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=store->curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work,2*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  xq=work;
+  yq=xq+curve_wsize;
+  soscl_bignum_b2w(xq,curve_wsize,q.x,store->curve_params->curve_bsize);
+  soscl_bignum_b2w(yq,curve_wsize,q.y,store->curve_params->curve_bsize);
+  ret=SOSCL_ERROR;
+  low=0;
+  high=(int)store->header->count;
+  //xq,yq has the layout of an entry start
+  while(low<high)
+    {
+      middle=low+(high-low)/2;
+      cmp=soscl_ecdsa_keystore_compare(store->entries+middle*store->header->entry_wsize,xq,curve_wsize);
+      if(0==cmp)
+	{
+	  ret=middle;
+	  break;
+	}
+      if(cmp<0)
+	low=middle+1;
+      else
+	high=middle;
+    }
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//soscl_ecdsa_verification with the key index of the store
+int soscl_ecdsa_keystore_verification(soscl_type_ecdsa_keystore *store,int index,soscl_type_ecdsa_signature signature,int(*soscl_hash)(uint8_t*,uint8_t*,int),uint8_t *input,int inputlength,int configuration)
+{
+  soscl_type_ecc_word_affine_point table[SOSCL_ECDSA_ARRAY_SIZE];
+  int curve_wsize;
+  if(NULL==store || NULL==store->header)
+    return(SOSCL_INVALID_INPUT);
+  if(index<0 || index>=(int)store->header->count)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=store->curve_params->curve_wsize;
+  //the table is only read by soscl_ecdsa_verification_table
+  soscl_ecdsa_keystore_table(table,(word_type*)store->g_table,(word_type*)store->entries+index*store->header->entry_wsize,curve_wsize);
+  return(soscl_ecdsa_verification_table(table,signature,soscl_hash,input,inputlength,store->curve_params,configuration));
+}
+
+#ifdef SOSCL_ECDSA_KEYSTORE_MMAP
+int soscl_ecdsa_keystore_save(char *filename,uint8_t *image,int image_size)
+{
+  FILE *f;
+  int ret;
+  if(NULL==filename || NULL==image || image_size<=0)
+    return(SOSCL_INVALID_INPUT);
+  f=fopen(filename,"wb");
+  if(NULL==f)
+    return(SOSCL_ERROR);
+  ret=SOSCL_OK;
+  if((size_t)image_size!=fwrite(image,1,image_size,f))
+    ret=SOSCL_ERROR;
+  if(0!=fclose(f))
+    ret=SOSCL_ERROR;
+  return(ret);
+}
+
+//maps the store file read-only: the pages are shared by all the processes mapping the same file
+int soscl_ecdsa_keystore_map(soscl_type_ecdsa_keystore *store,char *filename,soscl_type_curve *curve_params)
+{
+  struct stat st;
+  void *mapping;
+  int fd,ret;
+  if(NULL==filename || NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==store)
+    return(SOSCL_INVALID_OUTPUT);
+  fd=open(filename,O_RDONLY);
+  if(fd<0)
+    return(SOSCL_ERROR);
+  if(0!=fstat(fd,&st) || st.st_size<(off_t)sizeof(soscl_type_ecdsa_keystore_header) || st.st_size>SOSCL_ECDSA_KEYSTORE_MAX_SIZE)
+    {
+      close(fd);
+      return(SOSCL_INVALID_INPUT);
+    }
+  mapping=mmap(NULL,(size_t)st.st_size,PROT_READ,MAP_SHARED,fd,0);
+  //the mapping remains valid after the file is closed
+  close(fd);
+  if(MAP_FAILED==mapping)
+    return(SOSCL_ERROR);
+  ret=soscl_ecdsa_keystore_open(store,(const uint8_t*)mapping,(int)st.st_size,curve_params);
+  if(SOSCL_OK!=ret)
+    {
+      munmap(mapping,(size_t)st.st_size);
+      return(ret);
+    }
+  store->mapping=mapping;
+  store->mapping_size=(int)st.st_size;
+  return(SOSCL_OK);
+}
+
+int soscl_ecdsa_keystore_unmap(soscl_type_ecdsa_keystore *store)
+{
+  if(NULL==store || NULL==store->mapping)
+    return(SOSCL_INVALID_INPUT);
+  if(0!=munmap(store->mapping,(size_t)store->mapping_size))
+    return(SOSCL_ERROR);
+  store->header=NULL;
+  store->g_table=NULL;
+  store->entries=NULL;
+  store->mapping=NULL;
+  store->mapping_size=0;
+  return(SOSCL_OK);
+}
+#endif//SOSCL_ECDSA_KEYSTORE_MMAP
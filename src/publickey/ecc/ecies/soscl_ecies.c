@@ -0,0 +1,281 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecies.c
+// implements the ECIES encryption scheme (SEC1 v2 5.1) with the X9.63 KDF, the XOR encryption scheme and HMAC
+// the whole pipeline (key agreement, key derivation, encryption and mac) is driven by a single context
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_hash.h>
+#include <soscl/soscl_hash_sha256.h>
+#include <soscl/soscl_hash_sha512.h>
+#include <soscl/soscl_hmac.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_keygeneration.h>
+#include <soscl/soscl_ecc_encoding.h>
+#include <soscl/soscl_ecdh.h>
+#include <soscl/soscl_ecies.h>
+
+extern int hash_size[SOSCL_HASH_FUNCTIONS_MAX_NB];
+
+//X9.63 KDF block: H(Z||counter||SharedInfo1), the counter being 32-bit big endian, starting at 1
+static int soscl_ecies_kdf_block(uint8_t *block,soscl_type_ecies *ctx,uint32_t counter)
+{
+  soscl_type_hmac_hash_ctx hctx;
+  uint8_t c[4];
+  int ret;
+  c[0]=(uint8_t)(counter>>24);
+  c[1]=(uint8_t)(counter>>16);
+  c[2]=(uint8_t)(counter>>8);
+  c[3]=(uint8_t)counter;
+  if(SOSCL_SHA256_ID==ctx->algo)
+    {
+      soscl_sha256_init(&hctx.ctx256);
+      soscl_sha256_core(&hctx.ctx256,ctx->z,ctx->curve_params->curve_bsize);
+      soscl_sha256_core(&hctx.ctx256,c,4);
+      if(0!=ctx->shared_info_length)
+	soscl_sha256_core(&hctx.ctx256,ctx->shared_info,ctx->shared_info_length);
+      ret=soscl_sha256_finish(block,&hctx.ctx256);
+    }
+  else
+    {
+      soscl_sha512_init(&hctx.ctx512);
+      soscl_sha512_core(&hctx.ctx512,ctx->z,ctx->curve_params->curve_bsize);
+      soscl_sha512_core(&hctx.ctx512,c,4);
+      if(0!=ctx->shared_info_length)
+	soscl_sha512_core(&hctx.ctx512,ctx->shared_info,ctx->shared_info_length);
+      ret=soscl_sha512_finish(block,&hctx.ctx512);
+    }
+  soscl_memset(&hctx,0,sizeof(hctx));
+  return(ret);
+}
+
+//common part of the initializations, Z being already computed
+//MK is made of the hash length KDF bytes following EK, so it starts at offset length in the KDF output
+static int soscl_ecies_init(soscl_type_ecies *ctx,int length,uint8_t *shared_info1,int shared_info1_length)
+{
+  uint8_t block[2*SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int hashsize,ret;
+  hashsize=hash_size[ctx->algo];
+  ctx->shared_info=shared_info1;
+  ctx->shared_info_length=shared_info1_length;
+  ctx->length=length;
+  ctx->offset=0;
+  //MK spans at most two KDF blocks
+  ret=soscl_ecies_kdf_block(block,ctx,(uint32_t)(length/hashsize)+1);
+  if(SOSCL_OK==ret && 0!=length%hashsize)
+    ret=soscl_ecies_kdf_block(block+hashsize,ctx,(uint32_t)(length/hashsize)+2);
+  if(SOSCL_OK==ret)
+    ret=soscl_hmac_state_init(&ctx->mac,ctx->algo,block+length%hashsize,hashsize);
+  if(SOSCL_OK==ret)
+    ret=soscl_hmac_state_start(&ctx->mac);
+  soscl_memset(block,0,sizeof(block));
+  return(ret);
+}
+
+static int soscl_ecies_check_init(soscl_type_ecies *ctx,int length,uint8_t *shared_info1,int shared_info1_length,soscl_type_curve *curve_params,int algo)
+{
+  if(NULL==ctx || NULL==curve_params || length<0 || shared_info1_length<0 || (NULL==shared_info1 && 0!=shared_info1_length))
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_SHA256_ID!=algo && SOSCL_SHA512_ID!=algo)
+    return(SOSCL_INVALID_INPUT);
+  ctx->curve_params=curve_params;
+  ctx->algo=algo;
+  return(SOSCL_OK);
+}
+
+//ephemeral is the encoded R, SOSCL_ECIES_EPHEMERAL_BYTESIZE(curve_params) bytes
+//q is the recipient public key, validated by the key agreement
+int soscl_ecies_encrypt_init(soscl_type_ecies *ctx,uint8_t *ephemeral,soscl_type_ecc_uint8_t_affine_point q,int length,uint8_t *shared_info1,int shared_info1_length,soscl_type_curve *curve_params,int algo)
+{
+  uint8_t k[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t xr[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t yr[SOSCL_SECP521R1_BYTESIZE];
+  soscl_type_ecc_uint8_t_affine_point r;
+  int ret;
+  ret=soscl_ecies_check_init(ctx,length,shared_info1,shared_info1_length,curve_params,algo);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  if(NULL==ephemeral)
+    return(SOSCL_INVALID_OUTPUT);
+  ctx->decrypt=SOSCL_FALSE;
+  r.x=xr;
+  r.y=yr;
+  //1. ephemeral key pair
+  ret=soscl_ecc_keygeneration(r,k,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecies_encrypt_init_end;
+  //soscl_ecc_point_decompress does not support p=1 mod 4
+  if(SOSCL_ECIES_EPHEMERAL_COMPRESSED(curve_params))
+    {
+      ret=soscl_ecc_point_compress(ephemeral,r,curve_params);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_ecies_encrypt_init_end;
+    }
+  else
+    {
+      ephemeral[0]=SOSCL_ECC_POINT_UNCOMPRESSED;
+      soscl_memcpy(ephemeral+1,xr,curve_params->curve_bsize);
+      soscl_memcpy(ephemeral+1+curve_params->curve_bsize,yr,curve_params->curve_bsize);
+    }
+  //2. Z=x(k.Q)
+  ret=soscl_ecdh_shared_secret(ctx->z,q,k,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecies_encrypt_init_end;
+  //3. MK, and the mac start
+  ret=soscl_ecies_init(ctx,length,shared_info1,shared_info1_length);
+ soscl_label_ecies_encrypt_init_end:
+  soscl_memset(k,0,sizeof(k));
+  if(SOSCL_OK!=ret)
+    soscl_memset(ctx,0,sizeof(soscl_type_ecies));
+  return(ret);
+}
+
+//d is the recipient secret key, ephemeral is the compressed or uncompressed R
+int soscl_ecies_decrypt_init(soscl_type_ecies *ctx,uint8_t *ephemeral,int ephemeral_length,uint8_t *d,int length,uint8_t *shared_info1,int shared_info1_length,soscl_type_curve *curve_params,int algo)
+{
+  uint8_t xr[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t yr[SOSCL_SECP521R1_BYTESIZE];
+  soscl_type_ecc_uint8_t_affine_point r;
+  int ret;
+  ret=soscl_ecies_check_init(ctx,length,shared_info1,shared_info1_length,curve_params,algo);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  if(NULL==ephemeral || NULL==d)
+    return(SOSCL_INVALID_INPUT);
+  ctx->decrypt=SOSCL_TRUE;
+  r.x=xr;
+  r.y=yr;
+  //an uncompressed R is checked on the curve by the key agreement
+  if(2*curve_params->curve_bsize+1==ephemeral_length && SOSCL_ECC_POINT_UNCOMPRESSED==ephemeral[0])
+    {
+      soscl_memcpy(xr,ephemeral+1,curve_params->curve_bsize);
+      soscl_memcpy(yr,ephemeral+1+curve_params->curve_bsize,curve_params->curve_bsize);
+    }
+  else
+    {
+      ret=soscl_ecc_point_decompress(r,ephemeral,ephemeral_length,curve_params);
+      if(SOSCL_OK!=ret)
+	return(SOSCL_INVALID_INPUT);
+    }
+  ret=soscl_ecdh_shared_secret(ctx->z,r,d,curve_params);
+  if(SOSCL_OK==ret)
+    ret=soscl_ecies_init(ctx,length,shared_info1,shared_info1_length);
+  if(SOSCL_OK!=ret)
+    soscl_memset(ctx,0,sizeof(soscl_type_ecies));
+  return(ret);
+}
+
+//output=input^EK, the mac being computed over the ciphertext, before it is overwritten when decrypting in place
+static int soscl_ecies_update(soscl_type_ecies *ctx,uint8_t *output,uint8_t *input,int input_length)
+{
+  int i,hashsize,index,ret;
+  if(NULL==ctx || input_length<0 || (NULL==input && 0!=input_length))
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==output && 0!=input_length)
+    return(SOSCL_INVALID_OUTPUT);
+  if(input_length>ctx->length-ctx->offset)
+    return(SOSCL_INVALID_LENGTH);
+  hashsize=hash_size[ctx->algo];
+  if(SOSCL_TRUE==ctx->decrypt)
+    {
+      ret=soscl_hmac_state_core(&ctx->mac,input,input_length);
+      if(SOSCL_OK!=ret)
+	return(ret);
+    }
+  for(i=0;i<input_length;i++)
+    {
+      index=ctx->offset%hashsize;
+      //a new EK block is needed
+      if(0==index)
+	{
+	  ret=soscl_ecies_kdf_block(ctx->keystream,ctx,(uint32_t)(ctx->offset/hashsize)+1);
+	  if(SOSCL_OK!=ret)
+	    return(ret);
+	}
+      output[i]=input[i]^ctx->keystream[index];
+      ctx->offset++;
+    }
+  if(SOSCL_FALSE==ctx->decrypt)
+    return(soscl_hmac_state_core(&ctx->mac,output,input_length));
+  return(SOSCL_OK);
+}
+
+int soscl_ecies_encrypt_update(soscl_type_ecies *ctx,uint8_t *output,uint8_t *input,int input_length)
+{
+  if(NULL!=ctx && SOSCL_FALSE!=ctx->decrypt)
+    return(SOSCL_INVALID_MODE);
+  return(soscl_ecies_update(ctx,output,input,input_length));
+}
+
+int soscl_ecies_decrypt_update(soscl_type_ecies *ctx,uint8_t *output,uint8_t *input,int input_length)
+{
+  if(NULL!=ctx && SOSCL_TRUE!=ctx->decrypt)
+    return(SOSCL_INVALID_MODE);
+  return(soscl_ecies_update(ctx,output,input,input_length));
+}
+
+//tag=HMAC(MK,C||SharedInfo2), the context being wiped afterwards
+static int soscl_ecies_tag(uint8_t *tag,soscl_type_ecies *ctx,uint8_t *shared_info2,int shared_info2_length)
+{
+  int ret;
+  if(ctx->offset!=ctx->length)
+    ret=SOSCL_INVALID_LENGTH;
+  else
+    {
+      ret=SOSCL_OK;
+      if(0!=shared_info2_length)
+	ret=soscl_hmac_state_core(&ctx->mac,shared_info2,shared_info2_length);
+      if(SOSCL_OK==ret)
+	ret=soscl_hmac_state_finish(&ctx->mac,tag,hash_size[ctx->algo]);
+    }
+  soscl_memset(ctx,0,sizeof(soscl_type_ecies));
+  return(ret);
+}
+
+//tag is hash length bytes long
+int soscl_ecies_encrypt_final(soscl_type_ecies *ctx,uint8_t *tag,uint8_t *shared_info2,int shared_info2_length)
+{
+  if(NULL==ctx || shared_info2_length<0 || (NULL==shared_info2 && 0!=shared_info2_length))
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_FALSE!=ctx->decrypt || NULL==ctx->curve_params)
+    return(SOSCL_INVALID_MODE);
+  if(NULL==tag)
+    return(SOSCL_INVALID_OUTPUT);
+  return(soscl_ecies_tag(tag,ctx,shared_info2,shared_info2_length));
+}
+
+//returns SOSCL_OK if the tag matches, the comparison being done in constant time
+int soscl_ecies_decrypt_final(soscl_type_ecies *ctx,uint8_t *tag,uint8_t *shared_info2,int shared_info2_length)
+{
+  uint8_t computed[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t diff;
+  int i,hashsize,ret;
+  if(NULL==ctx || NULL==tag || shared_info2_length<0 || (NULL==shared_info2 && 0!=shared_info2_length))
+    return(SOSCL_INVALID_INPUT);
+  if(SOSCL_TRUE!=ctx->decrypt || NULL==ctx->curve_params)
+    return(SOSCL_INVALID_MODE);
+  hashsize=hash_size[ctx->algo];
+  ret=soscl_ecies_tag(computed,ctx,shared_info2,shared_info2_length);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  diff=0;
+  for(i=0;i<hashsize;i++)
+    diff|=computed[i]^tag[i];
+  soscl_memset(computed,0,hashsize);
+  if(0!=diff)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
@@ -0,0 +1,98 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_encoding.c
+// implements the SEC1 v2 (2.3.3 and 2.3.4) compressed encoding of the curve points
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_init.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_encoding.h>
+
+//output=02|x if y is even, 03|x otherwise (curve_bsize+1 bytes)
+int soscl_ecc_point_compress(uint8_t *output,soscl_type_ecc_uint8_t_affine_point q,soscl_type_curve *curve_params)
+{
+  int bsize;
+  if(NULL==curve_params || NULL==q.x || NULL==q.y)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==output)
+    return(SOSCL_INVALID_OUTPUT);
+  bsize=curve_params->curve_bsize;
+  output[0]=SOSCL_ECC_POINT_COMPRESSED_EVEN^(q.y[bsize-1]&1);
+  soscl_memcpy(output+1,q.x,bsize);
+  return(SOSCL_OK);
+}
+
+//q=the point encoded in input (curve_bsize+1 bytes), y being recovered from y^2=x^3+a.x+b
+//returns SOSCL_INVALID_INPUT if the encoding is not a valid curve point
+int soscl_ecc_point_decompress(soscl_type_ecc_uint8_t_affine_point q,uint8_t *input,int input_length,soscl_type_curve *curve_params)
+{
+  word_type *work,*x,*y,*t,*a;
+  int ret;
+  int wsize,bsize;
+  if(NULL==curve_params || NULL==input)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q.x || NULL==q.y)
+    return(SOSCL_INVALID_OUTPUT);
+  bsize=curve_params->curve_bsize;
+  wsize=curve_params->curve_wsize;
+  if(input_length!=bsize+1)
+    return(SOSCL_INVALID_LENGTH);
+  if(SOSCL_ECC_POINT_COMPRESSED_EVEN!=input[0] && SOSCL_ECC_POINT_COMPRESSED_ODD!=input[0])
+    return(SOSCL_INVALID_INPUT);
+  if (soscl_stack_alloc(&work,4*wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  x=work;
+  y=x+wsize;
+  t=y+wsize;
+  a=t+wsize;
+  soscl_bignum_b2w(x,wsize,input+1,bsize);
+  //x shall be in [0,p-1]
+  if(soscl_bignum_memcmp(x,curve_params->p,wsize)>=0)
+    {
+      ret=SOSCL_INVALID_INPUT;
+      goto soscl_label_decompress_end;
+    }
+  //y^2=(x^2+a).x+b, computed in the curve field domain
+  soscl_ecc_to_domain(a,x,curve_params);
+  soscl_ecc_modsquare(y,a,curve_params);
+  soscl_ecc_modadd(y,y,(NULL!=curve_params->a_domain)?curve_params->a_domain:curve_params->a,curve_params);
+  soscl_ecc_modmult(y,y,a,curve_params);
+  soscl_ecc_to_domain(a,curve_params->b,curve_params);
+  soscl_ecc_modadd(y,y,a,curve_params);
+  ret=soscl_ecc_modsqrt(t,y,curve_params);
+  if(SOSCL_ERROR==ret)
+    ret=SOSCL_INVALID_INPUT;
+  if(SOSCL_OK!=ret)
+    goto soscl_label_decompress_end;
+  soscl_ecc_from_domain(t,t,curve_params);
+  //y=p-y if the parity does not match the encoding
+  if((t[0]&1)!=(word_type)(input[0]&1))
+    {
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(t,wsize))
+	{
+	  ret=SOSCL_INVALID_INPUT;
+	  goto soscl_label_decompress_end;
+	}
+      soscl_bignum_sub(t,curve_params->p,t,wsize);
+    }
+  soscl_memcpy(q.x,input+1,bsize);
+  soscl_bignum_w2b(q.y,bsize,t,wsize);
+ soscl_label_decompress_end:
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
@@ -0,0 +1,522 @@
+#!/usr/bin/env python3
+#SiFive Open Source Cryptographic Library
+#soscl_ecc_field_gen.py
+# generates straight-line, branch-free field arithmetic (mult, square, add, sub,
+# reduce, inversion) for secp256r1, secp384r1 and secp521r1, for 32 and 64 bits words
+# usage: python3 soscl_ecc_field_gen.py [output directory]
+# the generated files are checked in, re-run the script after any change
+
+import os
+import random
+import sys
+
+LICENSE = '''//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+'''
+
+#name, bit size, p as a sparse signed sum of powers of 2
+CURVES = [
+  ('p256r1', 256, {256: 1, 224: -1, 192: 1, 96: 1, 0: -1}),
+  ('p384r1', 384, {384: 1, 128: -1, 96: -1, 32: 1, 0: -1}),
+  ('p521r1', 521, {521: 1, 0: -1}),
+]
+
+DIGIT = 32
+
+def value(sparse):
+  return sum(c << e for e, c in sparse.items())
+
+def words(x, w, n):
+  return [(x >> (w * i)) & ((1 << w) - 1) for i in range(n)]
+
+def hexw(x, w):
+  return '0x%0*X' % (w // 4, x)
+
+class Field:
+  def __init__(self, name, bits, sparse):
+    self.name = name
+    self.bits = bits
+    self.sparse = sparse
+    self.p = value(sparse)
+    self.prefix = 'soscl_ecc_%s_gen' % name
+
+  def size(self, w):
+    return (self.bits + w - 1) // w
+
+  #2^bits mod p, as signed 32 bits digits
+  def fold_digits(self):
+    c = {e: -v for e, v in self.sparse.items() if e != self.bits}
+    assert value(c) == (1 << self.bits) - self.p
+    assert all(e % DIGIT == 0 for e in c)
+    return {e // DIGIT: v for e, v in c.items()}
+
+  #signed digits matrix m[j][i]: contribution of the input digit i to the output digit j
+  def fold_matrix(self):
+    n = self.bits // DIGIT
+    fold = self.fold_digits()
+    cols = []
+    for i in range(2 * n):
+      v = {i: 1}
+      while any(k >= n for k in v):
+        k = max(v)
+        coef = v.pop(k)
+        for e, f in fold.items():
+          v[e + k - n] = v.get(e + k - n, 0) + coef * f
+        v = {e: f for e, f in v.items() if f}
+      assert sum(f << (DIGIT * e) for e, f in v.items()) % self.p == (1 << (DIGIT * i)) % self.p
+      cols.append(v)
+    return [[cols[i].get(j, 0) for i in range(2 * n)] for j in range(n)]
+
+class Emitter:
+  def __init__(self):
+    self.lines = []
+
+  def __call__(self, line=''):
+    self.lines.append(line)
+
+  def text(self):
+    return '\n'.join(self.lines) + '\n'
+
+def emit_mul(o, f, w):
+  n = f.size(w)
+  o('static void %s_mul(word_type *r,word_type *a,word_type *b)' % f.prefix)
+  o('{')
+  o('  word_type t[%d];' % (2 * n))
+  o('  double_word_type uv;')
+  for i in range(n):
+    for j in range(n):
+      terms = ['(double_word_type)a[%d]*b[%d]' % (i, j)]
+      if i > 0:
+        terms.append('t[%d]' % (i + j))
+      if j > 0:
+        terms.append('(uv>>%d)' % w)
+      o('  uv=%s;' % '+'.join(terms))
+      o('  t[%d]=(word_type)uv;' % (i + j))
+    o('  t[%d]=(word_type)(uv>>%d);' % (i + n, w))
+  o('  %s_reduce(r,t);' % f.prefix)
+  o('}')
+  o()
+
+def emit_sqr(o, f, w):
+  n = f.size(w)
+  o('static void %s_sqr(word_type *r,word_type *a)' % f.prefix)
+  o('{')
+  o('  word_type t[%d];' % (2 * n))
+  o('  double_word_type uv,acc;')
+  o('  //cross products')
+  for i in range(n - 1):
+    for j in range(i + 1, n):
+      terms = ['(double_word_type)a[%d]*a[%d]' % (i, j)]
+      if i > 0:
+        terms.append('t[%d]' % (i + j))
+      if j > i + 1:
+        terms.append('(uv>>%d)' % w)
+      o('  uv=%s;' % '+'.join(terms))
+      o('  t[%d]=(word_type)uv;' % (i + j))
+    o('  t[%d]=(word_type)(uv>>%d);' % (i + n, w))
+  o('  //doubling')
+  o('  t[%d]=t[%d]>>%d;' % (2 * n - 1, 2 * n - 2, w - 1))
+  for k in range(2 * n - 2, 1, -1):
+    o('  t[%d]=(t[%d]<<1)|(t[%d]>>%d);' % (k, k, k - 1, w - 1))
+  o('  t[1]=t[1]<<1;')
+  o('  t[0]=0;')
+  o('  //squares')
+  for i in range(n):
+    o('  uv=(double_word_type)a[%d]*a[%d];' % (i, i))
+    o('  acc=(double_word_type)t[%d]+(word_type)uv%s;' % (2 * i, '' if i == 0 else '+(acc>>%d)' % w))
+    o('  t[%d]=(word_type)acc;' % (2 * i))
+    o('  acc=(double_word_type)t[%d]+(word_type)(uv>>%d)+(acc>>%d);' % (2 * i + 1, w, w))
+    o('  t[%d]=(word_type)acc;' % (2 * i + 1))
+  o('  %s_reduce(r,t);' % f.prefix)
+  o('}')
+  o()
+
+#r=a+b mod p, a and b<p
+def emit_add(o, f, w):
+  n = f.size(w)
+  p = words(f.p, w, n)
+  o('static void %s_add(word_type *r,word_type *a,word_type *b)' % f.prefix)
+  o('{')
+  o('  word_type s[%d],d[%d],carry,mask;' % (n, n))
+  o('  double_word_type uv;')
+  for i in range(n):
+    o('  uv=(double_word_type)a[%d]+b[%d]%s;' % (i, i, '' if i == 0 else '+(uv>>%d)' % w))
+    o('  s[%d]=(word_type)uv;' % i)
+  o('  carry=(word_type)(uv>>%d);' % w)
+  for i in range(n):
+    o('  uv=(double_word_type)s[%d]%s-%s;' % (i, '' if i == 0 else '-((uv>>%d)&1)' % w, hexw(p[i], w)))
+    o('  d[%d]=(word_type)uv;' % i)
+  o('  //keep a+b when a+b<p')
+  o('  mask=(word_type)0-((word_type)(uv>>%d)&1&(carry^1));' % w)
+  for i in range(n):
+    o('  r[%d]=(s[%d]&mask)|(d[%d]&~mask);' % (i, i, i))
+  o('}')
+  o()
+
+#r=a-b mod p, a and b<p
+def emit_sub(o, f, w):
+  n = f.size(w)
+  p = words(f.p, w, n)
+  o('static void %s_sub(word_type *r,word_type *a,word_type *b)' % f.prefix)
+  o('{')
+  o('  word_type d[%d],mask;' % n)
+  o('  double_word_type uv;')
+  for i in range(n):
+    o('  uv=(double_word_type)a[%d]-b[%d]%s;' % (i, i, '' if i == 0 else '-((uv>>%d)&1)' % w))
+    o('  d[%d]=(word_type)uv;' % i)
+  o('  //add p back on borrow')
+  o('  mask=(word_type)0-((word_type)(uv>>%d)&1);' % w)
+  for i in range(n):
+    o('  uv=(double_word_type)d[%d]+(%s&mask)%s;' % (i, hexw(p[i], w), '' if i == 0 else '+(uv>>%d)' % w))
+    o('  r[%d]=(word_type)uv;' % i)
+  o('}')
+  o()
+
+#interval of the carry after a signed digits accumulation, from the digits coefficients
+def carry_bounds(rows, lo, hi):
+  cmin = cmax = 0
+  for row in rows:
+    amin = cmin + sum(c * (lo if c > 0 else hi) for c in row)
+    amax = cmax + sum(c * (hi if c > 0 else lo) for c in row)
+    assert -(1 << 62) < amin and amax < (1 << 62)
+    cmin, cmax = amin >> DIGIT, amax >> DIGIT
+  return cmin, cmax
+
+def signed_terms(var, coefs):
+  out = []
+  for v, c in coefs:
+    if c == 0:
+      continue
+    if c == 1:
+      out.append('acc+=%s;' % v)
+    elif c == -1:
+      out.append('acc-=%s;' % v)
+    elif c > 0:
+      out.append('acc+=(int64_t)%d*%s;' % (c, v))
+    else:
+      out.append('acc-=(int64_t)%d*%s;' % (-c, v))
+  return out
+
+#Solinas reduction on 32 bits digits with signed accumulators:
+#1-c is folded into d+t.2^bits with the digits matrix
+#2-t.2^bits=t.(2^bits-p) is folded twice, the second carry being in {-1,0,1}
+#3-one final constant time subtraction of p
+def emit_reduce_digits(o, f):
+  n = f.bits // DIGIT
+  m = f.fold_matrix()
+  fold = f.fold_digits()
+  pd = words(f.p, DIGIT, n)
+  tmin, tmax = carry_bounds(m, 0, (1 << DIGIT) - 1)
+  o('//c is %d digits large, r=c mod p' % (2 * n))
+  o('static void %s_reduce_digits(uint32_t *r,uint32_t *c)' % f.prefix)
+  o('{')
+  o('  uint32_t d[%d],e[%d],mask;' % (n, n))
+  o('  int64_t acc,t;')
+  o('  //t in [%d,%d]' % (tmin, tmax))
+  o('  acc=0;')
+  for j in range(n):
+    for line in signed_terms('acc', [('c[%d]' % i, m[j][i]) for i in range(2 * n)]):
+      o('  ' + line)
+    o('  d[%d]=(uint32_t)acc;' % j)
+    o('  acc>>=%d;' % DIGIT)
+  o('  t=acc;')
+  for step in range(2):
+    o('  acc=0;')
+    for j in range(n):
+      o('  acc+=d[%d];' % j)
+      for line in signed_terms('acc', [('t', fold.get(j, 0))]):
+        o('  ' + line)
+      o('  d[%d]=(uint32_t)acc;' % j)
+      o('  acc>>=%d;' % DIGIT)
+    if step == 0:
+      o('  t=acc;')
+  o('  //d<2^%d<2p' % f.bits)
+  o('  acc=0;')
+  for j in range(n):
+    o('  acc+=(int64_t)d[%d]-%s;' % (j, hexw(pd[j], DIGIT)))
+    o('  e[%d]=(uint32_t)acc;' % j)
+    o('  acc>>=%d;' % DIGIT)
+  o('  mask=(uint32_t)acc;')
+  for j in range(n):
+    o('  r[%d]=(d[%d]&mask)|(e[%d]&~mask);' % (j, j, j))
+  o('}')
+  o()
+
+def emit_reduce_solinas(o, f, w):
+  n = f.size(w)
+  emit_reduce_digits(o, f)
+  o('static void %s_reduce(word_type *r,word_type *c)' % f.prefix)
+  o('{')
+  if w == DIGIT:
+    o('  %s_reduce_digits(r,c);' % f.prefix)
+  else:
+    o('  uint32_t cd[%d],rd[%d];' % (4 * n, 2 * n))
+    for i in range(2 * n):
+      o('  cd[%d]=(uint32_t)c[%d];' % (2 * i, i))
+      o('  cd[%d]=(uint32_t)(c[%d]>>32);' % (2 * i + 1, i))
+    o('  %s_reduce_digits(rd,cd);' % f.prefix)
+    for i in range(n):
+      o('  r[%d]=(word_type)rd[%d]|((word_type)rd[%d]<<32);' % (i, 2 * i, 2 * i + 1))
+  o('}')
+  o()
+
+#p=2^bits-1: c=(c mod 2^bits)+(c>>bits) until c<2^bits+2, then one constant time subtraction
+def emit_reduce_mersenne(o, f, w):
+  n = f.size(w)
+  q, s = divmod(f.bits, w)
+  low_mask = (1 << s) - 1
+  o('static void %s_reduce(word_type *r,word_type *c)' % f.prefix)
+  o('{')
+  o('  word_type t[%d],e[%d],mask;' % (2 * n, n))
+  o('  double_word_type uv;')
+  src, size, bound = 'c', 2 * n, 1 << (2 * n * w)
+  while True:
+    hbound = (bound - 1) >> f.bits
+    hwords = (hbound.bit_length() + w - 1) // w
+    bound = (1 << f.bits) + hbound
+    out_words = ((bound - 1).bit_length() + w - 1) // w
+    o('  //%s=(%s mod 2^%d)+(%s>>%d), t<2^%d+2^%d' % ('t', src, f.bits, src, f.bits, f.bits, hbound.bit_length()))
+    for i in range(out_words):
+      terms = []
+      if i < q:
+        terms.append('(double_word_type)%s[%d]' % (src, i))
+      elif i == q:
+        terms.append('(double_word_type)(%s[%d]&%s)' % (src, i, hexw(low_mask, w)))
+      if i < hwords:
+        hi = '(%s[%d]>>%d)' % (src, q + i, s)
+        if q + i + 1 < size:
+          hi = '(%s|(%s[%d]<<%d))' % (hi, src, q + i + 1, w - s)
+        terms.append(hi)
+      if i > 0:
+        terms.append('(uv>>%d)' % w)
+      if not terms:
+        break
+      if not terms[0].startswith('(double_word_type)'):
+        terms[0] = '(double_word_type)' + terms[0]
+      o('  uv=%s;' % '+'.join(terms))
+      o('  t[%d]=(word_type)uv;' % i)
+    src, size = 't', out_words
+    if hbound <= 1:
+      break
+  o('  //t<2^%d+2<2p' % f.bits)
+  pw = words(f.p, w, n)
+  for i in range(n):
+    o('  uv=(double_word_type)t[%d]%s-%s;' % (i, '' if i == 0 else '-((uv>>%d)&1)' % w, hexw(pw[i], w)))
+    o('  e[%d]=(word_type)uv;' % i)
+  o('  mask=(word_type)0-((word_type)(uv>>%d)&1);' % w)
+  for i in range(n):
+    o('  r[%d]=(t[%d]&mask)|(e[%d]&~mask);' % (i, i, i))
+  o('}')
+  o()
+
+#a^(p-2) with x_k=a^(2^k-1) blocks, one block per run of 1 bits of p-2
+def inversion_chain(f):
+  e = f.p - 2
+  bits = bin(e)[2:]
+  runs = []
+  i = 0
+  while i < len(bits):
+    j = i
+    while j < len(bits) and bits[j] == bits[i]:
+      j += 1
+    runs.append((bits[i], j - i))
+    i = j
+  have = {1}
+  steps = []
+  def need(k):
+    if k in have:
+      return
+    h = k // 2
+    need(h)
+    need(k - h)
+    steps.append(('block', k, h, k - h))
+    have.add(k)
+  for b, l in runs:
+    if b == '1':
+      need(l)
+  return runs, steps
+
+def emit_inv(o, f, w):
+  n = f.size(w)
+  runs, steps = inversion_chain(f)
+  blocks = sorted(have for have in set([1] + [s[1] for s in steps]))
+  o('//r=a^(p-2)=a^-1 mod p, 0 for a=0')
+  o('static void %s_inv(word_type *r,word_type *a)' % f.prefix)
+  o('{')
+  o('  word_type %s,t[%d];' % (','.join('x%d[%d]' % (k, n) for k in blocks if k != 1), n))
+  o('  //x_k=a^(2^k-1)')
+  def x(k):
+    return 'a' if k == 1 else 'x%d' % k
+  for _, k, h, l in steps:
+    o('  %s_nsqr(%s,%s,%d);' % (f.prefix, x(k), x(h), l))
+    o('  %s_mul(%s,%s,%s);' % (f.prefix, x(k), x(k), x(l)))
+  first = True
+  for b, l in runs:
+    if first:
+      assert b == '1'
+      o('  soscl_bignum_memcpy(t,%s,%d);' % (x(l), n))
+      first = False
+      continue
+    o('  %s_nsqr(t,t,%d);' % (f.prefix, l))
+    if b == '1':
+      o('  %s_mul(t,t,%s);' % (f.prefix, x(l)))
+  o('  soscl_bignum_memcpy(r,t,%d);' % n)
+  o('}')
+  o()
+
+def emit_nsqr(o, f):
+  o('//r=a^(2^count)')
+  o('static void %s_nsqr(word_type *r,word_type *a,int count)' % f.prefix)
+  o('{')
+  o('  int i;')
+  o('  %s_sqr(r,a);' % f.prefix)
+  o('  for(i=1;i<count;i++)')
+  o('    %s_sqr(r,r);' % f.prefix)
+  o('}')
+  o()
+
+def emit_wrappers(o, f, w):
+  n = f.size(w)
+  pre = f.prefix
+  o('static int %s_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)' % pre)
+  o('{')
+  o('  (void)curve_params;')
+  o('  %s_mul(r,a,b);' % pre)
+  o('  return(SOSCL_OK);')
+  o('}')
+  o()
+  o('static int %s_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)' % pre)
+  o('{')
+  o('  (void)curve_params;')
+  o('  %s_sqr(r,a);' % pre)
+  o('  return(SOSCL_OK);')
+  o('}')
+  o()
+  o('static int %s_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)' % pre)
+  o('{')
+  o('  (void)curve_params;')
+  o('  %s_add(r,a,b);' % pre)
+  o('  return(SOSCL_OK);')
+  o('}')
+  o()
+  o('static void %s_modsub(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)' % pre)
+  o('{')
+  o('  (void)curve_params;')
+  o('  %s_sub(r,a,b);' % pre)
+  o('}')
+  o()
+  o('static int %s_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)' % pre)
+  o('{')
+  o('  (void)curve_params;')
+  o('  %s_inv(r,a);' % pre)
+  o('  return(SOSCL_OK);')
+  o('}')
+  o()
+  o('//numbers larger than p^2 go through the generic reduction')
+  o('static void %s_modreduce(word_type *r,word_type *c,int c_size,soscl_type_curve *curve_params)' % pre)
+  o('{')
+  o('  word_type t[%d];' % (2 * n))
+  o('  if(c_size>%d)' % (2 * n))
+  o('    {')
+  o('      soscl_ecc_mod(r,c,c_size,curve_params->p,curve_params->curve_wsize);')
+  o('      return;')
+  o('    }')
+  o('  soscl_bignum_set_zero(t,%d);' % (2 * n))
+  o('  soscl_bignum_memcpy(t,c,c_size);')
+  o('  %s_reduce(r,t);' % pre)
+  o('}')
+  o()
+
+def generate(f):
+  o = Emitter()
+  fname = 'soscl_ecc_field_%s.c' % f.name
+  for line in LICENSE.splitlines():
+    o(line)
+  o('//%s' % fname)
+  o('// straight-line field arithmetic for sec%s, generated by soscl_ecc_field_gen.py: do not edit' % f.name)
+  o('// no loop (but the inversion squarings), no branch, no size parameter')
+  o()
+  o('#include <soscl/soscl_config.h>')
+  o('#include <soscl/soscl_types.h>')
+  o('#include <soscl/soscl_defs.h>')
+  o('#include <soscl/soscl_retdefs.h>')
+  o('#include <soscl/soscl_bignumbers.h>')
+  o('#include <soscl/soscl_ecc.h>')
+  o('#include <soscl/soscl_ecc_field_generated.h>')
+  o()
+  for w, flag in ((32, 'SOSCL_WORD32'), (64, 'SOSCL_WORD64')):
+    o('#ifdef %s' % flag)
+    if f.bits % DIGIT == 0:
+      emit_reduce_solinas(o, f, w)
+    else:
+      emit_reduce_mersenne(o, f, w)
+    emit_mul(o, f, w)
+    emit_sqr(o, f, w)
+    emit_add(o, f, w)
+    emit_sub(o, f, w)
+    emit_nsqr(o, f)
+    emit_inv(o, f, w)
+    emit_wrappers(o, f, w)
+    o('#endif//%s' % flag)
+    o()
+  pre = f.prefix
+  o('soscl_type_ecc_field_ops soscl_ecc_field_ops_%s_generated={%s_modmult,%s_modsquare,%s_modadd,%s_modsub,%s_modinv,%s_modreduce};'
+    % (f.name, pre, pre, pre, pre, pre, pre))
+  return fname, o.text()
+
+#python model of the digits reduction, checked on random and extreme numbers before writing anything
+def check_reduce_digits(f):
+  n = f.bits // DIGIT
+  m = f.fold_matrix()
+  fold = f.fold_digits()
+  def run(c):
+    cd = words(c, DIGIT, 2 * n)
+    acc = 0
+    d = []
+    for j in range(n):
+      acc += sum(m[j][i] * cd[i] for i in range(2 * n))
+      d.append(acc & 0xFFFFFFFF)
+      acc >>= DIGIT
+    t = acc
+    for step in range(2):
+      acc = 0
+      for j in range(n):
+        acc += d[j] + fold.get(j, 0) * t
+        d[j] = acc & 0xFFFFFFFF
+        acc >>= DIGIT
+      if step == 0:
+        t = acc
+      else:
+        assert acc == 0
+    v = sum(x << (DIGIT * j) for j, x in enumerate(d))
+    return v - f.p if v >= f.p else v
+  full = (1 << (2 * n * DIGIT)) - 1
+  tests = [0, 1, f.p, f.p - 1, f.p + 1, full, (f.p - 1) ** 2, f.p * f.p, 1 << (n * DIGIT)]
+  tests += [random.getrandbits(2 * n * DIGIT) for _ in range(2000)]
+  tests += [random.randrange(f.p) * random.randrange(f.p) for _ in range(2000)]
+  tests += [full ^ (1 << random.randrange(2 * n * DIGIT)) for _ in range(200)]
+  tests += [(1 << random.randrange(2 * n * DIGIT)) for _ in range(200)]
+  for c in tests:
+    assert run(c) == c % f.p, (f.name, hex(c))
+
+def main():
+  out = sys.argv[1] if len(sys.argv) > 1 else os.path.dirname(os.path.abspath(__file__))
+  random.seed(1)
+  for name, bits, sparse in CURVES:
+    f = Field(name, bits, sparse)
+    if bits % DIGIT == 0:
+      check_reduce_digits(f)
+    fname, text = generate(f)
+    with open(os.path.join(out, fname), 'w', newline='\r\n') as h:
+      h.write(text)
+
+if __name__ == '__main__':
+  main()
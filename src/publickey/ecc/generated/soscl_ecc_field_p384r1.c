@@ -0,0 +1,1676 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_field_p384r1.c
+// straight-line field arithmetic for secp384r1, generated by soscl_ecc_field_gen.py: do not edit
+// no loop (but the inversion squarings), no branch, no size parameter
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_field_generated.h>
+
+#ifdef SOSCL_WORD32
+//c is 24 digits large, r=c mod p
+static void soscl_ecc_p384r1_gen_reduce_digits(uint32_t *r,uint32_t *c)
+{
+  uint32_t d[12],e[12],mask;
+  int64_t acc,t;
+  //t in [-2,4]
+  acc=0;
+  acc+=c[0];
+  acc+=c[12];
+  acc+=c[20];
+  acc+=c[21];
+  acc-=c[23];
+  d[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[1];
+  acc-=c[12];
+  acc+=c[13];
+  acc-=c[20];
+  acc+=c[22];
+  acc+=c[23];
+  d[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[2];
+  acc-=c[13];
+  acc+=c[14];
+  acc-=c[21];
+  acc+=c[23];
+  d[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[3];
+  acc+=c[12];
+  acc-=c[14];
+  acc+=c[15];
+  acc+=c[20];
+  acc+=c[21];
+  acc-=c[22];
+  acc-=c[23];
+  d[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[4];
+  acc+=c[12];
+  acc+=c[13];
+  acc-=c[15];
+  acc+=c[16];
+  acc+=c[20];
+  acc+=(int64_t)2*c[21];
+  acc+=c[22];
+  acc-=(int64_t)2*c[23];
+  d[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[5];
+  acc+=c[13];
+  acc+=c[14];
+  acc-=c[16];
+  acc+=c[17];
+  acc+=c[21];
+  acc+=(int64_t)2*c[22];
+  acc+=c[23];
+  d[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[6];
+  acc+=c[14];
+  acc+=c[15];
+  acc-=c[17];
+  acc+=c[18];
+  acc+=c[22];
+  acc+=(int64_t)2*c[23];
+  d[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[7];
+  acc+=c[15];
+  acc+=c[16];
+  acc-=c[18];
+  acc+=c[19];
+  acc+=c[23];
+  d[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[8];
+  acc+=c[16];
+  acc+=c[17];
+  acc-=c[19];
+  acc+=c[20];
+  d[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[9];
+  acc+=c[17];
+  acc+=c[18];
+  acc-=c[20];
+  acc+=c[21];
+  d[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[10];
+  acc+=c[18];
+  acc+=c[19];
+  acc-=c[21];
+  acc+=c[22];
+  d[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[11];
+  acc+=c[19];
+  acc+=c[20];
+  acc-=c[22];
+  acc+=c[23];
+  d[11]=(uint32_t)acc;
+  acc>>=32;
+  t=acc;
+  acc=0;
+  acc+=d[0];
+  acc+=t;
+  d[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[1];
+  acc-=t;
+  d[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[2];
+  d[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[3];
+  acc+=t;
+  d[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[4];
+  acc+=t;
+  d[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[5];
+  d[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[6];
+  d[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[7];
+  d[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[8];
+  d[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[9];
+  d[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[10];
+  d[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[11];
+  d[11]=(uint32_t)acc;
+  acc>>=32;
+  t=acc;
+  acc=0;
+  acc+=d[0];
+  acc+=t;
+  d[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[1];
+  acc-=t;
+  d[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[2];
+  d[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[3];
+  acc+=t;
+  d[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[4];
+  acc+=t;
+  d[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[5];
+  d[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[6];
+  d[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[7];
+  d[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[8];
+  d[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[9];
+  d[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[10];
+  d[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[11];
+  d[11]=(uint32_t)acc;
+  acc>>=32;
+  //d<2^384<2p
+  acc=0;
+  acc+=(int64_t)d[0]-0xFFFFFFFF;
+  e[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[1]-0x00000000;
+  e[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[2]-0x00000000;
+  e[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[3]-0xFFFFFFFF;
+  e[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[4]-0xFFFFFFFE;
+  e[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[5]-0xFFFFFFFF;
+  e[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[6]-0xFFFFFFFF;
+  e[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[7]-0xFFFFFFFF;
+  e[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[8]-0xFFFFFFFF;
+  e[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[9]-0xFFFFFFFF;
+  e[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[10]-0xFFFFFFFF;
+  e[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[11]-0xFFFFFFFF;
+  e[11]=(uint32_t)acc;
+  acc>>=32;
+  mask=(uint32_t)acc;
+  r[0]=(d[0]&mask)|(e[0]&~mask);
+  r[1]=(d[1]&mask)|(e[1]&~mask);
+  r[2]=(d[2]&mask)|(e[2]&~mask);
+  r[3]=(d[3]&mask)|(e[3]&~mask);
+  r[4]=(d[4]&mask)|(e[4]&~mask);
+  r[5]=(d[5]&mask)|(e[5]&~mask);
+  r[6]=(d[6]&mask)|(e[6]&~mask);
+  r[7]=(d[7]&mask)|(e[7]&~mask);
+  r[8]=(d[8]&mask)|(e[8]&~mask);
+  r[9]=(d[9]&mask)|(e[9]&~mask);
+  r[10]=(d[10]&mask)|(e[10]&~mask);
+  r[11]=(d[11]&mask)|(e[11]&~mask);
+}
+
+static void soscl_ecc_p384r1_gen_reduce(word_type *r,word_type *c)
+{
+  soscl_ecc_p384r1_gen_reduce_digits(r,c);
+}
+
+static void soscl_ecc_p384r1_gen_mul(word_type *r,word_type *a,word_type *b)
+{
+  word_type t[24];
+  double_word_type uv;
+  uv=(double_word_type)a[0]*b[0];
+  t[0]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[1]+(uv>>32);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  t[12]=(word_type)(uv>>32);
+  uv=(double_word_type)a[1]*b[0]+t[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[1]+t[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[2]+t[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[3]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[4]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[5]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[6]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[7]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[8]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[9]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[10]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[11]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  t[13]=(word_type)(uv>>32);
+  uv=(double_word_type)a[2]*b[0]+t[2];
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[1]+t[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[2]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[3]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[4]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[5]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[6]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[7]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[8]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[9]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[10]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[11]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  t[14]=(word_type)(uv>>32);
+  uv=(double_word_type)a[3]*b[0]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[1]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[2]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[3]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[4]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[5]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[6]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[7]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[8]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[9]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[10]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[11]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  t[15]=(word_type)(uv>>32);
+  uv=(double_word_type)a[4]*b[0]+t[4];
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[1]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[2]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[3]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[4]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[5]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[6]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[7]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[8]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[9]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[10]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[11]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  t[16]=(word_type)(uv>>32);
+  uv=(double_word_type)a[5]*b[0]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[1]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[2]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[3]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[4]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[5]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[6]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[7]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[8]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[9]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[10]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[11]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  t[17]=(word_type)(uv>>32);
+  uv=(double_word_type)a[6]*b[0]+t[6];
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[1]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[2]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[3]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[4]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[5]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[6]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[7]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[8]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[9]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[10]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[11]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  t[18]=(word_type)(uv>>32);
+  uv=(double_word_type)a[7]*b[0]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[1]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[2]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[3]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[4]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[5]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[6]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[7]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[8]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[9]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[10]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[11]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  t[19]=(word_type)(uv>>32);
+  uv=(double_word_type)a[8]*b[0]+t[8];
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[1]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[2]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[3]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[4]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[5]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[6]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[7]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[8]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[9]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[10]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[11]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  t[20]=(word_type)(uv>>32);
+  uv=(double_word_type)a[9]*b[0]+t[9];
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[1]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[2]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[3]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[4]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[5]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[6]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[7]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[8]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[9]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[10]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[11]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  t[21]=(word_type)(uv>>32);
+  uv=(double_word_type)a[10]*b[0]+t[10];
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[1]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[2]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[3]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[4]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[5]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[6]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[7]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[8]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[9]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[10]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[11]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  t[22]=(word_type)(uv>>32);
+  uv=(double_word_type)a[11]*b[0]+t[11];
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[1]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[2]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[3]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[4]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[5]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[6]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[7]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[8]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[9]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[10]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[11]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  t[23]=(word_type)(uv>>32);
+  soscl_ecc_p384r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p384r1_gen_sqr(word_type *r,word_type *a)
+{
+  word_type t[24];
+  double_word_type uv,acc;
+  //cross products
+  uv=(double_word_type)a[0]*a[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  t[12]=(word_type)(uv>>32);
+  uv=(double_word_type)a[1]*a[2]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[3]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[4]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[5]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[6]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[7]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[8]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[9]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[10]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[11]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  t[13]=(word_type)(uv>>32);
+  uv=(double_word_type)a[2]*a[3]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[4]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[5]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[6]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[7]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[8]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[9]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[10]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[11]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  t[14]=(word_type)(uv>>32);
+  uv=(double_word_type)a[3]*a[4]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[5]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[6]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[7]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[8]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[9]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[10]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[11]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  t[15]=(word_type)(uv>>32);
+  uv=(double_word_type)a[4]*a[5]+t[9];
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[6]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[7]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[8]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[9]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[10]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[11]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  t[16]=(word_type)(uv>>32);
+  uv=(double_word_type)a[5]*a[6]+t[11];
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[7]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[8]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[9]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[10]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[11]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  t[17]=(word_type)(uv>>32);
+  uv=(double_word_type)a[6]*a[7]+t[13];
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[8]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[9]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[10]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[11]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  t[18]=(word_type)(uv>>32);
+  uv=(double_word_type)a[7]*a[8]+t[15];
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[9]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[10]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[11]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  t[19]=(word_type)(uv>>32);
+  uv=(double_word_type)a[8]*a[9]+t[17];
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[10]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[11]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  t[20]=(word_type)(uv>>32);
+  uv=(double_word_type)a[9]*a[10]+t[19];
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[11]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  t[21]=(word_type)(uv>>32);
+  uv=(double_word_type)a[10]*a[11]+t[21];
+  t[21]=(word_type)uv;
+  t[22]=(word_type)(uv>>32);
+  //doubling
+  t[23]=t[22]>>31;
+  t[22]=(t[22]<<1)|(t[21]>>31);
+  t[21]=(t[21]<<1)|(t[20]>>31);
+  t[20]=(t[20]<<1)|(t[19]>>31);
+  t[19]=(t[19]<<1)|(t[18]>>31);
+  t[18]=(t[18]<<1)|(t[17]>>31);
+  t[17]=(t[17]<<1)|(t[16]>>31);
+  t[16]=(t[16]<<1)|(t[15]>>31);
+  t[15]=(t[15]<<1)|(t[14]>>31);
+  t[14]=(t[14]<<1)|(t[13]>>31);
+  t[13]=(t[13]<<1)|(t[12]>>31);
+  t[12]=(t[12]<<1)|(t[11]>>31);
+  t[11]=(t[11]<<1)|(t[10]>>31);
+  t[10]=(t[10]<<1)|(t[9]>>31);
+  t[9]=(t[9]<<1)|(t[8]>>31);
+  t[8]=(t[8]<<1)|(t[7]>>31);
+  t[7]=(t[7]<<1)|(t[6]>>31);
+  t[6]=(t[6]<<1)|(t[5]>>31);
+  t[5]=(t[5]<<1)|(t[4]>>31);
+  t[4]=(t[4]<<1)|(t[3]>>31);
+  t[3]=(t[3]<<1)|(t[2]>>31);
+  t[2]=(t[2]<<1)|(t[1]>>31);
+  t[1]=t[1]<<1;
+  t[0]=0;
+  //squares
+  uv=(double_word_type)a[0]*a[0];
+  acc=(double_word_type)t[0]+(word_type)uv;
+  t[0]=(word_type)acc;
+  acc=(double_word_type)t[1]+(word_type)(uv>>32)+(acc>>32);
+  t[1]=(word_type)acc;
+  uv=(double_word_type)a[1]*a[1];
+  acc=(double_word_type)t[2]+(word_type)uv+(acc>>32);
+  t[2]=(word_type)acc;
+  acc=(double_word_type)t[3]+(word_type)(uv>>32)+(acc>>32);
+  t[3]=(word_type)acc;
+  uv=(double_word_type)a[2]*a[2];
+  acc=(double_word_type)t[4]+(word_type)uv+(acc>>32);
+  t[4]=(word_type)acc;
+  acc=(double_word_type)t[5]+(word_type)(uv>>32)+(acc>>32);
+  t[5]=(word_type)acc;
+  uv=(double_word_type)a[3]*a[3];
+  acc=(double_word_type)t[6]+(word_type)uv+(acc>>32);
+  t[6]=(word_type)acc;
+  acc=(double_word_type)t[7]+(word_type)(uv>>32)+(acc>>32);
+  t[7]=(word_type)acc;
+  uv=(double_word_type)a[4]*a[4];
+  acc=(double_word_type)t[8]+(word_type)uv+(acc>>32);
+  t[8]=(word_type)acc;
+  acc=(double_word_type)t[9]+(word_type)(uv>>32)+(acc>>32);
+  t[9]=(word_type)acc;
+  uv=(double_word_type)a[5]*a[5];
+  acc=(double_word_type)t[10]+(word_type)uv+(acc>>32);
+  t[10]=(word_type)acc;
+  acc=(double_word_type)t[11]+(word_type)(uv>>32)+(acc>>32);
+  t[11]=(word_type)acc;
+  uv=(double_word_type)a[6]*a[6];
+  acc=(double_word_type)t[12]+(word_type)uv+(acc>>32);
+  t[12]=(word_type)acc;
+  acc=(double_word_type)t[13]+(word_type)(uv>>32)+(acc>>32);
+  t[13]=(word_type)acc;
+  uv=(double_word_type)a[7]*a[7];
+  acc=(double_word_type)t[14]+(word_type)uv+(acc>>32);
+  t[14]=(word_type)acc;
+  acc=(double_word_type)t[15]+(word_type)(uv>>32)+(acc>>32);
+  t[15]=(word_type)acc;
+  uv=(double_word_type)a[8]*a[8];
+  acc=(double_word_type)t[16]+(word_type)uv+(acc>>32);
+  t[16]=(word_type)acc;
+  acc=(double_word_type)t[17]+(word_type)(uv>>32)+(acc>>32);
+  t[17]=(word_type)acc;
+  uv=(double_word_type)a[9]*a[9];
+  acc=(double_word_type)t[18]+(word_type)uv+(acc>>32);
+  t[18]=(word_type)acc;
+  acc=(double_word_type)t[19]+(word_type)(uv>>32)+(acc>>32);
+  t[19]=(word_type)acc;
+  uv=(double_word_type)a[10]*a[10];
+  acc=(double_word_type)t[20]+(word_type)uv+(acc>>32);
+  t[20]=(word_type)acc;
+  acc=(double_word_type)t[21]+(word_type)(uv>>32)+(acc>>32);
+  t[21]=(word_type)acc;
+  uv=(double_word_type)a[11]*a[11];
+  acc=(double_word_type)t[22]+(word_type)uv+(acc>>32);
+  t[22]=(word_type)acc;
+  acc=(double_word_type)t[23]+(word_type)(uv>>32)+(acc>>32);
+  t[23]=(word_type)acc;
+  soscl_ecc_p384r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p384r1_gen_add(word_type *r,word_type *a,word_type *b)
+{
+  word_type s[12],d[12],carry,mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]+b[0];
+  s[0]=(word_type)uv;
+  uv=(double_word_type)a[1]+b[1]+(uv>>32);
+  s[1]=(word_type)uv;
+  uv=(double_word_type)a[2]+b[2]+(uv>>32);
+  s[2]=(word_type)uv;
+  uv=(double_word_type)a[3]+b[3]+(uv>>32);
+  s[3]=(word_type)uv;
+  uv=(double_word_type)a[4]+b[4]+(uv>>32);
+  s[4]=(word_type)uv;
+  uv=(double_word_type)a[5]+b[5]+(uv>>32);
+  s[5]=(word_type)uv;
+  uv=(double_word_type)a[6]+b[6]+(uv>>32);
+  s[6]=(word_type)uv;
+  uv=(double_word_type)a[7]+b[7]+(uv>>32);
+  s[7]=(word_type)uv;
+  uv=(double_word_type)a[8]+b[8]+(uv>>32);
+  s[8]=(word_type)uv;
+  uv=(double_word_type)a[9]+b[9]+(uv>>32);
+  s[9]=(word_type)uv;
+  uv=(double_word_type)a[10]+b[10]+(uv>>32);
+  s[10]=(word_type)uv;
+  uv=(double_word_type)a[11]+b[11]+(uv>>32);
+  s[11]=(word_type)uv;
+  carry=(word_type)(uv>>32);
+  uv=(double_word_type)s[0]-0xFFFFFFFF;
+  d[0]=(word_type)uv;
+  uv=(double_word_type)s[1]-((uv>>32)&1)-0x00000000;
+  d[1]=(word_type)uv;
+  uv=(double_word_type)s[2]-((uv>>32)&1)-0x00000000;
+  d[2]=(word_type)uv;
+  uv=(double_word_type)s[3]-((uv>>32)&1)-0xFFFFFFFF;
+  d[3]=(word_type)uv;
+  uv=(double_word_type)s[4]-((uv>>32)&1)-0xFFFFFFFE;
+  d[4]=(word_type)uv;
+  uv=(double_word_type)s[5]-((uv>>32)&1)-0xFFFFFFFF;
+  d[5]=(word_type)uv;
+  uv=(double_word_type)s[6]-((uv>>32)&1)-0xFFFFFFFF;
+  d[6]=(word_type)uv;
+  uv=(double_word_type)s[7]-((uv>>32)&1)-0xFFFFFFFF;
+  d[7]=(word_type)uv;
+  uv=(double_word_type)s[8]-((uv>>32)&1)-0xFFFFFFFF;
+  d[8]=(word_type)uv;
+  uv=(double_word_type)s[9]-((uv>>32)&1)-0xFFFFFFFF;
+  d[9]=(word_type)uv;
+  uv=(double_word_type)s[10]-((uv>>32)&1)-0xFFFFFFFF;
+  d[10]=(word_type)uv;
+  uv=(double_word_type)s[11]-((uv>>32)&1)-0xFFFFFFFF;
+  d[11]=(word_type)uv;
+  //keep a+b when a+b<p
+  mask=(word_type)0-((word_type)(uv>>32)&1&(carry^1));
+  r[0]=(s[0]&mask)|(d[0]&~mask);
+  r[1]=(s[1]&mask)|(d[1]&~mask);
+  r[2]=(s[2]&mask)|(d[2]&~mask);
+  r[3]=(s[3]&mask)|(d[3]&~mask);
+  r[4]=(s[4]&mask)|(d[4]&~mask);
+  r[5]=(s[5]&mask)|(d[5]&~mask);
+  r[6]=(s[6]&mask)|(d[6]&~mask);
+  r[7]=(s[7]&mask)|(d[7]&~mask);
+  r[8]=(s[8]&mask)|(d[8]&~mask);
+  r[9]=(s[9]&mask)|(d[9]&~mask);
+  r[10]=(s[10]&mask)|(d[10]&~mask);
+  r[11]=(s[11]&mask)|(d[11]&~mask);
+}
+
+static void soscl_ecc_p384r1_gen_sub(word_type *r,word_type *a,word_type *b)
+{
+  word_type d[12],mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]-b[0];
+  d[0]=(word_type)uv;
+  uv=(double_word_type)a[1]-b[1]-((uv>>32)&1);
+  d[1]=(word_type)uv;
+  uv=(double_word_type)a[2]-b[2]-((uv>>32)&1);
+  d[2]=(word_type)uv;
+  uv=(double_word_type)a[3]-b[3]-((uv>>32)&1);
+  d[3]=(word_type)uv;
+  uv=(double_word_type)a[4]-b[4]-((uv>>32)&1);
+  d[4]=(word_type)uv;
+  uv=(double_word_type)a[5]-b[5]-((uv>>32)&1);
+  d[5]=(word_type)uv;
+  uv=(double_word_type)a[6]-b[6]-((uv>>32)&1);
+  d[6]=(word_type)uv;
+  uv=(double_word_type)a[7]-b[7]-((uv>>32)&1);
+  d[7]=(word_type)uv;
+  uv=(double_word_type)a[8]-b[8]-((uv>>32)&1);
+  d[8]=(word_type)uv;
+  uv=(double_word_type)a[9]-b[9]-((uv>>32)&1);
+  d[9]=(word_type)uv;
+  uv=(double_word_type)a[10]-b[10]-((uv>>32)&1);
+  d[10]=(word_type)uv;
+  uv=(double_word_type)a[11]-b[11]-((uv>>32)&1);
+  d[11]=(word_type)uv;
+  //add p back on borrow
+  mask=(word_type)0-((word_type)(uv>>32)&1);
+  uv=(double_word_type)d[0]+(0xFFFFFFFF&mask);
+  r[0]=(word_type)uv;
+  uv=(double_word_type)d[1]+(0x00000000&mask)+(uv>>32);
+  r[1]=(word_type)uv;
+  uv=(double_word_type)d[2]+(0x00000000&mask)+(uv>>32);
+  r[2]=(word_type)uv;
+  uv=(double_word_type)d[3]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[3]=(word_type)uv;
+  uv=(double_word_type)d[4]+(0xFFFFFFFE&mask)+(uv>>32);
+  r[4]=(word_type)uv;
+  uv=(double_word_type)d[5]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[5]=(word_type)uv;
+  uv=(double_word_type)d[6]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[6]=(word_type)uv;
+  uv=(double_word_type)d[7]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[7]=(word_type)uv;
+  uv=(double_word_type)d[8]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[8]=(word_type)uv;
+  uv=(double_word_type)d[9]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[9]=(word_type)uv;
+  uv=(double_word_type)d[10]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[10]=(word_type)uv;
+  uv=(double_word_type)d[11]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[11]=(word_type)uv;
+}
+
+//r=a^(2^count)
+static void soscl_ecc_p384r1_gen_nsqr(word_type *r,word_type *a,int count)
+{
+  int i;
+  soscl_ecc_p384r1_gen_sqr(r,a);
+  for(i=1;i<count;i++)
+    soscl_ecc_p384r1_gen_sqr(r,r);
+}
+
+//r=a^(p-2)=a^-1 mod p, 0 for a=0
+static void soscl_ecc_p384r1_gen_inv(word_type *r,word_type *a)
+{
+  word_type x2[12],x3[12],x4[12],x7[12],x8[12],x15[12],x16[12],x30[12],x31[12],x32[12],x63[12],x64[12],x127[12],x128[12],x255[12],t[12];
+  //x_k=a^(2^k-1)
+  soscl_ecc_p384r1_gen_nsqr(x2,a,1);
+  soscl_ecc_p384r1_gen_mul(x2,x2,a);
+  soscl_ecc_p384r1_gen_nsqr(x3,a,2);
+  soscl_ecc_p384r1_gen_mul(x3,x3,x2);
+  soscl_ecc_p384r1_gen_nsqr(x4,x2,2);
+  soscl_ecc_p384r1_gen_mul(x4,x4,x2);
+  soscl_ecc_p384r1_gen_nsqr(x7,x3,4);
+  soscl_ecc_p384r1_gen_mul(x7,x7,x4);
+  soscl_ecc_p384r1_gen_nsqr(x8,x4,4);
+  soscl_ecc_p384r1_gen_mul(x8,x8,x4);
+  soscl_ecc_p384r1_gen_nsqr(x15,x7,8);
+  soscl_ecc_p384r1_gen_mul(x15,x15,x8);
+  soscl_ecc_p384r1_gen_nsqr(x16,x8,8);
+  soscl_ecc_p384r1_gen_mul(x16,x16,x8);
+  soscl_ecc_p384r1_gen_nsqr(x31,x15,16);
+  soscl_ecc_p384r1_gen_mul(x31,x31,x16);
+  soscl_ecc_p384r1_gen_nsqr(x32,x16,16);
+  soscl_ecc_p384r1_gen_mul(x32,x32,x16);
+  soscl_ecc_p384r1_gen_nsqr(x63,x31,32);
+  soscl_ecc_p384r1_gen_mul(x63,x63,x32);
+  soscl_ecc_p384r1_gen_nsqr(x64,x32,32);
+  soscl_ecc_p384r1_gen_mul(x64,x64,x32);
+  soscl_ecc_p384r1_gen_nsqr(x127,x63,64);
+  soscl_ecc_p384r1_gen_mul(x127,x127,x64);
+  soscl_ecc_p384r1_gen_nsqr(x128,x64,64);
+  soscl_ecc_p384r1_gen_mul(x128,x128,x64);
+  soscl_ecc_p384r1_gen_nsqr(x255,x127,128);
+  soscl_ecc_p384r1_gen_mul(x255,x255,x128);
+  soscl_ecc_p384r1_gen_nsqr(x30,x15,15);
+  soscl_ecc_p384r1_gen_mul(x30,x30,x15);
+  soscl_bignum_memcpy(t,x255,12);
+  soscl_ecc_p384r1_gen_nsqr(t,t,1);
+  soscl_ecc_p384r1_gen_nsqr(t,t,32);
+  soscl_ecc_p384r1_gen_mul(t,t,x32);
+  soscl_ecc_p384r1_gen_nsqr(t,t,64);
+  soscl_ecc_p384r1_gen_nsqr(t,t,30);
+  soscl_ecc_p384r1_gen_mul(t,t,x30);
+  soscl_ecc_p384r1_gen_nsqr(t,t,1);
+  soscl_ecc_p384r1_gen_nsqr(t,t,1);
+  soscl_ecc_p384r1_gen_mul(t,t,a);
+  soscl_bignum_memcpy(r,t,12);
+}
+
+static int soscl_ecc_p384r1_gen_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_mul(r,a,b);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p384r1_gen_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_sqr(r,a);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p384r1_gen_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_add(r,a,b);
+  return(SOSCL_OK);
+}
+
+static void soscl_ecc_p384r1_gen_modsub(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_sub(r,a,b);
+}
+
+static int soscl_ecc_p384r1_gen_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_inv(r,a);
+  return(SOSCL_OK);
+}
+
+//numbers larger than p^2 go through the generic reduction
+static void soscl_ecc_p384r1_gen_modreduce(word_type *r,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  word_type t[24];
+  if(c_size>24)
+    {
+      soscl_ecc_mod(r,c,c_size,curve_params->p,curve_params->curve_wsize);
+      return;
+    }
+  soscl_bignum_set_zero(t,24);
+  soscl_bignum_memcpy(t,c,c_size);
+  soscl_ecc_p384r1_gen_reduce(r,t);
+}
+
+#endif//SOSCL_WORD32
+
+#ifdef SOSCL_WORD64
+//c is 24 digits large, r=c mod p
+static void soscl_ecc_p384r1_gen_reduce_digits(uint32_t *r,uint32_t *c)
+{
+  uint32_t d[12],e[12],mask;
+  int64_t acc,t;
+  //t in [-2,4]
+  acc=0;
+  acc+=c[0];
+  acc+=c[12];
+  acc+=c[20];
+  acc+=c[21];
+  acc-=c[23];
+  d[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[1];
+  acc-=c[12];
+  acc+=c[13];
+  acc-=c[20];
+  acc+=c[22];
+  acc+=c[23];
+  d[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[2];
+  acc-=c[13];
+  acc+=c[14];
+  acc-=c[21];
+  acc+=c[23];
+  d[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[3];
+  acc+=c[12];
+  acc-=c[14];
+  acc+=c[15];
+  acc+=c[20];
+  acc+=c[21];
+  acc-=c[22];
+  acc-=c[23];
+  d[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[4];
+  acc+=c[12];
+  acc+=c[13];
+  acc-=c[15];
+  acc+=c[16];
+  acc+=c[20];
+  acc+=(int64_t)2*c[21];
+  acc+=c[22];
+  acc-=(int64_t)2*c[23];
+  d[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[5];
+  acc+=c[13];
+  acc+=c[14];
+  acc-=c[16];
+  acc+=c[17];
+  acc+=c[21];
+  acc+=(int64_t)2*c[22];
+  acc+=c[23];
+  d[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[6];
+  acc+=c[14];
+  acc+=c[15];
+  acc-=c[17];
+  acc+=c[18];
+  acc+=c[22];
+  acc+=(int64_t)2*c[23];
+  d[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[7];
+  acc+=c[15];
+  acc+=c[16];
+  acc-=c[18];
+  acc+=c[19];
+  acc+=c[23];
+  d[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[8];
+  acc+=c[16];
+  acc+=c[17];
+  acc-=c[19];
+  acc+=c[20];
+  d[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[9];
+  acc+=c[17];
+  acc+=c[18];
+  acc-=c[20];
+  acc+=c[21];
+  d[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[10];
+  acc+=c[18];
+  acc+=c[19];
+  acc-=c[21];
+  acc+=c[22];
+  d[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=c[11];
+  acc+=c[19];
+  acc+=c[20];
+  acc-=c[22];
+  acc+=c[23];
+  d[11]=(uint32_t)acc;
+  acc>>=32;
+  t=acc;
+  acc=0;
+  acc+=d[0];
+  acc+=t;
+  d[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[1];
+  acc-=t;
+  d[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[2];
+  d[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[3];
+  acc+=t;
+  d[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[4];
+  acc+=t;
+  d[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[5];
+  d[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[6];
+  d[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[7];
+  d[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[8];
+  d[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[9];
+  d[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[10];
+  d[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[11];
+  d[11]=(uint32_t)acc;
+  acc>>=32;
+  t=acc;
+  acc=0;
+  acc+=d[0];
+  acc+=t;
+  d[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[1];
+  acc-=t;
+  d[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[2];
+  d[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[3];
+  acc+=t;
+  d[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[4];
+  acc+=t;
+  d[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[5];
+  d[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[6];
+  d[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[7];
+  d[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[8];
+  d[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[9];
+  d[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[10];
+  d[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=d[11];
+  d[11]=(uint32_t)acc;
+  acc>>=32;
+  //d<2^384<2p
+  acc=0;
+  acc+=(int64_t)d[0]-0xFFFFFFFF;
+  e[0]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[1]-0x00000000;
+  e[1]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[2]-0x00000000;
+  e[2]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[3]-0xFFFFFFFF;
+  e[3]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[4]-0xFFFFFFFE;
+  e[4]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[5]-0xFFFFFFFF;
+  e[5]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[6]-0xFFFFFFFF;
+  e[6]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[7]-0xFFFFFFFF;
+  e[7]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[8]-0xFFFFFFFF;
+  e[8]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[9]-0xFFFFFFFF;
+  e[9]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[10]-0xFFFFFFFF;
+  e[10]=(uint32_t)acc;
+  acc>>=32;
+  acc+=(int64_t)d[11]-0xFFFFFFFF;
+  e[11]=(uint32_t)acc;
+  acc>>=32;
+  mask=(uint32_t)acc;
+  r[0]=(d[0]&mask)|(e[0]&~mask);
+  r[1]=(d[1]&mask)|(e[1]&~mask);
+  r[2]=(d[2]&mask)|(e[2]&~mask);
+  r[3]=(d[3]&mask)|(e[3]&~mask);
+  r[4]=(d[4]&mask)|(e[4]&~mask);
+  r[5]=(d[5]&mask)|(e[5]&~mask);
+  r[6]=(d[6]&mask)|(e[6]&~mask);
+  r[7]=(d[7]&mask)|(e[7]&~mask);
+  r[8]=(d[8]&mask)|(e[8]&~mask);
+  r[9]=(d[9]&mask)|(e[9]&~mask);
+  r[10]=(d[10]&mask)|(e[10]&~mask);
+  r[11]=(d[11]&mask)|(e[11]&~mask);
+}
+
+static void soscl_ecc_p384r1_gen_reduce(word_type *r,word_type *c)
+{
+  uint32_t cd[24],rd[12];
+  cd[0]=(uint32_t)c[0];
+  cd[1]=(uint32_t)(c[0]>>32);
+  cd[2]=(uint32_t)c[1];
+  cd[3]=(uint32_t)(c[1]>>32);
+  cd[4]=(uint32_t)c[2];
+  cd[5]=(uint32_t)(c[2]>>32);
+  cd[6]=(uint32_t)c[3];
+  cd[7]=(uint32_t)(c[3]>>32);
+  cd[8]=(uint32_t)c[4];
+  cd[9]=(uint32_t)(c[4]>>32);
+  cd[10]=(uint32_t)c[5];
+  cd[11]=(uint32_t)(c[5]>>32);
+  cd[12]=(uint32_t)c[6];
+  cd[13]=(uint32_t)(c[6]>>32);
+  cd[14]=(uint32_t)c[7];
+  cd[15]=(uint32_t)(c[7]>>32);
+  cd[16]=(uint32_t)c[8];
+  cd[17]=(uint32_t)(c[8]>>32);
+  cd[18]=(uint32_t)c[9];
+  cd[19]=(uint32_t)(c[9]>>32);
+  cd[20]=(uint32_t)c[10];
+  cd[21]=(uint32_t)(c[10]>>32);
+  cd[22]=(uint32_t)c[11];
+  cd[23]=(uint32_t)(c[11]>>32);
+  soscl_ecc_p384r1_gen_reduce_digits(rd,cd);
+  r[0]=(word_type)rd[0]|((word_type)rd[1]<<32);
+  r[1]=(word_type)rd[2]|((word_type)rd[3]<<32);
+  r[2]=(word_type)rd[4]|((word_type)rd[5]<<32);
+  r[3]=(word_type)rd[6]|((word_type)rd[7]<<32);
+  r[4]=(word_type)rd[8]|((word_type)rd[9]<<32);
+  r[5]=(word_type)rd[10]|((word_type)rd[11]<<32);
+}
+
+static void soscl_ecc_p384r1_gen_mul(word_type *r,word_type *a,word_type *b)
+{
+  word_type t[12];
+  double_word_type uv;
+  uv=(double_word_type)a[0]*b[0];
+  t[0]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[1]+(uv>>64);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  t[6]=(word_type)(uv>>64);
+  uv=(double_word_type)a[1]*b[0]+t[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[1]+t[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[2]+t[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[3]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[4]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[5]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  t[7]=(word_type)(uv>>64);
+  uv=(double_word_type)a[2]*b[0]+t[2];
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[1]+t[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[2]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[3]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[4]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[5]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  t[8]=(word_type)(uv>>64);
+  uv=(double_word_type)a[3]*b[0]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[1]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[2]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[3]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[4]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[5]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  t[9]=(word_type)(uv>>64);
+  uv=(double_word_type)a[4]*b[0]+t[4];
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[1]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[2]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[3]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[4]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[5]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  t[10]=(word_type)(uv>>64);
+  uv=(double_word_type)a[5]*b[0]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[1]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[2]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[3]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[4]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[5]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  t[11]=(word_type)(uv>>64);
+  soscl_ecc_p384r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p384r1_gen_sqr(word_type *r,word_type *a)
+{
+  word_type t[12];
+  double_word_type uv,acc;
+  //cross products
+  uv=(double_word_type)a[0]*a[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  t[6]=(word_type)(uv>>64);
+  uv=(double_word_type)a[1]*a[2]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[3]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[4]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[5]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  t[7]=(word_type)(uv>>64);
+  uv=(double_word_type)a[2]*a[3]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[4]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[5]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  t[8]=(word_type)(uv>>64);
+  uv=(double_word_type)a[3]*a[4]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[5]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  t[9]=(word_type)(uv>>64);
+  uv=(double_word_type)a[4]*a[5]+t[9];
+  t[9]=(word_type)uv;
+  t[10]=(word_type)(uv>>64);
+  //doubling
+  t[11]=t[10]>>63;
+  t[10]=(t[10]<<1)|(t[9]>>63);
+  t[9]=(t[9]<<1)|(t[8]>>63);
+  t[8]=(t[8]<<1)|(t[7]>>63);
+  t[7]=(t[7]<<1)|(t[6]>>63);
+  t[6]=(t[6]<<1)|(t[5]>>63);
+  t[5]=(t[5]<<1)|(t[4]>>63);
+  t[4]=(t[4]<<1)|(t[3]>>63);
+  t[3]=(t[3]<<1)|(t[2]>>63);
+  t[2]=(t[2]<<1)|(t[1]>>63);
+  t[1]=t[1]<<1;
+  t[0]=0;
+  //squares
+  uv=(double_word_type)a[0]*a[0];
+  acc=(double_word_type)t[0]+(word_type)uv;
+  t[0]=(word_type)acc;
+  acc=(double_word_type)t[1]+(word_type)(uv>>64)+(acc>>64);
+  t[1]=(word_type)acc;
+  uv=(double_word_type)a[1]*a[1];
+  acc=(double_word_type)t[2]+(word_type)uv+(acc>>64);
+  t[2]=(word_type)acc;
+  acc=(double_word_type)t[3]+(word_type)(uv>>64)+(acc>>64);
+  t[3]=(word_type)acc;
+  uv=(double_word_type)a[2]*a[2];
+  acc=(double_word_type)t[4]+(word_type)uv+(acc>>64);
+  t[4]=(word_type)acc;
+  acc=(double_word_type)t[5]+(word_type)(uv>>64)+(acc>>64);
+  t[5]=(word_type)acc;
+  uv=(double_word_type)a[3]*a[3];
+  acc=(double_word_type)t[6]+(word_type)uv+(acc>>64);
+  t[6]=(word_type)acc;
+  acc=(double_word_type)t[7]+(word_type)(uv>>64)+(acc>>64);
+  t[7]=(word_type)acc;
+  uv=(double_word_type)a[4]*a[4];
+  acc=(double_word_type)t[8]+(word_type)uv+(acc>>64);
+  t[8]=(word_type)acc;
+  acc=(double_word_type)t[9]+(word_type)(uv>>64)+(acc>>64);
+  t[9]=(word_type)acc;
+  uv=(double_word_type)a[5]*a[5];
+  acc=(double_word_type)t[10]+(word_type)uv+(acc>>64);
+  t[10]=(word_type)acc;
+  acc=(double_word_type)t[11]+(word_type)(uv>>64)+(acc>>64);
+  t[11]=(word_type)acc;
+  soscl_ecc_p384r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p384r1_gen_add(word_type *r,word_type *a,word_type *b)
+{
+  word_type s[6],d[6],carry,mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]+b[0];
+  s[0]=(word_type)uv;
+  uv=(double_word_type)a[1]+b[1]+(uv>>64);
+  s[1]=(word_type)uv;
+  uv=(double_word_type)a[2]+b[2]+(uv>>64);
+  s[2]=(word_type)uv;
+  uv=(double_word_type)a[3]+b[3]+(uv>>64);
+  s[3]=(word_type)uv;
+  uv=(double_word_type)a[4]+b[4]+(uv>>64);
+  s[4]=(word_type)uv;
+  uv=(double_word_type)a[5]+b[5]+(uv>>64);
+  s[5]=(word_type)uv;
+  carry=(word_type)(uv>>64);
+  uv=(double_word_type)s[0]-0x00000000FFFFFFFF;
+  d[0]=(word_type)uv;
+  uv=(double_word_type)s[1]-((uv>>64)&1)-0xFFFFFFFF00000000;
+  d[1]=(word_type)uv;
+  uv=(double_word_type)s[2]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFE;
+  d[2]=(word_type)uv;
+  uv=(double_word_type)s[3]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[3]=(word_type)uv;
+  uv=(double_word_type)s[4]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[4]=(word_type)uv;
+  uv=(double_word_type)s[5]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[5]=(word_type)uv;
+  //keep a+b when a+b<p
+  mask=(word_type)0-((word_type)(uv>>64)&1&(carry^1));
+  r[0]=(s[0]&mask)|(d[0]&~mask);
+  r[1]=(s[1]&mask)|(d[1]&~mask);
+  r[2]=(s[2]&mask)|(d[2]&~mask);
+  r[3]=(s[3]&mask)|(d[3]&~mask);
+  r[4]=(s[4]&mask)|(d[4]&~mask);
+  r[5]=(s[5]&mask)|(d[5]&~mask);
+}
+
+static void soscl_ecc_p384r1_gen_sub(word_type *r,word_type *a,word_type *b)
+{
+  word_type d[6],mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]-b[0];
+  d[0]=(word_type)uv;
+  uv=(double_word_type)a[1]-b[1]-((uv>>64)&1);
+  d[1]=(word_type)uv;
+  uv=(double_word_type)a[2]-b[2]-((uv>>64)&1);
+  d[2]=(word_type)uv;
+  uv=(double_word_type)a[3]-b[3]-((uv>>64)&1);
+  d[3]=(word_type)uv;
+  uv=(double_word_type)a[4]-b[4]-((uv>>64)&1);
+  d[4]=(word_type)uv;
+  uv=(double_word_type)a[5]-b[5]-((uv>>64)&1);
+  d[5]=(word_type)uv;
+  //add p back on borrow
+  mask=(word_type)0-((word_type)(uv>>64)&1);
+  uv=(double_word_type)d[0]+(0x00000000FFFFFFFF&mask);
+  r[0]=(word_type)uv;
+  uv=(double_word_type)d[1]+(0xFFFFFFFF00000000&mask)+(uv>>64);
+  r[1]=(word_type)uv;
+  uv=(double_word_type)d[2]+(0xFFFFFFFFFFFFFFFE&mask)+(uv>>64);
+  r[2]=(word_type)uv;
+  uv=(double_word_type)d[3]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[3]=(word_type)uv;
+  uv=(double_word_type)d[4]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[4]=(word_type)uv;
+  uv=(double_word_type)d[5]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[5]=(word_type)uv;
+}
+
+//r=a^(2^count)
+static void soscl_ecc_p384r1_gen_nsqr(word_type *r,word_type *a,int count)
+{
+  int i;
+  soscl_ecc_p384r1_gen_sqr(r,a);
+  for(i=1;i<count;i++)
+    soscl_ecc_p384r1_gen_sqr(r,r);
+}
+
+//r=a^(p-2)=a^-1 mod p, 0 for a=0
+static void soscl_ecc_p384r1_gen_inv(word_type *r,word_type *a)
+{
+  word_type x2[6],x3[6],x4[6],x7[6],x8[6],x15[6],x16[6],x30[6],x31[6],x32[6],x63[6],x64[6],x127[6],x128[6],x255[6],t[6];
+  //x_k=a^(2^k-1)
+  soscl_ecc_p384r1_gen_nsqr(x2,a,1);
+  soscl_ecc_p384r1_gen_mul(x2,x2,a);
+  soscl_ecc_p384r1_gen_nsqr(x3,a,2);
+  soscl_ecc_p384r1_gen_mul(x3,x3,x2);
+  soscl_ecc_p384r1_gen_nsqr(x4,x2,2);
+  soscl_ecc_p384r1_gen_mul(x4,x4,x2);
+  soscl_ecc_p384r1_gen_nsqr(x7,x3,4);
+  soscl_ecc_p384r1_gen_mul(x7,x7,x4);
+  soscl_ecc_p384r1_gen_nsqr(x8,x4,4);
+  soscl_ecc_p384r1_gen_mul(x8,x8,x4);
+  soscl_ecc_p384r1_gen_nsqr(x15,x7,8);
+  soscl_ecc_p384r1_gen_mul(x15,x15,x8);
+  soscl_ecc_p384r1_gen_nsqr(x16,x8,8);
+  soscl_ecc_p384r1_gen_mul(x16,x16,x8);
+  soscl_ecc_p384r1_gen_nsqr(x31,x15,16);
+  soscl_ecc_p384r1_gen_mul(x31,x31,x16);
+  soscl_ecc_p384r1_gen_nsqr(x32,x16,16);
+  soscl_ecc_p384r1_gen_mul(x32,x32,x16);
+  soscl_ecc_p384r1_gen_nsqr(x63,x31,32);
+  soscl_ecc_p384r1_gen_mul(x63,x63,x32);
+  soscl_ecc_p384r1_gen_nsqr(x64,x32,32);
+  soscl_ecc_p384r1_gen_mul(x64,x64,x32);
+  soscl_ecc_p384r1_gen_nsqr(x127,x63,64);
+  soscl_ecc_p384r1_gen_mul(x127,x127,x64);
+  soscl_ecc_p384r1_gen_nsqr(x128,x64,64);
+  soscl_ecc_p384r1_gen_mul(x128,x128,x64);
+  soscl_ecc_p384r1_gen_nsqr(x255,x127,128);
+  soscl_ecc_p384r1_gen_mul(x255,x255,x128);
+  soscl_ecc_p384r1_gen_nsqr(x30,x15,15);
+  soscl_ecc_p384r1_gen_mul(x30,x30,x15);
+  soscl_bignum_memcpy(t,x255,6);
+  soscl_ecc_p384r1_gen_nsqr(t,t,1);
+  soscl_ecc_p384r1_gen_nsqr(t,t,32);
+  soscl_ecc_p384r1_gen_mul(t,t,x32);
+  soscl_ecc_p384r1_gen_nsqr(t,t,64);
+  soscl_ecc_p384r1_gen_nsqr(t,t,30);
+  soscl_ecc_p384r1_gen_mul(t,t,x30);
+  soscl_ecc_p384r1_gen_nsqr(t,t,1);
+  soscl_ecc_p384r1_gen_nsqr(t,t,1);
+  soscl_ecc_p384r1_gen_mul(t,t,a);
+  soscl_bignum_memcpy(r,t,6);
+}
+
+static int soscl_ecc_p384r1_gen_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_mul(r,a,b);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p384r1_gen_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_sqr(r,a);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p384r1_gen_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_add(r,a,b);
+  return(SOSCL_OK);
+}
+
+static void soscl_ecc_p384r1_gen_modsub(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_sub(r,a,b);
+}
+
+static int soscl_ecc_p384r1_gen_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p384r1_gen_inv(r,a);
+  return(SOSCL_OK);
+}
+
+//numbers larger than p^2 go through the generic reduction
+static void soscl_ecc_p384r1_gen_modreduce(word_type *r,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  word_type t[12];
+  if(c_size>12)
+    {
+      soscl_ecc_mod(r,c,c_size,curve_params->p,curve_params->curve_wsize);
+      return;
+    }
+  soscl_bignum_set_zero(t,12);
+  soscl_bignum_memcpy(t,c,c_size);
+  soscl_ecc_p384r1_gen_reduce(r,t);
+}
+
+#endif//SOSCL_WORD64
+
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p384r1_generated={soscl_ecc_p384r1_gen_modmult,soscl_ecc_p384r1_gen_modsquare,soscl_ecc_p384r1_gen_modadd,soscl_ecc_p384r1_gen_modsub,soscl_ecc_p384r1_gen_modinv,soscl_ecc_p384r1_gen_modreduce};
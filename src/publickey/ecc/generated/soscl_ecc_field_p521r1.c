@@ -0,0 +1,2113 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_field_p521r1.c
+// straight-line field arithmetic for secp521r1, generated by soscl_ecc_field_gen.py: do not edit
+// no loop (but the inversion squarings), no branch, no size parameter
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_field_generated.h>
+
+#ifdef SOSCL_WORD32
+static void soscl_ecc_p521r1_gen_reduce(word_type *r,word_type *c)
+{
+  word_type t[34],e[17],mask;
+  double_word_type uv;
+  //t=(c mod 2^521)+(c>>521), t<2^521+2^567
+  uv=(double_word_type)c[0]+((c[16]>>9)|(c[17]<<23));
+  t[0]=(word_type)uv;
+  uv=(double_word_type)c[1]+((c[17]>>9)|(c[18]<<23))+(uv>>32);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)c[2]+((c[18]>>9)|(c[19]<<23))+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)c[3]+((c[19]>>9)|(c[20]<<23))+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)c[4]+((c[20]>>9)|(c[21]<<23))+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)c[5]+((c[21]>>9)|(c[22]<<23))+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)c[6]+((c[22]>>9)|(c[23]<<23))+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)c[7]+((c[23]>>9)|(c[24]<<23))+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)c[8]+((c[24]>>9)|(c[25]<<23))+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)c[9]+((c[25]>>9)|(c[26]<<23))+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)c[10]+((c[26]>>9)|(c[27]<<23))+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)c[11]+((c[27]>>9)|(c[28]<<23))+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)c[12]+((c[28]>>9)|(c[29]<<23))+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)c[13]+((c[29]>>9)|(c[30]<<23))+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)c[14]+((c[30]>>9)|(c[31]<<23))+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)c[15]+((c[31]>>9)|(c[32]<<23))+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)(c[16]&0x000001FF)+((c[32]>>9)|(c[33]<<23))+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)(c[33]>>9)+(uv>>32);
+  t[17]=(word_type)uv;
+  //t=(t mod 2^521)+(t>>521), t<2^521+2^47
+  uv=(double_word_type)t[0]+((t[16]>>9)|(t[17]<<23));
+  t[0]=(word_type)uv;
+  uv=(double_word_type)t[1]+(t[17]>>9)+(uv>>32);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)t[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)t[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)(t[16]&0x000001FF)+(uv>>32);
+  t[16]=(word_type)uv;
+  //t=(t mod 2^521)+(t>>521), t<2^521+2^1
+  uv=(double_word_type)t[0]+(t[16]>>9);
+  t[0]=(word_type)uv;
+  uv=(double_word_type)t[1]+(uv>>32);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)t[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)t[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)(t[16]&0x000001FF)+(uv>>32);
+  t[16]=(word_type)uv;
+  //t<2^521+2<2p
+  uv=(double_word_type)t[0]-0xFFFFFFFF;
+  e[0]=(word_type)uv;
+  uv=(double_word_type)t[1]-((uv>>32)&1)-0xFFFFFFFF;
+  e[1]=(word_type)uv;
+  uv=(double_word_type)t[2]-((uv>>32)&1)-0xFFFFFFFF;
+  e[2]=(word_type)uv;
+  uv=(double_word_type)t[3]-((uv>>32)&1)-0xFFFFFFFF;
+  e[3]=(word_type)uv;
+  uv=(double_word_type)t[4]-((uv>>32)&1)-0xFFFFFFFF;
+  e[4]=(word_type)uv;
+  uv=(double_word_type)t[5]-((uv>>32)&1)-0xFFFFFFFF;
+  e[5]=(word_type)uv;
+  uv=(double_word_type)t[6]-((uv>>32)&1)-0xFFFFFFFF;
+  e[6]=(word_type)uv;
+  uv=(double_word_type)t[7]-((uv>>32)&1)-0xFFFFFFFF;
+  e[7]=(word_type)uv;
+  uv=(double_word_type)t[8]-((uv>>32)&1)-0xFFFFFFFF;
+  e[8]=(word_type)uv;
+  uv=(double_word_type)t[9]-((uv>>32)&1)-0xFFFFFFFF;
+  e[9]=(word_type)uv;
+  uv=(double_word_type)t[10]-((uv>>32)&1)-0xFFFFFFFF;
+  e[10]=(word_type)uv;
+  uv=(double_word_type)t[11]-((uv>>32)&1)-0xFFFFFFFF;
+  e[11]=(word_type)uv;
+  uv=(double_word_type)t[12]-((uv>>32)&1)-0xFFFFFFFF;
+  e[12]=(word_type)uv;
+  uv=(double_word_type)t[13]-((uv>>32)&1)-0xFFFFFFFF;
+  e[13]=(word_type)uv;
+  uv=(double_word_type)t[14]-((uv>>32)&1)-0xFFFFFFFF;
+  e[14]=(word_type)uv;
+  uv=(double_word_type)t[15]-((uv>>32)&1)-0xFFFFFFFF;
+  e[15]=(word_type)uv;
+  uv=(double_word_type)t[16]-((uv>>32)&1)-0x000001FF;
+  e[16]=(word_type)uv;
+  mask=(word_type)0-((word_type)(uv>>32)&1);
+  r[0]=(t[0]&mask)|(e[0]&~mask);
+  r[1]=(t[1]&mask)|(e[1]&~mask);
+  r[2]=(t[2]&mask)|(e[2]&~mask);
+  r[3]=(t[3]&mask)|(e[3]&~mask);
+  r[4]=(t[4]&mask)|(e[4]&~mask);
+  r[5]=(t[5]&mask)|(e[5]&~mask);
+  r[6]=(t[6]&mask)|(e[6]&~mask);
+  r[7]=(t[7]&mask)|(e[7]&~mask);
+  r[8]=(t[8]&mask)|(e[8]&~mask);
+  r[9]=(t[9]&mask)|(e[9]&~mask);
+  r[10]=(t[10]&mask)|(e[10]&~mask);
+  r[11]=(t[11]&mask)|(e[11]&~mask);
+  r[12]=(t[12]&mask)|(e[12]&~mask);
+  r[13]=(t[13]&mask)|(e[13]&~mask);
+  r[14]=(t[14]&mask)|(e[14]&~mask);
+  r[15]=(t[15]&mask)|(e[15]&~mask);
+  r[16]=(t[16]&mask)|(e[16]&~mask);
+}
+
+static void soscl_ecc_p521r1_gen_mul(word_type *r,word_type *a,word_type *b)
+{
+  word_type t[34];
+  double_word_type uv;
+  uv=(double_word_type)a[0]*b[0];
+  t[0]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[1]+(uv>>32);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  t[17]=(word_type)(uv>>32);
+  uv=(double_word_type)a[1]*b[0]+t[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[1]+t[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[2]+t[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[3]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[4]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[5]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[6]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[7]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[8]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[9]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[10]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[11]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[12]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[13]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[14]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[15]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[16]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  t[18]=(word_type)(uv>>32);
+  uv=(double_word_type)a[2]*b[0]+t[2];
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[1]+t[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[2]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[3]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[4]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[5]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[6]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[7]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[8]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[9]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[10]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[11]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[12]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[13]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[14]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[15]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[16]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  t[19]=(word_type)(uv>>32);
+  uv=(double_word_type)a[3]*b[0]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[1]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[2]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[3]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[4]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[5]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[6]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[7]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[8]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[9]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[10]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[11]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[12]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[13]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[14]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[15]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[16]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  t[20]=(word_type)(uv>>32);
+  uv=(double_word_type)a[4]*b[0]+t[4];
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[1]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[2]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[3]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[4]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[5]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[6]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[7]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[8]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[9]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[10]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[11]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[12]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[13]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[14]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[15]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[16]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  t[21]=(word_type)(uv>>32);
+  uv=(double_word_type)a[5]*b[0]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[1]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[2]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[3]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[4]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[5]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[6]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[7]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[8]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[9]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[10]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[11]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[12]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[13]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[14]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[15]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[16]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  t[22]=(word_type)(uv>>32);
+  uv=(double_word_type)a[6]*b[0]+t[6];
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[1]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[2]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[3]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[4]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[5]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[6]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[7]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[8]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[9]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[10]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[11]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[12]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[13]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[14]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[15]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[16]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  t[23]=(word_type)(uv>>32);
+  uv=(double_word_type)a[7]*b[0]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[1]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[2]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[3]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[4]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[5]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[6]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[7]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[8]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[9]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[10]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[11]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[12]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[13]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[14]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[15]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[16]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  t[24]=(word_type)(uv>>32);
+  uv=(double_word_type)a[8]*b[0]+t[8];
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[1]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[2]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[3]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[4]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[5]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[6]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[7]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[8]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[9]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[10]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[11]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[12]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[13]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[14]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[15]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[16]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  t[25]=(word_type)(uv>>32);
+  uv=(double_word_type)a[9]*b[0]+t[9];
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[1]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[2]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[3]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[4]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[5]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[6]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[7]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[8]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[9]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[10]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[11]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[12]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[13]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[14]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[15]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[9]*b[16]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  t[26]=(word_type)(uv>>32);
+  uv=(double_word_type)a[10]*b[0]+t[10];
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[1]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[2]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[3]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[4]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[5]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[6]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[7]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[8]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[9]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[10]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[11]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[12]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[13]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[14]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[15]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[10]*b[16]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  t[27]=(word_type)(uv>>32);
+  uv=(double_word_type)a[11]*b[0]+t[11];
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[1]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[2]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[3]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[4]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[5]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[6]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[7]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[8]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[9]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[10]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[11]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[12]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[13]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[14]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[15]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[11]*b[16]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  t[28]=(word_type)(uv>>32);
+  uv=(double_word_type)a[12]*b[0]+t[12];
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[1]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[2]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[3]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[4]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[5]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[6]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[7]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[8]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[9]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[10]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[11]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[12]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[13]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[14]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[15]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[12]*b[16]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  t[29]=(word_type)(uv>>32);
+  uv=(double_word_type)a[13]*b[0]+t[13];
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[1]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[2]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[3]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[4]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[5]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[6]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[7]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[8]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[9]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[10]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[11]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[12]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[13]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[14]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[15]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  uv=(double_word_type)a[13]*b[16]+t[29]+(uv>>32);
+  t[29]=(word_type)uv;
+  t[30]=(word_type)(uv>>32);
+  uv=(double_word_type)a[14]*b[0]+t[14];
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[1]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[2]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[3]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[4]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[5]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[6]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[7]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[8]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[9]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[10]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[11]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[12]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[13]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[14]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[15]+t[29]+(uv>>32);
+  t[29]=(word_type)uv;
+  uv=(double_word_type)a[14]*b[16]+t[30]+(uv>>32);
+  t[30]=(word_type)uv;
+  t[31]=(word_type)(uv>>32);
+  uv=(double_word_type)a[15]*b[0]+t[15];
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[1]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[2]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[3]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[4]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[5]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[6]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[7]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[8]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[9]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[10]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[11]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[12]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[13]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[14]+t[29]+(uv>>32);
+  t[29]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[15]+t[30]+(uv>>32);
+  t[30]=(word_type)uv;
+  uv=(double_word_type)a[15]*b[16]+t[31]+(uv>>32);
+  t[31]=(word_type)uv;
+  t[32]=(word_type)(uv>>32);
+  uv=(double_word_type)a[16]*b[0]+t[16];
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[1]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[2]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[3]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[4]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[5]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[6]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[7]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[8]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[9]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[10]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[11]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[12]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[13]+t[29]+(uv>>32);
+  t[29]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[14]+t[30]+(uv>>32);
+  t[30]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[15]+t[31]+(uv>>32);
+  t[31]=(word_type)uv;
+  uv=(double_word_type)a[16]*b[16]+t[32]+(uv>>32);
+  t[32]=(word_type)uv;
+  t[33]=(word_type)(uv>>32);
+  soscl_ecc_p521r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p521r1_gen_sqr(word_type *r,word_type *a)
+{
+  word_type t[34];
+  double_word_type uv,acc;
+  //cross products
+  uv=(double_word_type)a[0]*a[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[2]+(uv>>32);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[3]+(uv>>32);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  t[17]=(word_type)(uv>>32);
+  uv=(double_word_type)a[1]*a[2]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[3]+t[4]+(uv>>32);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[4]+t[5]+(uv>>32);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[5]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[6]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[7]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[8]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[9]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[10]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[11]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[12]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[13]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[14]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[15]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[16]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  t[18]=(word_type)(uv>>32);
+  uv=(double_word_type)a[2]*a[3]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[4]+t[6]+(uv>>32);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[5]+t[7]+(uv>>32);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[6]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[7]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[8]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[9]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[10]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[11]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[12]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[13]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[14]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[15]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[16]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  t[19]=(word_type)(uv>>32);
+  uv=(double_word_type)a[3]*a[4]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[5]+t[8]+(uv>>32);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[6]+t[9]+(uv>>32);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[7]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[8]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[9]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[10]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[11]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[12]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[13]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[14]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[15]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[16]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  t[20]=(word_type)(uv>>32);
+  uv=(double_word_type)a[4]*a[5]+t[9];
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[6]+t[10]+(uv>>32);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[7]+t[11]+(uv>>32);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[8]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[9]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[10]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[11]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[12]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[13]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[14]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[15]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[16]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  t[21]=(word_type)(uv>>32);
+  uv=(double_word_type)a[5]*a[6]+t[11];
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[7]+t[12]+(uv>>32);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[8]+t[13]+(uv>>32);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[9]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[10]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[11]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[12]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[13]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[14]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[15]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[16]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  t[22]=(word_type)(uv>>32);
+  uv=(double_word_type)a[6]*a[7]+t[13];
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[8]+t[14]+(uv>>32);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[9]+t[15]+(uv>>32);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[10]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[11]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[12]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[13]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[14]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[15]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[16]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  t[23]=(word_type)(uv>>32);
+  uv=(double_word_type)a[7]*a[8]+t[15];
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[9]+t[16]+(uv>>32);
+  t[16]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[10]+t[17]+(uv>>32);
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[11]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[12]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[13]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[14]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[15]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[7]*a[16]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  t[24]=(word_type)(uv>>32);
+  uv=(double_word_type)a[8]*a[9]+t[17];
+  t[17]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[10]+t[18]+(uv>>32);
+  t[18]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[11]+t[19]+(uv>>32);
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[12]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[13]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[14]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[15]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[8]*a[16]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  t[25]=(word_type)(uv>>32);
+  uv=(double_word_type)a[9]*a[10]+t[19];
+  t[19]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[11]+t[20]+(uv>>32);
+  t[20]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[12]+t[21]+(uv>>32);
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[13]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[14]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[15]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[9]*a[16]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  t[26]=(word_type)(uv>>32);
+  uv=(double_word_type)a[10]*a[11]+t[21];
+  t[21]=(word_type)uv;
+  uv=(double_word_type)a[10]*a[12]+t[22]+(uv>>32);
+  t[22]=(word_type)uv;
+  uv=(double_word_type)a[10]*a[13]+t[23]+(uv>>32);
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[10]*a[14]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[10]*a[15]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[10]*a[16]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  t[27]=(word_type)(uv>>32);
+  uv=(double_word_type)a[11]*a[12]+t[23];
+  t[23]=(word_type)uv;
+  uv=(double_word_type)a[11]*a[13]+t[24]+(uv>>32);
+  t[24]=(word_type)uv;
+  uv=(double_word_type)a[11]*a[14]+t[25]+(uv>>32);
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[11]*a[15]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[11]*a[16]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  t[28]=(word_type)(uv>>32);
+  uv=(double_word_type)a[12]*a[13]+t[25];
+  t[25]=(word_type)uv;
+  uv=(double_word_type)a[12]*a[14]+t[26]+(uv>>32);
+  t[26]=(word_type)uv;
+  uv=(double_word_type)a[12]*a[15]+t[27]+(uv>>32);
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[12]*a[16]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  t[29]=(word_type)(uv>>32);
+  uv=(double_word_type)a[13]*a[14]+t[27];
+  t[27]=(word_type)uv;
+  uv=(double_word_type)a[13]*a[15]+t[28]+(uv>>32);
+  t[28]=(word_type)uv;
+  uv=(double_word_type)a[13]*a[16]+t[29]+(uv>>32);
+  t[29]=(word_type)uv;
+  t[30]=(word_type)(uv>>32);
+  uv=(double_word_type)a[14]*a[15]+t[29];
+  t[29]=(word_type)uv;
+  uv=(double_word_type)a[14]*a[16]+t[30]+(uv>>32);
+  t[30]=(word_type)uv;
+  t[31]=(word_type)(uv>>32);
+  uv=(double_word_type)a[15]*a[16]+t[31];
+  t[31]=(word_type)uv;
+  t[32]=(word_type)(uv>>32);
+  //doubling
+  t[33]=t[32]>>31;
+  t[32]=(t[32]<<1)|(t[31]>>31);
+  t[31]=(t[31]<<1)|(t[30]>>31);
+  t[30]=(t[30]<<1)|(t[29]>>31);
+  t[29]=(t[29]<<1)|(t[28]>>31);
+  t[28]=(t[28]<<1)|(t[27]>>31);
+  t[27]=(t[27]<<1)|(t[26]>>31);
+  t[26]=(t[26]<<1)|(t[25]>>31);
+  t[25]=(t[25]<<1)|(t[24]>>31);
+  t[24]=(t[24]<<1)|(t[23]>>31);
+  t[23]=(t[23]<<1)|(t[22]>>31);
+  t[22]=(t[22]<<1)|(t[21]>>31);
+  t[21]=(t[21]<<1)|(t[20]>>31);
+  t[20]=(t[20]<<1)|(t[19]>>31);
+  t[19]=(t[19]<<1)|(t[18]>>31);
+  t[18]=(t[18]<<1)|(t[17]>>31);
+  t[17]=(t[17]<<1)|(t[16]>>31);
+  t[16]=(t[16]<<1)|(t[15]>>31);
+  t[15]=(t[15]<<1)|(t[14]>>31);
+  t[14]=(t[14]<<1)|(t[13]>>31);
+  t[13]=(t[13]<<1)|(t[12]>>31);
+  t[12]=(t[12]<<1)|(t[11]>>31);
+  t[11]=(t[11]<<1)|(t[10]>>31);
+  t[10]=(t[10]<<1)|(t[9]>>31);
+  t[9]=(t[9]<<1)|(t[8]>>31);
+  t[8]=(t[8]<<1)|(t[7]>>31);
+  t[7]=(t[7]<<1)|(t[6]>>31);
+  t[6]=(t[6]<<1)|(t[5]>>31);
+  t[5]=(t[5]<<1)|(t[4]>>31);
+  t[4]=(t[4]<<1)|(t[3]>>31);
+  t[3]=(t[3]<<1)|(t[2]>>31);
+  t[2]=(t[2]<<1)|(t[1]>>31);
+  t[1]=t[1]<<1;
+  t[0]=0;
+  //squares
+  uv=(double_word_type)a[0]*a[0];
+  acc=(double_word_type)t[0]+(word_type)uv;
+  t[0]=(word_type)acc;
+  acc=(double_word_type)t[1]+(word_type)(uv>>32)+(acc>>32);
+  t[1]=(word_type)acc;
+  uv=(double_word_type)a[1]*a[1];
+  acc=(double_word_type)t[2]+(word_type)uv+(acc>>32);
+  t[2]=(word_type)acc;
+  acc=(double_word_type)t[3]+(word_type)(uv>>32)+(acc>>32);
+  t[3]=(word_type)acc;
+  uv=(double_word_type)a[2]*a[2];
+  acc=(double_word_type)t[4]+(word_type)uv+(acc>>32);
+  t[4]=(word_type)acc;
+  acc=(double_word_type)t[5]+(word_type)(uv>>32)+(acc>>32);
+  t[5]=(word_type)acc;
+  uv=(double_word_type)a[3]*a[3];
+  acc=(double_word_type)t[6]+(word_type)uv+(acc>>32);
+  t[6]=(word_type)acc;
+  acc=(double_word_type)t[7]+(word_type)(uv>>32)+(acc>>32);
+  t[7]=(word_type)acc;
+  uv=(double_word_type)a[4]*a[4];
+  acc=(double_word_type)t[8]+(word_type)uv+(acc>>32);
+  t[8]=(word_type)acc;
+  acc=(double_word_type)t[9]+(word_type)(uv>>32)+(acc>>32);
+  t[9]=(word_type)acc;
+  uv=(double_word_type)a[5]*a[5];
+  acc=(double_word_type)t[10]+(word_type)uv+(acc>>32);
+  t[10]=(word_type)acc;
+  acc=(double_word_type)t[11]+(word_type)(uv>>32)+(acc>>32);
+  t[11]=(word_type)acc;
+  uv=(double_word_type)a[6]*a[6];
+  acc=(double_word_type)t[12]+(word_type)uv+(acc>>32);
+  t[12]=(word_type)acc;
+  acc=(double_word_type)t[13]+(word_type)(uv>>32)+(acc>>32);
+  t[13]=(word_type)acc;
+  uv=(double_word_type)a[7]*a[7];
+  acc=(double_word_type)t[14]+(word_type)uv+(acc>>32);
+  t[14]=(word_type)acc;
+  acc=(double_word_type)t[15]+(word_type)(uv>>32)+(acc>>32);
+  t[15]=(word_type)acc;
+  uv=(double_word_type)a[8]*a[8];
+  acc=(double_word_type)t[16]+(word_type)uv+(acc>>32);
+  t[16]=(word_type)acc;
+  acc=(double_word_type)t[17]+(word_type)(uv>>32)+(acc>>32);
+  t[17]=(word_type)acc;
+  uv=(double_word_type)a[9]*a[9];
+  acc=(double_word_type)t[18]+(word_type)uv+(acc>>32);
+  t[18]=(word_type)acc;
+  acc=(double_word_type)t[19]+(word_type)(uv>>32)+(acc>>32);
+  t[19]=(word_type)acc;
+  uv=(double_word_type)a[10]*a[10];
+  acc=(double_word_type)t[20]+(word_type)uv+(acc>>32);
+  t[20]=(word_type)acc;
+  acc=(double_word_type)t[21]+(word_type)(uv>>32)+(acc>>32);
+  t[21]=(word_type)acc;
+  uv=(double_word_type)a[11]*a[11];
+  acc=(double_word_type)t[22]+(word_type)uv+(acc>>32);
+  t[22]=(word_type)acc;
+  acc=(double_word_type)t[23]+(word_type)(uv>>32)+(acc>>32);
+  t[23]=(word_type)acc;
+  uv=(double_word_type)a[12]*a[12];
+  acc=(double_word_type)t[24]+(word_type)uv+(acc>>32);
+  t[24]=(word_type)acc;
+  acc=(double_word_type)t[25]+(word_type)(uv>>32)+(acc>>32);
+  t[25]=(word_type)acc;
+  uv=(double_word_type)a[13]*a[13];
+  acc=(double_word_type)t[26]+(word_type)uv+(acc>>32);
+  t[26]=(word_type)acc;
+  acc=(double_word_type)t[27]+(word_type)(uv>>32)+(acc>>32);
+  t[27]=(word_type)acc;
+  uv=(double_word_type)a[14]*a[14];
+  acc=(double_word_type)t[28]+(word_type)uv+(acc>>32);
+  t[28]=(word_type)acc;
+  acc=(double_word_type)t[29]+(word_type)(uv>>32)+(acc>>32);
+  t[29]=(word_type)acc;
+  uv=(double_word_type)a[15]*a[15];
+  acc=(double_word_type)t[30]+(word_type)uv+(acc>>32);
+  t[30]=(word_type)acc;
+  acc=(double_word_type)t[31]+(word_type)(uv>>32)+(acc>>32);
+  t[31]=(word_type)acc;
+  uv=(double_word_type)a[16]*a[16];
+  acc=(double_word_type)t[32]+(word_type)uv+(acc>>32);
+  t[32]=(word_type)acc;
+  acc=(double_word_type)t[33]+(word_type)(uv>>32)+(acc>>32);
+  t[33]=(word_type)acc;
+  soscl_ecc_p521r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p521r1_gen_add(word_type *r,word_type *a,word_type *b)
+{
+  word_type s[17],d[17],carry,mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]+b[0];
+  s[0]=(word_type)uv;
+  uv=(double_word_type)a[1]+b[1]+(uv>>32);
+  s[1]=(word_type)uv;
+  uv=(double_word_type)a[2]+b[2]+(uv>>32);
+  s[2]=(word_type)uv;
+  uv=(double_word_type)a[3]+b[3]+(uv>>32);
+  s[3]=(word_type)uv;
+  uv=(double_word_type)a[4]+b[4]+(uv>>32);
+  s[4]=(word_type)uv;
+  uv=(double_word_type)a[5]+b[5]+(uv>>32);
+  s[5]=(word_type)uv;
+  uv=(double_word_type)a[6]+b[6]+(uv>>32);
+  s[6]=(word_type)uv;
+  uv=(double_word_type)a[7]+b[7]+(uv>>32);
+  s[7]=(word_type)uv;
+  uv=(double_word_type)a[8]+b[8]+(uv>>32);
+  s[8]=(word_type)uv;
+  uv=(double_word_type)a[9]+b[9]+(uv>>32);
+  s[9]=(word_type)uv;
+  uv=(double_word_type)a[10]+b[10]+(uv>>32);
+  s[10]=(word_type)uv;
+  uv=(double_word_type)a[11]+b[11]+(uv>>32);
+  s[11]=(word_type)uv;
+  uv=(double_word_type)a[12]+b[12]+(uv>>32);
+  s[12]=(word_type)uv;
+  uv=(double_word_type)a[13]+b[13]+(uv>>32);
+  s[13]=(word_type)uv;
+  uv=(double_word_type)a[14]+b[14]+(uv>>32);
+  s[14]=(word_type)uv;
+  uv=(double_word_type)a[15]+b[15]+(uv>>32);
+  s[15]=(word_type)uv;
+  uv=(double_word_type)a[16]+b[16]+(uv>>32);
+  s[16]=(word_type)uv;
+  carry=(word_type)(uv>>32);
+  uv=(double_word_type)s[0]-0xFFFFFFFF;
+  d[0]=(word_type)uv;
+  uv=(double_word_type)s[1]-((uv>>32)&1)-0xFFFFFFFF;
+  d[1]=(word_type)uv;
+  uv=(double_word_type)s[2]-((uv>>32)&1)-0xFFFFFFFF;
+  d[2]=(word_type)uv;
+  uv=(double_word_type)s[3]-((uv>>32)&1)-0xFFFFFFFF;
+  d[3]=(word_type)uv;
+  uv=(double_word_type)s[4]-((uv>>32)&1)-0xFFFFFFFF;
+  d[4]=(word_type)uv;
+  uv=(double_word_type)s[5]-((uv>>32)&1)-0xFFFFFFFF;
+  d[5]=(word_type)uv;
+  uv=(double_word_type)s[6]-((uv>>32)&1)-0xFFFFFFFF;
+  d[6]=(word_type)uv;
+  uv=(double_word_type)s[7]-((uv>>32)&1)-0xFFFFFFFF;
+  d[7]=(word_type)uv;
+  uv=(double_word_type)s[8]-((uv>>32)&1)-0xFFFFFFFF;
+  d[8]=(word_type)uv;
+  uv=(double_word_type)s[9]-((uv>>32)&1)-0xFFFFFFFF;
+  d[9]=(word_type)uv;
+  uv=(double_word_type)s[10]-((uv>>32)&1)-0xFFFFFFFF;
+  d[10]=(word_type)uv;
+  uv=(double_word_type)s[11]-((uv>>32)&1)-0xFFFFFFFF;
+  d[11]=(word_type)uv;
+  uv=(double_word_type)s[12]-((uv>>32)&1)-0xFFFFFFFF;
+  d[12]=(word_type)uv;
+  uv=(double_word_type)s[13]-((uv>>32)&1)-0xFFFFFFFF;
+  d[13]=(word_type)uv;
+  uv=(double_word_type)s[14]-((uv>>32)&1)-0xFFFFFFFF;
+  d[14]=(word_type)uv;
+  uv=(double_word_type)s[15]-((uv>>32)&1)-0xFFFFFFFF;
+  d[15]=(word_type)uv;
+  uv=(double_word_type)s[16]-((uv>>32)&1)-0x000001FF;
+  d[16]=(word_type)uv;
+  //keep a+b when a+b<p
+  mask=(word_type)0-((word_type)(uv>>32)&1&(carry^1));
+  r[0]=(s[0]&mask)|(d[0]&~mask);
+  r[1]=(s[1]&mask)|(d[1]&~mask);
+  r[2]=(s[2]&mask)|(d[2]&~mask);
+  r[3]=(s[3]&mask)|(d[3]&~mask);
+  r[4]=(s[4]&mask)|(d[4]&~mask);
+  r[5]=(s[5]&mask)|(d[5]&~mask);
+  r[6]=(s[6]&mask)|(d[6]&~mask);
+  r[7]=(s[7]&mask)|(d[7]&~mask);
+  r[8]=(s[8]&mask)|(d[8]&~mask);
+  r[9]=(s[9]&mask)|(d[9]&~mask);
+  r[10]=(s[10]&mask)|(d[10]&~mask);
+  r[11]=(s[11]&mask)|(d[11]&~mask);
+  r[12]=(s[12]&mask)|(d[12]&~mask);
+  r[13]=(s[13]&mask)|(d[13]&~mask);
+  r[14]=(s[14]&mask)|(d[14]&~mask);
+  r[15]=(s[15]&mask)|(d[15]&~mask);
+  r[16]=(s[16]&mask)|(d[16]&~mask);
+}
+
+static void soscl_ecc_p521r1_gen_sub(word_type *r,word_type *a,word_type *b)
+{
+  word_type d[17],mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]-b[0];
+  d[0]=(word_type)uv;
+  uv=(double_word_type)a[1]-b[1]-((uv>>32)&1);
+  d[1]=(word_type)uv;
+  uv=(double_word_type)a[2]-b[2]-((uv>>32)&1);
+  d[2]=(word_type)uv;
+  uv=(double_word_type)a[3]-b[3]-((uv>>32)&1);
+  d[3]=(word_type)uv;
+  uv=(double_word_type)a[4]-b[4]-((uv>>32)&1);
+  d[4]=(word_type)uv;
+  uv=(double_word_type)a[5]-b[5]-((uv>>32)&1);
+  d[5]=(word_type)uv;
+  uv=(double_word_type)a[6]-b[6]-((uv>>32)&1);
+  d[6]=(word_type)uv;
+  uv=(double_word_type)a[7]-b[7]-((uv>>32)&1);
+  d[7]=(word_type)uv;
+  uv=(double_word_type)a[8]-b[8]-((uv>>32)&1);
+  d[8]=(word_type)uv;
+  uv=(double_word_type)a[9]-b[9]-((uv>>32)&1);
+  d[9]=(word_type)uv;
+  uv=(double_word_type)a[10]-b[10]-((uv>>32)&1);
+  d[10]=(word_type)uv;
+  uv=(double_word_type)a[11]-b[11]-((uv>>32)&1);
+  d[11]=(word_type)uv;
+  uv=(double_word_type)a[12]-b[12]-((uv>>32)&1);
+  d[12]=(word_type)uv;
+  uv=(double_word_type)a[13]-b[13]-((uv>>32)&1);
+  d[13]=(word_type)uv;
+  uv=(double_word_type)a[14]-b[14]-((uv>>32)&1);
+  d[14]=(word_type)uv;
+  uv=(double_word_type)a[15]-b[15]-((uv>>32)&1);
+  d[15]=(word_type)uv;
+  uv=(double_word_type)a[16]-b[16]-((uv>>32)&1);
+  d[16]=(word_type)uv;
+  //add p back on borrow
+  mask=(word_type)0-((word_type)(uv>>32)&1);
+  uv=(double_word_type)d[0]+(0xFFFFFFFF&mask);
+  r[0]=(word_type)uv;
+  uv=(double_word_type)d[1]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[1]=(word_type)uv;
+  uv=(double_word_type)d[2]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[2]=(word_type)uv;
+  uv=(double_word_type)d[3]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[3]=(word_type)uv;
+  uv=(double_word_type)d[4]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[4]=(word_type)uv;
+  uv=(double_word_type)d[5]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[5]=(word_type)uv;
+  uv=(double_word_type)d[6]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[6]=(word_type)uv;
+  uv=(double_word_type)d[7]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[7]=(word_type)uv;
+  uv=(double_word_type)d[8]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[8]=(word_type)uv;
+  uv=(double_word_type)d[9]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[9]=(word_type)uv;
+  uv=(double_word_type)d[10]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[10]=(word_type)uv;
+  uv=(double_word_type)d[11]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[11]=(word_type)uv;
+  uv=(double_word_type)d[12]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[12]=(word_type)uv;
+  uv=(double_word_type)d[13]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[13]=(word_type)uv;
+  uv=(double_word_type)d[14]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[14]=(word_type)uv;
+  uv=(double_word_type)d[15]+(0xFFFFFFFF&mask)+(uv>>32);
+  r[15]=(word_type)uv;
+  uv=(double_word_type)d[16]+(0x000001FF&mask)+(uv>>32);
+  r[16]=(word_type)uv;
+}
+
+//r=a^(2^count)
+static void soscl_ecc_p521r1_gen_nsqr(word_type *r,word_type *a,int count)
+{
+  int i;
+  soscl_ecc_p521r1_gen_sqr(r,a);
+  for(i=1;i<count;i++)
+    soscl_ecc_p521r1_gen_sqr(r,r);
+}
+
+//r=a^(p-2)=a^-1 mod p, 0 for a=0
+static void soscl_ecc_p521r1_gen_inv(word_type *r,word_type *a)
+{
+  word_type x2[17],x3[17],x4[17],x5[17],x8[17],x9[17],x16[17],x17[17],x32[17],x33[17],x64[17],x65[17],x129[17],x130[17],x259[17],x260[17],x519[17],t[17];
+  //x_k=a^(2^k-1)
+  soscl_ecc_p521r1_gen_nsqr(x2,a,1);
+  soscl_ecc_p521r1_gen_mul(x2,x2,a);
+  soscl_ecc_p521r1_gen_nsqr(x4,x2,2);
+  soscl_ecc_p521r1_gen_mul(x4,x4,x2);
+  soscl_ecc_p521r1_gen_nsqr(x8,x4,4);
+  soscl_ecc_p521r1_gen_mul(x8,x8,x4);
+  soscl_ecc_p521r1_gen_nsqr(x16,x8,8);
+  soscl_ecc_p521r1_gen_mul(x16,x16,x8);
+  soscl_ecc_p521r1_gen_nsqr(x32,x16,16);
+  soscl_ecc_p521r1_gen_mul(x32,x32,x16);
+  soscl_ecc_p521r1_gen_nsqr(x64,x32,32);
+  soscl_ecc_p521r1_gen_mul(x64,x64,x32);
+  soscl_ecc_p521r1_gen_nsqr(x3,a,2);
+  soscl_ecc_p521r1_gen_mul(x3,x3,x2);
+  soscl_ecc_p521r1_gen_nsqr(x5,x2,3);
+  soscl_ecc_p521r1_gen_mul(x5,x5,x3);
+  soscl_ecc_p521r1_gen_nsqr(x9,x4,5);
+  soscl_ecc_p521r1_gen_mul(x9,x9,x5);
+  soscl_ecc_p521r1_gen_nsqr(x17,x8,9);
+  soscl_ecc_p521r1_gen_mul(x17,x17,x9);
+  soscl_ecc_p521r1_gen_nsqr(x33,x16,17);
+  soscl_ecc_p521r1_gen_mul(x33,x33,x17);
+  soscl_ecc_p521r1_gen_nsqr(x65,x32,33);
+  soscl_ecc_p521r1_gen_mul(x65,x65,x33);
+  soscl_ecc_p521r1_gen_nsqr(x129,x64,65);
+  soscl_ecc_p521r1_gen_mul(x129,x129,x65);
+  soscl_ecc_p521r1_gen_nsqr(x130,x65,65);
+  soscl_ecc_p521r1_gen_mul(x130,x130,x65);
+  soscl_ecc_p521r1_gen_nsqr(x259,x129,130);
+  soscl_ecc_p521r1_gen_mul(x259,x259,x130);
+  soscl_ecc_p521r1_gen_nsqr(x260,x130,130);
+  soscl_ecc_p521r1_gen_mul(x260,x260,x130);
+  soscl_ecc_p521r1_gen_nsqr(x519,x259,260);
+  soscl_ecc_p521r1_gen_mul(x519,x519,x260);
+  soscl_bignum_memcpy(t,x519,17);
+  soscl_ecc_p521r1_gen_nsqr(t,t,1);
+  soscl_ecc_p521r1_gen_nsqr(t,t,1);
+  soscl_ecc_p521r1_gen_mul(t,t,a);
+  soscl_bignum_memcpy(r,t,17);
+}
+
+static int soscl_ecc_p521r1_gen_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_mul(r,a,b);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p521r1_gen_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_sqr(r,a);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p521r1_gen_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_add(r,a,b);
+  return(SOSCL_OK);
+}
+
+static void soscl_ecc_p521r1_gen_modsub(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_sub(r,a,b);
+}
+
+static int soscl_ecc_p521r1_gen_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_inv(r,a);
+  return(SOSCL_OK);
+}
+
+//numbers larger than p^2 go through the generic reduction
+static void soscl_ecc_p521r1_gen_modreduce(word_type *r,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  word_type t[34];
+  if(c_size>34)
+    {
+      soscl_ecc_mod(r,c,c_size,curve_params->p,curve_params->curve_wsize);
+      return;
+    }
+  soscl_bignum_set_zero(t,34);
+  soscl_bignum_memcpy(t,c,c_size);
+  soscl_ecc_p521r1_gen_reduce(r,t);
+}
+
+#endif//SOSCL_WORD32
+
+#ifdef SOSCL_WORD64
+static void soscl_ecc_p521r1_gen_reduce(word_type *r,word_type *c)
+{
+  word_type t[18],e[9],mask;
+  double_word_type uv;
+  //t=(c mod 2^521)+(c>>521), t<2^521+2^631
+  uv=(double_word_type)c[0]+((c[8]>>9)|(c[9]<<55));
+  t[0]=(word_type)uv;
+  uv=(double_word_type)c[1]+((c[9]>>9)|(c[10]<<55))+(uv>>64);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)c[2]+((c[10]>>9)|(c[11]<<55))+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)c[3]+((c[11]>>9)|(c[12]<<55))+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)c[4]+((c[12]>>9)|(c[13]<<55))+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)c[5]+((c[13]>>9)|(c[14]<<55))+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)c[6]+((c[14]>>9)|(c[15]<<55))+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)c[7]+((c[15]>>9)|(c[16]<<55))+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)(c[8]&0x00000000000001FF)+((c[16]>>9)|(c[17]<<55))+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)(c[17]>>9)+(uv>>64);
+  t[9]=(word_type)uv;
+  //t=(t mod 2^521)+(t>>521), t<2^521+2^111
+  uv=(double_word_type)t[0]+((t[8]>>9)|(t[9]<<55));
+  t[0]=(word_type)uv;
+  uv=(double_word_type)t[1]+(t[9]>>9)+(uv>>64);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)t[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)t[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)(t[8]&0x00000000000001FF)+(uv>>64);
+  t[8]=(word_type)uv;
+  //t=(t mod 2^521)+(t>>521), t<2^521+2^1
+  uv=(double_word_type)t[0]+(t[8]>>9);
+  t[0]=(word_type)uv;
+  uv=(double_word_type)t[1]+(uv>>64);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)t[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)t[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)(t[8]&0x00000000000001FF)+(uv>>64);
+  t[8]=(word_type)uv;
+  //t<2^521+2<2p
+  uv=(double_word_type)t[0]-0xFFFFFFFFFFFFFFFF;
+  e[0]=(word_type)uv;
+  uv=(double_word_type)t[1]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[1]=(word_type)uv;
+  uv=(double_word_type)t[2]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[2]=(word_type)uv;
+  uv=(double_word_type)t[3]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[3]=(word_type)uv;
+  uv=(double_word_type)t[4]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[4]=(word_type)uv;
+  uv=(double_word_type)t[5]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[5]=(word_type)uv;
+  uv=(double_word_type)t[6]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[6]=(word_type)uv;
+  uv=(double_word_type)t[7]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  e[7]=(word_type)uv;
+  uv=(double_word_type)t[8]-((uv>>64)&1)-0x00000000000001FF;
+  e[8]=(word_type)uv;
+  mask=(word_type)0-((word_type)(uv>>64)&1);
+  r[0]=(t[0]&mask)|(e[0]&~mask);
+  r[1]=(t[1]&mask)|(e[1]&~mask);
+  r[2]=(t[2]&mask)|(e[2]&~mask);
+  r[3]=(t[3]&mask)|(e[3]&~mask);
+  r[4]=(t[4]&mask)|(e[4]&~mask);
+  r[5]=(t[5]&mask)|(e[5]&~mask);
+  r[6]=(t[6]&mask)|(e[6]&~mask);
+  r[7]=(t[7]&mask)|(e[7]&~mask);
+  r[8]=(t[8]&mask)|(e[8]&~mask);
+}
+
+static void soscl_ecc_p521r1_gen_mul(word_type *r,word_type *a,word_type *b)
+{
+  word_type t[18];
+  double_word_type uv;
+  uv=(double_word_type)a[0]*b[0];
+  t[0]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[1]+(uv>>64);
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[0]*b[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  t[9]=(word_type)(uv>>64);
+  uv=(double_word_type)a[1]*b[0]+t[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[1]+t[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[2]+t[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[3]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[4]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[5]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[6]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[7]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[1]*b[8]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  t[10]=(word_type)(uv>>64);
+  uv=(double_word_type)a[2]*b[0]+t[2];
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[1]+t[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[2]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[3]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[4]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[5]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[6]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[7]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[2]*b[8]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  t[11]=(word_type)(uv>>64);
+  uv=(double_word_type)a[3]*b[0]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[1]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[2]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[3]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[4]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[5]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[6]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[7]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[3]*b[8]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  t[12]=(word_type)(uv>>64);
+  uv=(double_word_type)a[4]*b[0]+t[4];
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[1]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[2]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[3]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[4]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[5]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[6]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[7]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[4]*b[8]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  t[13]=(word_type)(uv>>64);
+  uv=(double_word_type)a[5]*b[0]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[1]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[2]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[3]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[4]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[5]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[6]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[7]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[5]*b[8]+t[13]+(uv>>64);
+  t[13]=(word_type)uv;
+  t[14]=(word_type)(uv>>64);
+  uv=(double_word_type)a[6]*b[0]+t[6];
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[1]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[2]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[3]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[4]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[5]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[6]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[7]+t[13]+(uv>>64);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[6]*b[8]+t[14]+(uv>>64);
+  t[14]=(word_type)uv;
+  t[15]=(word_type)(uv>>64);
+  uv=(double_word_type)a[7]*b[0]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[1]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[2]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[3]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[4]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[5]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[6]+t[13]+(uv>>64);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[7]+t[14]+(uv>>64);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[7]*b[8]+t[15]+(uv>>64);
+  t[15]=(word_type)uv;
+  t[16]=(word_type)(uv>>64);
+  uv=(double_word_type)a[8]*b[0]+t[8];
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[1]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[2]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[3]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[4]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[5]+t[13]+(uv>>64);
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[6]+t[14]+(uv>>64);
+  t[14]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[7]+t[15]+(uv>>64);
+  t[15]=(word_type)uv;
+  uv=(double_word_type)a[8]*b[8]+t[16]+(uv>>64);
+  t[16]=(word_type)uv;
+  t[17]=(word_type)(uv>>64);
+  soscl_ecc_p521r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p521r1_gen_sqr(word_type *r,word_type *a)
+{
+  word_type t[18];
+  double_word_type uv,acc;
+  //cross products
+  uv=(double_word_type)a[0]*a[1];
+  t[1]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[2]+(uv>>64);
+  t[2]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[3]+(uv>>64);
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[0]*a[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  t[9]=(word_type)(uv>>64);
+  uv=(double_word_type)a[1]*a[2]+t[3];
+  t[3]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[3]+t[4]+(uv>>64);
+  t[4]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[4]+t[5]+(uv>>64);
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[5]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[6]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[7]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[1]*a[8]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  t[10]=(word_type)(uv>>64);
+  uv=(double_word_type)a[2]*a[3]+t[5];
+  t[5]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[4]+t[6]+(uv>>64);
+  t[6]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[5]+t[7]+(uv>>64);
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[6]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[7]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[2]*a[8]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  t[11]=(word_type)(uv>>64);
+  uv=(double_word_type)a[3]*a[4]+t[7];
+  t[7]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[5]+t[8]+(uv>>64);
+  t[8]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[6]+t[9]+(uv>>64);
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[7]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[3]*a[8]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  t[12]=(word_type)(uv>>64);
+  uv=(double_word_type)a[4]*a[5]+t[9];
+  t[9]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[6]+t[10]+(uv>>64);
+  t[10]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[7]+t[11]+(uv>>64);
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[4]*a[8]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  t[13]=(word_type)(uv>>64);
+  uv=(double_word_type)a[5]*a[6]+t[11];
+  t[11]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[7]+t[12]+(uv>>64);
+  t[12]=(word_type)uv;
+  uv=(double_word_type)a[5]*a[8]+t[13]+(uv>>64);
+  t[13]=(word_type)uv;
+  t[14]=(word_type)(uv>>64);
+  uv=(double_word_type)a[6]*a[7]+t[13];
+  t[13]=(word_type)uv;
+  uv=(double_word_type)a[6]*a[8]+t[14]+(uv>>64);
+  t[14]=(word_type)uv;
+  t[15]=(word_type)(uv>>64);
+  uv=(double_word_type)a[7]*a[8]+t[15];
+  t[15]=(word_type)uv;
+  t[16]=(word_type)(uv>>64);
+  //doubling
+  t[17]=t[16]>>63;
+  t[16]=(t[16]<<1)|(t[15]>>63);
+  t[15]=(t[15]<<1)|(t[14]>>63);
+  t[14]=(t[14]<<1)|(t[13]>>63);
+  t[13]=(t[13]<<1)|(t[12]>>63);
+  t[12]=(t[12]<<1)|(t[11]>>63);
+  t[11]=(t[11]<<1)|(t[10]>>63);
+  t[10]=(t[10]<<1)|(t[9]>>63);
+  t[9]=(t[9]<<1)|(t[8]>>63);
+  t[8]=(t[8]<<1)|(t[7]>>63);
+  t[7]=(t[7]<<1)|(t[6]>>63);
+  t[6]=(t[6]<<1)|(t[5]>>63);
+  t[5]=(t[5]<<1)|(t[4]>>63);
+  t[4]=(t[4]<<1)|(t[3]>>63);
+  t[3]=(t[3]<<1)|(t[2]>>63);
+  t[2]=(t[2]<<1)|(t[1]>>63);
+  t[1]=t[1]<<1;
+  t[0]=0;
+  //squares
+  uv=(double_word_type)a[0]*a[0];
+  acc=(double_word_type)t[0]+(word_type)uv;
+  t[0]=(word_type)acc;
+  acc=(double_word_type)t[1]+(word_type)(uv>>64)+(acc>>64);
+  t[1]=(word_type)acc;
+  uv=(double_word_type)a[1]*a[1];
+  acc=(double_word_type)t[2]+(word_type)uv+(acc>>64);
+  t[2]=(word_type)acc;
+  acc=(double_word_type)t[3]+(word_type)(uv>>64)+(acc>>64);
+  t[3]=(word_type)acc;
+  uv=(double_word_type)a[2]*a[2];
+  acc=(double_word_type)t[4]+(word_type)uv+(acc>>64);
+  t[4]=(word_type)acc;
+  acc=(double_word_type)t[5]+(word_type)(uv>>64)+(acc>>64);
+  t[5]=(word_type)acc;
+  uv=(double_word_type)a[3]*a[3];
+  acc=(double_word_type)t[6]+(word_type)uv+(acc>>64);
+  t[6]=(word_type)acc;
+  acc=(double_word_type)t[7]+(word_type)(uv>>64)+(acc>>64);
+  t[7]=(word_type)acc;
+  uv=(double_word_type)a[4]*a[4];
+  acc=(double_word_type)t[8]+(word_type)uv+(acc>>64);
+  t[8]=(word_type)acc;
+  acc=(double_word_type)t[9]+(word_type)(uv>>64)+(acc>>64);
+  t[9]=(word_type)acc;
+  uv=(double_word_type)a[5]*a[5];
+  acc=(double_word_type)t[10]+(word_type)uv+(acc>>64);
+  t[10]=(word_type)acc;
+  acc=(double_word_type)t[11]+(word_type)(uv>>64)+(acc>>64);
+  t[11]=(word_type)acc;
+  uv=(double_word_type)a[6]*a[6];
+  acc=(double_word_type)t[12]+(word_type)uv+(acc>>64);
+  t[12]=(word_type)acc;
+  acc=(double_word_type)t[13]+(word_type)(uv>>64)+(acc>>64);
+  t[13]=(word_type)acc;
+  uv=(double_word_type)a[7]*a[7];
+  acc=(double_word_type)t[14]+(word_type)uv+(acc>>64);
+  t[14]=(word_type)acc;
+  acc=(double_word_type)t[15]+(word_type)(uv>>64)+(acc>>64);
+  t[15]=(word_type)acc;
+  uv=(double_word_type)a[8]*a[8];
+  acc=(double_word_type)t[16]+(word_type)uv+(acc>>64);
+  t[16]=(word_type)acc;
+  acc=(double_word_type)t[17]+(word_type)(uv>>64)+(acc>>64);
+  t[17]=(word_type)acc;
+  soscl_ecc_p521r1_gen_reduce(r,t);
+}
+
+static void soscl_ecc_p521r1_gen_add(word_type *r,word_type *a,word_type *b)
+{
+  word_type s[9],d[9],carry,mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]+b[0];
+  s[0]=(word_type)uv;
+  uv=(double_word_type)a[1]+b[1]+(uv>>64);
+  s[1]=(word_type)uv;
+  uv=(double_word_type)a[2]+b[2]+(uv>>64);
+  s[2]=(word_type)uv;
+  uv=(double_word_type)a[3]+b[3]+(uv>>64);
+  s[3]=(word_type)uv;
+  uv=(double_word_type)a[4]+b[4]+(uv>>64);
+  s[4]=(word_type)uv;
+  uv=(double_word_type)a[5]+b[5]+(uv>>64);
+  s[5]=(word_type)uv;
+  uv=(double_word_type)a[6]+b[6]+(uv>>64);
+  s[6]=(word_type)uv;
+  uv=(double_word_type)a[7]+b[7]+(uv>>64);
+  s[7]=(word_type)uv;
+  uv=(double_word_type)a[8]+b[8]+(uv>>64);
+  s[8]=(word_type)uv;
+  carry=(word_type)(uv>>64);
+  uv=(double_word_type)s[0]-0xFFFFFFFFFFFFFFFF;
+  d[0]=(word_type)uv;
+  uv=(double_word_type)s[1]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[1]=(word_type)uv;
+  uv=(double_word_type)s[2]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[2]=(word_type)uv;
+  uv=(double_word_type)s[3]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[3]=(word_type)uv;
+  uv=(double_word_type)s[4]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[4]=(word_type)uv;
+  uv=(double_word_type)s[5]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[5]=(word_type)uv;
+  uv=(double_word_type)s[6]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[6]=(word_type)uv;
+  uv=(double_word_type)s[7]-((uv>>64)&1)-0xFFFFFFFFFFFFFFFF;
+  d[7]=(word_type)uv;
+  uv=(double_word_type)s[8]-((uv>>64)&1)-0x00000000000001FF;
+  d[8]=(word_type)uv;
+  //keep a+b when a+b<p
+  mask=(word_type)0-((word_type)(uv>>64)&1&(carry^1));
+  r[0]=(s[0]&mask)|(d[0]&~mask);
+  r[1]=(s[1]&mask)|(d[1]&~mask);
+  r[2]=(s[2]&mask)|(d[2]&~mask);
+  r[3]=(s[3]&mask)|(d[3]&~mask);
+  r[4]=(s[4]&mask)|(d[4]&~mask);
+  r[5]=(s[5]&mask)|(d[5]&~mask);
+  r[6]=(s[6]&mask)|(d[6]&~mask);
+  r[7]=(s[7]&mask)|(d[7]&~mask);
+  r[8]=(s[8]&mask)|(d[8]&~mask);
+}
+
+static void soscl_ecc_p521r1_gen_sub(word_type *r,word_type *a,word_type *b)
+{
+  word_type d[9],mask;
+  double_word_type uv;
+  uv=(double_word_type)a[0]-b[0];
+  d[0]=(word_type)uv;
+  uv=(double_word_type)a[1]-b[1]-((uv>>64)&1);
+  d[1]=(word_type)uv;
+  uv=(double_word_type)a[2]-b[2]-((uv>>64)&1);
+  d[2]=(word_type)uv;
+  uv=(double_word_type)a[3]-b[3]-((uv>>64)&1);
+  d[3]=(word_type)uv;
+  uv=(double_word_type)a[4]-b[4]-((uv>>64)&1);
+  d[4]=(word_type)uv;
+  uv=(double_word_type)a[5]-b[5]-((uv>>64)&1);
+  d[5]=(word_type)uv;
+  uv=(double_word_type)a[6]-b[6]-((uv>>64)&1);
+  d[6]=(word_type)uv;
+  uv=(double_word_type)a[7]-b[7]-((uv>>64)&1);
+  d[7]=(word_type)uv;
+  uv=(double_word_type)a[8]-b[8]-((uv>>64)&1);
+  d[8]=(word_type)uv;
+  //add p back on borrow
+  mask=(word_type)0-((word_type)(uv>>64)&1);
+  uv=(double_word_type)d[0]+(0xFFFFFFFFFFFFFFFF&mask);
+  r[0]=(word_type)uv;
+  uv=(double_word_type)d[1]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[1]=(word_type)uv;
+  uv=(double_word_type)d[2]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[2]=(word_type)uv;
+  uv=(double_word_type)d[3]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[3]=(word_type)uv;
+  uv=(double_word_type)d[4]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[4]=(word_type)uv;
+  uv=(double_word_type)d[5]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[5]=(word_type)uv;
+  uv=(double_word_type)d[6]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[6]=(word_type)uv;
+  uv=(double_word_type)d[7]+(0xFFFFFFFFFFFFFFFF&mask)+(uv>>64);
+  r[7]=(word_type)uv;
+  uv=(double_word_type)d[8]+(0x00000000000001FF&mask)+(uv>>64);
+  r[8]=(word_type)uv;
+}
+
+//r=a^(2^count)
+static void soscl_ecc_p521r1_gen_nsqr(word_type *r,word_type *a,int count)
+{
+  int i;
+  soscl_ecc_p521r1_gen_sqr(r,a);
+  for(i=1;i<count;i++)
+    soscl_ecc_p521r1_gen_sqr(r,r);
+}
+
+//r=a^(p-2)=a^-1 mod p, 0 for a=0
+static void soscl_ecc_p521r1_gen_inv(word_type *r,word_type *a)
+{
+  word_type x2[9],x3[9],x4[9],x5[9],x8[9],x9[9],x16[9],x17[9],x32[9],x33[9],x64[9],x65[9],x129[9],x130[9],x259[9],x260[9],x519[9],t[9];
+  //x_k=a^(2^k-1)
+  soscl_ecc_p521r1_gen_nsqr(x2,a,1);
+  soscl_ecc_p521r1_gen_mul(x2,x2,a);
+  soscl_ecc_p521r1_gen_nsqr(x4,x2,2);
+  soscl_ecc_p521r1_gen_mul(x4,x4,x2);
+  soscl_ecc_p521r1_gen_nsqr(x8,x4,4);
+  soscl_ecc_p521r1_gen_mul(x8,x8,x4);
+  soscl_ecc_p521r1_gen_nsqr(x16,x8,8);
+  soscl_ecc_p521r1_gen_mul(x16,x16,x8);
+  soscl_ecc_p521r1_gen_nsqr(x32,x16,16);
+  soscl_ecc_p521r1_gen_mul(x32,x32,x16);
+  soscl_ecc_p521r1_gen_nsqr(x64,x32,32);
+  soscl_ecc_p521r1_gen_mul(x64,x64,x32);
+  soscl_ecc_p521r1_gen_nsqr(x3,a,2);
+  soscl_ecc_p521r1_gen_mul(x3,x3,x2);
+  soscl_ecc_p521r1_gen_nsqr(x5,x2,3);
+  soscl_ecc_p521r1_gen_mul(x5,x5,x3);
+  soscl_ecc_p521r1_gen_nsqr(x9,x4,5);
+  soscl_ecc_p521r1_gen_mul(x9,x9,x5);
+  soscl_ecc_p521r1_gen_nsqr(x17,x8,9);
+  soscl_ecc_p521r1_gen_mul(x17,x17,x9);
+  soscl_ecc_p521r1_gen_nsqr(x33,x16,17);
+  soscl_ecc_p521r1_gen_mul(x33,x33,x17);
+  soscl_ecc_p521r1_gen_nsqr(x65,x32,33);
+  soscl_ecc_p521r1_gen_mul(x65,x65,x33);
+  soscl_ecc_p521r1_gen_nsqr(x129,x64,65);
+  soscl_ecc_p521r1_gen_mul(x129,x129,x65);
+  soscl_ecc_p521r1_gen_nsqr(x130,x65,65);
+  soscl_ecc_p521r1_gen_mul(x130,x130,x65);
+  soscl_ecc_p521r1_gen_nsqr(x259,x129,130);
+  soscl_ecc_p521r1_gen_mul(x259,x259,x130);
+  soscl_ecc_p521r1_gen_nsqr(x260,x130,130);
+  soscl_ecc_p521r1_gen_mul(x260,x260,x130);
+  soscl_ecc_p521r1_gen_nsqr(x519,x259,260);
+  soscl_ecc_p521r1_gen_mul(x519,x519,x260);
+  soscl_bignum_memcpy(t,x519,9);
+  soscl_ecc_p521r1_gen_nsqr(t,t,1);
+  soscl_ecc_p521r1_gen_nsqr(t,t,1);
+  soscl_ecc_p521r1_gen_mul(t,t,a);
+  soscl_bignum_memcpy(r,t,9);
+}
+
+static int soscl_ecc_p521r1_gen_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_mul(r,a,b);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p521r1_gen_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_sqr(r,a);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_p521r1_gen_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_add(r,a,b);
+  return(SOSCL_OK);
+}
+
+static void soscl_ecc_p521r1_gen_modsub(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_sub(r,a,b);
+}
+
+static int soscl_ecc_p521r1_gen_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  (void)curve_params;
+  soscl_ecc_p521r1_gen_inv(r,a);
+  return(SOSCL_OK);
+}
+
+//numbers larger than p^2 go through the generic reduction
+static void soscl_ecc_p521r1_gen_modreduce(word_type *r,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  word_type t[18];
+  if(c_size>18)
+    {
+      soscl_ecc_mod(r,c,c_size,curve_params->p,curve_params->curve_wsize);
+      return;
+    }
+  soscl_bignum_set_zero(t,18);
+  soscl_bignum_memcpy(t,c,c_size);
+  soscl_ecc_p521r1_gen_reduce(r,t);
+}
+
+#endif//SOSCL_WORD64
+
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p521r1_generated={soscl_ecc_p521r1_gen_modmult,soscl_ecc_p521r1_gen_modsquare,soscl_ecc_p521r1_gen_modadd,soscl_ecc_p521r1_gen_modsub,soscl_ecc_p521r1_gen_modinv,soscl_ecc_p521r1_gen_modreduce};
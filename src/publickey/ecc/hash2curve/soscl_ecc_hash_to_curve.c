@@ -0,0 +1,459 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_hash_to_curve.c
+// implements the RFC 9380 hash_to_curve random oracle suites for the NIST curves:
+// P256_XMD:SHA-256_SSWU_RO_, P384_XMD:SHA-384_SSWU_RO_ and P521_XMD:SHA-512_SSWU_RO_
+// the map is straight-line (RFC 9380 F.2), the square root and the inversion being
+// computed with per-curve addition chains, in constant time
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_init.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_hash.h>
+#include <soscl/soscl_sha.h>
+#include <soscl/soscl_hash_sha256.h>
+#include <soscl/soscl_hash_sha384.h>
+#include <soscl/soscl_hash_sha512.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_hash_to_curve.h>
+
+extern int hash_size[SOSCL_HASH_FUNCTIONS_MAX_NB];
+extern int block_size[SOSCL_HASH_FUNCTIONS_MAX_NB];
+
+//the suite parameters: Z (as -z), c2=sqrt(-Z)
+typedef struct _soscl_t_ecc_h2c_suite
+{
+  int curve;
+  int algo;
+  int l;
+  word_type z;
+  const uint8_t *c2;
+  int c2_length;
+} soscl_type_ecc_h2c_suite;
+
+static const uint8_t soscl_ecc_h2c_p256_c2[SOSCL_SECP256R1_BYTESIZE]={0xda,0x53,0x8e,0x3b,0xe1,0xd8,0x9b,0x99,0xc9,0x78,0xfc,0x67,0x51,0x80,0xaa,0xb2,0x7b,0x8d,0x1f,0xf8,0x4c,0x55,0xd5,0xb6,0x2c,0xcd,0x34,0x27,0xe4,0x33,0xc4,0x7f};
+static const uint8_t soscl_ecc_h2c_p384_c2[SOSCL_SECP384R1_BYTESIZE]={0x2a,0xcc,0xb4,0xa6,0x56,0xb0,0x24,0x9c,0x71,0xf0,0x50,0x0e,0x83,0xda,0x2f,0xdd,0x7f,0x98,0xe3,0x83,0xd6,0x8b,0x53,0x87,0x1f,0x87,0x2f,0xcb,0x9c,0xcb,0x80,0xc5,0x3c,0x0d,0xe1,0xf8,0xa8,0x0f,0x7e,0x19,0x14,0xe2,0xec,0x69,0xf5,0xa6,0x26,0xb3};
+static const uint8_t soscl_ecc_h2c_p521_c2[1]={0x02};
+
+static const soscl_type_ecc_h2c_suite soscl_ecc_h2c_suites[]={
+  {SOSCL_SECP256R1,SOSCL_SHA256_ID,SOSCL_ECC_H2C_P256_L,10,soscl_ecc_h2c_p256_c2,sizeof(soscl_ecc_h2c_p256_c2)},
+  {SOSCL_SECP384R1,SOSCL_SHA384_ID,SOSCL_ECC_H2C_P384_L,12,soscl_ecc_h2c_p384_c2,sizeof(soscl_ecc_h2c_p384_c2)},
+  {SOSCL_SECP521R1,SOSCL_SHA512_ID,SOSCL_ECC_H2C_P521_L,4,soscl_ecc_h2c_p521_c2,sizeof(soscl_ecc_h2c_p521_c2)},
+};
+
+static const soscl_type_ecc_h2c_suite *soscl_ecc_h2c_suite(soscl_type_curve *curve_params)
+{
+  int i;
+  for(i=0;i<(int)(sizeof(soscl_ecc_h2c_suites)/sizeof(soscl_ecc_h2c_suites[0]));i++)
+    if(soscl_ecc_h2c_suites[i].curve==curve_params->curve)
+      return(&soscl_ecc_h2c_suites[i]);
+  return(NULL);
+}
+
+//1 if a==0, 0 otherwise, without branch
+static word_type soscl_ecc_h2c_iszero(word_type *a,int size)
+{
+  word_type acc;
+  int i;
+  for(acc=0,i=0;i<size;i++)
+    acc|=a[i];
+  return(((acc|(word_type)(0-acc))>>(SOSCL_WORD_BITS-1))^1);
+}
+
+static word_type soscl_ecc_h2c_equal(word_type *a,word_type *b,int size)
+{
+  word_type acc;
+  int i;
+  for(acc=0,i=0;i<size;i++)
+    acc|=a[i]^b[i];
+  return(((acc|(word_type)(0-acc))>>(SOSCL_WORD_BITS-1))^1);
+}
+
+//r=a if flag=1, r unchanged if flag=0
+static void soscl_ecc_h2c_cmov(word_type *r,word_type *a,word_type flag,int size)
+{
+  word_type mask;
+  int i;
+  mask=(word_type)0-flag;
+  for(i=0;i<size;i++)
+    r[i]^=mask&(r[i]^a[i]);
+}
+
+//r=a^((p-3)/4), with addition chains for the NIST primes
+//t shall be 6 words arrays
+//a^(p-2)=(a^((p-3)/4))^4.a, so that the same chain provides the inversion
+static void soscl_ecc_h2c_pow_c1(word_type *r,word_type *a,word_type *t,soscl_type_curve *curve_params)
+{
+  word_type *t0,*t1,*t2,*t3,*t4,*t5;
+  int curve_wsize,i;
+  curve_wsize=curve_params->curve_wsize;
+  t0=t;
+  t1=t0+curve_wsize;
+  t2=t1+curve_wsize;
+  t3=t2+curve_wsize;
+  t4=t3+curve_wsize;
+  t5=t4+curve_wsize;
+  switch(curve_params->curve)
+    {
+    case SOSCL_SECP256R1:
+      //(p-3)/4=((2^32-1).2^32+1).2^190+2^94-1
+      //t0=a^(2^2-1),t1=a^(2^4-1),t2=a^(2^8-1),t3=a^(2^16-1),t4=a^(2^32-1)
+      soscl_ecc_modsquare(t0,a,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare_n(t1,t0,2,curve_params);
+      soscl_ecc_modmult(t1,t1,t0,curve_params);
+      soscl_ecc_modsquare_n(t2,t1,4,curve_params);
+      soscl_ecc_modmult(t2,t2,t1,curve_params);
+      soscl_ecc_modsquare_n(t3,t2,8,curve_params);
+      soscl_ecc_modmult(t3,t3,t2,curve_params);
+      soscl_ecc_modsquare_n(t4,t3,16,curve_params);
+      soscl_ecc_modmult(t4,t4,t3,curve_params);
+      //t3=a^(2^30-1)
+      soscl_ecc_modsquare_n(t3,t3,8,curve_params);
+      soscl_ecc_modmult(t3,t3,t2,curve_params);
+      soscl_ecc_modsquare_n(t3,t3,4,curve_params);
+      soscl_ecc_modmult(t3,t3,t1,curve_params);
+      soscl_ecc_modsquare_n(t3,t3,2,curve_params);
+      soscl_ecc_modmult(t3,t3,t0,curve_params);
+      //t5=a^(2^64-1), then a^(2^94-1)
+      soscl_ecc_modsquare_n(t5,t4,32,curve_params);
+      soscl_ecc_modmult(t5,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,30,curve_params);
+      soscl_ecc_modmult(t5,t5,t3,curve_params);
+      soscl_ecc_modsquare_n(t0,t4,32,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare_n(t0,t0,190,curve_params);
+      soscl_ecc_modmult(r,t0,t5,curve_params);
+      break;
+    case SOSCL_SECP384R1:
+      //(p-3)/4=((2^255-1).2^33+2^32-1).2^94+2^30-1
+      //t0=a^(2^2-1),t1=a^(2^3-1)
+      soscl_ecc_modsquare(t0,a,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare(t1,t0,curve_params);
+      soscl_ecc_modmult(t1,t1,a,curve_params);
+      //t4=a^(2^6-1),t4=a^(2^12-1),t2=a^(2^15-1),t3=a^(2^30-1)
+      soscl_ecc_modsquare_n(t4,t1,3,curve_params);
+      soscl_ecc_modmult(t4,t4,t1,curve_params);
+      soscl_ecc_modsquare_n(t5,t4,6,curve_params);
+      soscl_ecc_modmult(t4,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t2,t4,3,curve_params);
+      soscl_ecc_modmult(t2,t2,t1,curve_params);
+      soscl_ecc_modsquare_n(t3,t2,15,curve_params);
+      soscl_ecc_modmult(t3,t3,t2,curve_params);
+      //t4=a^(2^60-1),t5=a^(2^120-1),t5=a^(2^240-1),t5=a^(2^255-1)
+      soscl_ecc_modsquare_n(t4,t3,30,curve_params);
+      soscl_ecc_modmult(t4,t4,t3,curve_params);
+      soscl_ecc_modsquare_n(t5,t4,60,curve_params);
+      soscl_ecc_modmult(t5,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t4,t5,120,curve_params);
+      soscl_ecc_modmult(t5,t4,t5,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,15,curve_params);
+      soscl_ecc_modmult(t5,t5,t2,curve_params);
+      //t4=a^(2^32-1)
+      soscl_ecc_modsquare_n(t4,t3,2,curve_params);
+      soscl_ecc_modmult(t4,t4,t0,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,33,curve_params);
+      soscl_ecc_modmult(t5,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,94,curve_params);
+      soscl_ecc_modmult(r,t5,t3,curve_params);
+      break;
+    case SOSCL_SECP521R1:
+      //(p-3)/4=2^519-1
+      //t0=a^(2^2-1),t1=a^(2^3-1),t2=a^(2^4-1),t1=a^(2^7-1),t2=a^(2^8-1)
+      soscl_ecc_modsquare(t0,a,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare(t1,t0,curve_params);
+      soscl_ecc_modmult(t1,t1,a,curve_params);
+      soscl_ecc_modsquare_n(t2,t0,2,curve_params);
+      soscl_ecc_modmult(t2,t2,t0,curve_params);
+      soscl_ecc_modsquare_n(t3,t2,3,curve_params);
+      soscl_ecc_modmult(t1,t3,t1,curve_params);
+      soscl_ecc_modsquare_n(t3,t2,4,curve_params);
+      soscl_ecc_modmult(t2,t3,t2,curve_params);
+      //t2=a^(2^16-1),...,a^(2^512-1)
+      for(i=8;i<512;i*=2)
+	{
+	  soscl_ecc_modsquare_n(t3,t2,i,curve_params);
+	  soscl_ecc_modmult(t2,t3,t2,curve_params);
+	}
+      soscl_ecc_modsquare_n(t2,t2,7,curve_params);
+      soscl_ecc_modmult(r,t2,t1,curve_params);
+      break;
+    default:
+      //left-to-right square and multiply, e=(p-3)/4=p>>2 as p=3 mod 4
+      soscl_bignum_rightshift(t5,curve_params->p,2,curve_wsize);
+      soscl_ecc_field_one(t1,curve_params);
+      for(i=curve_wsize*SOSCL_WORD_BITS-1;i>=0;i--)
+	{
+	  soscl_ecc_modsquare(t1,t1,curve_params);
+	  if(soscl_word_bit(t5,i))
+	    soscl_ecc_modmult(t1,t1,a,curve_params);
+	}
+      soscl_bignum_memcpy(r,t1,curve_wsize);
+      break;
+    }
+}
+
+//RFC 9380 5.3.1, output_length bytes from msg and the domain separation tag dst
+int soscl_ecc_expand_message_xmd(uint8_t *output,int output_length,uint8_t *msg,int msg_length,uint8_t *dst,int dst_length,int algo)
+{
+  uint8_t b0[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t bi[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t z_pad[SOSCL_HASH_BYTE_BLOCK_MAXSIZE];
+  uint8_t tmp[3];
+  int b_size,ell,i,j,len;
+  if(SOSCL_SHA256_ID!=algo && SOSCL_SHA384_ID!=algo && SOSCL_SHA512_ID!=algo)
+    return(SOSCL_INVALID_INPUT);
+  if((NULL==msg && 0!=msg_length) || msg_length<0 || NULL==dst || dst_length<0 || dst_length>SOSCL_ECC_H2C_DST_MAX_BYTESIZE)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==output || output_length<=0 || output_length>SOSCL_ECC_H2C_EXPAND_MAX_BYTESIZE)
+    return(SOSCL_INVALID_OUTPUT);
+  b_size=hash_size[algo];
+  ell=(output_length+b_size-1)/b_size;
+  if(ell>255)
+    return(SOSCL_INVALID_OUTPUT);
+  //b_0=H(Z_pad||msg||I2OSP(len_in_bytes,2)||I2OSP(0,1)||DST_prime)
+  soscl_memset(z_pad,0,block_size[algo]);
+  if(SOSCL_OK!=soscl_sha_init(algo))
+    return(SOSCL_ERROR);
+  soscl_sha_core(z_pad,block_size[algo]);
+  soscl_sha_core(msg,msg_length);
+  tmp[0]=(uint8_t)(output_length>>8);
+  tmp[1]=(uint8_t)output_length;
+  tmp[2]=0;
+  soscl_sha_core(tmp,3);
+  soscl_sha_core(dst,dst_length);
+  tmp[0]=(uint8_t)dst_length;
+  soscl_sha_core(tmp,1);
+  soscl_sha_finish(b0);
+  //b_i=H(strxor(b_0,b_(i-1))||I2OSP(i,1)||DST_prime), b_0 xor b_0=0 giving b_1
+  soscl_memset(bi,0,b_size);
+  for(i=1;i<=ell;i++)
+    {
+      for(j=0;j<b_size;j++)
+	bi[j]^=b0[j];
+      soscl_sha_init(algo);
+      soscl_sha_core(bi,b_size);
+      tmp[0]=(uint8_t)i;
+      soscl_sha_core(tmp,1);
+      soscl_sha_core(dst,dst_length);
+      tmp[0]=(uint8_t)dst_length;
+      soscl_sha_core(tmp,1);
+      soscl_sha_finish(bi);
+      len=(i<ell)?b_size:output_length-(ell-1)*b_size;
+      soscl_memcpy(output+(i-1)*b_size,bi,len);
+    }
+  return(SOSCL_OK);
+}
+
+//RFC 9380 5.2, count (1 or 2) field elements u, in the curve field domain
+int soscl_ecc_hash_to_field(word_type *u,int count,uint8_t *msg,int msg_length,uint8_t *dst,int dst_length,soscl_type_curve *curve_params)
+{
+  uint8_t uniform[2*SOSCL_ECC_H2C_MAX_L];
+  const soscl_type_ecc_h2c_suite *suite;
+  word_type *work;
+  int i,ret,curve_wsize;
+  if(NULL==curve_params || count<1 || count>2)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==u)
+    return(SOSCL_INVALID_OUTPUT);
+  suite=soscl_ecc_h2c_suite(curve_params);
+  if(NULL==suite)
+    return(SOSCL_INVALID_INPUT);
+  ret=soscl_ecc_expand_message_xmd(uniform,count*suite->l,msg,msg_length,dst,dst_length,suite->algo);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  curve_wsize=curve_params->curve_wsize;
+  if(soscl_stack_alloc(&work,2*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  //u_i=OS2IP(L bytes) mod p
+  for(i=0;i<count;i++)
+    {
+      soscl_bignum_b2w(work,2*curve_wsize,uniform+i*suite->l,suite->l);
+      ret=soscl_bignum_mod(u+i*curve_wsize,work,2*curve_wsize,curve_params->p,curve_wsize);
+      if(SOSCL_OK!=ret)
+	goto soscl_label_hash_to_field_end;
+      soscl_ecc_to_domain(u+i*curve_wsize,u+i*curve_wsize,curve_params);
+    }
+ soscl_label_hash_to_field_end:
+  if(soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
+//RFC 9380 6.6.2 simplified SWU, straight-line version of F.2 with sqrt_ratio for p=3 mod 4 (F.2.1.2)
+//u in the curve field domain, q=(x.tv4^2:y.tv4^3:tv4) so that no inversion is needed
+int soscl_ecc_map_to_curve_sswu(soscl_type_ecc_word_jacobian_point q,word_type *u,soscl_type_curve *curve_params)
+{
+  const soscl_type_ecc_h2c_suite *suite;
+  word_type *work,*tv1,*tv2,*tv3,*tv4,*tv5,*tv6,*y1,*y2,*z,*b,*c2,*chain;
+  word_type *a;
+  word_type is_qr,e;
+  int curve_wsize;
+  if(NULL==curve_params || NULL==u)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q.x || NULL==q.y || NULL==q.z)
+    return(SOSCL_INVALID_OUTPUT);
+  suite=soscl_ecc_h2c_suite(curve_params);
+  if(NULL==suite)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if(soscl_stack_alloc(&work,17*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  tv1=work;
+  tv2=tv1+curve_wsize;
+  tv3=tv2+curve_wsize;
+  tv4=tv3+curve_wsize;
+  tv5=tv4+curve_wsize;
+  tv6=tv5+curve_wsize;
+  y1=tv6+curve_wsize;
+  y2=y1+curve_wsize;
+  z=y2+curve_wsize;
+  b=z+curve_wsize;
+  c2=b+curve_wsize;
+  chain=c2+curve_wsize;
+  a=(NULL!=curve_params->a_domain)?curve_params->a_domain:curve_params->a;
+  //constants: Z=p-z, B and c2, in the field domain
+  soscl_bignum_set_one_word(tv1,suite->z,curve_wsize);
+  soscl_bignum_sub(z,curve_params->p,tv1,curve_wsize);
+  soscl_ecc_to_domain(z,z,curve_params);
+  soscl_ecc_to_domain(b,curve_params->b,curve_params);
+  soscl_bignum_b2w(c2,curve_wsize,(uint8_t*)suite->c2,suite->c2_length);
+  soscl_ecc_to_domain(c2,c2,curve_params);
+  //1-2. tv1=Z.u^2
+  soscl_ecc_modsquare(tv1,u,curve_params);
+  soscl_ecc_modmult(tv1,z,tv1,curve_params);
+  //3-4. tv2=tv1^2+tv1
+  soscl_ecc_modsquare(tv2,tv1,curve_params);
+  soscl_ecc_modadd(tv2,tv2,tv1,curve_params);
+  //5-6. tv3=B.(tv2+1)
+  soscl_ecc_field_one(tv5,curve_params);
+  soscl_ecc_modadd(tv3,tv2,tv5,curve_params);
+  soscl_ecc_modmult(tv3,b,tv3,curve_params);
+  //7-8. tv4=A.(tv2!=0?-tv2:Z)
+  soscl_bignum_memcpy(tv4,z,curve_wsize);
+  soscl_bignum_set_zero(tv5,curve_wsize);
+  soscl_ecc_modsub(tv5,tv5,tv2,curve_params);
+  soscl_ecc_h2c_cmov(tv4,tv5,soscl_ecc_h2c_iszero(tv2,curve_wsize)^1,curve_wsize);
+  soscl_ecc_modmult(tv4,a,tv4,curve_params);
+  //9-16. tv2=gx numerator=tv3^3+A.tv3.tv4^2+B.tv4^3, tv6=gx denominator=tv4^3
+  soscl_ecc_modsquare(tv2,tv3,curve_params);
+  soscl_ecc_modsquare(tv6,tv4,curve_params);
+  soscl_ecc_modmult(tv5,a,tv6,curve_params);
+  soscl_ecc_modadd(tv2,tv2,tv5,curve_params);
+  soscl_ecc_modmult(tv2,tv2,tv3,curve_params);
+  soscl_ecc_modmult(tv6,tv6,tv4,curve_params);
+  soscl_ecc_modmult(tv5,b,tv6,curve_params);
+  soscl_ecc_modadd(tv2,tv2,tv5,curve_params);
+  //17. x=tv1.tv3 (x2 numerator)
+  soscl_ecc_modmult(q.x,tv1,tv3,curve_params);
+  //18. sqrt_ratio(tv2,tv6): y1=(tv2.tv6^3)^c1.tv2.tv6, y2=y1.c2
+  soscl_ecc_modsquare(tv5,tv6,curve_params);
+  soscl_ecc_modmult(y2,tv2,tv6,curve_params);
+  soscl_ecc_modmult(tv5,tv5,y2,curve_params);
+  soscl_ecc_h2c_pow_c1(y1,tv5,chain,curve_params);
+  soscl_ecc_modmult(y1,y1,y2,curve_params);
+  soscl_ecc_modmult(y2,y1,c2,curve_params);
+  //is_qr=(y1^2.tv6==tv2)
+  soscl_ecc_modsquare(tv5,y1,curve_params);
+  soscl_ecc_modmult(tv5,tv5,tv6,curve_params);
+  is_qr=soscl_ecc_h2c_equal(tv5,tv2,curve_wsize);
+  soscl_ecc_h2c_cmov(y2,y1,is_qr,curve_wsize);
+  //19-22. y=tv1.u.y2 for x2, y=y1 for x1
+  soscl_ecc_modmult(q.y,tv1,u,curve_params);
+  soscl_ecc_modmult(q.y,q.y,y2,curve_params);
+  soscl_ecc_h2c_cmov(q.x,tv3,is_qr,curve_wsize);
+  soscl_ecc_h2c_cmov(q.y,y2,is_qr,curve_wsize);
+  //23-24. sgn0(y)=sgn0(u)
+  soscl_ecc_from_domain(tv1,u,curve_params);
+  soscl_ecc_from_domain(tv2,q.y,curve_params);
+  e=(tv1[0]^tv2[0])&1;
+  soscl_bignum_set_zero(tv5,curve_wsize);
+  soscl_ecc_modsub(tv5,tv5,q.y,curve_params);
+  soscl_ecc_h2c_cmov(q.y,tv5,e,curve_wsize);
+  //25. x=x/tv4, as jacobian coordinates
+  soscl_ecc_modmult(q.x,q.x,tv4,curve_params);
+  soscl_ecc_modmult(q.y,q.y,tv6,curve_params);
+  soscl_bignum_memcpy(q.z,tv4,curve_wsize);
+  if(soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//RFC 9380 3, hash_to_curve: q=map(u0)+map(u1), the cofactor being 1 for the NIST curves (clear_cofactor is the identity)
+//q.x and q.y are curve_bsize bytes large
+int soscl_ecc_hash_to_curve(soscl_type_ecc_uint8_t_affine_point q,uint8_t *msg,int msg_length,uint8_t *dst,int dst_length,soscl_type_curve *curve_params)
+{
+  word_type *work,*u,*zi,*t;
+  soscl_type_ecc_word_jacobian_point q0,q1,r;
+  int ret,curve_wsize;
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q.x || NULL==q.y)
+    return(SOSCL_INVALID_OUTPUT);
+  if(NULL==soscl_ecc_h2c_suite(curve_params))
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if(soscl_stack_alloc(&work,19*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  u=work;
+  q0.x=u+2*curve_wsize;
+  q0.y=q0.x+curve_wsize;
+  q0.z=q0.y+curve_wsize;
+  q1.x=q0.z+curve_wsize;
+  q1.y=q1.x+curve_wsize;
+  q1.z=q1.y+curve_wsize;
+  r.x=q1.z+curve_wsize;
+  r.y=r.x+curve_wsize;
+  r.z=r.y+curve_wsize;
+  zi=r.z+curve_wsize;
+  t=zi+curve_wsize;
+  ret=soscl_ecc_hash_to_field(u,2,msg,msg_length,dst,dst_length,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_hash_to_curve_end;
+  ret=soscl_ecc_map_to_curve_sswu(q0,u,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_hash_to_curve_end;
+  ret=soscl_ecc_map_to_curve_sswu(q1,u+curve_wsize,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_hash_to_curve_end;
+  ret=soscl_ecc_add_jacobian_jacobian(r,q0,q1,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_hash_to_curve_end;
+  //the identity has no affine encoding (negligible probability)
+  if(SOSCL_TRUE==soscl_ecc_infinite_jacobian(r,curve_params))
+    {
+      ret=SOSCL_ERROR;
+      goto soscl_label_hash_to_curve_end;
+    }
+  //zi=z^(p-2)=(z^c1)^4.z
+  soscl_ecc_h2c_pow_c1(zi,r.z,t+curve_wsize,curve_params);
+  soscl_ecc_modsquare_n(zi,zi,2,curve_params);
+  soscl_ecc_modmult(zi,zi,r.z,curve_params);
+  soscl_ecc_modsquare(t,zi,curve_params);
+  soscl_ecc_modmult(r.x,r.x,t,curve_params);
+  soscl_ecc_modmult(t,t,zi,curve_params);
+  soscl_ecc_modmult(r.y,r.y,t,curve_params);
+  soscl_ecc_from_domain(r.x,r.x,curve_params);
+  soscl_ecc_from_domain(r.y,r.y,curve_params);
+  soscl_bignum_w2b(q.x,curve_params->curve_bsize,r.x,curve_wsize);
+  soscl_bignum_w2b(q.y,curve_params->curve_bsize,r.y,curve_wsize);
+ soscl_label_hash_to_curve_end:
+  if(soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
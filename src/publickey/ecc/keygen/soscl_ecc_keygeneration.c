@@ -47,14 +47,17 @@ int soscl_ecc_point_on_curve(soscl_type_ecc_uint8_t_affine_point q,soscl_type_cu
       ret=SOSCL_INVALID_OUTPUT;
       goto esepoc;
     }
-  //y^2=a.x+x^3+b
-  soscl_bignum_modmult(comput,wordx,wordx,curve_params->p,wsize);
-  soscl_bignum_modmult(comput,comput,wordx,curve_params->p,wsize);
-  soscl_bignum_modmult(comput2,wordx,curve_params->a,curve_params->p,wsize);
-  soscl_bignum_modadd(comput,comput,comput2,curve_params->p,wsize);
-  soscl_bignum_modadd(comput,comput,curve_params->b,curve_params->p,wsize);
-  soscl_bignum_modmult(comput2,wordy,wordy,curve_params->p,wsize);
-
+  //y^2=(x^2+a).x+b, computed in the curve field domain
+  soscl_ecc_to_domain(wordx,wordx,curve_params);
+  soscl_ecc_modsquare(comput,wordx,curve_params);
+  soscl_ecc_modadd(comput,comput,(NULL!=curve_params->a_domain)?curve_params->a_domain:curve_params->a,curve_params);
+  soscl_ecc_modmult(comput,comput,wordx,curve_params);
+  soscl_ecc_to_domain(comput2,curve_params->b,curve_params);
+  soscl_ecc_modadd(comput,comput,comput2,curve_params);
+  soscl_ecc_to_domain(wordy,wordy,curve_params);
+  soscl_ecc_modsquare(comput2,wordy,curve_params);
+  soscl_ecc_from_domain(comput,comput,curve_params);
+  soscl_ecc_from_domain(comput2,comput2,curve_params);
   if(soscl_bignum_memcmp(comput2,comput,wsize)!=0)
     {
       ret=SOSCL_INVALID_OUTPUT;
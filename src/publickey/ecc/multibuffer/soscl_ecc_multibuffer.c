@@ -0,0 +1,873 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_multibuffer.c
+// multi-buffer scalar multiplication: 4 or 8 independent (k,P) pairs run
+// the co-Z Montgomery ladder (Rivain, algorithm 9) in lockstep
+// the lanes are transposed, word i of lane l being at [i*lanes+l], so that every field operation
+// works on all the lanes at once with no lane dependent branch or address
+// the field operations engine is selected at init time: AVX-512 (8 lanes), AVX2 (4 lanes),
+// or the portable C loops (4 lanes) otherwise
+// the scalars are regularised to n+1 bits (k+n or k+2n), so that all lanes have the same ladder length
+// the field arithmetic is a lane-wise Montgomery multiplication, in a domain private to this file
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_init.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_multibuffer.h>
+
+#ifdef SOSCL_ECC_MULTIBUFFER_AVX
+#include <immintrin.h>
+#endif
+
+#define SOSCL_MB_MAX_LANES 8
+#define SOSCL_MB_MAX_WSIZE SOSCL_ECDSA_MAX_WORDSIZE
+
+typedef struct soscl_ecc_multibuffer_field soscl_type_ecc_multibuffer_field;
+
+//r=op(a,b) in every lane
+typedef void (*soscl_ecc_mb_function_t)(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f);
+
+typedef struct soscl_ecc_multibuffer_engine soscl_type_ecc_multibuffer_engine;
+
+struct soscl_ecc_multibuffer_engine
+{
+  soscl_ecc_mb_function_t modmult;
+  soscl_ecc_mb_function_t modadd;
+  soscl_ecc_mb_function_t modsub;
+  int lanes;
+  //fewer lanes engine, used when the work buffer does not fit in the stack
+  const soscl_type_ecc_multibuffer_engine *narrower;
+};
+
+struct soscl_ecc_multibuffer_field
+{
+  word_type *p;
+  word_type p_inv;//-p^-1 mod 2^SOSCL_WORD_BITS
+  int wsize;
+  int lanes;
+  word_type *t;//multiplication buffer of the C engine, (wsize+2) words per lane
+  word_type *a;//a, in the lanes domain
+  const soscl_type_ecc_multibuffer_engine *engine;
+};
+
+//r=a.b.2^(-wsize*SOSCL_WORD_BITS) mod p, lane-wise CIOS Montgomery multiplication
+static void soscl_ecc_mb_modmult_c(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type c[SOSCL_MB_MAX_LANES],m[SOSCL_MB_MAX_LANES],mask[SOSCL_MB_MAX_LANES];
+  double_word_type uv;
+  word_type *t;
+  int i,j,l,w,lanes;
+  t=f->t;
+  w=f->wsize;
+  lanes=f->lanes;
+  for(j=0;j<(w+2)*lanes;j++)
+    t[j]=0;
+  for(i=0;i<w;i++)
+    {
+      //t+=a.b[i]
+      for(l=0;l<lanes;l++)
+	c[l]=0;
+      for(j=0;j<w;j++)
+	for(l=0;l<lanes;l++)
+	  {
+	    uv=(double_word_type)a[j*lanes+l]*b[i*lanes+l]+t[j*lanes+l]+c[l];
+	    t[j*lanes+l]=(word_type)uv;
+	    c[l]=(word_type)(uv>>SOSCL_WORD_BITS);
+	  }
+      for(l=0;l<lanes;l++)
+	{
+	  uv=(double_word_type)t[w*lanes+l]+c[l];
+	  t[w*lanes+l]=(word_type)uv;
+	  t[(w+1)*lanes+l]=(word_type)(uv>>SOSCL_WORD_BITS);
+	}
+      //t=(t+m.p)/2^SOSCL_WORD_BITS
+      for(l=0;l<lanes;l++)
+	{
+	  m[l]=t[l]*f->p_inv;
+	  uv=(double_word_type)m[l]*f->p[0]+t[l];
+	  c[l]=(word_type)(uv>>SOSCL_WORD_BITS);
+	}
+      for(j=1;j<w;j++)
+	for(l=0;l<lanes;l++)
+	  {
+	    uv=(double_word_type)m[l]*f->p[j]+t[j*lanes+l]+c[l];
+	    t[(j-1)*lanes+l]=(word_type)uv;
+	    c[l]=(word_type)(uv>>SOSCL_WORD_BITS);
+	  }
+      for(l=0;l<lanes;l++)
+	{
+	  uv=(double_word_type)t[w*lanes+l]+c[l];
+	  t[(w-1)*lanes+l]=(word_type)uv;
+	  t[w*lanes+l]=t[(w+1)*lanes+l]+(word_type)(uv>>SOSCL_WORD_BITS);
+	}
+    }
+  //t<2p, r=t-p unless t<p
+  for(l=0;l<lanes;l++)
+    c[l]=0;
+  for(j=0;j<w;j++)
+    for(l=0;l<lanes;l++)
+      {
+	uv=(double_word_type)t[j*lanes+l]-f->p[j]-c[l];
+	r[j*lanes+l]=(word_type)uv;
+	c[l]=(word_type)(uv>>SOSCL_WORD_BITS)&1;
+      }
+  for(l=0;l<lanes;l++)
+    mask[l]=(word_type)0-(c[l]&(t[w*lanes+l]^1));
+  for(j=0;j<w;j++)
+    for(l=0;l<lanes;l++)
+      r[j*lanes+l]=(t[j*lanes+l]&mask[l])|(r[j*lanes+l]&~mask[l]);
+}
+
+//r=a+b mod p, a and b<p
+static void soscl_ecc_mb_modadd_c(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type c[SOSCL_MB_MAX_LANES],d[SOSCL_MB_MAX_LANES],mask[SOSCL_MB_MAX_LANES],s;
+  double_word_type uv;
+  int j,l,w,lanes;
+  w=f->wsize;
+  lanes=f->lanes;
+  for(l=0;l<lanes;l++)
+    {
+      c[l]=0;
+      d[l]=0;
+    }
+  //r=a+b, the borrow of a+b-p is in d
+  for(j=0;j<w;j++)
+    for(l=0;l<lanes;l++)
+      {
+	uv=(double_word_type)a[j*lanes+l]+b[j*lanes+l]+c[l];
+	s=(word_type)uv;
+	c[l]=(word_type)(uv>>SOSCL_WORD_BITS);
+	r[j*lanes+l]=s;
+	uv=(double_word_type)s-f->p[j]-d[l];
+	d[l]=(word_type)(uv>>SOSCL_WORD_BITS)&1;
+      }
+  //subtract p when a+b>=p
+  for(l=0;l<lanes;l++)
+    {
+      mask[l]=(word_type)0-((d[l]&(c[l]^1))^1);
+      d[l]=0;
+    }
+  for(j=0;j<w;j++)
+    for(l=0;l<lanes;l++)
+      {
+	uv=(double_word_type)r[j*lanes+l]-(f->p[j]&mask[l])-d[l];
+	r[j*lanes+l]=(word_type)uv;
+	d[l]=(word_type)(uv>>SOSCL_WORD_BITS)&1;
+      }
+}
+
+//r=a-b mod p, a and b<p
+static void soscl_ecc_mb_modsub_c(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type c[SOSCL_MB_MAX_LANES],mask[SOSCL_MB_MAX_LANES];
+  double_word_type uv;
+  int j,l,w,lanes;
+  w=f->wsize;
+  lanes=f->lanes;
+  for(l=0;l<lanes;l++)
+    c[l]=0;
+  for(j=0;j<w;j++)
+    for(l=0;l<lanes;l++)
+      {
+	uv=(double_word_type)a[j*lanes+l]-b[j*lanes+l]-c[l];
+	r[j*lanes+l]=(word_type)uv;
+	c[l]=(word_type)(uv>>SOSCL_WORD_BITS)&1;
+      }
+  //add p back on borrow
+  for(l=0;l<lanes;l++)
+    {
+      mask[l]=(word_type)0-c[l];
+      c[l]=0;
+    }
+  for(j=0;j<w;j++)
+    for(l=0;l<lanes;l++)
+      {
+	uv=(double_word_type)r[j*lanes+l]+(f->p[j]&mask[l])+c[l];
+	r[j*lanes+l]=(word_type)uv;
+	c[l]=(word_type)(uv>>SOSCL_WORD_BITS);
+      }
+}
+
+#ifdef SOSCL_ECC_MULTIBUFFER_AVX
+//the SIMD engines hold a lane word zero extended in a 64 bits element: the 32x32 bits products
+//of all the lanes are then a single _mm256_mul_epu32/_mm512_mul_epu32, the carries being in the upper halves
+//and the borrows in the sign bits
+#define SOSCL_MB_X4_LOAD(a) _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(a)))
+#define SOSCL_MB_X4_STORE(r,x) _mm_storeu_si128((__m128i*)(r),_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(x,even)))
+#define SOSCL_MB_X8_LOAD(a) _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)(a)))
+#define SOSCL_MB_X8_STORE(r,x) _mm256_storeu_si256((__m256i*)(r),_mm512_cvtepi64_epi32(x))
+
+//4 lanes versions of the C engine operations, AVX2
+__attribute__((target("avx2")))
+static void soscl_ecc_mb_modmult_x4(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  __m256i x[SOSCL_MB_MAX_WSIZE],p[SOSCL_MB_MAX_WSIZE],t[SOSCL_MB_MAX_WSIZE+2];
+  __m256i y,m,c,uv,low,p_inv,zero,even;
+  int i,j,w;
+  w=f->wsize;
+  low=_mm256_set1_epi64x(0xFFFFFFFF);
+  zero=_mm256_setzero_si256();
+  p_inv=_mm256_set1_epi64x(f->p_inv);
+  even=_mm256_set_epi32(7,5,3,1,6,4,2,0);
+  for(j=0;j<w;j++)
+    {
+      x[j]=SOSCL_MB_X4_LOAD(a+4*j);
+      p[j]=_mm256_set1_epi64x(f->p[j]);
+      t[j]=zero;
+    }
+  t[w]=zero;
+  t[w+1]=zero;
+  for(i=0;i<w;i++)
+    {
+      //t+=a.b[i]
+      y=SOSCL_MB_X4_LOAD(b+4*i);
+      c=zero;
+      for(j=0;j<w;j++)
+	{
+	  uv=_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(x[j],y),t[j]),c);
+	  t[j]=_mm256_and_si256(uv,low);
+	  c=_mm256_srli_epi64(uv,32);
+	}
+      uv=_mm256_add_epi64(t[w],c);
+      t[w]=_mm256_and_si256(uv,low);
+      t[w+1]=_mm256_srli_epi64(uv,32);
+      //t=(t+m.p)/2^SOSCL_WORD_BITS, _mm256_mul_epu32 only reads the low halves of m
+      m=_mm256_mul_epu32(t[0],p_inv);
+      c=_mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epu32(m,p[0]),t[0]),32);
+      for(j=1;j<w;j++)
+	{
+	  uv=_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(m,p[j]),t[j]),c);
+	  t[j-1]=_mm256_and_si256(uv,low);
+	  c=_mm256_srli_epi64(uv,32);
+	}
+      uv=_mm256_add_epi64(t[w],c);
+      t[w-1]=_mm256_and_si256(uv,low);
+      t[w]=_mm256_add_epi64(t[w+1],_mm256_srli_epi64(uv,32));
+    }
+  //t<2p, r=t-p unless t<p
+  c=zero;
+  for(j=0;j<w;j++)
+    {
+      uv=_mm256_sub_epi64(_mm256_sub_epi64(t[j],p[j]),c);
+      x[j]=uv;
+      c=_mm256_srli_epi64(uv,63);
+    }
+  m=_mm256_sub_epi64(zero,_mm256_andnot_si256(t[w],c));
+  for(j=0;j<w;j++)
+    {
+      uv=_mm256_or_si256(_mm256_and_si256(t[j],m),_mm256_andnot_si256(m,x[j]));
+      SOSCL_MB_X4_STORE(r+4*j,uv);
+    }
+}
+
+__attribute__((target("avx2")))
+static void soscl_ecc_mb_modadd_x4(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  __m256i s[SOSCL_MB_MAX_WSIZE],p[SOSCL_MB_MAX_WSIZE];
+  __m256i c,d,m,uv,low,one,zero,even;
+  int j,w;
+  w=f->wsize;
+  low=_mm256_set1_epi64x(0xFFFFFFFF);
+  one=_mm256_set1_epi64x(1);
+  zero=_mm256_setzero_si256();
+  even=_mm256_set_epi32(7,5,3,1,6,4,2,0);
+  c=zero;
+  d=zero;
+  //s=a+b, the borrow of a+b-p is in d
+  for(j=0;j<w;j++)
+    {
+      p[j]=_mm256_set1_epi64x(f->p[j]);
+      uv=_mm256_add_epi64(_mm256_add_epi64(SOSCL_MB_X4_LOAD(a+4*j),SOSCL_MB_X4_LOAD(b+4*j)),c);
+      s[j]=_mm256_and_si256(uv,low);
+      c=_mm256_srli_epi64(uv,32);
+      d=_mm256_srli_epi64(_mm256_sub_epi64(_mm256_sub_epi64(s[j],p[j]),d),63);
+    }
+  //subtract p when a+b>=p
+  m=_mm256_sub_epi64(zero,_mm256_xor_si256(_mm256_andnot_si256(c,d),one));
+  d=zero;
+  for(j=0;j<w;j++)
+    {
+      uv=_mm256_sub_epi64(_mm256_sub_epi64(s[j],_mm256_and_si256(p[j],m)),d);
+      SOSCL_MB_X4_STORE(r+4*j,uv);
+      d=_mm256_srli_epi64(uv,63);
+    }
+}
+
+__attribute__((target("avx2")))
+static void soscl_ecc_mb_modsub_x4(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  __m256i s[SOSCL_MB_MAX_WSIZE],p[SOSCL_MB_MAX_WSIZE];
+  __m256i c,m,uv,low,zero,even;
+  int j,w;
+  w=f->wsize;
+  low=_mm256_set1_epi64x(0xFFFFFFFF);
+  zero=_mm256_setzero_si256();
+  even=_mm256_set_epi32(7,5,3,1,6,4,2,0);
+  c=zero;
+  for(j=0;j<w;j++)
+    {
+      p[j]=_mm256_set1_epi64x(f->p[j]);
+      uv=_mm256_sub_epi64(_mm256_sub_epi64(SOSCL_MB_X4_LOAD(a+4*j),SOSCL_MB_X4_LOAD(b+4*j)),c);
+      s[j]=_mm256_and_si256(uv,low);
+      c=_mm256_srli_epi64(uv,63);
+    }
+  //add p back on borrow
+  m=_mm256_sub_epi64(zero,c);
+  c=zero;
+  for(j=0;j<w;j++)
+    {
+      uv=_mm256_add_epi64(_mm256_add_epi64(s[j],_mm256_and_si256(p[j],m)),c);
+      SOSCL_MB_X4_STORE(r+4*j,uv);
+      c=_mm256_srli_epi64(uv,32);
+    }
+}
+
+//8 lanes versions, AVX-512
+__attribute__((target("avx2,avx512f")))
+static void soscl_ecc_mb_modmult_x8(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  __m512i x[SOSCL_MB_MAX_WSIZE],p[SOSCL_MB_MAX_WSIZE],t[SOSCL_MB_MAX_WSIZE+2];
+  __m512i y,m,c,uv,low,p_inv,zero;
+  int i,j,w;
+  w=f->wsize;
+  low=_mm512_set1_epi64(0xFFFFFFFF);
+  zero=_mm512_setzero_si512();
+  p_inv=_mm512_set1_epi64(f->p_inv);
+  for(j=0;j<w;j++)
+    {
+      x[j]=SOSCL_MB_X8_LOAD(a+8*j);
+      p[j]=_mm512_set1_epi64(f->p[j]);
+      t[j]=zero;
+    }
+  t[w]=zero;
+  t[w+1]=zero;
+  for(i=0;i<w;i++)
+    {
+      //t+=a.b[i]
+      y=SOSCL_MB_X8_LOAD(b+8*i);
+      c=zero;
+      for(j=0;j<w;j++)
+	{
+	  uv=_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(x[j],y),t[j]),c);
+	  t[j]=_mm512_and_si512(uv,low);
+	  c=_mm512_srli_epi64(uv,32);
+	}
+      uv=_mm512_add_epi64(t[w],c);
+      t[w]=_mm512_and_si512(uv,low);
+      t[w+1]=_mm512_srli_epi64(uv,32);
+      //t=(t+m.p)/2^SOSCL_WORD_BITS
+      m=_mm512_mul_epu32(t[0],p_inv);
+      c=_mm512_srli_epi64(_mm512_add_epi64(_mm512_mul_epu32(m,p[0]),t[0]),32);
+      for(j=1;j<w;j++)
+	{
+	  uv=_mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(m,p[j]),t[j]),c);
+	  t[j-1]=_mm512_and_si512(uv,low);
+	  c=_mm512_srli_epi64(uv,32);
+	}
+      uv=_mm512_add_epi64(t[w],c);
+      t[w-1]=_mm512_and_si512(uv,low);
+      t[w]=_mm512_add_epi64(t[w+1],_mm512_srli_epi64(uv,32));
+    }
+  //t<2p, r=t-p unless t<p
+  c=zero;
+  for(j=0;j<w;j++)
+    {
+      uv=_mm512_sub_epi64(_mm512_sub_epi64(t[j],p[j]),c);
+      x[j]=uv;
+      c=_mm512_srli_epi64(uv,63);
+    }
+  m=_mm512_sub_epi64(zero,_mm512_andnot_si512(t[w],c));
+  for(j=0;j<w;j++)
+    {
+      uv=_mm512_or_si512(_mm512_and_si512(t[j],m),_mm512_andnot_si512(m,x[j]));
+      SOSCL_MB_X8_STORE(r+8*j,uv);
+    }
+}
+
+__attribute__((target("avx2,avx512f")))
+static void soscl_ecc_mb_modadd_x8(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  __m512i s[SOSCL_MB_MAX_WSIZE],p[SOSCL_MB_MAX_WSIZE];
+  __m512i c,d,m,uv,low,one,zero;
+  int j,w;
+  w=f->wsize;
+  low=_mm512_set1_epi64(0xFFFFFFFF);
+  one=_mm512_set1_epi64(1);
+  zero=_mm512_setzero_si512();
+  c=zero;
+  d=zero;
+  //s=a+b, the borrow of a+b-p is in d
+  for(j=0;j<w;j++)
+    {
+      p[j]=_mm512_set1_epi64(f->p[j]);
+      uv=_mm512_add_epi64(_mm512_add_epi64(SOSCL_MB_X8_LOAD(a+8*j),SOSCL_MB_X8_LOAD(b+8*j)),c);
+      s[j]=_mm512_and_si512(uv,low);
+      c=_mm512_srli_epi64(uv,32);
+      d=_mm512_srli_epi64(_mm512_sub_epi64(_mm512_sub_epi64(s[j],p[j]),d),63);
+    }
+  //subtract p when a+b>=p
+  m=_mm512_sub_epi64(zero,_mm512_xor_si512(_mm512_andnot_si512(c,d),one));
+  d=zero;
+  for(j=0;j<w;j++)
+    {
+      uv=_mm512_sub_epi64(_mm512_sub_epi64(s[j],_mm512_and_si512(p[j],m)),d);
+      SOSCL_MB_X8_STORE(r+8*j,uv);
+      d=_mm512_srli_epi64(uv,63);
+    }
+}
+
+__attribute__((target("avx2,avx512f")))
+static void soscl_ecc_mb_modsub_x8(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  __m512i s[SOSCL_MB_MAX_WSIZE],p[SOSCL_MB_MAX_WSIZE];
+  __m512i c,m,uv,low,zero;
+  int j,w;
+  w=f->wsize;
+  low=_mm512_set1_epi64(0xFFFFFFFF);
+  zero=_mm512_setzero_si512();
+  c=zero;
+  for(j=0;j<w;j++)
+    {
+      p[j]=_mm512_set1_epi64(f->p[j]);
+      uv=_mm512_sub_epi64(_mm512_sub_epi64(SOSCL_MB_X8_LOAD(a+8*j),SOSCL_MB_X8_LOAD(b+8*j)),c);
+      s[j]=_mm512_and_si512(uv,low);
+      c=_mm512_srli_epi64(uv,63);
+    }
+  //add p back on borrow
+  m=_mm512_sub_epi64(zero,c);
+  c=zero;
+  for(j=0;j<w;j++)
+    {
+      uv=_mm512_add_epi64(_mm512_add_epi64(s[j],_mm512_and_si512(p[j],m)),c);
+      SOSCL_MB_X8_STORE(r+8*j,uv);
+      c=_mm512_srli_epi64(uv,32);
+    }
+}
+
+static const soscl_type_ecc_multibuffer_engine soscl_ecc_mb_engine_x4={soscl_ecc_mb_modmult_x4,soscl_ecc_mb_modadd_x4,soscl_ecc_mb_modsub_x4,4,NULL};
+static const soscl_type_ecc_multibuffer_engine soscl_ecc_mb_engine_x8={soscl_ecc_mb_modmult_x8,soscl_ecc_mb_modadd_x8,soscl_ecc_mb_modsub_x8,8,&soscl_ecc_mb_engine_x4};
+#endif//SOSCL_ECC_MULTIBUFFER_AVX
+
+static const soscl_type_ecc_multibuffer_engine soscl_ecc_mb_engine_c={soscl_ecc_mb_modmult_c,soscl_ecc_mb_modadd_c,soscl_ecc_mb_modsub_c,4,NULL};
+
+//engine in use, set by soscl_ecc_mult_multi_set_implementation
+static const soscl_type_ecc_multibuffer_engine *soscl_ecc_mb_engine=&soscl_ecc_mb_engine_c;
+
+int soscl_ecc_mult_multi_set_implementation(int implementation)
+{
+  switch(implementation)
+    {
+    case SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_C:
+      soscl_ecc_mb_engine=&soscl_ecc_mb_engine_c;
+      return(SOSCL_OK);
+    case SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX2:
+#ifdef SOSCL_ECC_MULTIBUFFER_AVX
+      if(!__builtin_cpu_supports("avx2"))
+	return(SOSCL_INVALID_MODE);
+      soscl_ecc_mb_engine=&soscl_ecc_mb_engine_x4;
+      return(SOSCL_OK);
+#else
+      return(SOSCL_INVALID_MODE);
+#endif
+    case SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX512:
+#ifdef SOSCL_ECC_MULTIBUFFER_AVX
+      //the 8 lanes engine falls back on the AVX2 one
+      if(!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx2"))
+	return(SOSCL_INVALID_MODE);
+      soscl_ecc_mb_engine=&soscl_ecc_mb_engine_x8;
+      return(SOSCL_OK);
+#else
+      return(SOSCL_INVALID_MODE);
+#endif
+    default:
+      return(SOSCL_INVALID_INPUT);
+    }
+}
+
+//selects the widest engine supported by the CPU, called by soscl_init
+void soscl_ecc_mult_multi_select_implementation(void)
+{
+  if(SOSCL_OK==soscl_ecc_mult_multi_set_implementation(SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX512))
+    return;
+  if(SOSCL_OK==soscl_ecc_mult_multi_set_implementation(SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX2))
+    return;
+  soscl_ecc_mult_multi_set_implementation(SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_C);
+}
+
+static void soscl_ecc_mb_modmult(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  f->engine->modmult(r,a,b,f);
+}
+
+static void soscl_ecc_mb_modsquare(word_type *r,word_type *a,soscl_type_ecc_multibuffer_field *f)
+{
+  f->engine->modmult(r,a,a,f);
+}
+
+static void soscl_ecc_mb_modadd(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  f->engine->modadd(r,a,b,f);
+}
+
+static void soscl_ecc_mb_modsub(word_type *r,word_type *a,word_type *b,soscl_type_ecc_multibuffer_field *f)
+{
+  f->engine->modsub(r,a,b,f);
+}
+
+//swaps x and y in the lanes whose mask is all ones
+static void soscl_ecc_mb_cswap(word_type *x,word_type *y,word_type *mask,int wsize,int lanes)
+{
+  word_type d;
+  int j,l;
+  for(j=0;j<wsize;j++)
+    for(l=0;l<lanes;l++)
+      {
+	d=(x[j*lanes+l]^y[j*lanes+l])&mask[l];
+	x[j*lanes+l]^=d;
+	y[j*lanes+l]^=d;
+      }
+}
+
+static void soscl_ecc_mb_point_cswap(soscl_type_ecc_word_affine_point p0,soscl_type_ecc_word_affine_point p1,word_type *mask,int wsize,int lanes)
+{
+  soscl_ecc_mb_cswap(p0.x,p1.x,mask,wsize,lanes);
+  soscl_ecc_mb_cswap(p0.y,p1.y,mask,wsize,lanes);
+}
+
+//lanes versions of soscl_ecc_xycz_*, same operations sequences, work holds 7 lanes numbers
+static void soscl_ecc_mb_xycz_idbl(soscl_type_ecc_word_affine_point out1,soscl_type_ecc_word_affine_point out2,soscl_type_ecc_word_affine_point in,word_type *work,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type *t1,*t2,*t3,*t4,*t5,*t6;
+  int e;
+  e=f->wsize*f->lanes;
+  t1=work;
+  t2=t1+e;
+  t3=t2+e;
+  t4=t3+e;
+  t5=t4+e;
+  t6=t5+e;
+  soscl_bignum_memcpy(t2,in.y,e);
+  soscl_bignum_memcpy(t1,in.x,e);
+  soscl_ecc_mb_modsquare(t3,t1,f);
+  soscl_ecc_mb_modadd(t4,t3,t3,f);
+  soscl_ecc_mb_modadd(t3,t3,t4,f);
+  soscl_ecc_mb_modadd(t3,t3,f->a,f);
+  soscl_ecc_mb_modsquare(t4,t2,f);
+  soscl_ecc_mb_modadd(t4,t4,t4,f);
+  soscl_ecc_mb_modadd(t5,t4,t4,f);
+  soscl_ecc_mb_modmult(t5,t5,t1,f);
+  soscl_ecc_mb_modsquare(t6,t3,f);
+  soscl_ecc_mb_modsub(t6,t6,t5,f);
+  soscl_ecc_mb_modsub(t6,t6,t5,f);
+  soscl_ecc_mb_modsub(t1,t5,t6,f);
+  soscl_ecc_mb_modmult(t1,t1,t3,f);
+  soscl_ecc_mb_modsquare(t3,t4,f);
+  soscl_ecc_mb_modadd(t3,t3,t3,f);
+  soscl_ecc_mb_modsub(t1,t1,t3,f);
+  soscl_bignum_memcpy(out1.x,t6,e);
+  soscl_bignum_memcpy(out1.y,t1,e);
+  soscl_bignum_memcpy(out2.x,t5,e);
+  soscl_bignum_memcpy(out2.y,t3,e);
+}
+
+static void soscl_ecc_mb_xycz_add(soscl_type_ecc_word_affine_point o1,soscl_type_ecc_word_affine_point o2,soscl_type_ecc_word_affine_point i1,soscl_type_ecc_word_affine_point i2,word_type *work,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type *t1,*t2,*t3,*t4,*t5;
+  int e;
+  e=f->wsize*f->lanes;
+  t1=work;
+  t2=t1+e;
+  t3=t2+e;
+  t4=t3+e;
+  t5=t4+e;
+  soscl_bignum_memcpy(t2,i1.y,e);
+  soscl_bignum_memcpy(t1,i1.x,e);
+  soscl_bignum_memcpy(t3,i2.x,e);
+  soscl_bignum_memcpy(t4,i2.y,e);
+  soscl_ecc_mb_modsub(t5,t3,t1,f);
+  soscl_ecc_mb_modsquare(t5,t5,f);
+  soscl_ecc_mb_modmult(t1,t1,t5,f);
+  soscl_ecc_mb_modmult(t3,t3,t5,f);
+  soscl_ecc_mb_modsub(t4,t4,t2,f);
+  soscl_ecc_mb_modsquare(t5,t4,f);
+  soscl_ecc_mb_modsub(t5,t5,t1,f);
+  soscl_ecc_mb_modsub(t5,t5,t3,f);
+  soscl_ecc_mb_modsub(t3,t3,t1,f);
+  soscl_ecc_mb_modmult(t2,t2,t3,f);
+  soscl_ecc_mb_modsub(t3,t1,t5,f);
+  soscl_ecc_mb_modmult(t4,t4,t3,f);
+  soscl_ecc_mb_modsub(t4,t4,t2,f);
+  soscl_bignum_memcpy(o1.x,t5,e);
+  soscl_bignum_memcpy(o1.y,t4,e);
+  soscl_bignum_memcpy(o2.x,t1,e);
+  soscl_bignum_memcpy(o2.y,t2,e);
+}
+
+static void soscl_ecc_mb_xycz_addc(soscl_type_ecc_word_affine_point o1,soscl_type_ecc_word_affine_point o2,soscl_type_ecc_word_affine_point i1,soscl_type_ecc_word_affine_point i2,word_type *work,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type *t1,*t2,*t3,*t4,*t5,*t6,*t7;
+  int e;
+  e=f->wsize*f->lanes;
+  t1=work;
+  t2=t1+e;
+  t3=t2+e;
+  t4=t3+e;
+  t5=t4+e;
+  t6=t5+e;
+  t7=t6+e;
+  soscl_bignum_memcpy(t2,i1.y,e);
+  soscl_bignum_memcpy(t1,i1.x,e);
+  soscl_bignum_memcpy(t3,i2.x,e);
+  soscl_bignum_memcpy(t4,i2.y,e);
+  soscl_ecc_mb_modsub(t5,t3,t1,f);
+  soscl_ecc_mb_modsquare(t5,t5,f);
+  soscl_ecc_mb_modmult(t1,t1,t5,f);
+  soscl_ecc_mb_modmult(t3,t3,t5,f);
+  soscl_ecc_mb_modadd(t5,t4,t2,f);
+  soscl_ecc_mb_modsub(t4,t4,t2,f);
+  soscl_ecc_mb_modsub(t6,t3,t1,f);
+  soscl_ecc_mb_modmult(t2,t2,t6,f);
+  soscl_ecc_mb_modadd(t6,t3,t1,f);
+  soscl_ecc_mb_modsquare(t3,t4,f);
+  soscl_ecc_mb_modsub(t3,t3,t6,f);
+  soscl_ecc_mb_modsub(t7,t1,t3,f);
+  soscl_ecc_mb_modmult(t4,t4,t7,f);
+  soscl_ecc_mb_modsub(t4,t4,t2,f);
+  soscl_ecc_mb_modsquare(t7,t5,f);
+  soscl_ecc_mb_modsub(t7,t7,t6,f);
+  soscl_ecc_mb_modsub(t6,t7,t1,f);
+  soscl_ecc_mb_modmult(t6,t6,t5,f);
+  soscl_ecc_mb_modsub(t6,t6,t2,f);
+  soscl_bignum_memcpy(o1.x,t3,e);
+  soscl_bignum_memcpy(o1.y,t4,e);
+  soscl_bignum_memcpy(o2.x,t7,e);
+  soscl_bignum_memcpy(o2.y,t6,e);
+}
+
+//xycz-addc then xycz-add, one ladder step
+static void soscl_ecc_mb_xycz_addc_then_add(soscl_type_ecc_word_affine_point o1,soscl_type_ecc_word_affine_point o2,soscl_type_ecc_word_affine_point i1,soscl_type_ecc_word_affine_point i2,word_type *work,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type *t1,*t2,*t3,*t4,*t5,*t6,*t7;
+  int e;
+  e=f->wsize*f->lanes;
+  t1=work;
+  t2=t1+e;
+  t3=t2+e;
+  t4=t3+e;
+  t5=t4+e;
+  t6=t5+e;
+  t7=t6+e;
+  soscl_ecc_mb_modsub(t5,i2.x,i1.x,f);
+  soscl_ecc_mb_modsquare(t5,t5,f);
+  soscl_ecc_mb_modmult(t1,i1.x,t5,f);
+  soscl_ecc_mb_modmult(t3,i2.x,t5,f);
+  soscl_ecc_mb_modadd(t5,i2.y,i1.y,f);
+  soscl_ecc_mb_modsub(t4,i2.y,i1.y,f);
+  soscl_ecc_mb_modsub(t6,t3,t1,f);
+  soscl_ecc_mb_modmult(t2,i1.y,t6,f);
+  soscl_ecc_mb_modadd(t6,t3,t1,f);
+  soscl_ecc_mb_modsquare(t3,t4,f);
+  soscl_ecc_mb_modsub(t3,t3,t6,f);
+  soscl_ecc_mb_modsub(t7,t1,t3,f);
+  soscl_ecc_mb_modmult(t4,t4,t7,f);
+  soscl_ecc_mb_modsub(t4,t4,t2,f);
+  soscl_ecc_mb_modsquare(t7,t5,f);
+  soscl_ecc_mb_modsub(t7,t7,t6,f);
+  soscl_ecc_mb_modsub(t6,t7,t1,f);
+  soscl_ecc_mb_modmult(t6,t6,t5,f);
+  soscl_ecc_mb_modsub(t6,t6,t2,f);
+  //result from addc is input for add
+  soscl_ecc_mb_modsub(o1.x,t7,t3,f);
+  soscl_ecc_mb_modsquare(o1.x,o1.x,f);
+  soscl_ecc_mb_modmult(o2.x,t3,o1.x,f);
+  soscl_ecc_mb_modmult(t7,t7,o1.x,f);
+  soscl_ecc_mb_modsub(o1.y,t6,t4,f);
+  soscl_ecc_mb_modsquare(o1.x,o1.y,f);
+  soscl_ecc_mb_modsub(o1.x,o1.x,o2.x,f);
+  soscl_ecc_mb_modsub(o1.x,o1.x,t7,f);
+  soscl_ecc_mb_modsub(t7,t7,o2.x,f);
+  soscl_ecc_mb_modmult(o2.y,t4,t7,f);
+  soscl_ecc_mb_modsub(t7,o2.x,o1.x,f);
+  soscl_ecc_mb_modmult(o1.y,o1.y,t7,f);
+  soscl_ecc_mb_modsub(o1.y,o1.y,o2.y,f);
+}
+
+//lane l of the transposed x from/to the wsize words number a
+static void soscl_ecc_mb_lane_get(word_type *a,word_type *x,int l,int wsize,int lanes)
+{
+  int j;
+  for(j=0;j<wsize;j++)
+    a[j]=x[j*lanes+l];
+}
+
+static void soscl_ecc_mb_lane_set(word_type *x,word_type *a,int l,int wsize,int lanes)
+{
+  int j;
+  for(j=0;j<wsize;j++)
+    x[j*lanes+l]=a[j];
+}
+
+//lanes are p[0] and p[1] on input, lambda is a lanes number (the inverse of the final Z)
+//the ladder follows soscl_ecc_coz_ladder, with conditional swaps instead of p[b] indexing
+static void soscl_ecc_mb_ladder(soscl_type_ecc_word_affine_point *r,word_type *lambda,word_type *kr,int msb,soscl_type_ecc_word_affine_point point,word_type *r2,word_type *work,soscl_type_ecc_multibuffer_field *f)
+{
+  word_type mask[SOSCL_MB_MAX_LANES],*tmp,*t;
+  int i,l,w,e,lanes;
+  w=f->wsize;
+  lanes=f->lanes;
+  e=w*lanes;
+  t=work+7*e;
+  soscl_ecc_mb_xycz_idbl(r[1],r[0],point,work,f);
+  //the regular scalars bit msb is 1 for all lanes
+  for(i=msb-1;i>=1;i--)
+    {
+      for(l=0;l<lanes;l++)
+	mask[l]=(word_type)0-(word_type)soscl_word_bit(kr+l*(w+1),i);
+      soscl_ecc_mb_point_cswap(r[0],r[1],mask,w,lanes);
+      soscl_ecc_mb_xycz_addc_then_add(r[0],r[1],r[0],r[1],work,f);
+      soscl_ecc_mb_point_cswap(r[0],r[1],mask,w,lanes);
+    }
+  for(l=0;l<lanes;l++)
+    mask[l]=(word_type)0-(kr[l*(w+1)]&1);
+  //r[0] is now p[b] and r[1] is p[1-b]
+  soscl_ecc_mb_point_cswap(r[0],r[1],mask,w,lanes);
+  soscl_ecc_mb_xycz_addc(r[1],r[0],r[0],r[1],work,f);
+  //lambda=(x1-x0).yb.xP, with x1-x0=(-1)^(1-b).(r[0].x-r[1].x)
+  soscl_ecc_mb_modsub(lambda,r[0].x,r[1].x,f);
+  soscl_ecc_mb_modsub(t,r[1].x,r[0].x,f);
+  for(i=0;i<e;i++)
+    lambda[i]=(lambda[i]&mask[i%lanes])|(t[i]&~mask[i%lanes]);
+  soscl_ecc_mb_modmult(lambda,lambda,r[0].y,f);
+  soscl_ecc_mb_modmult(lambda,lambda,point.x,f);
+  //lane by lane inversion: (x.R)^-1.R^2=x^-1.R
+  tmp=t+e;
+  for(l=0;l<lanes;l++)
+    {
+      soscl_ecc_mb_lane_get(tmp,lambda,l,w,lanes);
+      soscl_bignum_modinv(tmp+w,tmp,f->p,w);
+      soscl_ecc_mb_lane_set(lambda,tmp+w,l,w,lanes);
+    }
+  soscl_ecc_mb_modmult(lambda,lambda,r2,f);
+  soscl_ecc_mb_modmult(lambda,lambda,r2,f);
+  soscl_ecc_mb_modmult(lambda,lambda,point.y,f);
+  soscl_ecc_mb_modmult(lambda,lambda,r[0].x,f);
+  soscl_ecc_mb_xycz_add(r[0],r[1],r[1],r[0],work,f);
+  soscl_ecc_mb_point_cswap(r[0],r[1],mask,w,lanes);
+}
+
+//work buffer words of soscl_ecc_mult_multi
+//r0,r1,point,a,r2,1,lambda,lambda2: 11 lanes numbers, 9 for the operations
+//multiplication buffer, regular scalars, scalar work
+static int soscl_ecc_mb_work_size(int wsize,int lanes,int size)
+{
+  return(20*wsize*lanes+(wsize+2)*lanes+lanes*(wsize+1)+size+2*(wsize+1)+2*wsize+1);
+}
+
+//q[i]=k[i].points[i], i=0..count-1
+int soscl_ecc_mult_multi(soscl_type_ecc_word_affine_point *q,word_type *k,word_type size,soscl_type_ecc_word_affine_point *points,int count,soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_multibuffer_field f;
+  soscl_type_ecc_word_affine_point r[2],point;
+  word_type *work,*r2,*one,*lambda,*lambda2,*kr,*tmp,*scratch;
+  int w,e,l,first,src,msb,msw,total,i,ret,lanes;
+  if(NULL==curve_params || NULL==k || NULL==points || count<0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q)
+    return(SOSCL_INVALID_OUTPUT);
+  w=curve_params->curve_wsize;
+  if(w>SOSCL_MB_MAX_WSIZE)
+    return(SOSCL_INVALID_INPUT);
+  //the work buffer grows with the lanes: P-384 and P-521 do not fit 8 lanes in a 2048 words stack
+  f.engine=soscl_ecc_mb_engine;
+  while(NULL!=f.engine->narrower && soscl_stack_size()<soscl_ecc_mb_work_size(w,f.engine->lanes,(int)size)+1)
+    f.engine=f.engine->narrower;
+  lanes=f.engine->lanes;
+  e=w*lanes;
+  total=soscl_ecc_mb_work_size(w,lanes,(int)size);
+  if (soscl_stack_alloc(&work,total)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  r[0].x=work;
+  r[0].y=r[0].x+e;
+  r[1].x=r[0].y+e;
+  r[1].y=r[1].x+e;
+  point.x=r[1].y+e;
+  point.y=point.x+e;
+  f.a=point.y+e;
+  r2=f.a+e;
+  one=r2+e;
+  lambda=one+e;
+  lambda2=lambda+e;
+  scratch=lambda2+e;
+  f.t=scratch+9*e;
+  kr=f.t+(w+2)*lanes;
+  tmp=kr+lanes*(w+1);
+  f.p=curve_params->p;
+  f.wsize=w;
+  f.lanes=lanes;
+  //-p^-1 mod 2^SOSCL_WORD_BITS, Newton iterations
+  f.p_inv=f.p[0];
+  for(i=0;i<5;i++)
+    f.p_inv*=2-f.p[0]*f.p_inv;
+  f.p_inv=(word_type)0-f.p_inv;
+  //r2=2^(2.w.SOSCL_WORD_BITS) mod p, in all lanes
+  soscl_bignum_set_zero(tmp,2*w+1);
+  tmp[2*w]=1;
+  soscl_ecc_mod(lambda2,tmp,2*w+1,f.p,w);
+  soscl_bignum_set_zero(one,w);
+  one[0]=1;
+  for(l=0;l<lanes;l++)
+    {
+      soscl_ecc_mb_lane_set(r2,lambda2,l,w,lanes);
+      soscl_ecc_mb_lane_set(f.a,curve_params->a,l,w,lanes);
+      soscl_ecc_mb_lane_set(lambda,one,l,w,lanes);
+    }
+  soscl_bignum_memcpy(one,lambda,e);
+  soscl_ecc_mb_modmult(f.a,f.a,r2,&f);
+  soscl_ecc_msbit_and_size(&msb,&msw,curve_params);
+  ret=SOSCL_OK;
+  for(first=0;first<count;first+=lanes)
+    {
+      //missing lanes replay the last pair
+      for(l=0;l<lanes;l++)
+	{
+	  src=(first+l<count)?first+l:count-1;
+	  soscl_ecc_mb_lane_set(point.x,points[src].x,l,w,lanes);
+	  soscl_ecc_mb_lane_set(point.y,points[src].y,l,w,lanes);
+	  soscl_ecc_regular_scalar(kr+l*(w+1),k+src*size,(int)size,msb,tmp,curve_params);
+	}
+      soscl_ecc_mb_modmult(point.x,point.x,r2,&f);
+      soscl_ecc_mb_modmult(point.y,point.y,r2,&f);
+      soscl_ecc_mb_ladder(r,lambda,kr,msb,point,r2,scratch,&f);
+      //x0.lambda^2, y0.lambda^3
+      soscl_ecc_mb_modsquare(lambda2,lambda,&f);
+      soscl_ecc_mb_modmult(r[0].x,r[0].x,lambda2,&f);
+      soscl_ecc_mb_modmult(lambda2,lambda2,lambda,&f);
+      soscl_ecc_mb_modmult(r[0].y,r[0].y,lambda2,&f);
+      soscl_ecc_mb_modmult(r[0].x,r[0].x,one,&f);
+      soscl_ecc_mb_modmult(r[0].y,r[0].y,one,&f);
+      for(l=0;l<lanes && first+l<count;l++)
+	{
+	  soscl_ecc_mb_lane_get(q[first+l].x,r[0].x,l,w,lanes);
+	  soscl_ecc_mb_lane_get(q[first+l].y,r[0].y,l,w,lanes);
+	}
+    }
+  soscl_memset(work,0,total*(int)sizeof(word_type));
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
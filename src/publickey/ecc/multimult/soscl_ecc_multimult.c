@@ -0,0 +1,314 @@
+//SiFive Open Source Cryptographic Library
+//The software library for accessing to cryptographic algorithms on SiFive RISC-V
+/*Copyright 2019 SiFive
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+//soscl_ecc_multimult.c
+// implements multi-scalar multiplication q=k[0].P[0]+...+k[count-1].P[count-1]
+// Straus (interleaved windows) for few points, Pippenger (buckets) for many points
+
+#include <soscl/soscl_config.h>
+#include <soscl/soscl_types.h>
+#include <soscl/soscl_init.h>
+#include <soscl/soscl_defs.h>
+#include <soscl/soscl_stack.h>
+#include <soscl/soscl_retdefs.h>
+#include <soscl/soscl_string.h>
+#include <soscl/soscl_bignumbers.h>
+#include <soscl/soscl_ecc.h>
+#include <soscl/soscl_ecc_multimult.h>
+
+//Pippenger window width, growing with the number of points
+static int soscl_ecc_multimult_window(int count)
+{
+  if(count<128)
+    return(5);
+  if(count<256)
+    return(6);
+  if(count<1024)
+    return(7);
+  return(8);
+}
+
+//width bits of k, starting at bit index, bits beyond the scalar are 0
+static int soscl_ecc_multimult_digit(word_type *k,int index,int width,int curve_wsize)
+{
+  int j,digit;
+  digit=0;
+  for(j=width-1;j>=0;j--)
+    {
+      digit<<=1;
+      if(index+j<curve_wsize*SOSCL_WORD_BITS)
+	digit|=soscl_word_bit(k,index+j);
+    }
+  return(digit);
+}
+
+static void soscl_ecc_multimult_set_infinite(soscl_type_ecc_word_jacobian_point q,int curve_wsize)
+{
+  soscl_bignum_set_one_word(q.x,1,curve_wsize);
+  soscl_bignum_set_one_word(q.y,1,curve_wsize);
+  soscl_bignum_set_zero(q.z,curve_wsize);
+}
+
+static void soscl_ecc_multimult_set_jacobian(soscl_type_ecc_word_jacobian_point *q,word_type *buffer,int curve_wsize)
+{
+  q->x=buffer;
+  q->y=q->x+curve_wsize;
+  q->z=q->y+curve_wsize;
+}
+
+//number of words for the scratch buffers (tables or buckets)
+int soscl_ecc_multi_mult_workspace_size(int count,soscl_type_curve *curve_params)
+{
+  if(NULL==curve_params || count<=0)
+    return(0);
+  if(count<=SOSCL_ECC_MULTIMULT_STRAUS_MAX)
+    //P, 2P and 3P for each point
+    return(count*SOSCL_ECC_MULTIMULT_STRAUS_TABLE*3*curve_params->curve_wsize);
+  //2^c-1 buckets, plus running and total sums
+  //plus the points in the Montgomery domain, if needed
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY==curve_params->domain)
+    return(((1<<soscl_ecc_multimult_window(count))+1)*3*curve_params->curve_wsize+count*2*curve_params->curve_wsize);
+  return(((1<<soscl_ecc_multimult_window(count))+1)*3*curve_params->curve_wsize);
+}
+
+//Straus: one shared doubling chain, each point adding its own 2-bit window
+//the tables are normalised to affine coordinates (one inversion per SOSCL_ECC_MULTIMULT_STRAUS_BATCH points)
+//so that the main loop only uses mixed additions
+static int soscl_ecc_multimult_straus(soscl_type_ecc_word_jacobian_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,int nbits,word_type *buffer,soscl_type_curve *curve_params)
+{
+  int i,j,digit,first,nb,ret;
+  int curve_wsize;
+  soscl_type_ecc_word_jacobian_point t[SOSCL_ECC_MULTIMULT_STRAUS_TABLE];
+  soscl_type_ecc_word_jacobian_point tj[2*SOSCL_ECC_MULTIMULT_STRAUS_BATCH];
+  soscl_type_ecc_word_affine_point ta[2*SOSCL_ECC_MULTIMULT_STRAUS_BATCH];
+  soscl_type_ecc_word_affine_point entry;
+  curve_wsize=curve_params->curve_wsize;
+  //table i: P[i], 2P[i], 3P[i]
+  for(i=0;i<count;i++)
+    {
+      for(j=0;j<SOSCL_ECC_MULTIMULT_STRAUS_TABLE;j++)
+	soscl_ecc_multimult_set_jacobian(&t[j],buffer+(i*SOSCL_ECC_MULTIMULT_STRAUS_TABLE+j)*3*curve_wsize,curve_wsize);
+      //P[i] is already affine (0:0 if infinite), converted into the field domain
+      soscl_ecc_convert_affine_to_jacobian(t[0],points[i],curve_params);
+      soscl_ecc_to_domain(t[0].x,t[0].x,curve_params);
+      soscl_ecc_to_domain(t[0].y,t[0].y,curve_params);
+      entry.x=t[0].x;
+      entry.y=t[0].y;
+      if(SOSCL_TRUE==soscl_ecc_infinite_affine(points[i].x,points[i].y,curve_wsize))
+	{
+	  //z=0 entries are normalised into 0:0
+	  soscl_bignum_set_zero(t[1].z,curve_wsize);
+	  soscl_bignum_set_zero(t[2].z,curve_wsize);
+	}
+      else
+	{
+	  if(SOSCL_OK!=(ret=soscl_ecc_double_jacobian(t[1],t[0],curve_params)))
+	    return(ret);
+	  if(SOSCL_OK!=(ret=soscl_ecc_add_jacobian_affine(t[2],t[1],entry,curve_params)))
+	    return(ret);
+	}
+    }
+  //2P[i], 3P[i] to affine, in place
+  for(first=0;first<count;first+=SOSCL_ECC_MULTIMULT_STRAUS_BATCH)
+    {
+      nb=count-first;
+      if(nb>SOSCL_ECC_MULTIMULT_STRAUS_BATCH)
+	nb=SOSCL_ECC_MULTIMULT_STRAUS_BATCH;
+      for(i=0;i<nb;i++)
+	for(j=0;j<2;j++)
+	  {
+	    soscl_ecc_multimult_set_jacobian(&tj[2*i+j],buffer+((first+i)*SOSCL_ECC_MULTIMULT_STRAUS_TABLE+j+1)*3*curve_wsize,curve_wsize);
+	    ta[2*i+j].x=tj[2*i+j].x;
+	    ta[2*i+j].y=tj[2*i+j].y;
+	  }
+      if(SOSCL_OK!=(ret=soscl_ecc_batch_to_affine(ta,tj,2*nb,curve_params)))
+	return(ret);
+    }
+  soscl_ecc_multimult_set_infinite(q,curve_wsize);
+  for(i=nbits-2;i>=0;i-=2)
+    {
+      soscl_ecc_double_jacobian(q,q,curve_params);
+      soscl_ecc_double_jacobian(q,q,curve_params);
+      for(j=0;j<count;j++)
+	{
+	  digit=soscl_ecc_multimult_digit(k+j*curve_wsize,i,2,curve_wsize);
+	  if(0==digit)
+	    continue;
+	  entry.x=buffer+(j*SOSCL_ECC_MULTIMULT_STRAUS_TABLE+digit-1)*3*curve_wsize;
+	  entry.y=entry.x+curve_wsize;
+	  if(SOSCL_OK!=(ret=soscl_ecc_add_jacobian_affine(q,q,entry,curve_params)))
+	    return(ret);
+	}
+    }
+  return(SOSCL_OK);
+}
+
+//Pippenger: per c-bit window, points are dropped in the bucket of their digit
+//then sum(d.bucket[d]) is obtained with two running sums
+static int soscl_ecc_multimult_pippenger(soscl_type_ecc_word_jacobian_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,int nbits,word_type *buffer,soscl_type_curve *curve_params)
+{
+  int i,j,c,w,nb_buckets,digit,ret;
+  int curve_wsize;
+  soscl_type_ecc_word_jacobian_point bucket,sum,total;
+  soscl_type_ecc_word_affine_point entry;
+  word_type *domain_points;
+  curve_wsize=curve_params->curve_wsize;
+  c=soscl_ecc_multimult_window(count);
+  nb_buckets=(1<<c)-1;
+  soscl_ecc_multimult_set_jacobian(&sum,buffer+nb_buckets*3*curve_wsize,curve_wsize);
+  soscl_ecc_multimult_set_jacobian(&total,sum.z+curve_wsize,curve_wsize);
+  //points converted once into the Montgomery domain
+  domain_points=total.z+curve_wsize;
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY==curve_params->domain)
+    for(i=0;i<count;i++)
+      {
+	soscl_ecc_to_domain(domain_points+2*i*curve_wsize,points[i].x,curve_params);
+	soscl_ecc_to_domain(domain_points+(2*i+1)*curve_wsize,points[i].y,curve_params);
+      }
+  soscl_ecc_multimult_set_infinite(q,curve_wsize);
+  for(w=((nbits+c-1)/c)-1;w>=0;w--)
+    {
+      for(i=0;i<c;i++)
+	soscl_ecc_double_jacobian(q,q,curve_params);
+      for(j=0;j<nb_buckets;j++)
+	{
+	  soscl_ecc_multimult_set_jacobian(&bucket,buffer+j*3*curve_wsize,curve_wsize);
+	  soscl_ecc_multimult_set_infinite(bucket,curve_wsize);
+	}
+      for(i=0;i<count;i++)
+	{
+	  digit=soscl_ecc_multimult_digit(k+i*curve_wsize,w*c,c,curve_wsize);
+	  if(0==digit)
+	    continue;
+	  soscl_ecc_multimult_set_jacobian(&bucket,buffer+(digit-1)*3*curve_wsize,curve_wsize);
+	  entry=points[i];
+	  if(SOSCL_ECC_DOMAIN_MONTGOMERY==curve_params->domain)
+	    {
+	      entry.x=domain_points+2*i*curve_wsize;
+	      entry.y=entry.x+curve_wsize;
+	    }
+	  if(SOSCL_OK!=(ret=soscl_ecc_add_jacobian_affine(bucket,bucket,entry,curve_params)))
+	    return(ret);
+	}
+      soscl_ecc_multimult_set_infinite(sum,curve_wsize);
+      soscl_ecc_multimult_set_infinite(total,curve_wsize);
+      for(j=nb_buckets-1;j>=0;j--)
+	{
+	  soscl_ecc_multimult_set_jacobian(&bucket,buffer+j*3*curve_wsize,curve_wsize);
+	  if(SOSCL_OK!=(ret=soscl_ecc_add_jacobian_jacobian(sum,sum,bucket,curve_params)))
+	    return(ret);
+	  if(SOSCL_OK!=(ret=soscl_ecc_add_jacobian_jacobian(total,total,sum,curve_params)))
+	    return(ret);
+	}
+      if(SOSCL_OK!=(ret=soscl_ecc_add_jacobian_jacobian(q,q,total,curve_params)))
+	return(ret);
+    }
+  return(SOSCL_OK);
+}
+
+//q=sum(k[i].points[i]), q being left in the curve field domain
+static int soscl_ecc_multimult_compute(soscl_type_ecc_word_jacobian_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,word_type *workspace,int workspace_size,soscl_type_curve *curve_params)
+{
+  int i,n,nbits,size,ret;
+  int curve_wsize;
+  word_type *buffer;
+  curve_wsize=curve_params->curve_wsize;
+  size=soscl_ecc_multi_mult_workspace_size(count,curve_params);
+  if(NULL!=workspace)
+    {
+      if(workspace_size<size)
+	return(SOSCL_INVALID_LENGTH);
+      buffer=workspace;
+    }
+  else
+    if(soscl_stack_alloc(&buffer,size)!=SOSCL_OK)
+      return(SOSCL_STACK_ERROR);
+  //the doubling chain only covers the longest scalar, rounded to the Straus window
+  nbits=0;
+  for(i=0;i<count;i++)
+    {
+      n=curve_wsize*SOSCL_WORD_BITS;
+      while((n>nbits) && (soscl_word_bit(k+i*curve_wsize,n-1)==0))
+	n--;
+      if(n>nbits)
+	nbits=n;
+    }
+  nbits+=nbits&1;
+  if(count<=SOSCL_ECC_MULTIMULT_STRAUS_MAX)
+    ret=soscl_ecc_multimult_straus(q,k,points,count,nbits,buffer,curve_params);
+  else
+    ret=soscl_ecc_multimult_pippenger(q,k,points,count,nbits,buffer,curve_params);
+  if(NULL==workspace)
+    {
+      soscl_memset(buffer,0,size*sizeof(word_type));
+      if(soscl_stack_free(&buffer)!=SOSCL_OK)
+	return(SOSCL_STACK_ERROR);
+    }
+  return(ret);
+}
+
+//q=sum(k[i].points[i]), k being count scalars of curve_wsize words, one after the other
+//workspace (workspace_size words) holds the tables; if NULL, they are taken from the soscl stack
+//the result is left in jacobian coordinates (infinity being 1:1:0)
+int soscl_ecc_multi_mult_jacobian(soscl_type_ecc_word_jacobian_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,word_type *workspace,int workspace_size,soscl_type_curve *curve_params)
+{
+  int ret;
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==k || NULL==points || count<=0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q.x || NULL==q.y || NULL==q.z)
+    return(SOSCL_INVALID_OUTPUT);
+  ret=soscl_ecc_multimult_compute(q,k,points,count,workspace,workspace_size,curve_params);
+  if(SOSCL_OK==ret && SOSCL_TRUE!=soscl_ecc_infinite_jacobian(q,curve_params))
+    {
+      soscl_ecc_from_domain(q.x,q.x,curve_params);
+      soscl_ecc_from_domain(q.y,q.y,curve_params);
+      soscl_ecc_from_domain(q.z,q.z,curve_params);
+    }
+  return(ret);
+}
+
+//same as above, with an affine result (infinity being 0:0)
+int soscl_ecc_multi_mult(soscl_type_ecc_word_affine_point q,word_type *k,soscl_type_ecc_word_affine_point *points,int count,word_type *workspace,int workspace_size,soscl_type_curve *curve_params)
+{
+  int ret;
+  int curve_wsize;
+  word_type *work;
+  soscl_type_ecc_word_jacobian_point qj;
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==k || NULL==points || count<=0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q.x || NULL==q.y)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if(soscl_stack_alloc(&work,3*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  soscl_ecc_multimult_set_jacobian(&qj,work,curve_wsize);
+  ret=soscl_ecc_multimult_compute(qj,k,points,count,workspace,workspace_size,curve_params);
+  if(SOSCL_OK==ret)
+    {
+      if(SOSCL_TRUE==soscl_ecc_infinite_jacobian(qj,curve_params))
+	{
+	  soscl_bignum_set_zero(q.x,curve_wsize);
+	  soscl_bignum_set_zero(q.y,curve_wsize);
+	}
+      else
+	{
+	  ret=soscl_ecc_convert_jacobian_to_affine(q,qj,curve_params);
+	  soscl_ecc_from_domain(q.x,q.x,curve_params);
+	  soscl_ecc_from_domain(q.y,q.y,curve_params);
+	}
+    }
+  if(soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
@@ -34,12 +34,74 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <soscl/soscl_hash_sha384.h>
 #include <soscl/soscl_hash_sha512.h>
 
+//field operations tables, one per curve reduction and per domain
+static int soscl_ecc_std_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
+static int soscl_ecc_std_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params);
+static int soscl_ecc_std_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
+static void soscl_ecc_std_modsub(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
+static int soscl_ecc_std_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params);
+static int soscl_ecc_mont_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
+static int soscl_ecc_mont_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params);
+static int soscl_ecc_mont_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params);
+static int soscl_ecc_mont_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params);
+static void soscl_ecc_reduce_generic(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
+#ifdef SOSCL_WORD32
+static void soscl_ecc_reduce_p224r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
+#endif//SOSCL_WORD32
+static void soscl_ecc_reduce_p256r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
+#ifdef SOSCL_WORD32
+static void soscl_ecc_reduce_p256k1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
+#endif//SOSCL_WORD32
+static void soscl_ecc_reduce_p384r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
+static void soscl_ecc_reduce_p521r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params);
+
+soscl_type_ecc_field_ops soscl_ecc_field_ops_generic={soscl_ecc_std_modmult,soscl_ecc_std_modsquare,soscl_ecc_std_modadd,soscl_ecc_std_modsub,soscl_ecc_std_modinv,soscl_ecc_reduce_generic};
+#ifdef SOSCL_WORD32
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p224r1={soscl_ecc_std_modmult,soscl_ecc_std_modsquare,soscl_ecc_std_modadd,soscl_ecc_std_modsub,soscl_ecc_std_modinv,soscl_ecc_reduce_p224r1};
+#endif//SOSCL_WORD32
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p256r1={soscl_ecc_std_modmult,soscl_ecc_std_modsquare,soscl_ecc_std_modadd,soscl_ecc_std_modsub,soscl_ecc_std_modinv,soscl_ecc_reduce_p256r1};
+#ifdef SOSCL_WORD32
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p256k1={soscl_ecc_std_modmult,soscl_ecc_std_modsquare,soscl_ecc_std_modadd,soscl_ecc_std_modsub,soscl_ecc_std_modinv,soscl_ecc_reduce_p256k1};
+#endif//SOSCL_WORD32
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p384r1={soscl_ecc_std_modmult,soscl_ecc_std_modsquare,soscl_ecc_std_modadd,soscl_ecc_std_modsub,soscl_ecc_std_modinv,soscl_ecc_reduce_p384r1};
+soscl_type_ecc_field_ops soscl_ecc_field_ops_p521r1={soscl_ecc_std_modmult,soscl_ecc_std_modsquare,soscl_ecc_std_modadd,soscl_ecc_std_modsub,soscl_ecc_std_modinv,soscl_ecc_reduce_p521r1};
+#ifdef SOSCL_ECC_GENERATED_FIELD
+#include <soscl/soscl_ecc_field_generated.h>
+#define SOSCL_ECC_FIELD_OPS_P256R1 soscl_ecc_field_ops_p256r1_generated
+#define SOSCL_ECC_FIELD_OPS_P384R1 soscl_ecc_field_ops_p384r1_generated
+#define SOSCL_ECC_FIELD_OPS_P521R1 soscl_ecc_field_ops_p521r1_generated
+#else
+#define SOSCL_ECC_FIELD_OPS_P256R1 soscl_ecc_field_ops_p256r1
+#define SOSCL_ECC_FIELD_OPS_P384R1 soscl_ecc_field_ops_p384r1
+#define SOSCL_ECC_FIELD_OPS_P521R1 soscl_ecc_field_ops_p521r1
+#endif//SOSCL_ECC_GENERATED_FIELD
+//Montgomery domain: the reduction entry is only used for plain (domain preserving) reductions mod p
+soscl_type_ecc_field_ops soscl_ecc_field_ops_montgomery={soscl_ecc_mont_modmult,soscl_ecc_mont_modsquare,soscl_ecc_mont_modadd,soscl_ecc_std_modsub,soscl_ecc_mont_modinv,soscl_ecc_reduce_generic};
+
+//field operations table of the curve, the generic one if not set
+#define SOSCL_ECC_FIELD(curve_params) ((NULL!=(curve_params)->field_ops)?(curve_params)->field_ops:&soscl_ecc_field_ops_generic)
+
 //curves parameters (see secg or NIST)
 
 #ifdef SOSCL_WORD32
 word_type zero[SOSCL_SECP521R1_WORDSIZE]={0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
 #endif
 
+//SECP224R1
+#ifdef SOSCL_WORD32
+static  word_type soscl_xg_p224r1[SOSCL_SECP224R1_WORDSIZE]={0x115c1d21,0x343280d6,0x56c21122,0x4a03c1d3,0x321390b9,0x6bb4bf7f,0xb70e0cbd};
+static  word_type soscl_yg_p224r1[SOSCL_SECP224R1_WORDSIZE]={0x85007e34,0x44d58199,0x5a074764,0xcd4375a0,0x4c22dfe6,0xb5f723fb,0xbd376388};
+static  word_type soscl_a_p224r1[SOSCL_SECP224R1_WORDSIZE]={0xfffffffe,0xffffffff,0xffffffff,0xfffffffe,0xffffffff,0xffffffff,0xffffffff};
+static  word_type soscl_b_p224r1[SOSCL_SECP224R1_WORDSIZE]={0x2355ffb4,0x270b3943,0xd7bfd8ba,0x5044b0b7,0xf5413256,0x0c04b3ab,0xb4050a85};
+static  word_type soscl_p_p224r1[SOSCL_SECP224R1_WORDSIZE]={0x00000001,0x00000000,0x00000000,0xffffffff,0xffffffff,0xffffffff,0xffffffff};
+static  word_type soscl_n_p224r1[SOSCL_SECP224R1_WORDSIZE]={0x5c5c2a3d,0x13dd2945,0xe0b8f03e,0xffff16a2,0xffffffff,0xffffffff,0xffffffff};
+#ifdef SOSCL_ECC_INVERSE_2_OPTIMIZATION
+static  word_type soscl_inverse_2_p224r1[SOSCL_SECP224R1_WORDSIZE]={0x00000001,0x00000000,0x80000000,0xffffffff,0xffffffff,0xffffffff,0x7fffffff};
+#endif
+#endif//SOSCL_WORD32
+soscl_type_curve soscl_secp224r1={soscl_a_p224r1,soscl_b_p224r1,soscl_p_p224r1,soscl_n_p224r1,soscl_xg_p224r1,soscl_yg_p224r1,soscl_inverse_2_p224r1,NULL,SOSCL_SECP224R1_WORDSIZE,SOSCL_SECP224R1_BYTESIZE,SOSCL_SECP224R1,SOSCL_ECC_DOMAIN_STANDARD,NULL,0,NULL,&soscl_ecc_field_ops_p224r1};
+//--------------------------------------------------------------------------------
+
 //SECP256R1
 #ifdef SOSCL_WORD32
 static  word_type soscl_xg_p256r1[SOSCL_SECP256R1_WORDSIZE]={0xd898c296,0xf4a13945,0x2deb33a0,0x77037d81,0x63a440f2,0xf8bce6e5,0xe12c4247,0x6b17d1f2};
@@ -53,9 +115,25 @@ static  word_type soscl_inverse_2_p256r1[SOSCL_SECP256R1_WORDSIZE]={0x00000000,0
 #endif
 static  word_type soscl_square_p_p256r1[SOSCL_SECP256R1_WORDSIZE*2]={0x00000001,0x00000000,0x00000000,0xfffffffe,0xffffffff,0xffffffff,0xfffffffe,0x00000001,0xfffffffe,0x00000001,0xfffffffe,0x00000001,0x00000001,0xfffffffe,0x00000002,0xfffffffe};
 #endif//SOSCL_WORD32
-soscl_type_curve soscl_secp256r1={soscl_a_p256r1,soscl_b_p256r1,soscl_p_p256r1,soscl_n_p256r1,soscl_xg_p256r1,soscl_yg_p256r1,soscl_inverse_2_p256r1,soscl_square_p_p256r1,SOSCL_SECP256R1_WORDSIZE,SOSCL_SECP256R1_BYTESIZE,SOSCL_SECP256R1};
+soscl_type_curve soscl_secp256r1={soscl_a_p256r1,soscl_b_p256r1,soscl_p_p256r1,soscl_n_p256r1,soscl_xg_p256r1,soscl_yg_p256r1,soscl_inverse_2_p256r1,soscl_square_p_p256r1,SOSCL_SECP256R1_WORDSIZE,SOSCL_SECP256R1_BYTESIZE,SOSCL_SECP256R1,SOSCL_ECC_DOMAIN_STANDARD,NULL,0,NULL,&SOSCL_ECC_FIELD_OPS_P256R1};
 //--------------------------------------------------------------------------------  
 
+//SECP256K1
+#ifdef SOSCL_WORD32
+static  word_type soscl_xg_p256k1[SOSCL_SECP256K1_WORDSIZE]={0x16f81798,0x59f2815b,0x2dce28d9,0x029bfcdb,0xce870b07,0x55a06295,0xf9dcbbac,0x79be667e};
+static  word_type soscl_yg_p256k1[SOSCL_SECP256K1_WORDSIZE]={0xfb10d4b8,0x9c47d08f,0xa6855419,0xfd17b448,0x0e1108a8,0x5da4fbfc,0x26a3c465,0x483ada77};
+static  word_type soscl_a_p256k1[SOSCL_SECP256K1_WORDSIZE]={0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000};
+static  word_type soscl_b_p256k1[SOSCL_SECP256K1_WORDSIZE]={0x00000007,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000};
+static  word_type soscl_p_p256k1[SOSCL_SECP256K1_WORDSIZE]={0xfffffc2f,0xfffffffe,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff};
+static  word_type soscl_n_p256k1[SOSCL_SECP256K1_WORDSIZE]={0xd0364141,0xbfd25e8c,0xaf48a03b,0xbaaedce6,0xfffffffe,0xffffffff,0xffffffff,0xffffffff};
+#ifdef SOSCL_ECC_INVERSE_2_OPTIMIZATION
+static  word_type soscl_inverse_2_p256k1[SOSCL_SECP256K1_WORDSIZE]={0x7ffffe18,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0x7fffffff};
+#endif
+#endif//SOSCL_WORD32
+//a=0: a_domain is set (standard domain, so a itself) for the doublings to use the general a formulas instead of the a=-3 ones
+soscl_type_curve soscl_secp256k1={soscl_a_p256k1,soscl_b_p256k1,soscl_p_p256k1,soscl_n_p256k1,soscl_xg_p256k1,soscl_yg_p256k1,soscl_inverse_2_p256k1,NULL,SOSCL_SECP256K1_WORDSIZE,SOSCL_SECP256K1_BYTESIZE,SOSCL_SECP256K1,SOSCL_ECC_DOMAIN_STANDARD,NULL,0,soscl_a_p256k1,&soscl_ecc_field_ops_p256k1};
+//--------------------------------------------------------------------------------
+
 //SECP384R1
 #ifdef SOSCL_WORD32
 static word_type soscl_xg_p384r1[SOSCL_SECP384R1_WORDSIZE]={0x72760ab7,0x3a545e38,0xbf55296c,0x5502f25d,0x82542a38,0x59f741e0,0x8ba79b98,0x6e1d3b62,0xf320ad74,0x8eb1c71e,0xbe8b0537,0xaa87ca22};
@@ -68,7 +146,7 @@ static  word_type soscl_n_p384r1[SOSCL_SECP384R1_WORDSIZE]={0xccc52973,0xecec196
 static  word_type soscl_inverse_2_p384r1[SOSCL_SECP384R1_WORDSIZE]={0x80000000,0x00000000,0x80000000,0x7fffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0xffffffff,0x7fffffff};
 #endif
 #endif//SOSCL_WORD32
-soscl_type_curve soscl_secp384r1={soscl_a_p384r1,soscl_b_p384r1,soscl_p_p384r1,soscl_n_p384r1,soscl_xg_p384r1,soscl_yg_p384r1,soscl_inverse_2_p384r1,NULL,SOSCL_SECP384R1_WORDSIZE,SOSCL_SECP384R1_BYTESIZE,SOSCL_SECP384R1};
+soscl_type_curve soscl_secp384r1={soscl_a_p384r1,soscl_b_p384r1,soscl_p_p384r1,soscl_n_p384r1,soscl_xg_p384r1,soscl_yg_p384r1,soscl_inverse_2_p384r1,NULL,SOSCL_SECP384R1_WORDSIZE,SOSCL_SECP384R1_BYTESIZE,SOSCL_SECP384R1,SOSCL_ECC_DOMAIN_STANDARD,NULL,0,NULL,&SOSCL_ECC_FIELD_OPS_P384R1};
 //--------------------------------------------------------------------------------
 //SECP521R1
 #ifdef SOSCL_WORD32
@@ -82,8 +160,73 @@ static word_type soscl_n_p521r1[SOSCL_SECP521R1_WORDSIZE]={0x91386409,0xbb6fb71e
 static word_type soscl_inverse_2_p521r1[SOSCL_SECP521R1_WORDSIZE]={0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000100};
   #endif
 #endif//SOSCL_WORD32
-soscl_type_curve soscl_secp521r1={soscl_a_p521r1,soscl_b_p521r1,soscl_p_p521r1,soscl_n_p521r1,soscl_xg_p521r1,soscl_yg_p521r1,soscl_inverse_2_p521r1,NULL,SOSCL_SECP521R1_WORDSIZE,SOSCL_SECP521R1_BYTESIZE,SOSCL_SECP521R1};
+soscl_type_curve soscl_secp521r1={soscl_a_p521r1,soscl_b_p521r1,soscl_p_p521r1,soscl_n_p521r1,soscl_xg_p521r1,soscl_yg_p521r1,soscl_inverse_2_p521r1,NULL,SOSCL_SECP521R1_WORDSIZE,SOSCL_SECP521R1_BYTESIZE,SOSCL_SECP521R1,SOSCL_ECC_DOMAIN_STANDARD,NULL,0,NULL,&SOSCL_ECC_FIELD_OPS_P521R1};
 
+//BP256R1 (brainpoolP256r1, RFC 5639)
+#ifdef SOSCL_WORD32
+static word_type soscl_xg_bp256r1[SOSCL_BP256R1_WORDSIZE]={0x9ace3262,0x3a4453bd,0xe3bd23c2,0xb9de27e1,0xfc81b7af,0x2c4b482f,0xcb7e57cb,0x8bd2aeb9};
+static word_type soscl_yg_bp256r1[SOSCL_BP256R1_WORDSIZE]={0x2f046997,0x5c1d54c7,0x2ded8e54,0xc2774513,0x14611dc9,0x97f8461a,0xc3dac4fd,0x547ef835};
+static word_type soscl_a_bp256r1[SOSCL_BP256R1_WORDSIZE]={0xf330b5d9,0xe94a4b44,0x26dc5c6c,0xfb8055c1,0x417affe7,0xeef67530,0xfc2c3057,0x7d5a0975};
+static word_type soscl_b_bp256r1[SOSCL_BP256R1_WORDSIZE]={0xff8c07b6,0x6bccdc18,0x5cf7e1ce,0x95841629,0xbbd77cbf,0xf330b5d9,0xe94a4b44,0x26dc5c6c};
+static word_type soscl_p_bp256r1[SOSCL_BP256R1_WORDSIZE]={0x1f6e5377,0x2013481d,0xd5262028,0x6e3bf623,0x9d838d72,0x3e660a90,0xa1eea9bc,0xa9fb57db};
+static word_type soscl_n_bp256r1[SOSCL_BP256R1_WORDSIZE]={0x974856a7,0x901e0e82,0xb561a6f7,0x8c397aa3,0x9d838d71,0x3e660a90,0xa1eea9bc,0xa9fb57db};
+//Montgomery domain constants, R=2^256
+static word_type soscl_inverse_2_bp256r1[SOSCL_BP256R1_WORDSIZE]={0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x80000000};
+static word_type soscl_a_domain_bp256r1[SOSCL_BP256R1_WORDSIZE]={0x69696261,0xd5d18edf,0xc1d20c64,0xa68123f1,0x6398556e,0x95ec1e5e,0xd666bc17,0x1e4676ab};
+static word_type soscl_r2_bp256r1[SOSCL_BP256R1_WORDSIZE]={0xa6465b6c,0x8cfedf7b,0x614d4f4d,0x5cce4c26,0x6b1ac807,0xa1ecdacd,0xe5957fa8,0x4717aa21};
+#define SOSCL_BP256R1_PINV 0xcefd89b9
+#endif//SOSCL_WORD32
+soscl_type_curve soscl_bp256r1={soscl_a_bp256r1,soscl_b_bp256r1,soscl_p_bp256r1,soscl_n_bp256r1,soscl_xg_bp256r1,soscl_yg_bp256r1,soscl_inverse_2_bp256r1,NULL,SOSCL_BP256R1_WORDSIZE,SOSCL_BP256R1_BYTESIZE,SOSCL_BP256R1,SOSCL_ECC_DOMAIN_MONTGOMERY,soscl_r2_bp256r1,SOSCL_BP256R1_PINV,soscl_a_domain_bp256r1,&soscl_ecc_field_ops_montgomery};
+
+//BP384R1 (brainpoolP384r1, RFC 5639)
+#ifdef SOSCL_WORD32
+static word_type soscl_xg_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x47d4af1e,0xef87b2e2,0x36d646aa,0xe826e034,0x0cbd10e8,0xdb7fcafe,0x7ef14fe3,0x8847a3e7,0xb7c13f6b,0xa2a63a81,0x68cf45ff,0x1d1c64f0};
+static word_type soscl_yg_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x263c5315,0x42820341,0x77918111,0x0e464621,0xf9912928,0xe19c054f,0xfeec5864,0x62b70b29,0x95cfd552,0x5cb1eb8e,0x20f9c2a4,0x8abe1d75};
+static word_type soscl_a_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x22ce2826,0x04a8c7dd,0x503ad4eb,0x8aa5814a,0xba91f90f,0x139165ef,0x4fb22787,0xc2bea28e,0xce05afa0,0x3c72080a,0x3d8c150c,0x7bc382c6};
+static word_type soscl_b_bp384r1[SOSCL_BP384R1_WORDSIZE]={0xfa504c11,0x3ab78696,0x95dbc994,0x7cb43902,0x3eeb62d5,0x2e880ea5,0x07dcd2a6,0x2fb77de1,0x16f0447c,0x8b39b554,0x22ce2826,0x04a8c7dd};
+static word_type soscl_p_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x3107ec53,0x87470013,0x901d1a71,0xacd3a729,0x7fb71123,0x12b1da19,0xed5456b4,0x152f7109,0x50e641df,0x0f5d6f7e,0xa3386d28,0x8cb91e82};
+static word_type soscl_n_bp384r1[SOSCL_BP384R1_WORDSIZE]={0xe9046565,0x3b883202,0x6b7fc310,0xcf3ab6af,0xac0425a7,0x1f166e6c,0xed5456b3,0x152f7109,0x50e641df,0x0f5d6f7e,0xa3386d28,0x8cb91e82};
+//Montgomery domain constants, R=2^384
+static word_type soscl_inverse_2_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x80000000};
+static word_type soscl_a_domain_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x466c3c99,0xdb26b895,0xf157b07b,0x75d7f3fe,0xd7f10db4,0x936771b9,0x35529374,0xe7ffe9e5,0x42b00c60,0x400a8fdf,0xa2e8c0d1,0x7c338021};
+static word_type soscl_r2_bp384r1[SOSCL_BP384R1_WORDSIZE]={0x40b64bde,0x087cefff,0x3d7fd965,0x53528334,0xc9940899,0x8e28f99c,0x9918d5af,0x62140191,0xa57e052c,0xd5c6ef3b,0x178df842,0x36bf6883};
+#define SOSCL_BP384R1_PINV 0xea9ec825
+#endif//SOSCL_WORD32
+soscl_type_curve soscl_bp384r1={soscl_a_bp384r1,soscl_b_bp384r1,soscl_p_bp384r1,soscl_n_bp384r1,soscl_xg_bp384r1,soscl_yg_bp384r1,soscl_inverse_2_bp384r1,NULL,SOSCL_BP384R1_WORDSIZE,SOSCL_BP384R1_BYTESIZE,SOSCL_BP384R1,SOSCL_ECC_DOMAIN_MONTGOMERY,soscl_r2_bp384r1,SOSCL_BP384R1_PINV,soscl_a_domain_bp384r1,&soscl_ecc_field_ops_montgomery};
+
+//BP512R1 (brainpoolP512r1, RFC 5639)
+#ifdef SOSCL_WORD32
+static word_type soscl_xg_bp512r1[SOSCL_BP512R1_WORDSIZE]={0xbcb9f822,0x8b352209,0x406a5e68,0x7c6d5047,0x93b97d5f,0x50d1687b,0xe2d0d48d,0xff3b1f78,0xf4d0098e,0xb43b62ee,0xb5d916c1,0x85ed9f70,0x9c4c6a93,0x5a21322e,0xd82ed964,0x81aee4bd};
+static word_type soscl_yg_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x3ad80892,0x78cd1e0f,0xa8f05406,0xd1ca2b2f,0x8a2763ae,0x5bca4bd8,0x4a5f485e,0xb2dcde49,0x881f8111,0xa000c55b,0x24a57b1a,0xf209f700,0xcf7822fd,0xc0eabfa9,0x566332ec,0x7dde385d};
+static word_type soscl_a_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x77fc94ca,0xe7c1ac4d,0x2bf2c7b9,0x7f1117a7,0x8b9ac8b5,0x0a2ef1c9,0xa8253aa1,0x2ded5d5a,0xea9863bc,0xa83441ca,0x3df91610,0x94cbdd8d,0xac234cc5,0xe2327145,0x8b603b89,0x7830a331};
+static word_type soscl_b_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x8016f723,0x2809bd63,0x5ebae5dd,0x984050b7,0xdc083e67,0x77fc94ca,0xe7c1ac4d,0x2bf2c7b9,0x7f1117a7,0x8b9ac8b5,0x0a2ef1c9,0xa8253aa1,0x2ded5d5a,0xea9863bc,0xa83441ca,0x3df91610};
+static word_type soscl_p_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x583a48f3,0x28aa6056,0x2d82c685,0x2881ff2f,0xe6a380e6,0xaecda12a,0x9bc66842,0x7d4d9b00,0x70330871,0xd6639cca,0xb3c9d20e,0xcb308db3,0x33c9fc07,0x3fd4e6ae,0xdbe9c48b,0xaadd9db8};
+static word_type soscl_n_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x9ca90069,0xb5879682,0x085ddadd,0x1db1d381,0x7fac1047,0x41866119,0x4ca92619,0x553e5c41,0x70330870,0xd6639cca,0xb3c9d20e,0xcb308db3,0x33c9fc07,0x3fd4e6ae,0xdbe9c48b,0xaadd9db8};
+//Montgomery domain constants, R=2^512
+static word_type soscl_inverse_2_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x80000000};
+static word_type soscl_a_domain_bp512r1[SOSCL_BP512R1_WORDSIZE]={0xea10c446,0xda1f8a34,0xafa7d283,0x14e4957d,0x4675bbab,0x40b04b72,0x9e6e87ff,0xcf8f0111,0x3f80d1c7,0xa5ec30c8,0xf41e8778,0x182d0f59,0xe2d0850c,0xb83b84fa,0x227d2a83,0x5ec4f187};
+static word_type soscl_r2_bp512r1[SOSCL_BP512R1_WORDSIZE]={0x6158f205,0x49ad144a,0x27157905,0x793fb130,0x905affd3,0x53b7f9bc,0x83514a25,0xe0c19a77,0xd5898057,0x19486fd8,0xd42bff83,0xa16daa5f,0x2056eecc,0x202e1940,0xa9ff6450,0x3c4c9d05};
+#define SOSCL_BP512R1_PINV 0x7d89efc5
+#endif//SOSCL_WORD32
+soscl_type_curve soscl_bp512r1={soscl_a_bp512r1,soscl_b_bp512r1,soscl_p_bp512r1,soscl_n_bp512r1,soscl_xg_bp512r1,soscl_yg_bp512r1,soscl_inverse_2_bp512r1,NULL,SOSCL_BP512R1_WORDSIZE,SOSCL_BP512R1_BYTESIZE,SOSCL_BP512R1,SOSCL_ECC_DOMAIN_MONTGOMERY,soscl_r2_bp512r1,SOSCL_BP512R1_PINV,soscl_a_domain_bp512r1,&soscl_ecc_field_ops_montgomery};
+
+
+//a in the field domain
+#define SOSCL_ECC_DOMAIN_A(curve_params) ((NULL!=(curve_params)->a_domain)?(curve_params)->a_domain:(curve_params)->a)
+
+//d=a in the curve field domain, buffer (2*curve_wsize) being used only for the Montgomery domain
+static void soscl_ecc_affine_to_domain(soscl_type_ecc_word_affine_point *d,soscl_type_ecc_word_affine_point a,word_type *buffer,soscl_type_curve *curve_params)
+{
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY!=curve_params->domain)
+    {
+      *d=a;
+      return;
+    }
+  d->x=buffer;
+  d->y=buffer+curve_params->curve_wsize;
+  soscl_ecc_to_domain(d->x,a.x,curve_params);
+  soscl_ecc_to_domain(d->y,a.y,curve_params);
+}
 
 //function for copying affine points coordinates
 void soscl_affine_copy(soscl_type_ecc_word_affine_point q,soscl_type_ecc_word_affine_point p,int curve_wsize)
@@ -206,13 +349,90 @@ void soscl_ecc_mod384r1(word_type *r,word_type *number,int number_size,word_type
 }
 #endif//WORD32
 
-//not optimized for secp521r1 yet
+//p521r1 reduction: p=2^521-1, so c=hi.2^521+lo=hi+lo mod p
+//c is expected to be lower than 2^1042 (product of two reduced numbers), otherwise the generic reduction is used
 void soscl_ecc_mod521r1(word_type *b,word_type *c,int c_size,word_type *p,int p_size)
 {
+#ifdef SOSCL_WORD32
+  word_type lo[SOSCL_SECP521R1_WORDSIZE],hi[SOSCL_SECP521R1_WORDSIZE];
+  int i;
+  //c<2^1042: the words 33 and above are 0, and the word 32 is lower than 2^18
+  if(SOSCL_SECP521R1_WORDSIZE!=p_size || c_size>2*p_size || a(2*p_size-1,c,c_size) || (a(2*p_size-2,c,c_size)>>18))
+    {
+      soscl_bignum_mod(b,c,c_size,p,p_size);
+      return;
+    }
+  for(i=0;i<p_size;i++)
+    {
+      lo[i]=a(i,c,c_size);
+      hi[i]=(a(i+p_size-1,c,c_size)>>9)|(a(i+p_size,c,c_size)<<23);
+    }
+  lo[p_size-1]&=0x1ff;
+  //lo<2^521 and hi<2^521 (c<2^1042), so lo+hi<2^522 fits in p_size words
+  soscl_bignum_add(lo,lo,hi,p_size);
+  //second folding of the bit 521
+  soscl_bignum_set_one_word(hi,lo[p_size-1]>>9,p_size);
+  lo[p_size-1]&=0x1ff;
+  soscl_bignum_add(lo,lo,hi,p_size);
+  if(soscl_bignum_memcmp(lo,p,p_size)>=0)
+    soscl_bignum_sub(lo,lo,p,p_size);
+  soscl_bignum_memcpy(b,lo,p_size);
+#else
   soscl_bignum_mod(b,c,c_size,p,p_size);
+#endif//WORD32
 }
 
 #ifdef SOSCL_WORD32
+//p224r1 reduction, p=2^224-2^96+1 (FIPS 186-4 D.2.2)
+//number is at most 2*SOSCL_SECP224R1_WORDSIZE words large
+void soscl_ecc_mod224r1(word_type *r,word_type *number,int number_size,word_type *p)
+{
+  int i;
+  int carry;
+  word_type a[SOSCL_SECP224R1_WORDSIZE*2];
+  word_type s[SOSCL_SECP224R1_WORDSIZE];
+  for(i=0;i<(int)number_size;i++)
+    a[i]=number[i];
+  for(;i<SOSCL_SECP224R1_WORDSIZE*2;i++)
+    a[i]=0;
+  //t
+  for(i=0;i<SOSCL_SECP224R1_WORDSIZE;i++)
+    r[i]=a[i];
+  //s1
+  s[0]=s[1]=s[2]=0;
+  s[3]=a[7];
+  s[4]=a[8];
+  s[5]=a[9];
+  s[6]=a[10];
+  carry=(int)soscl_bignum_add(r,r,s,SOSCL_SECP224R1_WORDSIZE);
+  //s2
+  s[3]=a[11];
+  s[4]=a[12];
+  s[5]=a[13];
+  s[6]=0;
+  carry+=(int)soscl_bignum_add(r,r,s,SOSCL_SECP224R1_WORDSIZE);
+  //d1
+  for(i=0;i<SOSCL_SECP224R1_WORDSIZE;i++)
+    s[i]=a[7+i];
+  carry-=(int)soscl_bignum_sub(r,r,s,SOSCL_SECP224R1_WORDSIZE);
+  //d2
+  s[0]=a[11];
+  s[1]=a[12];
+  s[2]=a[13];
+  s[3]=s[4]=s[5]=s[6]=0;
+  carry-=(int)soscl_bignum_sub(r,r,s,SOSCL_SECP224R1_WORDSIZE);
+  if(carry<0)
+    {
+      while(carry<0)
+	carry+=(int)soscl_bignum_add(r,r,p,SOSCL_SECP224R1_WORDSIZE);
+    }
+  else
+    {
+      while((carry!=0) || soscl_bignum_memcmp(r,p,SOSCL_SECP224R1_WORDSIZE)>=0)
+	carry-=(int)soscl_bignum_sub(r,r,p,SOSCL_SECP224R1_WORDSIZE);
+    }
+}
+
 //enhanced p256r1 reduction, thanks to primes properties
 void soscl_ecc_mod256r1(word_type *r, word_type *number,int number_size,word_type *p)
 {
@@ -306,6 +526,61 @@ void soscl_ecc_mod256r1(word_type *r, word_type *number,int number_size,word_typ
 	carry-=(int)soscl_bignum_sub(r,r,p,SOSCL_SECP256R1_WORDSIZE);
     }
 }
+
+//p256k1 reduction, p=2^256-2^32-977: c=hi.2^256+lo=lo+hi.(2^32+977) mod p
+//number is at most 2*SOSCL_SECP256K1_WORDSIZE words large
+void soscl_ecc_mod256k1(word_type *r,word_type *number,int number_size,word_type *p)
+{
+  word_type a[2*SOSCL_SECP256K1_WORDSIZE];
+  double_word_type acc,top;
+  int i;
+  for(i=0;i<number_size;i++)
+    a[i]=number[i];
+  for(;i<2*SOSCL_SECP256K1_WORDSIZE;i++)
+    a[i]=0;
+  //first folding: r+top.2^256=lo+hi.977+hi.2^32, top<2^34
+  acc=0;
+  for(i=0;i<SOSCL_SECP256K1_WORDSIZE;i++)
+    {
+      acc+=(double_word_type)a[i]+(double_word_type)a[SOSCL_SECP256K1_WORDSIZE+i]*977;
+      if(i>0)
+	acc+=a[SOSCL_SECP256K1_WORDSIZE+i-1];
+      r[i]=(word_type)acc;
+      acc>>=SOSCL_WORD_BITS;
+    }
+  top=acc+a[2*SOSCL_SECP256K1_WORDSIZE-1];
+  //second folding: r=r+top.977+top.2^32
+  acc=(double_word_type)r[0]+top*977;
+  r[0]=(word_type)acc;
+  acc>>=SOSCL_WORD_BITS;
+  acc+=(double_word_type)r[1]+top;
+  r[1]=(word_type)acc;
+  acc>>=SOSCL_WORD_BITS;
+  for(i=2;i<SOSCL_SECP256K1_WORDSIZE;i++)
+    {
+      acc+=r[i];
+      r[i]=(word_type)acc;
+      acc>>=SOSCL_WORD_BITS;
+    }
+  //a last carry means r is small: adding 2^32+977 cannot carry again
+  if(0!=acc)
+    {
+      acc=(double_word_type)r[0]+977;
+      r[0]=(word_type)acc;
+      acc>>=SOSCL_WORD_BITS;
+      acc+=(double_word_type)r[1]+1;
+      r[1]=(word_type)acc;
+      acc>>=SOSCL_WORD_BITS;
+      for(i=2;i<SOSCL_SECP256K1_WORDSIZE && 0!=acc;i++)
+	{
+	  acc+=r[i];
+	  r[i]=(word_type)acc;
+	  acc>>=SOSCL_WORD_BITS;
+	}
+    }
+  if(soscl_bignum_memcmp(r,p,SOSCL_SECP256K1_WORDSIZE)>=0)
+    soscl_bignum_sub(r,r,p,SOSCL_SECP256K1_WORDSIZE);
+}
 #endif //WORD32
 
 int soscl_ecc_point_less_than_psquare(word_type *c,word_type c_size,word_type *psquare,word_type psq_size)
@@ -322,26 +597,225 @@ int soscl_ecc_point_less_than_psquare(word_type *c,word_type c_size,word_type *p
 	return(SOSCL_TRUE);
 }
 
+static void soscl_ecc_reduce_generic(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  soscl_ecc_mod(b,c,c_size,curve_params->p,curve_params->curve_wsize);
+}
+
+#ifdef SOSCL_WORD32
+static void soscl_ecc_reduce_p224r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  if(c_size<=2*SOSCL_SECP224R1_WORDSIZE)
+    soscl_ecc_mod224r1(b,c,c_size,curve_params->p);
+  else
+    soscl_ecc_mod(b,c,c_size,curve_params->p,curve_params->curve_wsize);
+}
+#endif//WORD32
+
+static void soscl_ecc_reduce_p256r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  if(NULL!=curve_params->square_p && SOSCL_TRUE==soscl_ecc_point_less_than_psquare(c,c_size,curve_params->square_p,curve_params->curve_wsize*2))
+    soscl_ecc_mod256r1(b,c,c_size,curve_params->p);
+  else
+    soscl_ecc_mod(b,c,c_size,curve_params->p,curve_params->curve_wsize);
+}
+
+#ifdef SOSCL_WORD32
+static void soscl_ecc_reduce_p256k1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  if(c_size<=2*SOSCL_SECP256K1_WORDSIZE)
+    soscl_ecc_mod256k1(b,c,c_size,curve_params->p);
+  else
+    soscl_ecc_mod(b,c,c_size,curve_params->p,curve_params->curve_wsize);
+}
+#endif//WORD32
+
+static void soscl_ecc_reduce_p384r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  soscl_ecc_mod384r1(b,c,c_size,curve_params->p);
+}
+
+static void soscl_ecc_reduce_p521r1(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
+{
+  soscl_ecc_mod521r1(b,c,c_size,curve_params->p,curve_params->curve_wsize);
+}
+
+//b=c mod p, with the curve reduction
 void soscl_ecc_modcurve(word_type *b,word_type *c,int c_size,soscl_type_curve *curve_params)
 {
+  SOSCL_ECC_FIELD(curve_params)->reduce(b,c,c_size,curve_params);
+}
+
+//default table for the library curves
+soscl_type_ecc_field_ops *soscl_ecc_default_field_ops(soscl_type_curve *curve_params)
+{
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY==curve_params->domain)
+    return(&soscl_ecc_field_ops_montgomery);
   switch(curve_params->curve)
     {
+#ifdef SOSCL_WORD32
+    case SOSCL_SECP224R1:
+      return(&soscl_ecc_field_ops_p224r1);
+#endif//WORD32
     case SOSCL_SECP256R1:
-      if(NULL!=curve_params->square_p && SOSCL_TRUE==soscl_ecc_point_less_than_psquare(c,c_size,curve_params->square_p,curve_params->curve_wsize*2))
-	soscl_ecc_mod256r1(b,c,c_size,curve_params->p);
-      else
-	soscl_ecc_mod(b,c,c_size,curve_params->p,curve_params->curve_wsize);
-      break;
+      return(&SOSCL_ECC_FIELD_OPS_P256R1);
+#ifdef SOSCL_WORD32
+    case SOSCL_SECP256K1:
+      return(&soscl_ecc_field_ops_p256k1);
+#endif//WORD32
     case SOSCL_SECP384R1:
-      soscl_ecc_mod384r1(b,c,c_size,curve_params->p);
-      break;
+      return(&SOSCL_ECC_FIELD_OPS_P384R1);
     case SOSCL_SECP521R1:
-      soscl_ecc_mod521r1(b,c,c_size,curve_params->p,curve_params->curve_wsize);
-      break;
+      return(&SOSCL_ECC_FIELD_OPS_P521R1);
     default:
-      soscl_ecc_mod(b,c,c_size,curve_params->p,curve_params->curve_wsize);
-      break;
+      return(&soscl_ecc_field_ops_generic);
+    }
+}
+
+//plugs a backend (asm, hardware...) into the curve: NULL restores the default table
+//every ECC/ECDSA routine uses the curve field through this table
+int soscl_ecc_set_field_ops(soscl_type_curve *curve_params,soscl_type_ecc_field_ops *field_ops)
+{
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==field_ops)
+    field_ops=soscl_ecc_default_field_ops(curve_params);
+  if(NULL==field_ops->mult || NULL==field_ops->square || NULL==field_ops->add || NULL==field_ops->sub || NULL==field_ops->inv || NULL==field_ops->reduce)
+    return(SOSCL_INVALID_INPUT);
+  curve_params->field_ops=field_ops;
+  return(SOSCL_OK);
+}
+
+//Montgomery reduction (REDC): r=t.R^-1 mod p, R=2^(curve_wsize*SOSCL_WORD_BITS)
+//t is 2*curve_wsize+1 words large (t<p.R), and is modified
+static void soscl_ecc_montgomery_reduce(word_type *r,word_type *t,soscl_type_curve *curve_params)
+{
+  int i,j,curve_wsize;
+  word_type m,carry;
+  double_word_type acc;
+  curve_wsize=curve_params->curve_wsize;
+  for(i=0;i<curve_wsize;i++)
+    {
+      //t+=m.p.2^(i*SOSCL_WORD_BITS), so that t[i]=0
+      m=t[i]*curve_params->p_inv;
+      carry=0;
+      for(j=0;j<curve_wsize;j++)
+	{
+	  acc=(double_word_type)m*curve_params->p[j]+t[i+j]+carry;
+	  t[i+j]=(word_type)acc;
+	  carry=(word_type)(acc>>SOSCL_WORD_BITS);
+	}
+      for(j=i+curve_wsize;carry && j<=2*curve_wsize;j++)
+	{
+	  acc=(double_word_type)t[j]+carry;
+	  t[j]=(word_type)acc;
+	  carry=(word_type)(acc>>SOSCL_WORD_BITS);
+	}
     }
+  //t/R<2p
+  if(t[2*curve_wsize] || soscl_bignum_memcmp(t+curve_wsize,curve_params->p,curve_wsize)>=0)
+    soscl_bignum_sub(r,t+curve_wsize,curve_params->p,curve_wsize);
+  else
+    soscl_bignum_memcpy(r,t+curve_wsize,curve_wsize);
+}
+
+//r=a in the curve field domain (a.R mod p for the Montgomery domain)
+int soscl_ecc_to_domain(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY==curve_params->domain)
+    return(soscl_ecc_modmult(r,a,curve_params->r2,curve_params));
+  if(r!=a)
+    soscl_bignum_memcpy(r,a,curve_params->curve_wsize);
+  return(SOSCL_OK);
+}
+
+//r=a back from the curve field domain
+int soscl_ecc_from_domain(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  word_type *t;
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY!=curve_params->domain)
+    {
+      if(r!=a)
+	soscl_bignum_memcpy(r,a,curve_wsize);
+      return(SOSCL_OK);
+    }
+  if (soscl_stack_alloc(&t, 2*curve_wsize+1)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  soscl_bignum_memcpy(t,a,curve_wsize);
+  soscl_bignum_set_zero(t+curve_wsize,curve_wsize+1);
+  soscl_ecc_montgomery_reduce(r,t,curve_params);
+  if (soscl_stack_free(&t)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//r=1 in the curve field domain
+int soscl_ecc_field_one(word_type *r,soscl_type_curve *curve_params)
+{
+  //R^2.R^-1=R
+  if(SOSCL_ECC_DOMAIN_MONTGOMERY==curve_params->domain)
+    return(soscl_ecc_from_domain(r,curve_params->r2,curve_params));
+  soscl_bignum_set_one_word(r,1,curve_params->curve_wsize);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_std_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  return(soscl_bignum_modinv(r,a,curve_params->p,curve_params->curve_wsize));
+}
+
+static int soscl_ecc_mont_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  int ret;
+  ret=soscl_bignum_modinv(r,a,curve_params->p,curve_params->curve_wsize);
+  if(SOSCL_OK!=ret)
+    return(ret);
+  //(a.R)^-1 -> a^-1.R: two multiplications by R^2
+  soscl_ecc_mont_modmult(r,r,curve_params->r2,curve_params);
+  soscl_ecc_mont_modmult(r,r,curve_params->r2,curve_params);
+  return(SOSCL_OK);
+}
+
+//r=a^-1 mod p, a and r being in the curve field domain
+int soscl_ecc_modinv(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  return(SOSCL_ECC_FIELD(curve_params)->inv(r,a,curve_params));
+}
+
+//r[i]=a[i]^-1 mod p for count numbers, with one single inversion (Montgomery's trick)
+//r and a shall not overlap, all the a values shall be invertible
+int soscl_ecc_modinv_batch(word_type *r,word_type *a,int count,soscl_type_curve *curve_params)
+{
+  int i,ret,curve_wsize;
+  word_type *work,*inv,*tmp;
+  if(count<=0)
+    return(SOSCL_INVALID_INPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if(soscl_stack_alloc(&work,curve_wsize*2)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  inv=work;
+  tmp=inv+curve_wsize;
+  //prefix products: r_i=a_0*...*a_i
+  soscl_bignum_memcpy(r,a,curve_wsize);
+  for(i=1;i<count;i++)
+    soscl_ecc_modmult(r+i*curve_wsize,r+(i-1)*curve_wsize,a+i*curve_wsize,curve_params);
+  ret=soscl_ecc_modinv(inv,r+(count-1)*curve_wsize,curve_params);
+  if(SOSCL_OK!=ret)
+    goto soscl_label_ecc_modinv_batch_end;
+  //backward, inv=(a_0*...*a_i)^-1
+  for(i=count-1;i>0;i--)
+    {
+      soscl_ecc_modmult(tmp,inv,a+i*curve_wsize,curve_params);
+      soscl_ecc_modmult(r+i*curve_wsize,inv,r+(i-1)*curve_wsize,curve_params);
+      soscl_bignum_memcpy(inv,tmp,curve_wsize);
+    }
+  soscl_bignum_memcpy(r,inv,curve_wsize);
+ soscl_label_ecc_modinv_batch_end:
+  if(soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
 }
 
 //setting the msbit corresponding to the curve p msb position
@@ -381,7 +855,27 @@ void soscl_ecc_msbit_and_size(int *msb,int *msw,soscl_type_curve *curve_params)
     (*msb)--;
 }
 
-void soscl_ecc_modsub(word_type *p_result, word_type *p_left, word_type *p_right,soscl_type_curve *curve_params)
+//kr=k+n if it is n+1 bits long, k+2n otherwise, k being reduced mod n first
+//so that the bit msb (the n bit length) of kr is always 1, and a ladder on kr runs a fixed number of steps
+//kr is wsize+1 words large, work is size+2*(wsize+1) words large
+void soscl_ecc_regular_scalar(word_type *kr,word_type *k,int size,int msb,word_type *work,soscl_type_curve *curve_params)
+{
+  word_type *kn,*k2n,mask,carry;
+  int j,wsize;
+  wsize=curve_params->curve_wsize;
+  kn=work+size;
+  k2n=kn+wsize+1;
+  soscl_bignum_memcpy(work,k,size);
+  soscl_ecc_mod(kn,work,size,curve_params->n,wsize);
+  kn[wsize]=soscl_bignum_add(kn,kn,curve_params->n,wsize);
+  carry=soscl_bignum_add(k2n,kn,curve_params->n,wsize);
+  k2n[wsize]=kn[wsize]+carry;
+  mask=(word_type)0-(word_type)soscl_word_bit(kn,msb);
+  for(j=0;j<wsize+1;j++)
+    kr[j]=(kn[j]&mask)|(k2n[j]&~mask);
+}
+
+static void soscl_ecc_std_modsub(word_type *p_result, word_type *p_left, word_type *p_right,soscl_type_curve *curve_params)
 {
   word_type borrow;
   borrow=soscl_bignum_sub(p_result, p_left, p_right,curve_params->curve_wsize);
@@ -389,20 +883,48 @@ void soscl_ecc_modsub(word_type *p_result, word_type *p_left, word_type *p_right
     soscl_bignum_add(p_result, p_result, curve_params->p,curve_params->curve_wsize);
 }
 
-int soscl_ecc_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+void soscl_ecc_modsub(word_type *p_result, word_type *p_left, word_type *p_right,soscl_type_curve *curve_params)
+{
+  SOSCL_ECC_FIELD(curve_params)->sub(p_result,p_left,p_right,curve_params);
+}
+
+static int soscl_ecc_std_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
 {
   word_type *tmp;
   int curve_wsize;
   curve_wsize=curve_params->curve_wsize;
   if (soscl_stack_alloc(&tmp, 1+curve_wsize)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
-  tmp[curve_params->curve_wsize]=soscl_bignum_add(tmp,a,b,curve_params->curve_wsize);
-  soscl_ecc_modcurve(r,tmp,1+curve_params->curve_wsize,curve_params);
+  tmp[curve_wsize]=soscl_bignum_add(tmp,a,b,curve_wsize);
+  soscl_ecc_modcurve(r,tmp,1+curve_wsize,curve_params);
   if (soscl_stack_free(&tmp)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
 }
 
+//no special form for p: a+b<2p, so one conditional subtraction
+static int soscl_ecc_mont_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  word_type *tmp;
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&tmp, 1+curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  tmp[curve_wsize]=soscl_bignum_add(tmp,a,b,curve_wsize);
+  if(tmp[curve_wsize] || soscl_bignum_memcmp(tmp,curve_params->p,curve_wsize)>=0)
+    soscl_bignum_sub(r,tmp,curve_params->p,curve_wsize);
+  else
+    soscl_bignum_memcpy(r,tmp,curve_wsize);
+  if (soscl_stack_free(&tmp)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+int soscl_ecc_modadd(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  return(SOSCL_ECC_FIELD(curve_params)->add(r,a,b,curve_params));
+}
+
 int soscl_ecc_modleftshift(word_type *a,word_type *b,word_type c,word_type size,soscl_type_curve *curve_params)
 {
   word_type *tmp;
@@ -417,21 +939,21 @@ int soscl_ecc_modleftshift(word_type *a,word_type *b,word_type c,word_type size,
   return(SOSCL_OK);
 }
 
-int soscl_ecc_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+static int soscl_ecc_std_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
 {
   word_type *mult;
   int curve_wsize;
   curve_wsize=curve_params->curve_wsize;
   if (soscl_stack_alloc(&mult, 2*curve_wsize)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
-  soscl_bignum_mult(mult,a,b,curve_params->curve_wsize);
-  soscl_ecc_modcurve(r,mult,2*curve_params->curve_wsize,curve_params);
+  soscl_bignum_mult(mult,a,b,curve_wsize);
+  soscl_ecc_modcurve(r,mult,2*curve_wsize,curve_params);
   if (soscl_stack_free(&mult)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
 }
 
-int soscl_ecc_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+static int soscl_ecc_std_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
 {
   word_type *mult;
   int curve_wsize;
@@ -445,6 +967,179 @@ int soscl_ecc_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params
   return(SOSCL_OK);
 }
 
+//REDC needs one extra word
+static int soscl_ecc_mont_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  word_type *mult;
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&mult, 2*curve_wsize+1)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  soscl_bignum_mult(mult,a,b,curve_wsize);
+  mult[2*curve_wsize]=0;
+  soscl_ecc_montgomery_reduce(r,mult,curve_params);
+  if (soscl_stack_free(&mult)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+static int soscl_ecc_mont_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  word_type *mult;
+  int curve_wsize;
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&mult, 2*curve_wsize+1)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  soscl_bignum_square(mult,a,curve_wsize);
+  mult[2*curve_wsize]=0;
+  soscl_ecc_montgomery_reduce(r,mult,curve_params);
+  if (soscl_stack_free(&mult)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+int soscl_ecc_modmult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  return(SOSCL_ECC_FIELD(curve_params)->mult(r,a,b,curve_params));
+}
+
+int soscl_ecc_modsquare(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  return(SOSCL_ECC_FIELD(curve_params)->square(r,a,curve_params));
+}
+
+//r=a^(2^n)
+int soscl_ecc_modsquare_n(word_type *r,word_type *a,int n,soscl_type_curve *curve_params)
+{
+  int i,ret;
+  if(r!=a)
+    soscl_bignum_memcpy(r,a,curve_params->curve_wsize);
+  for(i=0;i<n;i++)
+    if(SOSCL_OK!=(ret=soscl_ecc_modsquare(r,r,curve_params)))
+      return(ret);
+  return(SOSCL_OK);
+}
+
+//r=a^((p+1)/4), with addition chains for the NIST primes
+//t shall be 6 words arrays
+static void soscl_ecc_modsqrt_chain(word_type *r,word_type *a,word_type *t,soscl_type_curve *curve_params)
+{
+  word_type *t0,*t1,*t2,*t3,*t4,*t5,*e;
+  int curve_wsize,i;
+  curve_wsize=curve_params->curve_wsize;
+  t0=t;
+  t1=t0+curve_wsize;
+  t2=t1+curve_wsize;
+  t3=t2+curve_wsize;
+  t4=t3+curve_wsize;
+  t5=t4+curve_wsize;
+  switch(curve_params->curve)
+    {
+    case SOSCL_SECP256R1:
+      //(p+1)/4=(((2^32-1).2^32+1).2^96+1).2^94
+      //t0=a^(2^2-1),t1=a^(2^4-1),t0=a^(2^8-1),t1=a^(2^16-1),t0=a^(2^32-1)
+      soscl_ecc_modsquare(t0,a,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare_n(t1,t0,2,curve_params);
+      soscl_ecc_modmult(t1,t1,t0,curve_params);
+      soscl_ecc_modsquare_n(t0,t1,4,curve_params);
+      soscl_ecc_modmult(t0,t0,t1,curve_params);
+      soscl_ecc_modsquare_n(t1,t0,8,curve_params);
+      soscl_ecc_modmult(t1,t1,t0,curve_params);
+      soscl_ecc_modsquare_n(t0,t1,16,curve_params);
+      soscl_ecc_modmult(t0,t0,t1,curve_params);
+      soscl_ecc_modsquare_n(t0,t0,32,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare_n(t0,t0,96,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare_n(r,t0,94,curve_params);
+      break;
+    case SOSCL_SECP384R1:
+      //(p+1)/4=(((2^255-1).2^33+2^32-1).2^64+1).2^30
+      //t0=a^(2^2-1),t1=a^(2^3-1)
+      soscl_ecc_modsquare(t0,a,curve_params);
+      soscl_ecc_modmult(t0,t0,a,curve_params);
+      soscl_ecc_modsquare(t1,t0,curve_params);
+      soscl_ecc_modmult(t1,t1,a,curve_params);
+      //t4=a^(2^6-1),t4=a^(2^12-1),t2=a^(2^15-1),t3=a^(2^30-1)
+      soscl_ecc_modsquare_n(t4,t1,3,curve_params);
+      soscl_ecc_modmult(t4,t4,t1,curve_params);
+      soscl_ecc_modsquare_n(t5,t4,6,curve_params);
+      soscl_ecc_modmult(t4,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t2,t4,3,curve_params);
+      soscl_ecc_modmult(t2,t2,t1,curve_params);
+      soscl_ecc_modsquare_n(t3,t2,15,curve_params);
+      soscl_ecc_modmult(t3,t3,t2,curve_params);
+      //t4=a^(2^60-1),t5=a^(2^120-1),t5=a^(2^240-1),t5=a^(2^255-1)
+      soscl_ecc_modsquare_n(t4,t3,30,curve_params);
+      soscl_ecc_modmult(t4,t4,t3,curve_params);
+      soscl_ecc_modsquare_n(t5,t4,60,curve_params);
+      soscl_ecc_modmult(t5,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t4,t5,120,curve_params);
+      soscl_ecc_modmult(t5,t4,t5,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,15,curve_params);
+      soscl_ecc_modmult(t5,t5,t2,curve_params);
+      //t4=a^(2^32-1)
+      soscl_ecc_modsquare_n(t4,t3,2,curve_params);
+      soscl_ecc_modmult(t4,t4,t0,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,33,curve_params);
+      soscl_ecc_modmult(t5,t5,t4,curve_params);
+      soscl_ecc_modsquare_n(t5,t5,64,curve_params);
+      soscl_ecc_modmult(t5,t5,a,curve_params);
+      soscl_ecc_modsquare_n(r,t5,30,curve_params);
+      break;
+    case SOSCL_SECP521R1:
+      //(p+1)/4=2^519
+      soscl_ecc_modsquare_n(r,a,519,curve_params);
+      break;
+    default:
+      //left-to-right square and multiply, e=(p+1)/4
+      e=t5;
+      soscl_bignum_set_one_word(t0,1,curve_wsize);
+      soscl_bignum_add(e,curve_params->p,t0,curve_wsize);
+      soscl_bignum_rightshift(e,e,2,curve_wsize);
+      soscl_ecc_field_one(t1,curve_params);
+      for(i=curve_wsize*SOSCL_WORD_BITS-1;i>=0;i--)
+	{
+	  soscl_ecc_modsquare(t1,t1,curve_params);
+	  if(soscl_word_bit(e,i))
+	    soscl_ecc_modmult(t1,t1,a,curve_params);
+	}
+      soscl_bignum_memcpy(r,t1,curve_wsize);
+      break;
+    }
+}
+
+//r=square root of a mod p, for p=3 mod 4 (a and r in the curve field domain)
+//returns SOSCL_ERROR if a is not a square
+int soscl_ecc_modsqrt(word_type *r,word_type *a,soscl_type_curve *curve_params)
+{
+  word_type *work,*check;
+  int curve_wsize,ret;
+  if(NULL==curve_params || NULL==a)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==r)
+    return(SOSCL_INVALID_OUTPUT);
+  if(3!=(curve_params->p[0]&3))
+    return(SOSCL_INVALID_MODE);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work,8*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  check=work+6*curve_wsize;
+  soscl_ecc_modsqrt_chain(check+curve_wsize,a,work,curve_params);
+  soscl_ecc_modsquare(check,check+curve_wsize,curve_params);
+  if(0==soscl_bignum_memcmp(check,a,curve_wsize))
+    {
+      soscl_bignum_memcpy(r,check+curve_wsize,curve_wsize);
+      ret=SOSCL_OK;
+    }
+  else
+    ret=SOSCL_ERROR;
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(ret);
+}
+
 int soscl_ecc_infinite_affine(word_type *x,word_type *y,int size)
 {
   if(SOSCL_OK==soscl_bignum_cmp_with_zero(x,size) && SOSCL_OK==soscl_bignum_cmp_with_zero(y,size))
@@ -515,18 +1210,37 @@ int soscl_ecc_double_jacobian(soscl_type_ecc_word_jacobian_point q2,soscl_type_e
   soscl_ecc_modmult(t2,q1.y,q1.z,curve_params);
   //t3=t3
   soscl_ecc_modsquare(t3,q1.z,curve_params);
-  //t1=t1+t3
-  soscl_ecc_modadd(t1,q1.x,t3,curve_params);
-  //t3=t3+t3
-  soscl_ecc_modadd(t3,t3,t3,curve_params);
-  //t3=t1-t3
-  soscl_ecc_modsub(t3,t1,t3,curve_params);
-  //t1=t1*t3
-  soscl_ecc_modmult(t1,t1,t3,curve_params);
-  //t3=t1+t1
-  soscl_ecc_modadd(t3,t1,t1,curve_params);
-  //t1=t1+t3
-  soscl_ecc_modadd(t1,t1,t3,curve_params);
+  if(NULL!=curve_params->a_domain)
+    {
+      //general a: t1=3.x1^2+a.z1^4
+      //t3=a.t3^2
+      soscl_ecc_modsquare(t3,t3,curve_params);
+      soscl_ecc_modmult(t3,t3,curve_params->a_domain,curve_params);
+      //t1=x1^2
+      soscl_ecc_modsquare(t1,q1.x,curve_params);
+      //t3=t3+t1
+      soscl_ecc_modadd(t3,t3,t1,curve_params);
+      //t1=t1+t1
+      soscl_ecc_modadd(t1,t1,t1,curve_params);
+      //t1=t1+t3
+      soscl_ecc_modadd(t1,t1,t3,curve_params);
+    }
+  else
+    {
+      //a=-3: t1=3.(x1+z1^2).(x1-z1^2)
+      //t1=t1+t3
+      soscl_ecc_modadd(t1,q1.x,t3,curve_params);
+      //t3=t3+t3
+      soscl_ecc_modadd(t3,t3,t3,curve_params);
+      //t3=t1-t3
+      soscl_ecc_modsub(t3,t1,t3,curve_params);
+      //t1=t1*t3
+      soscl_ecc_modmult(t1,t1,t3,curve_params);
+      //t3=t1+t1
+      soscl_ecc_modadd(t3,t1,t1,curve_params);
+      //t1=t1+t3
+      soscl_ecc_modadd(t1,t1,t3,curve_params);
+    }
   //t1=t1/2
   soscl_ecc_modmult(t1,t1,curve_params->inverse_2,curve_params);
   //t3=t1
@@ -568,7 +1282,7 @@ int soscl_ecc_add_jacobian_affine(soscl_type_ecc_word_jacobian_point q3,soscl_ty
       //x2:y2:1
       soscl_bignum_memcpy(q3.x,q2.x,curve_wsize);
       soscl_bignum_memcpy(q3.y,q2.y,curve_wsize);
-      soscl_bignum_set_one_word(q3.z,1,curve_wsize);
+      soscl_ecc_field_one(q3.z,curve_params);
       return(SOSCL_OK);
     }
   if (soscl_stack_alloc(&work, 7*curve_wsize)!=SOSCL_OK)
@@ -590,8 +1304,21 @@ int soscl_ecc_add_jacobian_affine(soscl_type_ecc_word_jacobian_point q3,soscl_ty
   soscl_ecc_modmult(t5,t5,t3,curve_params);
   soscl_ecc_modmult(t5,t5,t6,curve_params);
   soscl_ecc_modsub(t1,t1,t4,curve_params);
-  soscl_ecc_modmult(t3,t1,t3,curve_params);
   soscl_ecc_modsub(t2,t2,t5,curve_params);
+  //same x: q1==q2 (doubling) or q1==-q2 (infinity)
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(t1,curve_wsize))
+    {
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(t2,curve_wsize))
+	soscl_ecc_double_jacobian(q3,q1,curve_params);
+      else
+	{
+	  soscl_bignum_set_one_word(q3.x,1,curve_wsize);
+	  soscl_bignum_set_one_word(q3.y,1,curve_wsize);
+	  soscl_bignum_set_zero(q3.z,curve_wsize);
+	}
+      goto soscl_label_add_jacobian_affine_end;
+    }
+  soscl_ecc_modmult(t3,t1,t3,curve_params);
   soscl_ecc_modsquare(t6,t1,curve_params);
   soscl_ecc_modsquare(t7,t2,curve_params);
   soscl_ecc_modmult(t4,t4,t6,curve_params);
@@ -606,6 +1333,7 @@ int soscl_ecc_add_jacobian_affine(soscl_type_ecc_word_jacobian_point q3,soscl_ty
   soscl_bignum_memcpy(q3.x,t7,curve_wsize);
   soscl_bignum_memcpy(q3.y,t6,curve_wsize);
   soscl_bignum_memcpy(q3.z,t3,curve_wsize);
+ soscl_label_add_jacobian_affine_end:
   if (soscl_stack_free(&work)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
@@ -619,7 +1347,7 @@ int soscl_ecc_convert_affine_to_jacobian(soscl_type_ecc_word_jacobian_point q,so
   //conversion from x:y to x*z^2:y*z^3:z, with z=1, so x,y,1
   soscl_bignum_memcpy(q.x,a.x,curve_wsize);
   soscl_bignum_memcpy(q.y,a.y,curve_wsize);
-  soscl_bignum_set_one_word(q.z,1,curve_wsize);
+  soscl_ecc_field_one(q.z,curve_params);
   return(SOSCL_OK);
 }
 
@@ -633,17 +1361,68 @@ int soscl_ecc_convert_jacobian_to_affine(soscl_type_ecc_word_affine_point a,sosc
     return(SOSCL_STACK_ERROR);
   tmp=work;
   tmp1=tmp+curve_wsize;
-  //x:y:z corresponds to x/z:y/z
-  //z
-  soscl_ecc_modsquare(tmp,q.z,curve_params);
-  //z^-2 (modular inversion)
-  soscl_bignum_modinv(tmp1,tmp,curve_params->p,curve_wsize);
-  soscl_ecc_modmult(a.x,q.x,tmp1,curve_params);
-  //z
-  soscl_ecc_modmult(tmp,tmp,q.z,curve_params);
-  //z^-3 (modular inversion)
-  soscl_bignum_modinv(tmp1,tmp,curve_params->p,curve_wsize);
-  soscl_ecc_modmult(a.y,q.y,tmp1,curve_params);
+  //x:y:z corresponds to x/z^2:y/z^3
+  //z^-1 (single modular inversion)
+  soscl_ecc_modinv(tmp1,q.z,curve_params);
+  //z^-2
+  soscl_ecc_modsquare(tmp,tmp1,curve_params);
+  soscl_ecc_modmult(a.x,q.x,tmp,curve_params);
+  //z^-3
+  soscl_ecc_modmult(tmp,tmp,tmp1,curve_params);
+  soscl_ecc_modmult(a.y,q.y,tmp,curve_params);
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//n jacobian points q converted into n affine points a, with one single inversion (Montgomery's trick)
+//a[i] coordinates may be the ones of q[i]; infinite points are converted into 0:0
+int soscl_ecc_batch_to_affine(soscl_type_ecc_word_affine_point *a,soscl_type_ecc_word_jacobian_point *q,int n,soscl_type_curve *curve_params)
+{
+  word_type *work,*prod,*inv,*tmp,*tmp1;
+  int i,curve_wsize;
+  if(NULL==curve_params || NULL==q || n<=0)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==a)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work,(n+2)*curve_wsize)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  prod=work;
+  inv=prod+n*curve_wsize;
+  tmp=inv+curve_wsize;
+  //prod[i]=z[0]*...*z[i], skipping the infinite points
+  soscl_ecc_field_one(tmp,curve_params);
+  for(i=0;i<n;i++)
+    {
+      if(SOSCL_OK!=soscl_bignum_cmp_with_zero(q[i].z,curve_wsize))
+	soscl_ecc_modmult(tmp,tmp,q[i].z,curve_params);
+      soscl_bignum_memcpy(prod+i*curve_wsize,tmp,curve_wsize);
+    }
+  //(z[0]*...*z[n-1])^-1
+  soscl_ecc_modinv(inv,tmp,curve_params);
+  for(i=n-1;i>=0;i--)
+    {
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(q[i].z,curve_wsize))
+	{
+	  soscl_bignum_set_zero(a[i].x,curve_wsize);
+	  soscl_bignum_set_zero(a[i].y,curve_wsize);
+	  continue;
+	}
+      //z[i]^-1=inv*prod[i-1], then inv=(z[0]*...*z[i-1])^-1
+      if(i>0)
+	soscl_ecc_modmult(tmp,inv,prod+(i-1)*curve_wsize,curve_params);
+      else
+	soscl_bignum_memcpy(tmp,inv,curve_wsize);
+      soscl_ecc_modmult(inv,inv,q[i].z,curve_params);
+      //prod[i] no longer needed: z[i]^-2, then z[i]^-3
+      tmp1=prod+i*curve_wsize;
+      soscl_ecc_modsquare(tmp1,tmp,curve_params);
+      soscl_ecc_modmult(a[i].x,q[i].x,tmp1,curve_params);
+      soscl_ecc_modmult(tmp1,tmp1,tmp,curve_params);
+      soscl_ecc_modmult(a[i].y,q[i].y,tmp1,curve_params);
+    }
+  soscl_memset(work,0,(n+2)*curve_wsize*(int)sizeof(word_type));
   if (soscl_stack_free(&work)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
@@ -657,14 +1436,16 @@ int soscl_ecc_mult_jacobian(soscl_type_ecc_word_affine_point q, word_type *m, so
   word_type mask;
   uint8_t first_step;
   soscl_type_ecc_word_jacobian_point t;
+  soscl_type_ecc_word_affine_point x1d;
 
   curve_wsize=curve_params->curve_wsize;
-  if (soscl_stack_alloc(&work, curve_wsize*4)!=SOSCL_OK)
+  if (soscl_stack_alloc(&work, curve_wsize*6)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   xc=work;
   yc=xc+curve_wsize;
   zc=yc+curve_wsize;
   zq=zc+curve_wsize;
+  soscl_ecc_affine_to_domain(&x1d,x1,zq+curve_wsize,curve_params);
 
   soscl_bignum_set_zero(q.x,curve_params->curve_wsize);
   soscl_bignum_set_zero(q.y,curve_params->curve_wsize);
@@ -686,14 +1467,16 @@ int soscl_ecc_mult_jacobian(soscl_type_ecc_word_affine_point q, word_type *m, so
 	  {
 	    if(first_step)
 	      {
-		soscl_ecc_convert_affine_to_jacobian(t,x1,curve_params);
+		soscl_ecc_convert_affine_to_jacobian(t,x1d,curve_params);
 		first_step=0;
 	      }
 	    else
-	      soscl_ecc_add_jacobian_affine(t,t,x1,curve_params);
+	      soscl_ecc_add_jacobian_affine(t,t,x1d,curve_params);
 	  }
       }
   soscl_ecc_convert_jacobian_to_affine(q,t,curve_params);
+  soscl_ecc_from_domain(q.x,q.x,curve_params);
+  soscl_ecc_from_domain(q.y,q.y,curve_params);
 
   if (soscl_stack_free(&work)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
@@ -737,9 +1520,22 @@ int soscl_ecc_add_jacobian_jacobian(soscl_type_ecc_word_jacobian_point T3,soscl_
   soscl_ecc_modmult(t2,X1.y,X2.z,curve_params);
   soscl_ecc_modmult(t2,t2,t7,curve_params);
   soscl_ecc_modsub(t1,t1,t4,curve_params);
+  soscl_ecc_modsub(t2,t2,t5,curve_params);
+  //same x: X1==X2 (doubling) or X1==-X2 (infinity)
+  if(SOSCL_OK==soscl_bignum_cmp_with_zero(t1,curve_wsize))
+    {
+      if(SOSCL_OK==soscl_bignum_cmp_with_zero(t2,curve_wsize))
+	soscl_ecc_double_jacobian(T3,X1,curve_params);
+      else
+	{
+	  soscl_bignum_set_one_word(T3.x,1,curve_wsize);
+	  soscl_bignum_set_one_word(T3.y,1,curve_wsize);
+	  soscl_bignum_set_zero(T3.z,curve_wsize);
+	}
+      goto soscl_label_add_jacobian_jacobian_end;
+    }
   soscl_ecc_modmult(t3,X2.z,X1.z,curve_params);
   soscl_ecc_modmult(T3.z,t1,t3,curve_params);
-  soscl_ecc_modsub(t2,t2,t5,curve_params);
   soscl_ecc_modsquare(t7,t1,curve_params);
   soscl_ecc_modsquare(t6,t2,curve_params);
   soscl_ecc_modmult(t4,t4,t7,curve_params);
@@ -752,6 +1548,7 @@ int soscl_ecc_add_jacobian_jacobian(soscl_type_ecc_word_jacobian_point T3,soscl_
   soscl_ecc_modmult(t7,t5,t1,curve_params);
   soscl_ecc_modsub(T3.y,t2,t7,curve_params);
 
+ soscl_label_add_jacobian_jacobian_end:
   if (soscl_stack_free(&work)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
@@ -783,7 +1580,7 @@ int soscl_ecc_add_affine_affine(soscl_type_ecc_word_affine_point q3,soscl_type_e
   tmp1=lambda+curve_wsize;
   tmp2=tmp1+curve_wsize;
   soscl_ecc_modsub(tmp1,q2.x,q1.x,curve_params);
-  soscl_bignum_modinv(tmp2,tmp1,curve_params->p,curve_wsize);
+  soscl_ecc_modinv(tmp2,tmp1,curve_params);
   soscl_ecc_modsub(tmp1,q2.y,q1.y,curve_params);
   soscl_ecc_modmult(lambda,tmp1,tmp2,curve_params);
   //x3=lambda-x1-x2
@@ -802,30 +1599,30 @@ int soscl_ecc_add_affine_affine(soscl_type_ecc_word_affine_point q3,soscl_type_e
 
 int soscl_ecc_double_affine(soscl_type_ecc_word_affine_point q2,soscl_type_ecc_word_affine_point q1, soscl_type_curve *curve_params)
 {
-  word_type *lambda,*t1,*t2,*t3,*three,*work;
+  word_type *lambda,*t1,*t2,*t3,*work;
   int curve_wsize;
 
   if(NULL==curve_params)
     return(SOSCL_INVALID_INPUT);
   curve_wsize=curve_params->curve_wsize;
-  if (soscl_stack_alloc(&work, curve_wsize*5+4)!=SOSCL_OK)
+  if (soscl_stack_alloc(&work, curve_wsize*4+3)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
 
   lambda=work;
   t1=lambda+curve_wsize+1;
   t2=t1+curve_wsize+1;
   t3=t2+curve_wsize+1;
-  three=t3+curve_wsize+1;
  
-  soscl_bignum_set_one_word(three,3,curve_wsize);
+  //3.x1^2 with additions, as 3 is not in the field domain
   soscl_ecc_modsquare(t1,q1.x,curve_params);
-  soscl_ecc_modmult(lambda,three,t1,curve_params);
+  soscl_ecc_modadd(lambda,t1,t1,curve_params);
+  soscl_ecc_modadd(lambda,lambda,t1,curve_params);
   //  t1[curve_wsize]=soscl_bignum_add(t1,lambda,curve_params->a,curve_wsize);
   //soscl_ecc_modcurve(t1,t1,curve_wsize+1,curve_params);
-  soscl_ecc_modadd(t1,lambda,curve_params->a,curve_params);
+  soscl_ecc_modadd(t1,lambda,SOSCL_ECC_DOMAIN_A(curve_params),curve_params);
   t2[curve_wsize]=soscl_bignum_leftshift(t2,q1.y,1,curve_wsize);
   soscl_ecc_modcurve(t2,t2,curve_wsize+1,curve_params);
-  soscl_bignum_modinv(t3,t2,curve_params->p,curve_wsize);
+  soscl_ecc_modinv(t3,t2,curve_params);
   soscl_ecc_modmult(lambda,t1,t3,curve_params);
   soscl_ecc_modsquare(t1,lambda,curve_params);
   soscl_ecc_modsub(t2,t1,q1.x,curve_params);
@@ -844,7 +1641,7 @@ int soscl_ecc_mult_affine(soscl_type_ecc_word_affine_point q, word_type *m,soscl
 {
   int i,j;
   word_type *xt,*yt,*work;
-  soscl_type_ecc_word_affine_point point;
+  soscl_type_ecc_word_affine_point point,pd;
   int size;
   word_type mask;
   int ret;
@@ -853,13 +1650,14 @@ int soscl_ecc_mult_affine(soscl_type_ecc_word_affine_point q, word_type *m,soscl
   if(NULL==curve_params)
     return(SOSCL_INVALID_INPUT);
   curve_wsize=curve_params->curve_wsize;
-  if (soscl_stack_alloc(&work, curve_wsize*2)!=SOSCL_OK)
+  if (soscl_stack_alloc(&work, curve_wsize*4)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   xt=work;
   yt=xt+curve_wsize;
 
   point.x=xt;
   point.y=yt;
+  soscl_ecc_affine_to_domain(&pd,p,yt+curve_wsize,curve_params);
   
   soscl_bignum_memset(q.x,0,curve_wsize);
   soscl_bignum_memset(q.y,0,curve_wsize);
@@ -885,17 +1683,19 @@ int soscl_ecc_mult_affine(soscl_type_ecc_word_affine_point q, word_type *m,soscl
 	    {
 	      if(first_step)
 		{
-		  soscl_affine_copy(q,p,curve_wsize);
+		  soscl_affine_copy(q,pd,curve_wsize);
 		  first_step=0;
 		}
 	      else
 		{
-		  soscl_ecc_add_affine_affine(point,q,p,curve_params);
+		  soscl_ecc_add_affine_affine(point,q,pd,curve_params);
 		  soscl_affine_copy(q,point,curve_wsize);
 		}
 	    }
 	}
     }
+  soscl_ecc_from_domain(q.x,q.x,curve_params);
+  soscl_ecc_from_domain(q.y,q.y,curve_params);
   if (soscl_stack_free(&work)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
@@ -1142,7 +1942,7 @@ int soscl_ecc_xycz_idbl(soscl_type_ecc_word_affine_point out1,soscl_type_ecc_wor
   //3.t3+t4
   soscl_ecc_modadd(t3,t3,t4,curve_params);
   //4.t3+a
-  soscl_ecc_modadd(t3,t3,curve_params->a,curve_params);
+  soscl_ecc_modadd(t3,t3,SOSCL_ECC_DOMAIN_A(curve_params),curve_params);
   //5.t2
   soscl_ecc_modsquare(t4,t2,curve_params);
   //6.2xt4
@@ -1178,35 +1978,13 @@ int soscl_ecc_xycz_idbl(soscl_type_ecc_word_affine_point out1,soscl_type_ecc_wor
 }
 
 //algorithm 9 from Rivain Fast and Regular Algorithms for Scalar Multiplication over Elliptic Curves
-//Montgomery Ladder
-//q=k.x
-int soscl_ecc_mult_coz(soscl_type_ecc_word_affine_point *q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point ,soscl_type_curve *curve_params)
+//Montgomery Ladder, steps 1 to 10
+//on return, p[0] is k.point in co-Z coordinates, and its Z is zn/zd
+//the final inversion is left to the caller, so that it can be shared between several ladders
+static void soscl_ecc_coz_ladder(soscl_type_ecc_word_affine_point *p,word_type *zn,word_type *zd,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params)
 {
   int i,n,b;
-  soscl_type_ecc_word_affine_point p[2];
-  word_type *xr[2],*yr[2],*lambda,*lambda2,*work;
-  int curve_wsize;
-  if(NULL==curve_params)
-    return(SOSCL_INVALID_INPUT);
-  if(NULL==q)
-    return(SOSCL_INVALID_OUTPUT);
-  if(NULL==k)
-    return(SOSCL_INVALID_OUTPUT);
-  curve_wsize=curve_params->curve_wsize;
-  if (soscl_stack_alloc(&work, curve_wsize*6)!=SOSCL_OK)
-    return(SOSCL_STACK_ERROR);
-  xr[0]=work;
-  yr[0]=xr[0]+curve_wsize;
-  xr[1]=yr[0]+curve_wsize;
-  yr[1]=xr[1]+curve_wsize;
-  lambda=yr[1]+curve_wsize;
-  lambda2=lambda+curve_wsize;
-  
   //1. xycz-idbl
-  p[0].x=xr[0];
-  p[0].y=yr[0];
-  p[1].x=xr[1];
-  p[1].y=yr[1];
   soscl_ecc_xycz_idbl(p[1],p[0],point,curve_params);
   //2.for i=n-2 downto 1 do
   n=(int)size*(int)sizeof(word_type)*8;
@@ -1225,23 +2003,142 @@ int soscl_ecc_mult_coz(soscl_type_ecc_word_affine_point *q,word_type *k,word_typ
   b=k[0]&1;
   //8. (r1-b,rb)=xycz-addc(rb,r1-b)
   soscl_ecc_xycz_addc(p[1-b],p[b],p[b],p[1-b],curve_params);
-//9. lambda=finallnvz(r0,r1,p,b);
-  soscl_ecc_modsub(lambda,xr[1],xr[0],curve_params);
-  soscl_ecc_modmult(lambda,lambda,yr[b],curve_params);
-  soscl_ecc_modmult(lambda,lambda,point.x,curve_params);
-  soscl_bignum_modinv(lambda,lambda,curve_params->p,curve_wsize);
-  soscl_ecc_modmult(lambda,lambda,point.y,curve_params);
-  soscl_ecc_modmult(lambda,lambda,xr[b],curve_params);
+//9. lambda=finallnvz(r0,r1,p,b)=zd/zn, without the inversion
+  soscl_ecc_modsub(zn,p[1].x,p[0].x,curve_params);
+  soscl_ecc_modmult(zn,zn,p[b].y,curve_params);
+  soscl_ecc_modmult(zn,zn,point.x,curve_params);
+  soscl_ecc_modmult(zd,point.y,p[b].x,curve_params);
   //10. (rb,r1-b)=xycz-add(r1-b,rb)
   soscl_ecc_xycz_add(p[b],p[1-b],p[1-b],p[b],curve_params);
+}
+
+//q=k.x
+int soscl_ecc_mult_coz(soscl_type_ecc_word_affine_point *q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point ,soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_word_affine_point p[2],pointd;
+  word_type *lambda,*lambda2,*work;
+  int curve_wsize;
+  if(NULL==curve_params)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q)
+    return(SOSCL_INVALID_OUTPUT);
+  if(NULL==k)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work, curve_wsize*8)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  p[0].x=work;
+  p[0].y=p[0].x+curve_wsize;
+  p[1].x=p[0].y+curve_wsize;
+  p[1].y=p[1].x+curve_wsize;
+  lambda=p[1].y+curve_wsize;
+  lambda2=lambda+curve_wsize;
+  soscl_ecc_affine_to_domain(&pointd,point,lambda2+curve_wsize,curve_params);
+  soscl_ecc_coz_ladder(p,lambda,lambda2,k,size,pointd,curve_params);
+  soscl_ecc_modinv(lambda,lambda,curve_params);
+  soscl_ecc_modmult(lambda,lambda,lambda2,curve_params);
   //11. return..
-  //x0.lambda
+  //x0.lambda^2
   soscl_ecc_modsquare(lambda2,lambda,curve_params);
-  soscl_ecc_modmult(q->x,lambda2,xr[0],curve_params);
-  //y0.lambda
+  soscl_ecc_modmult(q->x,lambda2,p[0].x,curve_params);
+  //y0.lambda^3
   soscl_ecc_modmult(lambda2,lambda,lambda2,curve_params);
-  soscl_ecc_modmult(q->y,lambda2,yr[0],curve_params);
+  soscl_ecc_modmult(q->y,lambda2,p[0].y,curve_params);
+  soscl_ecc_from_domain(q->x,q->x,curve_params);
+  soscl_ecc_from_domain(q->y,q->y,curve_params);
+
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
 
+//q=k.point in jacobian coordinates, without any inversion, so that several results can be normalised together
+//q coordinates are in the field domain, as for the soscl_ecc_*_jacobian functions
+int soscl_ecc_mult_coz_jacobian(soscl_type_ecc_word_jacobian_point q,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_word_affine_point p[2],pointd;
+  word_type *zd,*t,*work;
+  int curve_wsize;
+  if(NULL==curve_params || NULL==k)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==q.x || NULL==q.y || NULL==q.z)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  if (soscl_stack_alloc(&work, curve_wsize*8)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  p[0].x=work;
+  p[0].y=p[0].x+curve_wsize;
+  p[1].x=p[0].y+curve_wsize;
+  p[1].y=p[1].x+curve_wsize;
+  zd=p[1].y+curve_wsize;
+  t=zd+curve_wsize;
+  soscl_ecc_affine_to_domain(&pointd,point,t+curve_wsize,curve_params);
+  soscl_ecc_coz_ladder(p,q.z,zd,k,size,pointd,curve_params);
+  //(x0:y0:zn/zd) is (x0.zd^2:y0.zd^3:zn)
+  soscl_ecc_modsquare(t,zd,curve_params);
+  soscl_ecc_modmult(q.x,t,p[0].x,curve_params);
+  soscl_ecc_modmult(t,t,zd,curve_params);
+  soscl_ecc_modmult(q.y,t,p[0].y,curve_params);
+  soscl_memset(work,0,curve_wsize*8*(int)sizeof(word_type));
+  if (soscl_stack_free(&work)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  return(SOSCL_OK);
+}
+
+//x=x-coordinate of k.point (e.g. for ECDH)
+//the ladder is the full co-Z one of soscl_ecc_mult_coz, only the final y-coordinate conversion is skipped
+//the scalar is regularised first, so that the number of ladder steps does not depend on the bit length of k
+int soscl_ecc_mult_coz_affine_x(word_type *x,word_type *k,word_type size,soscl_type_ecc_word_affine_point point,soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_word_affine_point p[2],pointd;
+  word_type *lambda,*lambda2,*kr,*km,*t,*work;
+  int curve_wsize,work_size,msb,msw;
+  if(NULL==curve_params || NULL==k)
+    return(SOSCL_INVALID_INPUT);
+  if(NULL==x)
+    return(SOSCL_INVALID_OUTPUT);
+  curve_wsize=curve_params->curve_wsize;
+  //ladder buffers, regular scalar, k mod n and the scalars computation buffer
+  work_size=curve_wsize*8+(curve_wsize+1)+curve_wsize+(int)size+3*curve_wsize+2;
+  if (soscl_stack_alloc(&work, work_size)!=SOSCL_OK)
+    return(SOSCL_STACK_ERROR);
+  p[0].x=work;
+  p[0].y=p[0].x+curve_wsize;
+  p[1].x=p[0].y+curve_wsize;
+  p[1].y=p[1].x+curve_wsize;
+  lambda=p[1].y+curve_wsize;
+  lambda2=lambda+curve_wsize;
+  kr=lambda2+3*curve_wsize;
+  km=kr+curve_wsize+1;
+  t=km+curve_wsize;
+  //km=k mod n, t=n-km
+  soscl_bignum_memcpy(t,k,(int)size);
+  soscl_ecc_mod(km,t,(int)size,curve_params->n,curve_wsize);
+  soscl_bignum_sub(t,curve_params->n,km,curve_wsize);
+  //the regular scalars of 1, n-1 and n-2 have a prefix equal to n or n-1, so the ladder would meet the infinity point
+  //k.point is then +-point or -2.point, which has the x-coordinate of 2.point
+  //this test is not regular, but it only tells these three trivial scalars apart
+  soscl_bignum_set_one_word(kr,1,curve_wsize);
+  if(0==soscl_bignum_memcmp(km,kr,curve_wsize) || 0==soscl_bignum_memcmp(t,kr,curve_wsize))
+    {
+      soscl_bignum_memcpy(x,point.x,curve_wsize);
+      goto soscl_label_mult_coz_affine_x_end;
+    }
+  kr[0]=2;
+  if(0==soscl_bignum_memcmp(t,kr,curve_wsize))
+    soscl_bignum_memcpy(km,kr,curve_wsize);
+  soscl_ecc_msbit_and_size(&msb,&msw,curve_params);
+  soscl_ecc_regular_scalar(kr,km,curve_wsize,msb,t,curve_params);
+  soscl_ecc_affine_to_domain(&pointd,point,lambda2+curve_wsize,curve_params);
+  soscl_ecc_coz_ladder(p,lambda,lambda2,kr,(word_type)curve_wsize+1,pointd,curve_params);
+  soscl_ecc_modinv(lambda,lambda,curve_params);
+  soscl_ecc_modmult(lambda,lambda,lambda2,curve_params);
+  //x0.lambda^2
+  soscl_ecc_modsquare(lambda,lambda,curve_params);
+  soscl_ecc_modmult(x,lambda,p[0].x,curve_params);
+  soscl_ecc_from_domain(x,x,curve_params);
+ soscl_label_mult_coz_affine_x_end:
+  soscl_memset(work,0,work_size*(int)sizeof(word_type));
   if (soscl_stack_free(&work)!=SOSCL_OK)
     return(SOSCL_STACK_ERROR);
   return(SOSCL_OK);
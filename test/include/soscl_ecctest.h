@@ -2,3 +2,17 @@ int test_ecc_key_generation(int loopmax);
 int test_ecc_oncurve_kat(char *filename);
 int test_ecc_mult_kat(char *filename);
 int test_ecc_keypair_kat(char *filename);
+int test_ecc_multi_mult(void);
+int test_ecc_batch_to_affine(void);
+int test_ecc_ecdh(void);
+int test_ecc_point_compression(void);
+int test_ecc_brainpool(void);
+int test_ecc_complete(void);
+int test_ecc_field_ops(void);
+int test_ecc_field_generated(void);
+int test_ecc_mult_multi(void);
+int test_x25519(void);
+int test_ed25519(void);
+int test_ecc_hash_to_curve(void);
+int test_ecies(void);
+int test_bip32(void);
@@ -1,3 +1,11 @@
 void test_ecdsa_selftests(void);
 int test_ecdsa_rfc(int loopmax);
 int test_ecdsa_signature_verification_kat(char *filename);
+int test_ecdsa_batch_verification(int count);
+int test_ecdsa_sign_batch(int count);
+int test_ecdsa_nonce_pool(int count);
+int test_ecdsa_rfc6979(void);
+int test_ecdsa_verification_r_plus_n(void);
+int test_ecdsa_keystore(int count);
+int test_ecdsa_stream(void);
+int test_ecdsa_cache(void);
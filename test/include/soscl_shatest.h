@@ -15,4 +15,9 @@ int test_hash_kat(char *filename);
 int test_hmac_kat(char *filename);
 
 int test_hash_selftests(void);
+int test_hash_nist_kat(char *filename,int algo);
+int test_sha256_nist_kat(void);
+int test_sha256_multi(void);
+int test_sha512_nist_kat(void);
+int test_sha512_multi(void);
 
@@ -4,6 +4,7 @@
 #define SOSCL_TEST_HASH
 #define SOSCL_TEST_ECDSA
 #define SOSCL_TEST_HMAC
+#define SOSCL_TEST_SECP224R1
 #define SOSCL_TEST_SECP384R1
 #define SOSCL_TEST_SECP256R1
 #define SOSCL_TEST_SECP521R1
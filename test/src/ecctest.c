@@ -29,19 +29,35 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <soscl/soscl_init.h>
 #include <soscl/soscl_ecc.h>
 #include <soscl/soscl_ecc_keygeneration.h>
+#include <soscl/soscl_ecc_multimult.h>
+#include <soscl/soscl_ecdh.h>
+#include <soscl/soscl_ecies.h>
+#include <soscl/soscl_bip32.h>
+#include <soscl/soscl_ecc_encoding.h>
+#include <soscl/soscl_ecc_complete.h>
+#include <soscl/soscl_ecc_field_generated.h>
+#include <soscl/soscl_ecc_multibuffer.h>
 #include <soscl/soscl_bignumbers.h>
 #include <soscl/soscl_hash_sha256.h>
 #include <soscl/soscl_hash_sha384.h>
 #include <soscl/soscl_hash_sha512.h>
 #include <soscl/soscl_rng.h>
 #include <soscl/soscl_string.h>
+#include <soscl/soscl_x25519.h>
+#include <soscl/soscl_ed25519.h>
+#include <soscl/soscl_ecc_hash_to_curve.h>
 #include <soscl_commontest.h>
 
+extern soscl_type_curve soscl_secp224r1;
 extern soscl_type_curve soscl_secp256r1;
+extern soscl_type_curve soscl_secp256k1;
 extern soscl_type_curve soscl_secp384r1;
 #ifdef SOSCL_TEST_SECP521R1
 extern soscl_type_curve soscl_secp521r1;
 #endif
+extern soscl_type_curve soscl_bp256r1;
+extern soscl_type_curve soscl_bp384r1;
+extern soscl_type_curve soscl_bp512r1;
 
 int test_ecc_key_generation(int loopmax)
 {
@@ -163,7 +179,7 @@ int ecc_oncurve_vector_process(char *line)
 {
   //file format is [curve][public key-x, prepended by 0x][public key-y, prepended by a 0x][result, P or F]
   int i,k;
-  char curve_string[3][20];
+  char curve_string[4][20];
   int curve_nb;
   char temp_string[MAX_LINE];
   uint8_t kat_pkx[MAX_LINE];
@@ -187,6 +203,10 @@ int ecc_oncurve_vector_process(char *line)
   sprintf(curve_string[2],"P521");
   curve_nb++;
 #endif
+#ifdef SOSCL_TEST_SECP224R1
+  sprintf(curve_string[3],"P224");
+  curve_nb++;
+#endif
   
   //process the line fields, separated by [ and ]
   i=0;
@@ -266,6 +286,10 @@ int ecc_oncurve_vector_process(char *line)
 #ifdef SOSCL_TEST_SECP521R1
   if(curve_id==2)
     result=soscl_ecc_point_on_curve(q,&soscl_secp521r1);
+#endif
+#ifdef SOSCL_TEST_SECP224R1
+  if(curve_id==3)
+    result=soscl_ecc_point_on_curve(q,&soscl_secp224r1);
 #endif
   if((SOSCL_OK==result && kat_result[0]!='P')||(SOSCL_OK!=result && kat_result[0]=='P'))
     return(SOSCL_ERROR);
@@ -587,7 +611,7 @@ int ecc_mult_vector_process(char *line)
   int ret;
   soscl_type_curve *curve_params;
   word_type curve_bsize,curve_wsize;
-  char curve_string[3][20];
+  char curve_string[4][20];
   int curve_nb;
   uint8_t tmp[SOSCL_SECP521R1_BYTESIZE];
   char temp_string[MAX_LINE];
@@ -599,7 +623,8 @@ int ecc_mult_vector_process(char *line)
   sprintf(curve_string[0],"P256");
   sprintf(curve_string[1],"P384");
   sprintf(curve_string[2],"P521");
-  curve_nb=3;
+  sprintf(curve_string[3],"P224");
+  curve_nb=4;
   
   //process the line fields, separated by [ and ]
   i=0;
@@ -674,6 +699,10 @@ int ecc_mult_vector_process(char *line)
 #ifdef SOSCL_TEST_SECP521R1
   if(curve_id==2)
     curve_params=&soscl_secp521r1;
+#endif
+#ifdef SOSCL_TEST_SECP224R1
+  if(curve_id==3)
+    curve_params=&soscl_secp224r1;
 #endif
   curve_bsize=curve_params->curve_bsize;
   curve_wsize=curve_params->curve_wsize;
@@ -774,4 +803,1086 @@ int test_ecc_mult_kat(char *filename)
 }
 
 
+#define SOSCL_TEST_MULTIMULT_MAX 70
+static word_type test_multimult_x[SOSCL_TEST_MULTIMULT_MAX][SOSCL_ECDSA_MAX_WORDSIZE];
+static word_type test_multimult_y[SOSCL_TEST_MULTIMULT_MAX][SOSCL_ECDSA_MAX_WORDSIZE];
+static word_type test_multimult_k[SOSCL_TEST_MULTIMULT_MAX*SOSCL_ECDSA_MAX_WORDSIZE];
+static word_type test_multimult_workspace[2048];
+
+//random points (points 0 and 1 being equal) and scalars
+//the multi-scalar multiplication is compared with the sum of the single multiplications
+int test_ecc_multi_mult_check(int count,word_type *workspace,int workspace_size,soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_uint8_t_affine_point Q;
+  soscl_type_ecc_word_affine_point points[SOSCL_TEST_MULTIMULT_MAX],q,r;
+  soscl_type_ecc_word_jacobian_point acc;
+  uint8_t x[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t y[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t d[SOSCL_SECP521R1_BYTESIZE];
+  word_type qx[SOSCL_ECDSA_MAX_WORDSIZE],qy[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type rx[SOSCL_ECDSA_MAX_WORDSIZE],ry[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type ax[SOSCL_ECDSA_MAX_WORDSIZE],ay[SOSCL_ECDSA_MAX_WORDSIZE],az[SOSCL_ECDSA_MAX_WORDSIZE];
+  int i,wsize,bsize;
+  wsize=curve_params->curve_wsize;
+  bsize=curve_params->curve_bsize;
+  Q.x=x;
+  Q.y=y;
+  for(i=0;i<count;i++)
+    {
+      points[i].x=test_multimult_x[i];
+      points[i].y=test_multimult_y[i];
+      if(1!=i)
+	{
+	  if(SOSCL_OK!=soscl_ecc_keygeneration(Q,d,curve_params))
+	    return(SOSCL_ERROR);
+	  soscl_bignum_b2w(points[i].x,wsize,x,bsize);
+	  soscl_bignum_b2w(points[i].y,wsize,y,bsize);
+	}
+      else
+	{
+	  soscl_bignum_memcpy(points[1].x,points[0].x,wsize);
+	  soscl_bignum_memcpy(points[1].y,points[0].y,wsize);
+	}
+      //scalars shorter than n
+      soscl_rng_read(d,bsize-1,SOSCL_RAND_GENERIC);
+      soscl_bignum_b2w(test_multimult_k+i*wsize,wsize,d,bsize-1);
+    }
+  q.x=qx;
+  q.y=qy;
+  if(SOSCL_OK!=soscl_ecc_multi_mult(q,test_multimult_k,points,count,workspace,workspace_size,curve_params))
+    return(SOSCL_ERROR);
+  r.x=rx;
+  r.y=ry;
+  acc.x=ax;
+  acc.y=ay;
+  acc.z=az;
+  soscl_bignum_set_one_word(acc.x,1,wsize);
+  soscl_bignum_set_one_word(acc.y,1,wsize);
+  soscl_bignum_set_zero(acc.z,wsize);
+  //the accumulation uses the point operations, so in the curve field domain
+  for(i=0;i<count;i++)
+    {
+      soscl_ecc_mult_coz(&r,test_multimult_k+i*wsize,wsize,points[i],curve_params);
+      soscl_ecc_to_domain(r.x,r.x,curve_params);
+      soscl_ecc_to_domain(r.y,r.y,curve_params);
+      soscl_ecc_add_jacobian_affine(acc,acc,r,curve_params);
+    }
+  soscl_ecc_convert_jacobian_to_affine(r,acc,curve_params);
+  soscl_ecc_from_domain(r.x,r.x,curve_params);
+  soscl_ecc_from_domain(r.y,r.y,curve_params);
+  if(0!=soscl_bignum_memcmp(q.x,r.x,wsize) || 0!=soscl_bignum_memcmp(q.y,r.y,wsize))
+    return(SOSCL_ERROR);
+  //k.P+(n-k).P is infinity
+  soscl_bignum_sub(test_multimult_k+wsize,curve_params->n,test_multimult_k,wsize);
+  if(SOSCL_OK!=soscl_ecc_multi_mult(q,test_multimult_k,points,2,NULL,0,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_TRUE!=soscl_ecc_infinite_affine(q.x,q.y,wsize))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecc_multi_mult(void)
+{
+  //Straus, tables on the soscl stack
+  if(SOSCL_OK!=test_ecc_multi_mult_check(3,NULL,0,&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_multi_mult_check(3,NULL,0,&soscl_secp384r1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_multi_mult_check(3,NULL,0,&soscl_secp521r1))
+    return(SOSCL_ERROR);
+#endif
+  //Pippenger, buckets in a caller workspace
+  if(soscl_ecc_multi_mult_workspace_size(SOSCL_TEST_MULTIMULT_MAX,&soscl_secp256r1)>(int)(sizeof(test_multimult_workspace)/sizeof(word_type)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_multi_mult_check(SOSCL_TEST_MULTIMULT_MAX,test_multimult_workspace,sizeof(test_multimult_workspace)/sizeof(word_type),&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+#define SOSCL_TEST_BATCH_AFFINE_NB 6
+//jacobian points 2G, 3G, ... (one being infinite) normalised at once, compared with the single conversion
+int test_ecc_batch_to_affine_curve(soscl_type_curve *curve_params)
+{
+  word_type buffer[SOSCL_TEST_BATCH_AFFINE_NB*5*SOSCL_ECDSA_MAX_WORDSIZE];
+  soscl_type_ecc_word_jacobian_point q[SOSCL_TEST_BATCH_AFFINE_NB];
+  soscl_type_ecc_word_affine_point a[SOSCL_TEST_BATCH_AFFINE_NB],r[SOSCL_TEST_BATCH_AFFINE_NB],g;
+  int i,wsize;
+  wsize=curve_params->curve_wsize;
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  for(i=0;i<SOSCL_TEST_BATCH_AFFINE_NB;i++)
+    {
+      q[i].x=buffer+i*5*wsize;
+      q[i].y=q[i].x+wsize;
+      q[i].z=q[i].y+wsize;
+      r[i].x=q[i].z+wsize;
+      r[i].y=r[i].x+wsize;
+      if(0==i)
+	{
+	  soscl_ecc_convert_affine_to_jacobian(q[0],g,curve_params);
+	  soscl_ecc_double_jacobian(q[0],q[0],curve_params);
+	}
+      else
+	soscl_ecc_add_jacobian_affine(q[i],q[i-1],g,curve_params);
+      soscl_ecc_convert_jacobian_to_affine(r[i],q[i],curve_params);
+    }
+  soscl_bignum_set_one_word(q[2].x,1,wsize);
+  soscl_bignum_set_one_word(q[2].y,1,wsize);
+  soscl_bignum_set_zero(q[2].z,wsize);
+  soscl_bignum_set_zero(r[2].x,wsize);
+  soscl_bignum_set_zero(r[2].y,wsize);
+  //in place normalisation
+  for(i=0;i<SOSCL_TEST_BATCH_AFFINE_NB;i++)
+    {
+      a[i].x=q[i].x;
+      a[i].y=q[i].y;
+    }
+  if(SOSCL_OK!=soscl_ecc_batch_to_affine(a,q,SOSCL_TEST_BATCH_AFFINE_NB,curve_params))
+    return(SOSCL_ERROR);
+  for(i=0;i<SOSCL_TEST_BATCH_AFFINE_NB;i++)
+    if(0!=soscl_bignum_memcmp(a[i].x,r[i].x,wsize) || 0!=soscl_bignum_memcmp(a[i].y,r[i].y,wsize))
+      return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecc_batch_to_affine(void)
+{
+  if(SOSCL_OK!=test_ecc_batch_to_affine_curve(&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_batch_to_affine_curve(&soscl_secp384r1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_batch_to_affine_curve(&soscl_secp521r1))
+    return(SOSCL_ERROR);
+#endif
+  return(SOSCL_OK);
+}
+
+//NIST CAVS ECC CDH primitive, P-256 COUNT=0
+int test_ecc_ecdh_kat(void)
+{
+  uint8_t qx[SOSCL_SECP256R1_BYTESIZE]={0x70,0x0c,0x48,0xf7,0x7f,0x56,0x58,0x4c,0x5c,0xc6,0x32,0xca,0x65,0x64,0x0d,0xb9,0x1b,0x6b,0xac,0xce,0x3a,0x4d,0xf6,0xb4,0x2c,0xe7,0xcc,0x83,0x88,0x33,0xd2,0x87};
+  uint8_t qy[SOSCL_SECP256R1_BYTESIZE]={0xdb,0x71,0xe5,0x09,0xe3,0xfd,0x9b,0x06,0x0d,0xdb,0x20,0xba,0x5c,0x51,0xdc,0xc5,0x94,0x8d,0x46,0xfb,0xf6,0x40,0xdf,0xe0,0x44,0x17,0x82,0xca,0xb8,0x5f,0xa4,0xac};
+  uint8_t d[SOSCL_SECP256R1_BYTESIZE]={0x7d,0x7d,0xc5,0xf7,0x1e,0xb2,0x9d,0xda,0xf8,0x0d,0x62,0x14,0x63,0x2e,0xea,0xe0,0x3d,0x90,0x58,0xaf,0x1f,0xb6,0xd2,0x2e,0xd8,0x0b,0xad,0xb6,0x2b,0xc1,0xa5,0x34};
+  uint8_t z[SOSCL_SECP256R1_BYTESIZE]={0x46,0xfc,0x62,0x10,0x64,0x20,0xff,0x01,0x2e,0x54,0xa4,0x34,0xfb,0xdd,0x2d,0x25,0xcc,0xc5,0x85,0x20,0x60,0x56,0x1e,0x68,0x04,0x0d,0xd7,0x77,0x89,0x97,0xbd,0x7b};
+  uint8_t secret[SOSCL_SECP256R1_BYTESIZE];
+  soscl_type_ecc_uint8_t_affine_point peer;
+  peer.x=qx;
+  peer.y=qy;
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(secret,peer,d,&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(secret,z,SOSCL_SECP256R1_BYTESIZE))
+    return(SOSCL_ERROR);
+  //a point not on the curve shall be rejected
+  qy[SOSCL_SECP256R1_BYTESIZE-1]^=1;
+  if(SOSCL_INVALID_INPUT!=soscl_ecdh_shared_secret(secret,peer,d,&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//both parties shall compute the same secret, equal to the x-coordinate of the full multiplication
+int test_ecc_ecdh_curve(soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_uint8_t_affine_point qa,qb;
+  uint8_t xa[SOSCL_SECP521R1_BYTESIZE],ya[SOSCL_SECP521R1_BYTESIZE],da[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t xb[SOSCL_SECP521R1_BYTESIZE],yb[SOSCL_SECP521R1_BYTESIZE],db[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t sa[SOSCL_SECP521R1_BYTESIZE],sb[SOSCL_SECP521R1_BYTESIZE];
+  word_type wd[SOSCL_ECDSA_MAX_WORDSIZE],wx[SOSCL_ECDSA_MAX_WORDSIZE],wy[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type rx[SOSCL_ECDSA_MAX_WORDSIZE],ry[SOSCL_ECDSA_MAX_WORDSIZE];
+  soscl_type_ecc_word_affine_point p,r;
+  int wsize,bsize;
+  wsize=curve_params->curve_wsize;
+  bsize=curve_params->curve_bsize;
+  qa.x=xa;
+  qa.y=ya;
+  qb.x=xb;
+  qb.y=yb;
+  if(SOSCL_OK!=soscl_ecc_keygeneration(qa,da,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecc_keygeneration(qb,db,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sa,qb,da,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sb,qa,db,curve_params))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(sa,sb,bsize))
+    return(SOSCL_ERROR);
+  soscl_bignum_b2w(wd,wsize,da,bsize);
+  soscl_bignum_b2w(wx,wsize,xb,bsize);
+  soscl_bignum_b2w(wy,wsize,yb,bsize);
+  p.x=wx;
+  p.y=wy;
+  r.x=rx;
+  r.y=ry;
+  soscl_ecc_mult_coz(&r,wd,wsize,p,curve_params);
+  soscl_bignum_w2b(sb,bsize,rx,wsize);
+  if(0!=memcmp(sa,sb,bsize))
+    return(SOSCL_ERROR);
+  //short scalars take as many ladder steps as the others: d=1, 2, 2^32+1, n-2 and n-1
+  //d.Q and -d.Q share the x-coordinate, so d=1 and d=n-1 shall both return the x-coordinate of Q, and d=n-2 the one of 2.Q
+  memset(da,0,bsize);
+  da[bsize-1]=1;
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sa,qb,da,curve_params) || 0!=memcmp(sa,xb,bsize))
+    return(SOSCL_ERROR);
+  soscl_bignum_w2b(da,bsize,curve_params->n,wsize);
+  da[bsize-1]--;
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sa,qb,da,curve_params) || 0!=memcmp(sa,xb,bsize))
+    return(SOSCL_ERROR);
+  memset(da,0,bsize);
+  da[bsize-1]=2;
+  soscl_bignum_b2w(wd,wsize,da,bsize);
+  soscl_ecc_mult_coz(&r,wd,wsize,p,curve_params);
+  soscl_bignum_w2b(sb,bsize,rx,wsize);
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sa,qb,da,curve_params) || 0!=memcmp(sa,sb,bsize))
+    return(SOSCL_ERROR);
+  soscl_bignum_w2b(da,bsize,curve_params->n,wsize);
+  da[bsize-1]-=2;
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sa,qb,da,curve_params) || 0!=memcmp(sa,sb,bsize))
+    return(SOSCL_ERROR);
+  memset(da,0,bsize);
+  da[bsize-1]=1;
+  da[bsize-5]=1;
+  soscl_bignum_b2w(wd,wsize,da,bsize);
+  soscl_ecc_mult_coz(&r,wd,wsize,p,curve_params);
+  soscl_bignum_w2b(sb,bsize,rx,wsize);
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(sa,qb,da,curve_params) || 0!=memcmp(sa,sb,bsize))
+    return(SOSCL_ERROR);
+  //d=0 is rejected
+  memset(da,0,bsize);
+  if(SOSCL_INVALID_INPUT!=soscl_ecdh_shared_secret(sa,qb,da,curve_params))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecc_ecdh(void)
+{
+  if(SOSCL_OK!=test_ecc_ecdh_kat())
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_ecdh_curve(&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_ecdh_curve(&soscl_secp384r1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_ecdh_curve(&soscl_secp521r1))
+    return(SOSCL_ERROR);
+#endif
+#ifdef SOSCL_TEST_SECP224R1
+  if(SOSCL_OK!=test_ecc_ecdh_curve(&soscl_secp224r1))
+    return(SOSCL_ERROR);
+#endif
+  if(SOSCL_OK!=test_ecc_ecdh_curve(&soscl_secp256k1))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//compressed points are decoded back to the generated public keys
+//x-coordinates with no matching y are rejected
+int test_ecc_point_compression_curve(soscl_type_curve *curve_params)
+{
+  soscl_type_ecc_uint8_t_affine_point q,r;
+  uint8_t x[SOSCL_SECP521R1_BYTESIZE],y[SOSCL_SECP521R1_BYTESIZE],d[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t rx[SOSCL_SECP521R1_BYTESIZE],ry[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t compressed[SOSCL_SECP521R1_BYTESIZE+1];
+  int i,bsize,ret,rejected;
+  bsize=curve_params->curve_bsize;
+  q.x=x;
+  q.y=y;
+  r.x=rx;
+  r.y=ry;
+  for(i=0;i<4;i++)
+    {
+      if(SOSCL_OK!=soscl_ecc_keygeneration(q,d,curve_params))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecc_point_compress(compressed,q,curve_params))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecc_point_decompress(r,compressed,bsize+1,curve_params))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(rx,x,bsize) || 0!=memcmp(ry,y,bsize))
+	return(SOSCL_ERROR);
+      //the other parity gives -q
+      compressed[0]^=1;
+      if(SOSCL_OK!=soscl_ecc_point_decompress(r,compressed,bsize+1,curve_params))
+	return(SOSCL_ERROR);
+      if(0==memcmp(ry,y,bsize) || SOSCL_OK!=soscl_ecc_point_on_curve(r,curve_params))
+	return(SOSCL_ERROR);
+    }
+  compressed[0]=SOSCL_ECC_POINT_UNCOMPRESSED;
+  if(SOSCL_INVALID_INPUT!=soscl_ecc_point_decompress(r,compressed,bsize+1,curve_params))
+    return(SOSCL_ERROR);
+  //about half of the x are not on the curve
+  compressed[0]=SOSCL_ECC_POINT_COMPRESSED_EVEN;
+  rejected=0;
+  for(i=0;i<16;i++)
+    {
+      compressed[bsize]=(uint8_t)i;
+      ret=soscl_ecc_point_decompress(r,compressed,bsize+1,curve_params);
+      if(SOSCL_INVALID_INPUT==ret)
+	rejected++;
+      else
+	if(SOSCL_OK!=ret || SOSCL_OK!=soscl_ecc_point_on_curve(r,curve_params))
+	  return(SOSCL_ERROR);
+    }
+  if(0==rejected || 16==rejected)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecc_point_compression(void)
+{
+  if(SOSCL_OK!=test_ecc_point_compression_curve(&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_point_compression_curve(&soscl_secp384r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_point_compression_curve(&soscl_secp256k1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_point_compression_curve(&soscl_secp521r1))
+    return(SOSCL_ERROR);
+#endif
+  return(SOSCL_OK);
+}
+
+//RFC 7027 brainpoolP256r1 key exchange: dA.G=QA, then dA.QB
+int test_ecc_brainpool_kat(void)
+{
+  uint8_t da[SOSCL_BP256R1_BYTESIZE]={0x81,0xdb,0x1e,0xe1,0x00,0x15,0x0f,0xf2,0xea,0x33,0x8d,0x70,0x82,0x71,0xbe,0x38,0x30,0x0c,0xb5,0x42,0x41,0xd7,0x99,0x50,0xf7,0x7b,0x06,0x30,0x39,0x80,0x4f,0x1d};
+  uint8_t qax[SOSCL_BP256R1_BYTESIZE]={0x44,0x10,0x6e,0x91,0x3f,0x92,0xbc,0x02,0xa1,0x70,0x5d,0x99,0x53,0xa8,0x41,0x4d,0xb9,0x5e,0x1a,0xaa,0x49,0xe8,0x1d,0x9e,0x85,0xf9,0x29,0xa8,0xe3,0x10,0x0b,0xe5};
+  uint8_t qay[SOSCL_BP256R1_BYTESIZE]={0x8a,0xb4,0x84,0x6f,0x11,0xca,0xcc,0xb7,0x3c,0xe4,0x9c,0xbd,0xd1,0x20,0xf5,0xa9,0x00,0xa6,0x9f,0xd3,0x2c,0x27,0x22,0x23,0xf7,0x89,0xef,0x10,0xeb,0x08,0x9b,0xdc};
+  uint8_t qbx[SOSCL_BP256R1_BYTESIZE]={0x8d,0x2d,0x68,0x8c,0x6c,0xf9,0x3e,0x11,0x60,0xad,0x04,0xcc,0x44,0x29,0x11,0x7d,0xc2,0xc4,0x18,0x25,0xe1,0xe9,0xfc,0xa0,0xad,0xdd,0x34,0xe6,0xf1,0xb3,0x9f,0x7b};
+  uint8_t qby[SOSCL_BP256R1_BYTESIZE]={0x99,0x0c,0x57,0x52,0x08,0x12,0xbe,0x51,0x26,0x41,0xe4,0x70,0x34,0x83,0x21,0x06,0xbc,0x7d,0x3e,0x8d,0xd0,0xe4,0xc7,0xf1,0x13,0x6d,0x70,0x06,0x54,0x7c,0xec,0x6a};
+  uint8_t z[SOSCL_BP256R1_BYTESIZE]={0x89,0xaf,0xc3,0x9d,0x41,0xd3,0xb3,0x27,0x81,0x4b,0x80,0x94,0x0b,0x04,0x25,0x90,0xf9,0x65,0x56,0xec,0x91,0xe6,0xae,0x79,0x39,0xbc,0xe3,0x1f,0x3a,0x18,0xbf,0x2b};
+  uint8_t x[SOSCL_BP256R1_BYTESIZE],y[SOSCL_BP256R1_BYTESIZE];
+  soscl_type_ecc_uint8_t_affine_point q;
+  q.x=x;
+  q.y=y;
+  if(SOSCL_OK!=soscl_ecc_publickeygeneration(q,da,&soscl_bp256r1))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(x,qax,SOSCL_BP256R1_BYTESIZE) || 0!=memcmp(y,qay,SOSCL_BP256R1_BYTESIZE))
+    return(SOSCL_ERROR);
+  q.x=qbx;
+  q.y=qby;
+  if(SOSCL_OK!=soscl_ecdh_shared_secret(x,q,da,&soscl_bp256r1))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(x,z,SOSCL_BP256R1_BYTESIZE))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//brainpool curves, their field elements being in the Montgomery domain
+int test_ecc_brainpool(void)
+{
+  soscl_type_curve *curves[3];
+  int i;
+  curves[0]=&soscl_bp256r1;
+  curves[1]=&soscl_bp384r1;
+  curves[2]=&soscl_bp512r1;
+  if(SOSCL_OK!=test_ecc_brainpool_kat())
+    return(SOSCL_ERROR);
+  for(i=0;i<3;i++)
+    {
+      if(SOSCL_OK!=test_ecc_ecdh_curve(curves[i]))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=test_ecc_point_compression_curve(curves[i]))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=test_ecc_multi_mult_check(3,NULL,0,curves[i]))
+	return(SOSCL_ERROR);
+    }
+  if(soscl_ecc_multi_mult_workspace_size(SOSCL_TEST_MULTIMULT_MAX,&soscl_bp256r1)>(int)(sizeof(test_multimult_workspace)/sizeof(word_type)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_multi_mult_check(SOSCL_TEST_MULTIMULT_MAX,test_multimult_workspace,sizeof(test_multimult_workspace)/sizeof(word_type),&soscl_bp256r1))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//complete formulas: ladder result against the coZ one, then the exceptional cases
+int test_ecc_complete_curve(soscl_type_curve *curve_params)
+{
+  word_type k[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type qx[SOSCL_ECDSA_MAX_WORDSIZE],qy[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type rx[SOSCL_ECDSA_MAX_WORDSIZE],ry[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type px[SOSCL_ECDSA_MAX_WORDSIZE],py[SOSCL_ECDSA_MAX_WORDSIZE],pz[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type sx[SOSCL_ECDSA_MAX_WORDSIZE],sy[SOSCL_ECDSA_MAX_WORDSIZE],sz[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type tx[SOSCL_ECDSA_MAX_WORDSIZE],ty[SOSCL_ECDSA_MAX_WORDSIZE],tz[SOSCL_ECDSA_MAX_WORDSIZE];
+  uint8_t d[SOSCL_SECP521R1_BYTESIZE];
+  soscl_type_ecc_word_affine_point g,q,r;
+  soscl_type_ecc_word_projective_point p,s,t;
+  int i,wsize,bsize;
+  wsize=curve_params->curve_wsize;
+  bsize=curve_params->curve_bsize;
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  q.x=qx;
+  q.y=qy;
+  r.x=rx;
+  r.y=ry;
+  p.x=px;
+  p.y=py;
+  p.z=pz;
+  s.x=sx;
+  s.y=sy;
+  s.z=sz;
+  t.x=tx;
+  t.y=ty;
+  t.z=tz;
+  for(i=0;i<4;i++)
+    {
+      //scalars shorter than n
+      soscl_rng_read(d,bsize-1,SOSCL_RAND_GENERIC);
+      soscl_bignum_b2w(k,wsize,d,bsize-1);
+      if(SOSCL_OK!=soscl_ecc_mult_complete(q,k,wsize,g,curve_params))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecc_mult_coz(&r,k,wsize,g,curve_params))
+	return(SOSCL_ERROR);
+      if(0!=soscl_bignum_memcmp(qx,rx,wsize) || 0!=soscl_bignum_memcmp(qy,ry,wsize))
+	return(SOSCL_ERROR);
+    }
+  //(n-1).G=-G
+  soscl_bignum_memcpy(k,curve_params->n,wsize);
+  k[0]--;
+  if(SOSCL_OK!=soscl_ecc_mult_complete(q,k,wsize,g,curve_params))
+    return(SOSCL_ERROR);
+  soscl_bignum_sub(ry,curve_params->p,curve_params->yg,wsize);
+  if(0!=soscl_bignum_memcmp(qx,curve_params->xg,wsize) || 0!=soscl_bignum_memcmp(qy,ry,wsize))
+    return(SOSCL_ERROR);
+  //n.G and 0.G are the infinity point
+  k[0]++;
+  if(SOSCL_OK!=soscl_ecc_mult_complete(q,k,wsize,g,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_TRUE!=soscl_ecc_infinite_affine(qx,qy,wsize))
+    return(SOSCL_ERROR);
+  soscl_bignum_set_zero(k,wsize);
+  if(SOSCL_OK!=soscl_ecc_mult_complete(q,k,wsize,g,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_TRUE!=soscl_ecc_infinite_affine(qx,qy,wsize))
+    return(SOSCL_ERROR);
+  //G+G=2.G
+  soscl_ecc_convert_affine_to_projective(p,g,curve_params);
+  soscl_ecc_add_complete(s,p,p,curve_params);
+  soscl_ecc_double_complete(t,p,curve_params);
+  soscl_ecc_convert_projective_to_affine(q,s,curve_params);
+  soscl_ecc_convert_projective_to_affine(r,t,curve_params);
+  if(0!=soscl_bignum_memcmp(qx,rx,wsize) || 0!=soscl_bignum_memcmp(qy,ry,wsize))
+    return(SOSCL_ERROR);
+  //G+O=G and O+G=G
+  soscl_ecc_projective_set_infinite(t,curve_params);
+  soscl_ecc_add_complete(s,p,t,curve_params);
+  soscl_ecc_convert_projective_to_affine(q,s,curve_params);
+  if(0!=soscl_bignum_memcmp(qx,g.x,wsize) || 0!=soscl_bignum_memcmp(qy,g.y,wsize))
+    return(SOSCL_ERROR);
+  soscl_ecc_add_complete(s,t,p,curve_params);
+  soscl_ecc_convert_projective_to_affine(q,s,curve_params);
+  if(0!=soscl_bignum_memcmp(qx,g.x,wsize) || 0!=soscl_bignum_memcmp(qy,g.y,wsize))
+    return(SOSCL_ERROR);
+  //G+(-G)=O, 2.O=O
+  soscl_bignum_memcpy(tx,g.x,wsize);
+  soscl_bignum_sub(ty,curve_params->p,g.y,wsize);
+  soscl_ecc_field_one(tz,curve_params);
+  soscl_ecc_add_complete(s,p,t,curve_params);
+  if(SOSCL_OK!=soscl_bignum_cmp_with_zero(sz,wsize))
+    return(SOSCL_ERROR);
+  soscl_ecc_double_complete(s,s,curve_params);
+  if(SOSCL_OK!=soscl_bignum_cmp_with_zero(sz,wsize))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecc_complete(void)
+{
+  word_type px[SOSCL_ECDSA_MAX_WORDSIZE],py[SOSCL_ECDSA_MAX_WORDSIZE],pz[SOSCL_ECDSA_MAX_WORDSIZE];
+  soscl_type_ecc_word_projective_point p;
+  p.x=px;
+  p.y=py;
+  p.z=pz;
+  if(SOSCL_OK!=test_ecc_complete_curve(&soscl_secp224r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_complete_curve(&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_complete_curve(&soscl_secp384r1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_complete_curve(&soscl_secp521r1))
+    return(SOSCL_ERROR);
+  //only a=-3 curves are supported
+  if(SOSCL_INVALID_INPUT!=soscl_ecc_double_complete(p,p,&soscl_bp256r1))
+    return(SOSCL_ERROR);
+#endif
+  return(SOSCL_OK);
+}
+
+static int test_ecc_field_ops_count;
+static soscl_type_ecc_field_ops test_ecc_field_ops_table;
+
+static int test_ecc_field_ops_mult(word_type *r,word_type *a,word_type *b,soscl_type_curve *curve_params)
+{
+  test_ecc_field_ops_count++;
+  return(soscl_ecc_default_field_ops(curve_params)->mult(r,a,b,curve_params));
+}
+
+//a backend table plugged into the curve is used by the point arithmetic
+int test_ecc_field_ops(void)
+{
+  word_type k[SOSCL_SECP256R1_WORDSIZE],qx[SOSCL_SECP256R1_WORDSIZE],qy[SOSCL_SECP256R1_WORDSIZE],rx[SOSCL_SECP256R1_WORDSIZE],ry[SOSCL_SECP256R1_WORDSIZE];
+  uint8_t d[SOSCL_SECP256R1_BYTESIZE];
+  soscl_type_ecc_word_affine_point g,q,r;
+  soscl_type_curve *curve_params=&soscl_secp256r1;
+  int wsize,ret;
+  wsize=curve_params->curve_wsize;
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  q.x=qx;
+  q.y=qy;
+  r.x=rx;
+  r.y=ry;
+  soscl_rng_read(d,SOSCL_SECP256R1_BYTESIZE-1,SOSCL_RAND_GENERIC);
+  soscl_bignum_b2w(k,wsize,d,SOSCL_SECP256R1_BYTESIZE-1);
+  if(SOSCL_OK!=soscl_ecc_mult_coz(&q,k,wsize,g,curve_params))
+    return(SOSCL_ERROR);
+  test_ecc_field_ops_table=*soscl_ecc_default_field_ops(curve_params);
+  test_ecc_field_ops_table.mult=test_ecc_field_ops_mult;
+  if(SOSCL_OK!=soscl_ecc_set_field_ops(curve_params,&test_ecc_field_ops_table))
+    return(SOSCL_ERROR);
+  test_ecc_field_ops_count=0;
+  ret=soscl_ecc_mult_coz(&r,k,wsize,g,curve_params);
+  soscl_ecc_set_field_ops(curve_params,NULL);
+  if(SOSCL_OK!=ret || 0==test_ecc_field_ops_count)
+    return(SOSCL_ERROR);
+  if(0!=soscl_bignum_memcmp(qx,rx,wsize) || 0!=soscl_bignum_memcmp(qy,ry,wsize))
+    return(SOSCL_ERROR);
+  if(curve_params->field_ops!=soscl_ecc_default_field_ops(curve_params))
+    return(SOSCL_ERROR);
+  //incomplete tables are rejected
+  test_ecc_field_ops_table.inv=NULL;
+  if(SOSCL_INVALID_INPUT!=soscl_ecc_set_field_ops(curve_params,&test_ecc_field_ops_table))
+    return(SOSCL_ERROR);
+  if(curve_params->field_ops!=soscl_ecc_default_field_ops(curve_params))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//random number of size words, reduced mod p when reduce is set
+static void test_ecc_field_random(word_type *a,int size,int reduce,soscl_type_curve *curve_params)
+{
+  uint8_t bytes[2*SOSCL_ECDSA_MAX_WORDSIZE*sizeof(word_type)];
+  word_type t[2*SOSCL_ECDSA_MAX_WORDSIZE];
+  soscl_rng_read(bytes,size*sizeof(word_type),SOSCL_RAND_GENERIC);
+  soscl_bignum_b2w(t,size,bytes,size*sizeof(word_type));
+  if(reduce)
+    soscl_ecc_mod(a,t,size,curve_params->p,curve_params->curve_wsize);
+  else
+    soscl_bignum_memcpy(a,t,size);
+}
+
+//generated field arithmetic against the generic reduction
+static int test_ecc_field_generated_curve(soscl_type_ecc_field_ops *ops,soscl_type_curve *curve_params)
+{
+  word_type a[SOSCL_ECDSA_MAX_WORDSIZE],b[SOSCL_ECDSA_MAX_WORDSIZE],r[SOSCL_ECDSA_MAX_WORDSIZE],ref[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type c[2*SOSCL_ECDSA_MAX_WORDSIZE];
+  soscl_type_ecc_word_affine_point g,q1,q2;
+  word_type q1x[SOSCL_ECDSA_MAX_WORDSIZE],q1y[SOSCL_ECDSA_MAX_WORDSIZE],q2x[SOSCL_ECDSA_MAX_WORDSIZE],q2y[SOSCL_ECDSA_MAX_WORDSIZE];
+  int wsize,i,ret;
+  wsize=curve_params->curve_wsize;
+  for(i=0;i<200;i++)
+    {
+      switch(i)
+	{
+	case 0:
+	  soscl_bignum_set_zero(a,wsize);
+	  soscl_bignum_set_zero(b,wsize);
+	  break;
+	case 1:
+	  //p-1, p-1
+	  soscl_bignum_set_one_word(a,1,wsize);
+	  soscl_bignum_sub(a,curve_params->p,a,wsize);
+	  soscl_bignum_memcpy(b,a,wsize);
+	  break;
+	case 2:
+	  soscl_bignum_set_one_word(a,1,wsize);
+	  soscl_bignum_sub(b,curve_params->p,a,wsize);
+	  break;
+	default:
+	  test_ecc_field_random(a,wsize,1,curve_params);
+	  test_ecc_field_random(b,wsize,1,curve_params);
+	}
+      //a.b
+      ops->mult(r,a,b,curve_params);
+      soscl_bignum_mult(c,a,b,wsize);
+      soscl_ecc_mod(ref,c,2*wsize,curve_params->p,wsize);
+      if(0!=soscl_bignum_memcmp(r,ref,wsize))
+	return(SOSCL_ERROR);
+      //a^2
+      ops->square(r,a,curve_params);
+      soscl_bignum_square(c,a,wsize);
+      soscl_ecc_mod(ref,c,2*wsize,curve_params->p,wsize);
+      if(0!=soscl_bignum_memcmp(r,ref,wsize))
+	return(SOSCL_ERROR);
+      //a+b
+      ops->add(r,a,b,curve_params);
+      c[wsize]=soscl_bignum_add(c,a,b,wsize);
+      soscl_ecc_mod(ref,c,wsize+1,curve_params->p,wsize);
+      if(0!=soscl_bignum_memcmp(r,ref,wsize))
+	return(SOSCL_ERROR);
+      //a-b=a+(p-b)
+      ops->sub(r,a,b,curve_params);
+      soscl_bignum_sub(c,curve_params->p,b,wsize);
+      c[wsize]=soscl_bignum_add(c,c,a,wsize);
+      soscl_ecc_mod(ref,c,wsize+1,curve_params->p,wsize);
+      if(0!=soscl_bignum_memcmp(r,ref,wsize))
+	return(SOSCL_ERROR);
+      //a^-1
+      if(SOSCL_OK!=soscl_bignum_cmp_with_zero(a,wsize))
+	{
+	  ops->inv(r,a,curve_params);
+	  soscl_bignum_modinv(ref,a,curve_params->p,wsize);
+	  if(0!=soscl_bignum_memcmp(r,ref,wsize))
+	    return(SOSCL_ERROR);
+	}
+      //any number up to 2 words sizes
+      if(1==i)
+	soscl_bignum_memset(c,SOSCL_WORD_MAX_VALUE,2*wsize);
+      else
+	test_ecc_field_random(c,2*wsize,0,curve_params);
+      ops->reduce(r,c,2*wsize-(i%(wsize+1)),curve_params);
+      soscl_ecc_mod(ref,c,2*wsize-(i%(wsize+1)),curve_params->p,wsize);
+      if(0!=soscl_bignum_memcmp(r,ref,wsize))
+	return(SOSCL_ERROR);
+    }
+  //whole scalar multiplication with the table plugged into the curve
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  q1.x=q1x;
+  q1.y=q1y;
+  q2.x=q2x;
+  q2.y=q2y;
+  test_ecc_field_random(a,wsize,1,curve_params);
+  if(SOSCL_OK!=soscl_ecc_mult_coz(&q1,a,wsize,g,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecc_set_field_ops(curve_params,ops))
+    return(SOSCL_ERROR);
+  ret=soscl_ecc_mult_coz(&q2,a,wsize,g,curve_params);
+  soscl_ecc_set_field_ops(curve_params,NULL);
+  if(SOSCL_OK!=ret)
+    return(SOSCL_ERROR);
+  if(0!=soscl_bignum_memcmp(q1x,q2x,wsize) || 0!=soscl_bignum_memcmp(q1y,q2y,wsize))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+#ifdef SOSCL_TEST_SECP521R1
+extern soscl_type_ecc_field_ops soscl_ecc_field_ops_p521r1;
+//P-521 fast reduction (the table replaced by the generated one) of numbers above 2^1042,
+//which shall take the generic reduction
+static int test_ecc_reduce_p521r1_wide(void)
+{
+  word_type c[2*SOSCL_SECP521R1_WORDSIZE],r[SOSCL_SECP521R1_WORDSIZE],ref[SOSCL_SECP521R1_WORDSIZE];
+  int i,size;
+  for(i=0;i<3;i++)
+    {
+      //2^1056-1, 2^1074-1 (lo+hi would overflow the fast reduction) and 2^1088-1
+      size=2*SOSCL_SECP521R1_WORDSIZE-(0==i);
+      soscl_bignum_memset(c,SOSCL_WORD_MAX_VALUE,size);
+      if(1==i)
+	c[size-1]>>=14;
+      soscl_ecc_field_ops_p521r1.reduce(r,c,size,&soscl_secp521r1);
+      soscl_ecc_mod(ref,c,size,soscl_secp521r1.p,SOSCL_SECP521R1_WORDSIZE);
+      if(0!=soscl_bignum_memcmp(r,ref,SOSCL_SECP521R1_WORDSIZE))
+	return(SOSCL_ERROR);
+    }
+  return(SOSCL_OK);
+}
+#endif
+
+int test_ecc_field_generated(void)
+{
+  if(SOSCL_OK!=test_ecc_field_generated_curve(&soscl_ecc_field_ops_p256r1_generated,&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_field_generated_curve(&soscl_ecc_field_ops_p384r1_generated,&soscl_secp384r1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_field_generated_curve(&soscl_ecc_field_ops_p521r1_generated,&soscl_secp521r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_reduce_p521r1_wide())
+    return(SOSCL_ERROR);
+#endif
+  return(SOSCL_OK);
+}
+
+#define TEST_ECC_MULT_MULTI_COUNT 10
+//every pair against the single scalar multiplication, count is not a multiple of the lanes number
+static int test_ecc_mult_multi_curve(soscl_type_curve *curve_params)
+{
+  word_type k[TEST_ECC_MULT_MULTI_COUNT*SOSCL_ECDSA_MAX_WORDSIZE],c[SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type px[TEST_ECC_MULT_MULTI_COUNT][SOSCL_ECDSA_MAX_WORDSIZE],py[TEST_ECC_MULT_MULTI_COUNT][SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type qx[TEST_ECC_MULT_MULTI_COUNT][SOSCL_ECDSA_MAX_WORDSIZE],qy[TEST_ECC_MULT_MULTI_COUNT][SOSCL_ECDSA_MAX_WORDSIZE];
+  word_type rx[SOSCL_ECDSA_MAX_WORDSIZE],ry[SOSCL_ECDSA_MAX_WORDSIZE];
+  uint8_t d[SOSCL_ECDSA_MAX_WORDSIZE*sizeof(word_type)];
+  soscl_type_ecc_word_affine_point g,p[TEST_ECC_MULT_MULTI_COUNT],q[TEST_ECC_MULT_MULTI_COUNT],r;
+  int wsize,i;
+  wsize=curve_params->curve_wsize;
+  g.x=curve_params->xg;
+  g.y=curve_params->yg;
+  r.x=rx;
+  r.y=ry;
+  for(i=0;i<TEST_ECC_MULT_MULTI_COUNT;i++)
+    {
+      p[i].x=px[i];
+      p[i].y=py[i];
+      q[i].x=qx[i];
+      q[i].y=qy[i];
+      //P[i]=(i+2).G, k[i] random
+      soscl_bignum_set_one_word(c,(word_type)(i+2),wsize);
+      if(SOSCL_OK!=soscl_ecc_mult_coz(&p[i],c,wsize,g,curve_params))
+	return(SOSCL_ERROR);
+      soscl_rng_read(d,wsize*sizeof(word_type),SOSCL_RAND_GENERIC);
+      soscl_bignum_b2w(k+i*wsize,wsize,d,wsize*sizeof(word_type));
+    }
+  //the last scalar is small
+  soscl_bignum_set_one_word(k+(TEST_ECC_MULT_MULTI_COUNT-1)*wsize,3,wsize);
+  if(SOSCL_OK!=soscl_ecc_mult_multi(q,k,wsize,p,TEST_ECC_MULT_MULTI_COUNT,curve_params))
+    return(SOSCL_ERROR);
+  for(i=0;i<TEST_ECC_MULT_MULTI_COUNT;i++)
+    {
+      if(SOSCL_OK!=soscl_ecc_mult_coz(&r,k+i*wsize,wsize,p[i],curve_params))
+	return(SOSCL_ERROR);
+      if(0!=soscl_bignum_memcmp(qx[i],rx,wsize) || 0!=soscl_bignum_memcmp(qy[i],ry,wsize))
+	return(SOSCL_ERROR);
+    }
+  //single pair
+  if(SOSCL_OK!=soscl_ecc_mult_multi(q,k,wsize,p,1,curve_params))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecc_mult_coz(&r,k,wsize,p[0],curve_params))
+    return(SOSCL_ERROR);
+  if(0!=soscl_bignum_memcmp(qx[0],rx,wsize) || 0!=soscl_bignum_memcmp(qy[0],ry,wsize))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//with every engine available on the CPU
+int test_ecc_mult_multi(void)
+{
+  int implementations[3]={SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_C,SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX2,SOSCL_ECC_MULTIBUFFER_IMPLEMENTATION_AVX512};
+  int j,ret;
+  ret=SOSCL_OK;
+  for(j=0;j<3 && SOSCL_OK==ret;j++)
+    {
+      if(SOSCL_OK!=soscl_ecc_mult_multi_set_implementation(implementations[j]))
+	continue;
+      if(SOSCL_OK!=test_ecc_mult_multi_curve(&soscl_secp256r1))
+	ret=SOSCL_ERROR;
+      if(SOSCL_OK!=test_ecc_mult_multi_curve(&soscl_secp384r1))
+	ret=SOSCL_ERROR;
+      if(SOSCL_OK!=test_ecc_mult_multi_curve(&soscl_bp256r1))
+	ret=SOSCL_ERROR;
+#ifdef SOSCL_TEST_SECP521R1
+      if(SOSCL_OK!=test_ecc_mult_multi_curve(&soscl_secp521r1))
+	ret=SOSCL_ERROR;
+#endif
+    }
+  soscl_ecc_mult_multi_select_implementation();
+  return(ret);
+}
+
+//RFC 7748 5.2 first vector, then both Diffie-Hellman parties shall agree
+int test_x25519(void)
+{
+  uint8_t k[SOSCL_X25519_BYTESIZE]={0xa5,0x46,0xe3,0x6b,0xf0,0x52,0x7c,0x9d,0x3b,0x16,0x15,0x4b,0x82,0x46,0x5e,0xdd,0x62,0x14,0x4c,0x0a,0xc1,0xfc,0x5a,0x18,0x50,0x6a,0x22,0x44,0xba,0x44,0x9a,0xc4};
+  uint8_t u[SOSCL_X25519_BYTESIZE]={0xe6,0xdb,0x68,0x67,0x58,0x30,0x30,0xdb,0x35,0x94,0xc1,0xa4,0x24,0xb1,0x5f,0x7c,0x72,0x66,0x24,0xec,0x26,0xb3,0x35,0x3b,0x10,0xa9,0x03,0xa6,0xd0,0xab,0x1c,0x4c};
+  uint8_t o[SOSCL_X25519_BYTESIZE]={0xc3,0xda,0x55,0x37,0x9d,0xe9,0xc6,0x90,0x8e,0x94,0xea,0x4d,0xf2,0x8d,0x08,0x4f,0x32,0xec,0xcf,0x03,0x49,0x1c,0x71,0xf7,0x54,0xb4,0x07,0x55,0x77,0xa2,0x85,0x52};
+  uint8_t base[SOSCL_X25519_BYTESIZE]={9};
+  uint8_t a[SOSCL_X25519_BYTESIZE],b[SOSCL_X25519_BYTESIZE];
+  uint8_t pa[SOSCL_X25519_BYTESIZE],pb[SOSCL_X25519_BYTESIZE];
+  uint8_t sa[SOSCL_X25519_BYTESIZE],sb[SOSCL_X25519_BYTESIZE];
+  uint8_t r[SOSCL_X25519_BYTESIZE];
+  int i;
+  if(SOSCL_OK!=soscl_x25519(r,k,u))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(r,o,SOSCL_X25519_BYTESIZE))
+    return(SOSCL_ERROR);
+  for(i=0;i<4;i++)
+    {
+      soscl_rng_read(a,SOSCL_X25519_BYTESIZE,SOSCL_RAND_GENERIC);
+      soscl_rng_read(b,SOSCL_X25519_BYTESIZE,SOSCL_RAND_GENERIC);
+      //the fixed-base public key shall match the ladder on u=9
+      if(SOSCL_OK!=soscl_x25519_public_key(pa,a) || SOSCL_OK!=soscl_x25519(r,a,base))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(r,pa,SOSCL_X25519_BYTESIZE))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_x25519_public_key(pb,b))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_x25519(sa,a,pb) || SOSCL_OK!=soscl_x25519(sb,b,pa))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(sa,sb,SOSCL_X25519_BYTESIZE))
+	return(SOSCL_ERROR);
+    }
+  //u=0 is a low order point
+  soscl_memset(u,0,SOSCL_X25519_BYTESIZE);
+  if(SOSCL_ERROR!=soscl_x25519(r,k,u))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//RFC 8032 7.1 TEST 1, then sign/verify round trips with tampered inputs
+int test_ed25519(void)
+{
+  uint8_t sk[SOSCL_ED25519_SECRET_KEY_BYTESIZE]={0x9d,0x61,0xb1,0x9d,0xef,0xfd,0x5a,0x60,0xba,0x84,0x4a,0xf4,0x92,0xec,0x2c,0xc4,0x44,0x49,0xc5,0x69,0x7b,0x32,0x69,0x19,0x70,0x3b,0xac,0x03,0x1c,0xae,0x7f,0x60};
+  uint8_t pk[SOSCL_ED25519_PUBLIC_KEY_BYTESIZE]={0xd7,0x5a,0x98,0x01,0x82,0xb1,0x0a,0xb7,0xd5,0x4b,0xfe,0xd3,0xc9,0x64,0x07,0x3a,0x0e,0xe1,0x72,0xf3,0xda,0xa6,0x23,0x25,0xaf,0x02,0x1a,0x68,0xf7,0x07,0x51,0x1a};
+  uint8_t sig[SOSCL_ED25519_SIGNATURE_BYTESIZE]={0xe5,0x56,0x43,0x00,0xc3,0x60,0xac,0x72,0x90,0x86,0xe2,0xcc,0x80,0x6e,0x82,0x8a,0x84,0x87,0x7f,0x1e,0xb8,0xe5,0xd9,0x74,0xd8,0x73,0xe0,0x65,0x22,0x49,0x01,0x55,0x5f,0xb8,0x82,0x15,0x90,0xa3,0x3b,0xac,0xc6,0x1e,0x39,0x70,0x1c,0xf9,0xb4,0x6b,0xd2,0x5b,0xf5,0xf0,0x59,0x5b,0xbe,0x24,0x65,0x51,0x41,0x43,0x8e,0x7a,0x10,0x0b};
+  uint8_t p[SOSCL_ED25519_PUBLIC_KEY_BYTESIZE];
+  uint8_t s[SOSCL_ED25519_SIGNATURE_BYTESIZE];
+  uint8_t msg[100];
+  int i;
+  if(SOSCL_OK!=soscl_ed25519_public_key(p,sk))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(p,pk,SOSCL_ED25519_PUBLIC_KEY_BYTESIZE))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ed25519_sign(s,NULL,0,sk,NULL))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(s,sig,SOSCL_ED25519_SIGNATURE_BYTESIZE))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ed25519_verify(sig,NULL,0,pk))
+    return(SOSCL_ERROR);
+  for(i=0;i<4;i++)
+    {
+      soscl_rng_read(sk,SOSCL_ED25519_SECRET_KEY_BYTESIZE,SOSCL_RAND_GENERIC);
+      soscl_rng_read(msg,sizeof(msg),SOSCL_RAND_GENERIC);
+      if(SOSCL_OK!=soscl_ed25519_public_key(p,sk))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ed25519_sign(s,msg,sizeof(msg),sk,p))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ed25519_verify(s,msg,sizeof(msg),p))
+	return(SOSCL_ERROR);
+      msg[i]^=1;
+      if(SOSCL_OK==soscl_ed25519_verify(s,msg,sizeof(msg),p))
+	return(SOSCL_ERROR);
+      msg[i]^=1;
+      s[i]^=1;
+      if(SOSCL_OK==soscl_ed25519_verify(s,msg,sizeof(msg),p))
+	return(SOSCL_ERROR);
+    }
+  //S+L shall be rejected
+  soscl_memcpy(s,sig,SOSCL_ED25519_SIGNATURE_BYTESIZE);
+  s[SOSCL_ED25519_SIGNATURE_BYTESIZE-1]|=0xf0;
+  if(SOSCL_OK==soscl_ed25519_verify(s,NULL,0,pk))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//RFC 9380 K.1 (expand_message_xmd) and J.1 (hash_to_curve) vectors, empty message
+int test_ecc_hash_to_curve_curve(char *dst,uint8_t *x,uint8_t *y,soscl_type_curve *curve_params)
+{
+  uint8_t qx[SOSCL_SECP521R1_BYTESIZE],qy[SOSCL_SECP521R1_BYTESIZE];
+  soscl_type_ecc_uint8_t_affine_point q;
+  q.x=qx;
+  q.y=qy;
+  if(SOSCL_OK!=soscl_ecc_hash_to_curve(q,NULL,0,(uint8_t*)dst,strlen(dst),curve_params))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(qx,x,curve_params->curve_bsize) || 0!=memcmp(qy,y,curve_params->curve_bsize))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecc_hash_to_curve(void)
+{
+  char dst_xmd[]="QUUX-V01-CS02-with-expander-SHA256-128";
+  uint8_t uniform_xmd[SOSCL_SHA256_BYTE_HASHSIZE]={0x68,0xa9,0x85,0xb8,0x7e,0xb6,0xb4,0x69,0x52,0x12,0x89,0x11,0xf2,0xa4,0x41,0x2b,0xbc,0x30,0x2a,0x9d,0x75,0x96,0x67,0xf8,0x7f,0x7a,0x21,0xd8,0x03,0xf0,0x72,0x35};
+  uint8_t p256_x[SOSCL_SECP256R1_BYTESIZE]={0x2c,0x15,0x23,0x0b,0x26,0xdb,0xc6,0xfc,0x9a,0x37,0x05,0x11,0x58,0xc9,0x5b,0x79,0x65,0x6e,0x17,0xa1,0xa9,0x20,0xb1,0x13,0x94,0xca,0x91,0xc4,0x42,0x47,0xd3,0xe4};
+  uint8_t p256_y[SOSCL_SECP256R1_BYTESIZE]={0x8a,0x7a,0x74,0x98,0x5c,0xc5,0xc7,0x76,0xcd,0xfe,0x4b,0x1f,0x19,0x88,0x49,0x70,0x45,0x39,0x12,0xe9,0xd3,0x15,0x28,0xc0,0x60,0xbe,0x9a,0xb5,0xc4,0x3e,0x84,0x15};
+  uint8_t p384_x[SOSCL_SECP384R1_BYTESIZE]={0xeb,0x9f,0xe1,0xb4,0xf4,0xe1,0x4e,0x71,0x40,0x80,0x3c,0x1d,0x99,0xd0,0xa9,0x3c,0xd8,0x23,0xd2,0xb0,0x24,0x04,0x0f,0x9c,0x06,0x7a,0x8e,0xca,0x1f,0x5a,0x2e,0xea,0xc9,0xad,0x60,0x49,0x73,0x52,0x7a,0x35,0x6f,0x3f,0xa3,0xae,0xff,0x0e,0x4d,0x83};
+  uint8_t p384_y[SOSCL_SECP384R1_BYTESIZE]={0x0c,0x21,0x70,0x8c,0xff,0x38,0x2b,0x7f,0x46,0x43,0xc0,0x7b,0x10,0x5c,0x2e,0xae,0xc2,0xce,0xad,0x93,0xa9,0x17,0xd8,0x25,0x60,0x1e,0x63,0xc8,0xf2,0x1f,0x6a,0xbd,0x9a,0xbc,0x22,0xc9,0x3c,0x2b,0xed,0x6f,0x23,0x59,0x54,0xb2,0x50,0x48,0xbb,0x1a};
+#ifdef SOSCL_TEST_SECP521R1
+  uint8_t p521_x[SOSCL_SECP521R1_BYTESIZE]={0x00,0xfd,0x76,0x7c,0xeb,0xb2,0x45,0x20,0x30,0x35,0x8d,0x0e,0x9c,0xf9,0x07,0xf5,0x25,0xf5,0x09,0x20,0xc8,0xf6,0x07,0x88,0x9a,0x6a,0x35,0x68,0x07,0x27,0xf6,0x4f,0x4d,0x66,0xb1,0x61,0xfa,0xfe,0xb2,0x65,0x4b,0xea,0x0d,0x35,0x08,0x6b,0xec,0x0a,0x10,0xb3,0x0b,0x14,0xad,0xef,0x35,0x56,0xed,0x9f,0x7f,0x1b,0xc2,0x3c,0xec,0xc9,0xc0,0x88};
+  uint8_t p521_y[SOSCL_SECP521R1_BYTESIZE]={0x01,0x69,0xba,0x78,0xd8,0xd8,0x51,0xe9,0x30,0x68,0x03,0x22,0x59,0x6e,0x39,0xc7,0x8f,0x4f,0xe3,0x1b,0x97,0xe5,0x76,0x29,0xef,0x64,0x60,0xdd,0xd6,0x8f,0x87,0x63,0xfd,0x7b,0xd7,0x67,0xa4,0xe9,0x4a,0x80,0xd3,0xd2,0x1a,0x3c,0x2e,0xe9,0x83,0x47,0xe0,0x24,0xfc,0x73,0xee,0x1c,0x27,0x16,0x6d,0xc3,0xfe,0x5e,0xee,0xf7,0x82,0xbe,0x41,0x1d};
+#endif
+  uint8_t uniform[SOSCL_SHA256_BYTE_HASHSIZE];
+  if(SOSCL_OK!=soscl_ecc_expand_message_xmd(uniform,sizeof(uniform),NULL,0,(uint8_t*)dst_xmd,strlen(dst_xmd),SOSCL_SHA256_ID))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(uniform,uniform_xmd,sizeof(uniform)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_hash_to_curve_curve("QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_",p256_x,p256_y,&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecc_hash_to_curve_curve("QUUX-V01-CS02-with-P384_XMD:SHA-384_SSWU_RO_",p384_x,p384_y,&soscl_secp384r1))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecc_hash_to_curve_curve("QUUX-V01-CS02-with-P521_XMD:SHA-512_SSWU_RO_",p521_x,p521_y,&soscl_secp521r1))
+    return(SOSCL_ERROR);
+#endif
+  //no suite for the brainpool curves
+  if(SOSCL_OK==test_ecc_hash_to_curve_curve("QUUX",p256_x,p256_y,&soscl_bp256r1))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//KAT: P-256, SHA-256, computed with an independent implementation of SEC1 ECIES (X9.63 KDF, XOR scheme, HMAC)
+//the recipient key is the RFC 6979 A.2.5 one, the plaintext is 00..27, SharedInfo1="shared1", SharedInfo2="shared2"
+static int test_ecies_kat(void)
+{
+  uint8_t d[SOSCL_SECP256R1_BYTESIZE]={0xc9,0xaf,0xa9,0xd8,0x45,0xba,0x75,0x16,0x6b,0x5c,0x21,0x57,0x67,0xb1,0xd6,0x93,0x4e,0x50,0xc3,0xdb,0x36,0xe8,0x9b,0x12,0x7b,0x8a,0x62,0x2b,0x12,0x0f,0x67,0x21};
+  uint8_t ephemeral[SOSCL_SECP256R1_BYTESIZE+1]={0x02,0xd8,0xcd,0x12,0xea,0x5c,0x67,0xf2,0xf8,0xa0,0x0c,0x11,0x24,0x89,0x3e,0xdc,0xfa,0x67,0x54,0xc4,0xd6,0xce,0xde,0x6b,0xe1,0x3b,0xdf,0x22,0x95,0xc8,0x10,0xa9,0x7f};
+  uint8_t c[40]={0x9e,0xcf,0x4c,0x69,0xec,0xce,0xfd,0xe5,0xbc,0x58,0x6b,0x22,0x29,0x4f,0x68,0xd5,0x03,0x01,0x18,0x54,0xe1,0x42,0x03,0x60,0x2e,0xbc,0x64,0xe3,0x38,0x95,0x47,0x02,0xc5,0xe5,0xa8,0x1a,0xad,0x5a,0x59,0x4b};
+  uint8_t tag[SOSCL_SHA256_BYTE_HASHSIZE]={0xd1,0xcb,0x37,0x86,0xe9,0x3b,0x89,0x16,0x6f,0x7b,0x5d,0x5f,0x31,0x62,0xcc,0x0f,0x69,0x18,0xb9,0x35,0x17,0x69,0x2f,0xae,0xb3,0x43,0xe7,0x32,0xe6,0x26,0xea,0xa3};
+  uint8_t shared1[7]={'s','h','a','r','e','d','1'};
+  uint8_t shared2[7]={'s','h','a','r','e','d','2'};
+  soscl_type_ecies ctx;
+  int i;
+  if(SOSCL_OK!=soscl_ecies_decrypt_init(&ctx,ephemeral,sizeof(ephemeral),d,sizeof(c),shared1,sizeof(shared1),&soscl_secp256r1,SOSCL_SHA256_ID))
+    return(SOSCL_ERROR);
+  //in place, in 7-byte chunks
+  for(i=0;i<(int)sizeof(c);i+=7)
+    if(SOSCL_OK!=soscl_ecies_decrypt_update(&ctx,c+i,c+i,((int)sizeof(c)-i<7)?(int)sizeof(c)-i:7))
+      return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_decrypt_final(&ctx,tag,shared2,sizeof(shared2)))
+    return(SOSCL_ERROR);
+  for(i=0;i<(int)sizeof(c);i++)
+    if(i!=c[i])
+      return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//round trip, in place, then the tag shall not match a modified ciphertext or SharedInfo2
+static int test_ecies_curve(soscl_type_curve *curve_params,int algo)
+{
+  uint8_t xq[SOSCL_SECP521R1_BYTESIZE],yq[SOSCL_SECP521R1_BYTESIZE],d[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t ephemeral[SOSCL_ECIES_EPHEMERAL_MAX_BYTESIZE];
+  uint8_t m[150],c[150];
+  uint8_t tag[SOSCL_SHA512_BYTE_HASHSIZE];
+  uint8_t shared2[2]={0x01,0x02};
+  soscl_type_ecc_uint8_t_affine_point q;
+  soscl_type_ecies ctx;
+  int i,len;
+  q.x=xq;
+  q.y=yq;
+  if(SOSCL_OK!=soscl_ecc_keygeneration(q,d,curve_params))
+    return(SOSCL_ERROR);
+  for(i=0;i<(int)sizeof(m);i++)
+    m[i]=(uint8_t)(3*i);
+  memcpy(c,m,sizeof(m));
+  if(SOSCL_OK!=soscl_ecies_encrypt_init(&ctx,ephemeral,q,sizeof(c),NULL,0,curve_params,algo))
+    return(SOSCL_ERROR);
+  for(i=0;i<(int)sizeof(c);i+=len)
+    {
+      len=((int)sizeof(c)-i<33)?(int)sizeof(c)-i:33;
+      if(SOSCL_OK!=soscl_ecies_encrypt_update(&ctx,c+i,c+i,len))
+	return(SOSCL_ERROR);
+    }
+  if(SOSCL_OK!=soscl_ecies_encrypt_final(&ctx,tag,shared2,sizeof(shared2)))
+    return(SOSCL_ERROR);
+  if(0==memcmp(c,m,sizeof(m)))
+    return(SOSCL_ERROR);
+  if(!SOSCL_ECIES_EPHEMERAL_COMPRESSED(curve_params) && SOSCL_ECC_POINT_UNCOMPRESSED!=ephemeral[0])
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_decrypt_init(&ctx,ephemeral,SOSCL_ECIES_EPHEMERAL_BYTESIZE(curve_params),d,sizeof(c),NULL,0,curve_params,algo))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_decrypt_update(&ctx,c,c,sizeof(c)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_decrypt_final(&ctx,tag,shared2,sizeof(shared2)))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(c,m,sizeof(m)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_decrypt_init(&ctx,ephemeral,SOSCL_ECIES_EPHEMERAL_BYTESIZE(curve_params),d,sizeof(c),NULL,0,curve_params,algo))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_decrypt_update(&ctx,c,m,sizeof(m)))
+    return(SOSCL_ERROR);
+  if(SOSCL_ERROR!=soscl_ecies_decrypt_final(&ctx,tag,shared2,sizeof(shared2)))
+    return(SOSCL_ERROR);
+  //the final call needs the whole message
+  if(SOSCL_OK!=soscl_ecies_encrypt_init(&ctx,ephemeral,q,sizeof(c),NULL,0,curve_params,algo))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecies_encrypt_update(&ctx,c,m,10))
+    return(SOSCL_ERROR);
+  if(SOSCL_INVALID_LENGTH!=soscl_ecies_encrypt_final(&ctx,tag,NULL,0))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+int test_ecies(void)
+{
+  if(SOSCL_OK!=test_ecies_kat())
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecies_curve(&soscl_secp256r1,SOSCL_SHA256_ID))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecies_curve(&soscl_secp384r1,SOSCL_SHA512_ID))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  if(SOSCL_OK!=test_ecies_curve(&soscl_secp521r1,SOSCL_SHA512_ID))
+    return(SOSCL_ERROR);
+#endif
+  if(SOSCL_OK!=test_ecies_curve(&soscl_bp256r1,SOSCL_SHA256_ID))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP224R1
+  //p=1 mod 4: R cannot be decompressed, so it is sent uncompressed
+  if(2*SOSCL_SECP224R1_BYTESIZE+1!=SOSCL_ECIES_EPHEMERAL_BYTESIZE(&soscl_secp224r1))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=test_ecies_curve(&soscl_secp224r1,SOSCL_SHA256_ID))
+    return(SOSCL_ERROR);
+#endif
+  return(SOSCL_OK);
+}
+
+//BIP32 test vector 1: m, m/0H and m/0H/1, then the batch derivation matches the single one
+//the m/0H children 0, 1, 5 and 2H were computed with an independent implementation
+int test_bip32(void)
+{
+  uint8_t seed[16]={0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f};
+  uint8_t m_d[SOSCL_BIP32_KEY_BYTESIZE]={0xe8,0xf3,0x2e,0x72,0x3d,0xec,0xf4,0x05,0x1a,0xef,0xac,0x8e,0x2c,0x93,0xc9,0xc5,0xb2,0x14,0x31,0x38,0x17,0xcd,0xb0,0x1a,0x14,0x94,0xb9,0x17,0xc8,0x43,0x6b,0x35};
+  uint8_t m_c[SOSCL_BIP32_CHAIN_CODE_BYTESIZE]={0x87,0x3d,0xff,0x81,0xc0,0x2f,0x52,0x56,0x23,0xfd,0x1f,0xe5,0x16,0x7e,0xac,0x3a,0x55,0xa0,0x49,0xde,0x3d,0x31,0x4b,0xb4,0x2e,0xe2,0x27,0xff,0xed,0x37,0xd5,0x08};
+  uint8_t m0h_d[SOSCL_BIP32_KEY_BYTESIZE]={0xed,0xb2,0xe1,0x4f,0x9e,0xe7,0x7d,0x26,0xdd,0x93,0xb4,0xec,0xed,0xe8,0xd1,0x6e,0xd4,0x08,0xce,0x14,0x9b,0x6c,0xd8,0x0b,0x07,0x15,0xa2,0xd9,0x11,0xa0,0xaf,0xea};
+  uint8_t m0h_c[SOSCL_BIP32_CHAIN_CODE_BYTESIZE]={0x47,0xfd,0xac,0xbd,0x0f,0x10,0x97,0x04,0x3b,0x78,0xc6,0x3c,0x20,0xc3,0x4e,0xf4,0xed,0x9a,0x11,0x1d,0x98,0x00,0x47,0xad,0x16,0x28,0x2c,0x7a,0xe6,0x23,0x61,0x41};
+  uint8_t m0h1_d[SOSCL_BIP32_KEY_BYTESIZE]={0x3c,0x6c,0xb8,0xd0,0xf6,0xa2,0x64,0xc9,0x1e,0xa8,0xb5,0x03,0x0f,0xad,0xaa,0x8e,0x53,0x8b,0x02,0x0f,0x0a,0x38,0x74,0x21,0xa1,0x2d,0xe9,0x31,0x9d,0xc9,0x33,0x68};
+  uint8_t m0h1_c[SOSCL_BIP32_CHAIN_CODE_BYTESIZE]={0x2a,0x78,0x57,0x63,0x13,0x86,0xba,0x23,0xda,0xca,0xc3,0x41,0x80,0xdd,0x19,0x83,0x73,0x4e,0x44,0x4f,0xdb,0xf7,0x74,0x04,0x15,0x78,0xe9,0xb6,0xad,0xb3,0x7c,0x19};
+  uint8_t m0h1_k[1+SOSCL_BIP32_KEY_BYTESIZE]={0x03,0x50,0x1e,0x45,0x4b,0xf0,0x07,0x51,0xf2,0x4b,0x1b,0x48,0x9a,0xa9,0x25,0x21,0x5d,0x66,0xaf,0x22,0x34,0xe3,0x89,0x1c,0x3b,0x21,0xa5,0x2b,0xed,0xb3,0xcd,0x71,0x1c};
+  uint8_t m0h2h_d[SOSCL_BIP32_KEY_BYTESIZE]={0x31,0x04,0x1f,0x44,0x2a,0xb2,0x34,0x4d,0x57,0x82,0x36,0x33,0x47,0xa9,0x40,0x0f,0x35,0x0f,0x84,0x2c,0x38,0x92,0x38,0x2b,0xb0,0x24,0xf6,0xe6,0x2f,0x4c,0x13,0x7d};
+  uint32_t indexes[4]={0,1,5,SOSCL_BIP32_HARDENED+2};
+  soscl_type_bip32_key m,m0h,child,pub,children[4];
+  int i;
+  if(SOSCL_OK!=soscl_bip32_master_key(&m,seed,sizeof(seed)))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(m.d,m_d,sizeof(m_d)) || 0!=memcmp(m.chain_code,m_c,sizeof(m_c)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_bip32_derive(&m0h,&m,SOSCL_BIP32_HARDENED))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(m0h.d,m0h_d,sizeof(m0h_d)) || 0!=memcmp(m0h.chain_code,m0h_c,sizeof(m0h_c)) || 1!=m0h.depth)
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_bip32_derive(&child,&m0h,1))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(child.d,m0h1_d,sizeof(m0h1_d)) || 0!=memcmp(child.chain_code,m0h1_c,sizeof(m0h1_c)))
+    return(SOSCL_ERROR);
+  if(m0h1_k[0]!=(0x02|(child.y[SOSCL_BIP32_KEY_BYTESIZE-1]&1)) || 0!=memcmp(child.x,m0h1_k+1,SOSCL_BIP32_KEY_BYTESIZE))
+    return(SOSCL_ERROR);
+  //CKDpub gives the same public key and chain code
+  if(SOSCL_OK!=soscl_bip32_neuter(&pub,&m0h))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_bip32_derive(&pub,&pub,1))
+    return(SOSCL_ERROR);
+  if(SOSCL_FALSE!=pub.has_private || 0!=memcmp(pub.x,child.x,SOSCL_BIP32_KEY_BYTESIZE) || 0!=memcmp(pub.y,child.y,SOSCL_BIP32_KEY_BYTESIZE) || 0!=memcmp(pub.chain_code,m0h1_c,sizeof(m0h1_c)))
+    return(SOSCL_ERROR);
+  //batch, private parent
+  if(SOSCL_OK!=soscl_bip32_derive_batch(children,&m0h,indexes,4))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(children[3].d,m0h2h_d,sizeof(m0h2h_d)))
+    return(SOSCL_ERROR);
+  for(i=0;i<4;i++)
+    {
+      if(SOSCL_OK!=soscl_bip32_derive(&child,&m0h,indexes[i]))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(&child,&children[i],sizeof(child)))
+	return(SOSCL_ERROR);
+    }
+  //batch, public parent: same public keys
+  if(SOSCL_OK!=soscl_bip32_neuter(&pub,&m0h))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_bip32_derive_batch(children,&pub,indexes,3))
+    return(SOSCL_ERROR);
+  for(i=0;i<3;i++)
+    {
+      if(SOSCL_OK!=soscl_bip32_derive(&child,&m0h,indexes[i]))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(child.x,children[i].x,SOSCL_BIP32_KEY_BYTESIZE) || 0!=memcmp(child.y,children[i].y,SOSCL_BIP32_KEY_BYTESIZE) || 0!=memcmp(child.chain_code,children[i].chain_code,SOSCL_BIP32_CHAIN_CODE_BYTESIZE))
+	return(SOSCL_ERROR);
+    }
+  //no hardened derivation from a public key
+  if(SOSCL_INVALID_INPUT!=soscl_bip32_derive_batch(children,&pub,indexes,4))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
 #endif//SOSCL_TEST_ECC
@@ -24,17 +24,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <soscl/soscl_string.h>
 #include <soscl/soscl_ecc.h>
 #include <soscl/soscl_ecdsa.h>
+#include <soscl/soscl_ecdsa_keystore.h>
+#include <soscl/soscl_ecdsa_cache.h>
 #include <soscl/soscl_ecc_keygeneration.h>
 #include <soscl/soscl_hash_sha256.h>
 #include <soscl/soscl_hash_sha384.h>
 #include <soscl/soscl_hash_sha512.h>
 #include <soscl/soscl_rng.h>
 #include <soscl_commontest.h>
+extern soscl_type_curve soscl_secp224r1;
 extern soscl_type_curve soscl_secp256r1;
+extern soscl_type_curve soscl_secp256k1;
 extern soscl_type_curve soscl_secp384r1;
 #ifdef SOSCL_TEST_SECP521R1
 extern soscl_type_curve soscl_secp521r1;
 #endif
+extern soscl_type_curve soscl_bp256r1;
+extern soscl_type_curve soscl_bp384r1;
+extern soscl_type_curve soscl_bp512r1;
 
 //#define VERBOSE
 
@@ -43,7 +50,7 @@ int ecdsa_signature_verification_vector_process(char *line)
   //file format is [curve][hash function][public key-x, prepended by 0x][public key-y, prepended by a 0x][r in hexa, prepended by 0x][s in hexa, prepended by 0x][result, P or F]
   
   int i,k;
-  char curve_string[3][20];
+  char curve_string[4][20];
   char hash_string[3][20];
   int curve_nb;
   int hash_nb;
@@ -64,7 +71,8 @@ int ecdsa_signature_verification_vector_process(char *line)
   //configure the supported algos
   sprintf(curve_string[0],"P256");
   sprintf(curve_string[1],"P384");
-  curve_nb=3;
+  sprintf(curve_string[3],"P224");
+  curve_nb=4;
   sprintf(hash_string[0],"SHA256");
   sprintf(hash_string[1],"SHA384");
   sprintf(hash_string[2],"SHA512");
@@ -212,6 +220,10 @@ int ecdsa_signature_verification_vector_process(char *line)
 #ifdef SOSCL_TEST_SECP521R1
   if(curve_id==2)
     curve_params=&soscl_secp521r1;
+#endif
+#ifdef SOSCL_TEST_SECP224R1
+  if(curve_id==3)
+    curve_params=&soscl_secp224r1;
 #endif
   if(curve_id==1 && hash_id==0)
     return(SOSCL_INVALID_INPUT);
@@ -517,4 +529,644 @@ int test_ecdsa_rfc(int loopmax)
     }
   return(SOSCL_OK);
 }
+#define SOSCL_TEST_BATCH_MAX 4
+//batch verification: valid signatures from random keys, then one corrupted message
+int test_ecdsa_batch_verification(int count)
+{
+  uint8_t d[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t xq[SOSCL_TEST_BATCH_MAX][SOSCL_SECP521R1_BYTESIZE];
+  uint8_t yq[SOSCL_TEST_BATCH_MAX][SOSCL_SECP521R1_BYTESIZE];
+  uint8_t r[SOSCL_TEST_BATCH_MAX][SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s[SOSCL_TEST_BATCH_MAX][SOSCL_SECP521R1_BYTESIZE];
+  uint8_t msg[SOSCL_TEST_BATCH_MAX][3];
+  soscl_type_ecdsa_verify_item items[SOSCL_TEST_BATCH_MAX];
+  int results[SOSCL_TEST_BATCH_MAX];
+  soscl_type_curve *curves[8];
+  int hashes[8];
+  int (*hash_functions[8])(uint8_t*,uint8_t*,int);
+  int i,icurve,res,configuration;
+  if(count>SOSCL_TEST_BATCH_MAX || count<2)
+    return(SOSCL_INVALID_INPUT);
+  curves[0]=&soscl_secp256r1;
+  hashes[0]=SOSCL_SHA256_ID;
+  hash_functions[0]=&soscl_sha256;
+  curves[1]=&soscl_secp384r1;
+  hashes[1]=SOSCL_SHA384_ID;
+  hash_functions[1]=&soscl_sha384;
+#ifdef SOSCL_TEST_SECP521R1
+  curves[2]=&soscl_secp521r1;
+  hashes[2]=SOSCL_SHA512_ID;
+  hash_functions[2]=&soscl_sha512;
+#else
+  curves[2]=NULL;
+#endif
+  curves[3]=&soscl_bp256r1;
+  hashes[3]=SOSCL_SHA256_ID;
+  hash_functions[3]=&soscl_sha256;
+  curves[4]=&soscl_bp384r1;
+  hashes[4]=SOSCL_SHA384_ID;
+  hash_functions[4]=&soscl_sha384;
+  curves[5]=&soscl_bp512r1;
+  hashes[5]=SOSCL_SHA512_ID;
+  hash_functions[5]=&soscl_sha512;
+#ifdef SOSCL_TEST_SECP224R1
+  curves[6]=&soscl_secp224r1;
+  hashes[6]=SOSCL_SHA256_ID;
+  hash_functions[6]=&soscl_sha256;
+#else
+  curves[6]=NULL;
+#endif
+  curves[7]=&soscl_secp256k1;
+  hashes[7]=SOSCL_SHA256_ID;
+  hash_functions[7]=&soscl_sha256;
+  for(icurve=0;icurve<8;icurve++)
+    {
+      if(NULL==curves[icurve])
+	continue;
+      configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(hashes[icurve]<<SOSCL_HASH_SHIFT);
+      for(i=0;i<count;i++)
+	{
+	  msg[i][0]='a';
+	  msg[i][1]='b';
+	  msg[i][2]=(uint8_t)('c'+i);
+	  items[i].q.x=xq[i];
+	  items[i].q.y=yq[i];
+	  items[i].signature.r=r[i];
+	  items[i].signature.s=s[i];
+	  items[i].input=msg[i];
+	  items[i].inputlength=3;
+	  if(SOSCL_OK!=soscl_ecc_keygeneration(items[i].q,d,curves[icurve]))
+	    return(SOSCL_ERROR);
+	  if(SOSCL_OK!=soscl_ecdsa_signature(items[i].signature,d,hash_functions[icurve],msg[i],3,curves[icurve],configuration))
+	    return(SOSCL_ERROR);
+	}
+      res=soscl_ecdsa_verify_batch(items,count,results,hash_functions[icurve],curves[icurve],configuration);
+      if(SOSCL_OK!=res)
+	{
+#ifdef VERBOSE
+	  printf("batch verification NOK %d\n",res);
+#endif
+	  return(SOSCL_ERROR);
+	}
+      for(i=0;i<count;i++)
+	if(SOSCL_OK!=results[i])
+	  return(SOSCL_ERROR);
+      //a wrong message shall be identified, without impacting the other items
+      msg[1][0]^=1;
+      res=soscl_ecdsa_verify_batch(items,count,results,hash_functions[icurve],curves[icurve],configuration);
+      if(SOSCL_ERROR!=res)
+	return(SOSCL_ERROR);
+      for(i=0;i<count;i++)
+	if((1==i && SOSCL_ERROR!=results[i]) || (1!=i && SOSCL_OK!=results[i]))
+	  return(SOSCL_ERROR);
+      //the batch result shall match the single verification one
+      for(i=0;i<count;i++)
+	if(results[i]!=soscl_ecdsa_verification(items[i].q,items[i].signature,hash_functions[icurve],items[i].input,items[i].inputlength,curves[icurve],configuration))
+	  return(SOSCL_ERROR);
+    }
+  return(SOSCL_OK);
+}
+//batch signing: random nonces are checked with the single verification, deterministic ones against the single signature
+int test_ecdsa_sign_batch(int count)
+{
+  uint8_t d[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t xq[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t yq[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t r[SOSCL_TEST_BATCH_MAX][SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s[SOSCL_TEST_BATCH_MAX][SOSCL_SECP521R1_BYTESIZE];
+  uint8_t r1[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s1[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t msg[SOSCL_TEST_BATCH_MAX][3];
+  soscl_type_ecdsa_sign_item items[SOSCL_TEST_BATCH_MAX];
+  soscl_type_ecc_uint8_t_affine_point q;
+  soscl_type_ecdsa_signature signature;
+  soscl_type_curve *curves[4];
+  int hashes[4];
+  int (*hash_functions[4])(uint8_t*,uint8_t*,int);
+  int i,icurve,configuration,bsize;
+  if(count>SOSCL_TEST_BATCH_MAX || count<1)
+    return(SOSCL_INVALID_INPUT);
+  curves[0]=&soscl_secp256r1;
+  hashes[0]=SOSCL_SHA256_ID;
+  hash_functions[0]=&soscl_sha256;
+  curves[1]=&soscl_secp384r1;
+  hashes[1]=SOSCL_SHA384_ID;
+  hash_functions[1]=&soscl_sha384;
+#ifdef SOSCL_TEST_SECP521R1
+  curves[2]=&soscl_secp521r1;
+  hashes[2]=SOSCL_SHA512_ID;
+  hash_functions[2]=&soscl_sha512;
+#else
+  curves[2]=NULL;
+#endif
+  curves[3]=&soscl_bp256r1;
+  hashes[3]=SOSCL_SHA256_ID;
+  hash_functions[3]=&soscl_sha256;
+  q.x=xq;
+  q.y=yq;
+  signature.r=r1;
+  signature.s=s1;
+  for(icurve=0;icurve<4;icurve++)
+    {
+      if(NULL==curves[icurve])
+	continue;
+      bsize=curves[icurve]->curve_bsize;
+      if(SOSCL_OK!=soscl_ecc_keygeneration(q,d,curves[icurve]))
+	return(SOSCL_ERROR);
+      for(i=0;i<count;i++)
+	{
+	  msg[i][0]='a';
+	  msg[i][1]='b';
+	  msg[i][2]=(uint8_t)('c'+i);
+	  items[i].input=msg[i];
+	  items[i].inputlength=3;
+	  items[i].signature.r=r[i];
+	  items[i].signature.s=s[i];
+	}
+      configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(hashes[icurve]<<SOSCL_HASH_SHIFT);
+      if(SOSCL_OK!=soscl_ecdsa_sign_batch(items,count,d,hash_functions[icurve],curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      for(i=0;i<count;i++)
+	if(SOSCL_OK!=soscl_ecdsa_verification(q,items[i].signature,hash_functions[icurve],msg[i],3,curves[icurve],configuration))
+	  return(SOSCL_ERROR);
+      configuration^=(SOSCL_DETERMINISTIC_NONCE<<SOSCL_NONCE_SHIFT);
+      if(SOSCL_OK!=soscl_ecdsa_sign_batch(items,count,d,hash_functions[icurve],curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      for(i=0;i<count;i++)
+	{
+	  if(SOSCL_OK!=soscl_ecdsa_signature(signature,d,hash_functions[icurve],msg[i],3,curves[icurve],configuration))
+	    return(SOSCL_ERROR);
+	  if(0!=memcmp(r1,r[i],bsize) || 0!=memcmp(s1,s[i],bsize))
+	    return(SOSCL_ERROR);
+	}
+    }
+  //a missing input is rejected before any computation
+  items[0].input=NULL;
+  configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(SOSCL_SHA256_ID<<SOSCL_HASH_SHIFT);
+  if(SOSCL_INVALID_INPUT!=soscl_ecdsa_sign_batch(items,count,d,&soscl_sha256,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+#define SOSCL_TEST_POOL_CAPACITY 4
+//offline/online signing: refill, then each signature consumes and wipes one entry
+int test_ecdsa_nonce_pool(int count)
+{
+  uint8_t d[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t xq[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t yq[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t r[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t msg[3];
+  word_type storage[SOSCL_TEST_POOL_CAPACITY*2*SOSCL_SECP521R1_WORDSIZE];
+  soscl_type_ecdsa_nonce_pool pool;
+  soscl_type_ecdsa_nonce_pool_stats stats;
+  soscl_type_ecc_uint8_t_affine_point q;
+  soscl_type_ecdsa_signature signature;
+  soscl_type_curve *curves[2];
+  int hashes[2];
+  int (*hash_functions[2])(uint8_t*,uint8_t*,int);
+  int i,j,icurve,configuration,wsize;
+  curves[0]=&soscl_secp256r1;
+  hashes[0]=SOSCL_SHA256_ID;
+  hash_functions[0]=&soscl_sha256;
+#ifdef SOSCL_TEST_SECP521R1
+  curves[1]=&soscl_secp521r1;
+  hashes[1]=SOSCL_SHA512_ID;
+  hash_functions[1]=&soscl_sha512;
+#else
+  curves[1]=NULL;
+#endif
+  q.x=xq;
+  q.y=yq;
+  signature.r=r;
+  signature.s=s;
+  msg[0]='a';
+  msg[1]='b';
+  for(icurve=0;icurve<2;icurve++)
+    {
+      if(NULL==curves[icurve])
+	continue;
+      wsize=SOSCL_ECDSA_NONCE_POOL_ENTRY_WSIZE(curves[icurve]);
+      configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(hashes[icurve]<<SOSCL_HASH_SHIFT);
+      if(SOSCL_OK!=soscl_ecc_keygeneration(q,d,curves[icurve]))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_nonce_pool_init(&pool,storage,SOSCL_TEST_POOL_CAPACITY,curves[icurve]))
+	return(SOSCL_ERROR);
+      //an empty pool does not sign
+      if(SOSCL_NONCE_POOL_EMPTY!=soscl_ecdsa_signature_pool(signature,d,hash_functions[icurve],msg,3,&pool,configuration))
+	return(SOSCL_ERROR);
+      for(i=0;i<count;i++)
+	{
+	  //refill is bounded by the free room
+	  if(SOSCL_TEST_POOL_CAPACITY-pool.count!=soscl_ecdsa_nonce_pool_refill(&pool,SOSCL_TEST_POOL_CAPACITY+1))
+	    return(SOSCL_ERROR);
+	  for(j=0;j<SOSCL_TEST_POOL_CAPACITY-1;j++)
+	    {
+	      msg[2]=(uint8_t)('c'+j);
+	      if(SOSCL_OK!=soscl_ecdsa_signature_pool(signature,d,hash_functions[icurve],msg,3,&pool,configuration))
+		return(SOSCL_ERROR);
+	      if(SOSCL_OK!=soscl_ecdsa_verification(q,signature,hash_functions[icurve],msg,3,curves[icurve],configuration))
+		return(SOSCL_ERROR);
+	      //the consumed entry has been wiped
+	      if(SOSCL_OK!=soscl_bignum_cmp_with_zero(storage+((pool.head+SOSCL_TEST_POOL_CAPACITY-1)%SOSCL_TEST_POOL_CAPACITY)*wsize,wsize))
+		return(SOSCL_ERROR);
+	    }
+	  if(SOSCL_OK!=soscl_ecdsa_nonce_pool_stats(&pool,&stats))
+	    return(SOSCL_ERROR);
+	  if(1!=stats.available || SOSCL_TEST_POOL_CAPACITY!=stats.capacity || (0==i && 0!=stats.low_water) || (0!=i && 1!=stats.low_water))
+	    return(SOSCL_ERROR);
+	  if(stats.generated!=SOSCL_TEST_POOL_CAPACITY+i*(SOSCL_TEST_POOL_CAPACITY-1) || stats.consumed!=(i+1)*(SOSCL_TEST_POOL_CAPACITY-1))
+	    return(SOSCL_ERROR);
+	}
+      //the last entry is dropped
+      if(SOSCL_OK!=soscl_ecdsa_nonce_pool_wipe(&pool))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_bignum_cmp_with_zero(storage,SOSCL_TEST_POOL_CAPACITY*wsize))
+	return(SOSCL_ERROR);
+      if(SOSCL_NONCE_POOL_EMPTY!=soscl_ecdsa_signature_pool(signature,d,hash_functions[icurve],msg,3,&pool,configuration))
+	return(SOSCL_ERROR);
+    }
+  return(SOSCL_OK);
+}
+//RFC 6979 deterministic signatures, appendix A.2.5 and A.2.7, message "sample"
+int test_ecdsa_rfc6979(void)
+{
+  uint8_t d_secp256r1[]={0xC9,0xAF,0xA9,0xD8,0x45,0xBA,0x75,0x16,0x6B,0x5C,0x21,0x57,0x67,0xB1,0xD6,0x93,0x4E,0x50,0xC3,0xDB,0x36,0xE8,0x9B,0x12,0x7B,0x8A,0x62,0x2B,0x12,0x0F,0x67,0x21};
+  uint8_t xq_secp256r1[]={0x60,0xFE,0xD4,0xBA,0x25,0x5A,0x9D,0x31,0xC9,0x61,0xEB,0x74,0xC6,0x35,0x6D,0x68,0xC0,0x49,0xB8,0x92,0x3B,0x61,0xFA,0x6C,0xE6,0x69,0x62,0x2E,0x60,0xF2,0x9F,0xB6};
+  uint8_t yq_secp256r1[]={0x79,0x03,0xFE,0x10,0x08,0xB8,0xBC,0x99,0xA4,0x1A,0xE9,0xE9,0x56,0x28,0xBC,0x64,0xF2,0xF1,0xB2,0x0C,0x2D,0x7E,0x9F,0x51,0x77,0xA3,0xC2,0x94,0xD4,0x46,0x22,0x99};
+  uint8_t r_secp256r1[]={0xEF,0xD4,0x8B,0x2A,0xAC,0xB6,0xA8,0xFD,0x11,0x40,0xDD,0x9C,0xD4,0x5E,0x81,0xD6,0x9D,0x2C,0x87,0x7B,0x56,0xAA,0xF9,0x91,0xC3,0x4D,0x0E,0xA8,0x4E,0xAF,0x37,0x16};
+  uint8_t s_secp256r1[]={0xF7,0xCB,0x1C,0x94,0x2D,0x65,0x7C,0x41,0xD4,0x36,0xC7,0xA1,0xB6,0xE2,0x9F,0x65,0xF3,0xE9,0x00,0xDB,0xB9,0xAF,0xF4,0x06,0x4D,0xC4,0xAB,0x2F,0x84,0x3A,0xCD,0xA8};
+#ifdef SOSCL_TEST_SECP521R1
+  uint8_t d_secp521r1[]={0x00,0xFA,0xD0,0x6D,0xAA,0x62,0xBA,0x3B,0x25,0xD2,0xFB,0x40,0x13,0x3D,0xA7,0x57,0x20,0x5D,0xE6,0x7F,0x5B,0xB0,0x01,0x8F,0xEE,0x8C,0x86,0xE1,0xB6,0x8C,0x7E,0x75,0xCA,0xA8,0x96,0xEB,0x32,0xF1,0xF4,0x7C,0x70,0x85,0x58,0x36,0xA6,0xD1,0x6F,0xCC,0x14,0x66,0xF6,0xD8,0xFB,0xEC,0x67,0xDB,0x89,0xEC,0x0C,0x08,0xB0,0xE9,0x96,0xB8,0x35,0x38};
+  uint8_t xq_secp521r1[]={0x01,0x89,0x45,0x50,0xD0,0x78,0x59,0x32,0xE0,0x0E,0xAA,0x23,0xB6,0x94,0xF2,0x13,0xF8,0xC3,0x12,0x1F,0x86,0xDC,0x97,0xA0,0x4E,0x5A,0x71,0x67,0xDB,0x4E,0x5B,0xCD,0x37,0x11,0x23,0xD4,0x6E,0x45,0xDB,0x6B,0x5D,0x53,0x70,0xA7,0xF2,0x0F,0xB6,0x33,0x15,0x5D,0x38,0xFF,0xA1,0x6D,0x2B,0xD7,0x61,0xDC,0xAC,0x47,0x4B,0x9A,0x2F,0x50,0x23,0xA4};
+  uint8_t yq_secp521r1[]={0x00,0x49,0x31,0x01,0xC9,0x62,0xCD,0x4D,0x2F,0xDD,0xF7,0x82,0x28,0x5E,0x64,0x58,0x41,0x39,0xC2,0xF9,0x1B,0x47,0xF8,0x7F,0xF8,0x23,0x54,0xD6,0x63,0x0F,0x74,0x6A,0x28,0xA0,0xDB,0x25,0x74,0x1B,0x5B,0x34,0xA8,0x28,0x00,0x8B,0x22,0xAC,0xC2,0x3F,0x92,0x4F,0xAA,0xFB,0xD4,0xD3,0x3F,0x81,0xEA,0x66,0x95,0x6D,0xFE,0xAA,0x2B,0xFD,0xFC,0xF5};
+  uint8_t r_secp521r1[]={0x00,0xC3,0x28,0xFA,0xFC,0xBD,0x79,0xDD,0x77,0x85,0x03,0x70,0xC4,0x63,0x25,0xD9,0x87,0xCB,0x52,0x55,0x69,0xFB,0x63,0xC5,0xD3,0xBC,0x53,0x95,0x0E,0x6D,0x4C,0x5F,0x17,0x4E,0x25,0xA1,0xEE,0x90,0x17,0xB5,0xD4,0x50,0x60,0x6A,0xDD,0x15,0x2B,0x53,0x49,0x31,0xD7,0xD4,0xE8,0x45,0x5C,0xC9,0x1F,0x9B,0x15,0xBF,0x05,0xEC,0x36,0xE3,0x77,0xFA};
+  uint8_t s_secp521r1[]={0x00,0x61,0x7C,0xCE,0x7C,0xF5,0x06,0x48,0x06,0xC4,0x67,0xF6,0x78,0xD3,0xB4,0x08,0x0D,0x6F,0x1C,0xC5,0x0A,0xF2,0x6C,0xA2,0x09,0x41,0x73,0x08,0x28,0x1B,0x68,0xAF,0x28,0x26,0x23,0xEA,0xA6,0x3E,0x5B,0x5C,0x07,0x23,0xD8,0xB8,0xC3,0x7F,0xF0,0x77,0x7B,0x1A,0x20,0xF8,0xCC,0xB1,0xDC,0xCC,0x43,0x99,0x7F,0x1E,0xE0,0xE4,0x4D,0xA4,0xA6,0x7A};
+#endif
+  uint8_t msg[]={'s','a','m','p','l','e'};
+  uint8_t r[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s[SOSCL_SECP521R1_BYTESIZE];
+  soscl_type_ecdsa_signature signature;
+  soscl_type_ecc_uint8_t_affine_point q;
+  int configuration;
+  signature.r=r;
+  signature.s=s;
+  configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(SOSCL_SHA256_ID<<SOSCL_HASH_SHIFT)^(SOSCL_DETERMINISTIC_NONCE<<SOSCL_NONCE_SHIFT);
+  if(SOSCL_OK!=soscl_ecdsa_signature(signature,d_secp256r1,&soscl_sha256,msg,sizeof(msg),&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(r,r_secp256r1,SOSCL_SECP256R1_BYTESIZE) || 0!=memcmp(s,s_secp256r1,SOSCL_SECP256R1_BYTESIZE))
+    return(SOSCL_ERROR);
+  q.x=xq_secp256r1;
+  q.y=yq_secp256r1;
+  if(SOSCL_OK!=soscl_ecdsa_verification(q,signature,&soscl_sha256,msg,sizeof(msg),&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  //the same input gives the same signature
+  if(SOSCL_OK!=soscl_ecdsa_signature(signature,d_secp256r1,&soscl_sha256,msg,sizeof(msg),&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(r,r_secp256r1,SOSCL_SECP256R1_BYTESIZE) || 0!=memcmp(s,s_secp256r1,SOSCL_SECP256R1_BYTESIZE))
+    return(SOSCL_ERROR);
+#ifdef SOSCL_TEST_SECP521R1
+  configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(SOSCL_SHA512_ID<<SOSCL_HASH_SHIFT)^(SOSCL_DETERMINISTIC_NONCE<<SOSCL_NONCE_SHIFT);
+  if(SOSCL_OK!=soscl_ecdsa_signature(signature,d_secp521r1,&soscl_sha512,msg,sizeof(msg),&soscl_secp521r1,configuration))
+    return(SOSCL_ERROR);
+  if(0!=memcmp(r,r_secp521r1,SOSCL_SECP521R1_BYTESIZE) || 0!=memcmp(s,s_secp521r1,SOSCL_SECP521R1_BYTESIZE))
+    return(SOSCL_ERROR);
+  q.x=xq_secp521r1;
+  q.y=yq_secp521r1;
+  if(SOSCL_OK!=soscl_ecdsa_verification(q,signature,&soscl_sha512,msg,sizeof(msg),&soscl_secp521r1,configuration))
+    return(SOSCL_ERROR);
+#endif
+  return(SOSCL_OK);
+}
+//x1 of u1.G+u2.Q is in [n,p-1], so x1 mod n=r only matches x1=r+n
+//Q is built from the chosen x1 (its private key is unknown)
+int test_ecdsa_verification_r_plus_n(void)
+{
+  uint8_t xq[]={0x7A,0x87,0x69,0xAB,0xED,0x62,0x93,0xB6,0xF8,0x4B,0xF0,0xB6,0x35,0x47,0x84,0x20,0xAC,0x44,0x6A,0x6D,0x82,0xB3,0x79,0x2E,0x93,0xA5,0x2A,0x1B,0x44,0x05,0xB1,0xC8};
+  uint8_t yq[]={0x28,0xEA,0xC3,0x7E,0x3A,0xAD,0xD6,0xCE,0xA2,0xCE,0xC4,0xD2,0x3A,0xC7,0xE0,0x38,0xCA,0x65,0x56,0xD4,0x21,0x3A,0x16,0xE1,0x6B,0x88,0xA1,0xD3,0x89,0x52,0xBA,0x21};
+  uint8_t r[]={0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0x3B};
+  uint8_t s[]={0x12,0x34,0x56,0x78,0x90,0xAB,0xCD,0xEF,0x12,0x34,0x56,0x78,0x90,0xAB,0xCD,0xEF,0x12,0x34,0x56,0x78,0x90,0xAB,0xCD,0xEF,0x12,0x34,0x56,0x78,0x90,0xAB,0xCD,0xEF};
+  uint8_t msg[]={'s','a','m','p','l','e'};
+  soscl_type_ecdsa_signature signature;
+  soscl_type_ecc_uint8_t_affine_point q;
+  soscl_type_ecdsa_verify_item item;
+  int configuration,result;
+  configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(SOSCL_SHA256_ID<<SOSCL_HASH_SHIFT);
+  q.x=xq;
+  q.y=yq;
+  signature.r=r;
+  signature.s=s;
+  if(SOSCL_OK!=soscl_ecdsa_verification(q,signature,&soscl_sha256,msg,sizeof(msg),&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  item.q=q;
+  item.signature=signature;
+  item.input=msg;
+  item.inputlength=sizeof(msg);
+  if(SOSCL_OK!=soscl_ecdsa_verify_batch(&item,1,&result,&soscl_sha256,&soscl_secp256r1,configuration) || SOSCL_OK!=result)
+    return(SOSCL_ERROR);
+  r[SOSCL_SECP256R1_BYTESIZE-1]^=1;
+  if(SOSCL_ERROR!=soscl_ecdsa_verification(q,signature,&soscl_sha256,msg,sizeof(msg),&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//count keys stored with their tables, then every signature checked through the store
+//P-256 (standard domain) and brainpoolP256r1 (Montgomery domain)
+#define SOSCL_TEST_KEYSTORE_WORDS 1024
+int test_ecdsa_keystore(int count)
+{
+  word_type image[SOSCL_TEST_KEYSTORE_WORDS];
+  uint8_t d[SOSCL_TEST_BATCH_MAX][SOSCL_SECP256R1_BYTESIZE];
+  uint8_t xq[SOSCL_TEST_BATCH_MAX][SOSCL_SECP256R1_BYTESIZE];
+  uint8_t yq[SOSCL_TEST_BATCH_MAX][SOSCL_SECP256R1_BYTESIZE];
+  uint8_t r[SOSCL_SECP256R1_BYTESIZE];
+  uint8_t s[SOSCL_SECP256R1_BYTESIZE];
+  uint8_t msg[3]={'a','b','c'};
+  soscl_type_ecc_uint8_t_affine_point keys[SOSCL_TEST_BATCH_MAX];
+  soscl_type_ecdsa_signature signature;
+  soscl_type_ecdsa_keystore store;
+  soscl_type_ecdsa_keystore_header *header;
+  soscl_type_curve *curves[2];
+  uint32_t stored_count;
+  int i,index,icurve,size,configuration;
+  if(count>SOSCL_TEST_BATCH_MAX || count<1)
+    return(SOSCL_INVALID_INPUT);
+  curves[0]=&soscl_secp256r1;
+  curves[1]=&soscl_bp256r1;
+  configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(SOSCL_SHA256_ID<<SOSCL_HASH_SHIFT);
+  signature.r=r;
+  signature.s=s;
+  for(icurve=0;icurve<2;icurve++)
+    {
+      for(i=0;i<count;i++)
+	{
+	  keys[i].x=xq[i];
+	  keys[i].y=yq[i];
+	  if(SOSCL_OK!=soscl_ecc_keygeneration(keys[i],d[i],curves[icurve]))
+	    return(SOSCL_ERROR);
+	}
+      size=soscl_ecdsa_keystore_size(count,curves[icurve]);
+      if(size>(int)sizeof(image))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_keystore_build((uint8_t*)image,size,keys,count,curves[icurve]))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_keystore_open(&store,(uint8_t*)image,size,curves[icurve]))
+	return(SOSCL_ERROR);
+      for(i=0;i<count;i++)
+	{
+	  //the store is sorted, the index is not the build order
+	  index=soscl_ecdsa_keystore_find(&store,keys[i]);
+	  if(index<0 || index>=count)
+	    return(SOSCL_ERROR);
+	  if(SOSCL_OK!=soscl_ecdsa_signature(signature,d[i],&soscl_sha256,msg,sizeof(msg),curves[icurve],configuration))
+	    return(SOSCL_ERROR);
+	  if(SOSCL_OK!=soscl_ecdsa_keystore_verification(&store,index,signature,&soscl_sha256,msg,sizeof(msg),configuration))
+	    return(SOSCL_ERROR);
+	  //another key of the store shall not verify it
+	  if(count>1 && SOSCL_OK==soscl_ecdsa_keystore_verification(&store,(index+1)%count,signature,&soscl_sha256,msg,sizeof(msg),configuration))
+	    return(SOSCL_ERROR);
+	  msg[0]^=1;
+	  if(SOSCL_OK==soscl_ecdsa_keystore_verification(&store,index,signature,&soscl_sha256,msg,sizeof(msg),configuration))
+	    return(SOSCL_ERROR);
+	  msg[0]^=1;
+	}
+      //a key made of two stored keys coordinates is not in the store
+      if(count>1)
+	{
+	  keys[0].y=yq[1];
+	  if(SOSCL_ERROR!=soscl_ecdsa_keystore_find(&store,keys[0]))
+	    return(SOSCL_ERROR);
+	  keys[0].y=yq[0];
+	}
+      //an image for another curve, or a modified table, shall be rejected
+      if(SOSCL_INVALID_INPUT!=soscl_ecdsa_keystore_open(&store,(uint8_t*)image,size,curves[1-icurve]))
+	return(SOSCL_ERROR);
+      ((uint8_t*)image)[size-1]^=1;
+      if(SOSCL_ERROR!=soscl_ecdsa_keystore_open(&store,(uint8_t*)image,size,curves[icurve]))
+	return(SOSCL_ERROR);
+      ((uint8_t*)image)[size-1]^=1;
+      //counts whose size computation would overflow
+      header=(soscl_type_ecdsa_keystore_header*)image;
+      stored_count=header->count;
+      header->count=0xffffffff;
+      if(SOSCL_INVALID_INPUT!=soscl_ecdsa_keystore_open(&store,(uint8_t*)image,size,curves[icurve]))
+	return(SOSCL_ERROR);
+      header->count=0x80000000/header->entry_wsize;
+      if(SOSCL_INVALID_INPUT!=soscl_ecdsa_keystore_open(&store,(uint8_t*)image,size,curves[icurve]))
+	return(SOSCL_ERROR);
+      header->count=stored_count;
+      if(SOSCL_INVALID_INPUT!=soscl_ecdsa_keystore_size(0x7fffffff,curves[icurve]))
+	return(SOSCL_ERROR);
+#ifdef SOSCL_ECDSA_KEYSTORE_MMAP
+      if(SOSCL_OK!=soscl_ecdsa_keystore_save("keystore.bin",(uint8_t*)image,size))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_keystore_map(&store,"keystore.bin",curves[icurve]))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_signature(signature,d[0],&soscl_sha256,msg,sizeof(msg),curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      index=soscl_ecdsa_keystore_find(&store,keys[0]);
+      if(SOSCL_OK!=soscl_ecdsa_keystore_verification(&store,index,signature,&soscl_sha256,msg,sizeof(msg),configuration))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_keystore_unmap(&store))
+	return(SOSCL_ERROR);
+      remove("keystore.bin");
+#endif
+    }
+  //invalid key
+  yq[0][0]^=1;
+  if(SOSCL_INVALID_INPUT!=soscl_ecdsa_keystore_build((uint8_t*)image,sizeof(image),keys,count,curves[1]))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//streamed signature and verification: the message is fed in uneven chunks
+//with a deterministic nonce, the signature shall match the one-shot one
+#define SOSCL_TEST_STREAM_SIZE 1000
+int test_ecdsa_stream(void)
+{
+  uint8_t d[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t xq[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t yq[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t r[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t r1[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t s1[SOSCL_SECP521R1_BYTESIZE];
+  uint8_t msg[SOSCL_TEST_STREAM_SIZE];
+  int chunks[5]={1,7,64,129,300};
+  soscl_type_ecc_uint8_t_affine_point q;
+  soscl_type_ecdsa_signature signature,signature1;
+  soscl_type_ecdsa_stream ctx;
+  soscl_type_curve *curves[4];
+  int hashes[4];
+  int (*hash_functions[4])(uint8_t*,uint8_t*,int);
+  int i,j,len,icurve,configuration,bsize;
+  curves[0]=&soscl_secp256r1;
+  hashes[0]=SOSCL_SHA256_ID;
+  hash_functions[0]=&soscl_sha256;
+  curves[1]=&soscl_secp384r1;
+  hashes[1]=SOSCL_SHA384_ID;
+  hash_functions[1]=&soscl_sha384;
+#ifdef SOSCL_TEST_SECP521R1
+  curves[2]=&soscl_secp521r1;
+  hashes[2]=SOSCL_SHA512_ID;
+  hash_functions[2]=&soscl_sha512;
+#else
+  curves[2]=NULL;
+#endif
+  curves[3]=&soscl_bp256r1;
+  hashes[3]=SOSCL_SHA256_ID;
+  hash_functions[3]=&soscl_sha256;
+  for(i=0;i<SOSCL_TEST_STREAM_SIZE;i++)
+    msg[i]=(uint8_t)(i*7+3);
+  q.x=xq;
+  q.y=yq;
+  signature.r=r;
+  signature.s=s;
+  signature1.r=r1;
+  signature1.s=s1;
+  for(icurve=0;icurve<4;icurve++)
+    {
+      if(NULL==curves[icurve])
+	continue;
+      bsize=curves[icurve]->curve_bsize;
+      if(SOSCL_OK!=soscl_ecc_keygeneration(q,d,curves[icurve]))
+	return(SOSCL_ERROR);
+      configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(hashes[icurve]<<SOSCL_HASH_SHIFT)^(SOSCL_DETERMINISTIC_NONCE<<SOSCL_NONCE_SHIFT);
+      if(SOSCL_OK!=soscl_ecdsa_sign_init(&ctx,curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      for(i=0,j=0;i<SOSCL_TEST_STREAM_SIZE;i+=len,j++)
+	{
+	  len=chunks[j%5];
+	  if(len>SOSCL_TEST_STREAM_SIZE-i)
+	    len=SOSCL_TEST_STREAM_SIZE-i;
+	  if(SOSCL_OK!=soscl_ecdsa_sign_update(&ctx,msg+i,len))
+	    return(SOSCL_ERROR);
+	}
+      if(SOSCL_OK!=soscl_ecdsa_sign_final(&ctx,signature,d))
+	return(SOSCL_ERROR);
+      //the context is consumed by the final call
+      if(SOSCL_INVALID_INPUT!=soscl_ecdsa_sign_final(&ctx,signature1,d))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_signature(signature1,d,hash_functions[icurve],msg,SOSCL_TEST_STREAM_SIZE,curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(r,r1,bsize) || 0!=memcmp(s,s1,bsize))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_verify_init(&ctx,curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      for(i=0,j=4;i<SOSCL_TEST_STREAM_SIZE;i+=len,j++)
+	{
+	  len=chunks[j%5];
+	  if(len>SOSCL_TEST_STREAM_SIZE-i)
+	    len=SOSCL_TEST_STREAM_SIZE-i;
+	  if(SOSCL_OK!=soscl_ecdsa_verify_update(&ctx,msg+i,len))
+	    return(SOSCL_ERROR);
+	}
+      if(SOSCL_OK!=soscl_ecdsa_verify_final(&ctx,q,signature))
+	return(SOSCL_ERROR);
+      //a truncated message shall be rejected
+      if(SOSCL_OK!=soscl_ecdsa_verify_init(&ctx,curves[icurve],configuration))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK!=soscl_ecdsa_verify_update(&ctx,msg,SOSCL_TEST_STREAM_SIZE-1))
+	return(SOSCL_ERROR);
+      if(SOSCL_OK==soscl_ecdsa_verify_final(&ctx,q,signature))
+	return(SOSCL_ERROR);
+    }
+  //an unsupported hash function is rejected at initialization
+  if(SOSCL_INVALID_INPUT!=soscl_ecdsa_sign_init(&ctx,&soscl_secp256r1,(SOSCL_HASH_MASK<<SOSCL_HASH_SHIFT)))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//lock hooks: the stripe locks shall be balanced
+static int soscl_test_cache_locked;
+static void soscl_test_cache_lock(void *arg,int stripe)
+{
+  (void)arg;
+  (void)stripe;
+  soscl_test_cache_locked++;
+}
+
+static void soscl_test_cache_unlock(void *arg,int stripe)
+{
+  (void)arg;
+  (void)stripe;
+  soscl_test_cache_locked--;
+}
+
+//a single 2-way stripe, so that the LRU eviction order is known
+//A and B are cached, A is used again, then C evicts B
+int test_ecdsa_cache(void)
+{
+  uint8_t d[SOSCL_SECP256R1_BYTESIZE];
+  uint8_t xq[SOSCL_SECP256R1_BYTESIZE];
+  uint8_t yq[SOSCL_SECP256R1_BYTESIZE];
+  uint8_t r[3][SOSCL_SECP256R1_BYTESIZE];
+  uint8_t s[3][SOSCL_SECP256R1_BYTESIZE];
+  uint8_t h[SOSCL_SHA256_BYTE_HASHSIZE];
+  uint8_t msg[3][3];
+  soscl_type_ecc_uint8_t_affine_point q;
+  soscl_type_ecdsa_signature signature[3];
+  soscl_type_ecdsa_cache_entry entries[2];
+  soscl_type_ecdsa_cache_stripe stripes[1];
+  soscl_type_ecdsa_cache cache;
+  soscl_type_ecdsa_cache_stats stats;
+  int i,configuration;
+  configuration=(SOSCL_MSG_INPUT_TYPE<<SOSCL_INPUT_SHIFT)^(SOSCL_SHA256_ID<<SOSCL_HASH_SHIFT);
+  q.x=xq;
+  q.y=yq;
+  if(SOSCL_OK!=soscl_ecc_keygeneration(q,d,&soscl_secp256r1))
+    return(SOSCL_ERROR);
+  for(i=0;i<3;i++)
+    {
+      msg[i][0]='a';
+      msg[i][1]='b';
+      msg[i][2]=(uint8_t)('c'+i);
+      signature[i].r=r[i];
+      signature[i].s=s[i];
+      if(SOSCL_OK!=soscl_ecdsa_signature(signature[i],d,&soscl_sha256,msg[i],3,&soscl_secp256r1,configuration))
+	return(SOSCL_ERROR);
+    }
+  soscl_test_cache_locked=0;
+  if(SOSCL_OK!=soscl_ecdsa_cache_init(&cache,entries,stripes,1,2,&soscl_test_cache_lock,&soscl_test_cache_unlock,NULL))
+    return(SOSCL_ERROR);
+  //the ticks go past 32 bits: a wrapped tick would mark A as empty
+  stripes[0].tick=0xffffffff;
+  //A, B: misses, then A: hit
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[0],&soscl_sha256,msg[0],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[1],&soscl_sha256,msg[1],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[0],&soscl_sha256,msg[0],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  //a failed verification is not cached
+  if(SOSCL_OK==soscl_ecdsa_verification_cached(&cache,q,signature[1],&soscl_sha256,msg[2],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_cache_stats(&cache,&stats) || 1!=stats.hits || 3!=stats.misses || 2!=stats.used || 2!=stats.capacity)
+    return(SOSCL_ERROR);
+  //C evicts B, the least recently used
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[2],&soscl_sha256,msg[2],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[0],&soscl_sha256,msg[0],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[1],&soscl_sha256,msg[1],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_cache_stats(&cache,&stats) || 2!=stats.hits || 5!=stats.misses)
+    return(SOSCL_ERROR);
+  //after a flush, the tuple is cached again, and it is found when given as a digest
+  if(SOSCL_OK!=soscl_ecdsa_cache_flush(&cache))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_cache_stats(&cache,&stats) || 0!=stats.used)
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[0],&soscl_sha256,msg[0],3,&soscl_secp256r1,configuration))
+    return(SOSCL_ERROR);
+  soscl_sha256(h,msg[0],3);
+  if(SOSCL_OK!=soscl_ecdsa_verification_cached(&cache,q,signature[0],NULL,h,sizeof(h),&soscl_secp256r1,(SOSCL_HASH_INPUT_TYPE<<SOSCL_INPUT_SHIFT)))
+    return(SOSCL_ERROR);
+  if(SOSCL_OK!=soscl_ecdsa_cache_stats(&cache,&stats) || 3!=stats.hits)
+    return(SOSCL_ERROR);
+  if(0!=soscl_test_cache_locked)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
 #endif//SOSCL_TEST_ECDSA
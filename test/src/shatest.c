@@ -23,6 +23,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <soscl/soscl_config.h>
 #include <soscl/soscl_retdefs.h>
 #include <soscl/soscl_types.h>
@@ -318,6 +319,8 @@ int hmac_vector_process(char *line)
   soscl_sha256_ctx_t ctx_sha256;
   soscl_sha384_ctx_t ctx_sha384;
   soscl_sha512_ctx_t ctx_sha512;
+  soscl_type_hmac_state hmac_state;
+  int pass;
   //configure the supported hash functions
   sprintf(hash_string[SOSCL_SHA256_ID],"HMAC-SHA256");
   sprintf(hash_string[SOSCL_SHA384_ID],"HMAC-SHA384");
@@ -502,6 +505,24 @@ int hmac_vector_process(char *line)
 	  printf("\n");
 	  return(SOSCL_ERROR);
 	}
+      //test #3: precomputed key state, used twice for the same key
+      if(SOSCL_OK!=soscl_hmac_state_init(&hmac_state,temp_id,kat_key,kat_key_len))
+	return(SOSCL_INVALID_INPUT);
+      for(pass=0;pass<2;pass++)
+	{
+	  soscl_hmac_state_start(&hmac_state);
+	  soscl_hmac_state_core(&hmac_state,kat_input,kat_input_len/2);
+	  soscl_hmac_state_core(&hmac_state,kat_input+kat_input_len/2,kat_input_len-kat_input_len/2);
+	  soscl_hmac_state_finish(&hmac_state,temp_hmac,hmac_len);
+	  if(soscl_memcmp(temp_hmac,kat_hmac,hmac_len)!=0)
+	    {
+	      printf("#3:");
+	      for(k=0;k<hmac_len;k++)
+		printf("%02x",temp_hmac[k]);
+	      printf("\n");
+	      return(SOSCL_ERROR);
+	    }
+	}
     }
   else
     {
@@ -661,4 +682,280 @@ int test_hash_selftests(void)
 #endif
   return(SOSCL_OK);
 }
+
+//NIST CAVS response files (NIST_SHA_byte_KAT): ShortMsg/LongMsg (Len, Msg, MD) and Monte (Seed, MD)
+//LongMsg lines are longer than MAX_LINE
+#define NIST_MAX_LINE (2*MAX_LINE)
+#define NIST_MONTE_ITERATIONS 1000
+static char nist_line[NIST_MAX_LINE];
+static uint8_t nist_msg[NIST_MAX_LINE/2];
+
+static int nist_read_hexa(uint8_t *array,char *line)
+{
+  int l;
+  //skipping "xxx = "
+  while(*line!='\0' && *line!='=')
+    line++;
+  if('='==*line)
+    line++;
+  while(' '==*line)
+    line++;
+  for(l=0;isxdigit((int)line[0]) && isxdigit((int)line[1]);l++,line+=2)
+    array[l]=hex(line[0],line[1]);
+  return(l);
+}
+
+int test_hash_nist_kat(char *filename,int algo)
+{
+  FILE *fp;
+  uint8_t md[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t digest[SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  uint8_t monte[3*SOSCL_HASH_BYTE_DIGEST_MAXSIZE];
+  int len,md_len,i,monte_mode,nb;
+  fp=fopen(filename,"r");
+  if(NULL==fp)
+    {
+      printf("file <%s> not found\n",filename);
+      return(SOSCL_INVALID_INPUT);
+    }
+  len=0;
+  nb=0;
+  monte_mode=SOSCL_FALSE;
+  while(fgets(nist_line,NIST_MAX_LINE,fp)!=NULL)
+    {
+      if(0==strncmp(nist_line,"Len = ",6))
+	len=atoi(&nist_line[6])/8;
+      if(0==strncmp(nist_line,"Msg = ",6))
+	nist_read_hexa(nist_msg,nist_line);
+      if(0==strncmp(nist_line,"Seed = ",7))
+	{
+	  md_len=nist_read_hexa(monte,nist_line);
+	  monte_mode=SOSCL_TRUE;
+	}
+      if(0!=strncmp(nist_line,"MD = ",5))
+	continue;
+      md_len=nist_read_hexa(md,nist_line);
+      if(SOSCL_TRUE==monte_mode)
+	{
+	  //MD0=MD1=MD2=seed, MDi=SHA(MDi-3||MDi-2||MDi-1)
+	  soscl_memcpy(&monte[md_len],monte,md_len);
+	  soscl_memcpy(&monte[2*md_len],monte,md_len);
+	  for(i=0;i<NIST_MONTE_ITERATIONS;i++)
+	    {
+	      if(SOSCL_OK!=soscl_sha(digest,monte,3*md_len,algo))
+		break;
+	      soscl_memcpy(monte,&monte[md_len],2*md_len);
+	      soscl_memcpy(&monte[2*md_len],digest,md_len);
+	    }
+	}
+      else
+	soscl_sha(digest,nist_msg,len,algo);
+      if(0!=memcmp(digest,md,md_len))
+	{
+#ifdef VERBOSE
+	  printf("%s: vector %d failed\n",filename,nb);
+#endif
+	  fclose(fp);
+	  return(SOSCL_ERROR);
+	}
+      //the next seed is the last MD
+      if(SOSCL_TRUE==monte_mode)
+	soscl_memcpy(monte,digest,md_len);
+      nb++;
+    }
+  fclose(fp);
+  if(0==nb)
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//SHA-256 NIST files, with every block function available on the CPU
+int test_sha256_nist_kat(void)
+{
+  char *files[3]={"NIST_SHA_byte_KAT/SHA256ShortMsg.rsp","NIST_SHA_byte_KAT/SHA256LongMsg.rsp","NIST_SHA_byte_KAT/SHA256Monte.rsp"};
+  int implementations[2]={SOSCL_SHA256_IMPLEMENTATION_C,SOSCL_SHA256_IMPLEMENTATION_SHANI};
+  int i,j,ret;
+  ret=SOSCL_OK;
+  for(j=0;j<2 && SOSCL_OK==ret;j++)
+    {
+      if(SOSCL_OK!=soscl_sha256_set_implementation(implementations[j]))
+	continue;
+#ifdef VERBOSE
+      printf("SHA-256 implementation %d\n",implementations[j]);
+#endif
+      for(i=0;i<3 && SOSCL_OK==ret;i++)
+	ret=test_hash_nist_kat(files[i],SOSCL_SHA256_ID);
+    }
+  soscl_sha256_select_implementation();
+  return(ret);
+}
+
+//multi-buffer SHA-256 against soscl_sha256, with every engine available on the CPU:
+//the NIST ShortMsg vectors in a single batch, then lengths around the padding boundaries
+#define SHA256_MULTI_TEST_NB 70
+int test_sha256_multi(void)
+{
+  static uint8_t msgs_buffer[SHA256_MULTI_TEST_NB][SOSCL_SHA256_BYTE_BLOCKSIZE*4];
+  uint8_t digests[SHA256_MULTI_TEST_NB][SOSCL_SHA256_BYTE_HASHSIZE];
+  uint8_t expected[SHA256_MULTI_TEST_NB][SOSCL_SHA256_BYTE_HASHSIZE];
+  uint8_t *msgs[SHA256_MULTI_TEST_NB],*hashes[SHA256_MULTI_TEST_NB];
+  int lens[SHA256_MULTI_TEST_NB];
+  int implementations[3]={SOSCL_SHA256_MULTI_IMPLEMENTATION_SERIAL,SOSCL_SHA256_MULTI_IMPLEMENTATION_AVX2,SOSCL_SHA256_MULTI_IMPLEMENTATION_AVX512};
+  FILE *fp;
+  int i,j,nb,len;
+  //ShortMsg vectors, up to 64 bytes
+  fp=fopen("NIST_SHA_byte_KAT/SHA256ShortMsg.rsp","r");
+  if(NULL==fp)
+    return(SOSCL_INVALID_INPUT);
+  nb=0;
+  len=0;
+  while(fgets(nist_line,NIST_MAX_LINE,fp)!=NULL && nb<SHA256_MULTI_TEST_NB)
+    {
+      if(0==strncmp(nist_line,"Len = ",6))
+	len=atoi(&nist_line[6])/8;
+      if(0==strncmp(nist_line,"Msg = ",6))
+	nist_read_hexa(msgs_buffer[nb],nist_line);
+      if(0==strncmp(nist_line,"MD = ",5))
+	{
+	  nist_read_hexa(expected[nb],nist_line);
+	  lens[nb]=len;
+	  nb++;
+	}
+    }
+  fclose(fp);
+  for(i=0;i<SHA256_MULTI_TEST_NB;i++)
+    {
+      msgs[i]=msgs_buffer[i];
+      hashes[i]=digests[i];
+    }
+  for(j=0;j<3;j++)
+    {
+      if(SOSCL_OK!=soscl_sha256_multi_set_implementation(implementations[j]))
+	continue;
+      soscl_memset(digests,0,sizeof(digests));
+      if(SOSCL_OK!=soscl_sha256_multi(hashes,msgs,lens,nb))
+	return(SOSCL_ERROR);
+      if(0!=memcmp(digests,expected,nb*SOSCL_SHA256_BYTE_HASHSIZE))
+	return(SOSCL_ERROR);
+    }
+  //lengths from 0 to 255 bytes, in the order 0,37,74... so the lanes finish at different times
+  for(i=0;i<SHA256_MULTI_TEST_NB;i++)
+    {
+      lens[i]=(i*37)%(SOSCL_SHA256_BYTE_BLOCKSIZE*4);
+      for(j=0;j<lens[i];j++)
+	msgs_buffer[i][j]=(uint8_t)(i+3*j);
+      soscl_sha256(expected[i],msgs[i],lens[i]);
+    }
+  for(j=0;j<3;j++)
+    {
+      if(SOSCL_OK!=soscl_sha256_multi_set_implementation(implementations[j]))
+	continue;
+      for(nb=1;nb<=SHA256_MULTI_TEST_NB;nb+=23)
+	{
+	  soscl_memset(digests,0,sizeof(digests));
+	  if(SOSCL_OK!=soscl_sha256_multi(hashes,msgs,lens,nb))
+	    return(SOSCL_ERROR);
+	  if(0!=memcmp(digests,expected,nb*SOSCL_SHA256_BYTE_HASHSIZE))
+	    return(SOSCL_ERROR);
+	}
+    }
+  soscl_sha256_multi_select_implementation();
+  if(SOSCL_INVALID_INPUT!=soscl_sha256_multi(hashes,msgs,lens,-1))
+    return(SOSCL_ERROR);
+  return(SOSCL_OK);
+}
+
+//SHA-384 and SHA-512 NIST files
+int test_sha512_nist_kat(void)
+{
+  char *files[6]={"NIST_SHA_byte_KAT/SHA384ShortMsg.rsp","NIST_SHA_byte_KAT/SHA384LongMsg.rsp","NIST_SHA_byte_KAT/SHA384Monte.rsp","NIST_SHA_byte_KAT/SHA512ShortMsg.rsp","NIST_SHA_byte_KAT/SHA512LongMsg.rsp","NIST_SHA_byte_KAT/SHA512Monte.rsp"};
+  int i,ret;
+  for(i=0;i<6;i++)
+    {
+      ret=test_hash_nist_kat(files[i],i<3?SOSCL_SHA384_ID:SOSCL_SHA512_ID);
+      if(SOSCL_OK!=ret)
+	return(ret);
+    }
+  return(SOSCL_OK);
+}
+
+//multi-buffer SHA-384 and SHA-512, same tests than the multi-buffer SHA-256
+int test_sha512_multi(void)
+{
+  static uint8_t msgs_buffer[SHA256_MULTI_TEST_NB][SOSCL_SHA512_BYTE_BLOCKSIZE*4];
+  uint8_t digests[SHA256_MULTI_TEST_NB][SOSCL_SHA512_BYTE_HASHSIZE];
+  uint8_t expected[SHA256_MULTI_TEST_NB][SOSCL_SHA512_BYTE_HASHSIZE];
+  uint8_t *msgs[SHA256_MULTI_TEST_NB],*hashes[SHA256_MULTI_TEST_NB];
+  int lens[SHA256_MULTI_TEST_NB];
+  int implementations[3]={SOSCL_SHA512_MULTI_IMPLEMENTATION_SERIAL,SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX2,SOSCL_SHA512_MULTI_IMPLEMENTATION_AVX512};
+  char *files[2]={"NIST_SHA_byte_KAT/SHA384ShortMsg.rsp","NIST_SHA_byte_KAT/SHA512ShortMsg.rsp"};
+  int algos[2]={SOSCL_SHA384_ID,SOSCL_SHA512_ID};
+  int (*multi[2])(uint8_t **,uint8_t **,int *,int)={soscl_sha384_multi,soscl_sha512_multi};
+  FILE *fp;
+  int a,i,j,nb,len,size;
+  for(i=0;i<SHA256_MULTI_TEST_NB;i++)
+    {
+      msgs[i]=msgs_buffer[i];
+      hashes[i]=digests[i];
+    }
+  for(a=0;a<2;a++)
+    {
+      size=(SOSCL_SHA384_ID==algos[a]?SOSCL_SHA384_BYTE_HASHSIZE:SOSCL_SHA512_BYTE_HASHSIZE);
+      //the first ShortMsg vectors
+      fp=fopen(files[a],"r");
+      if(NULL==fp)
+	return(SOSCL_INVALID_INPUT);
+      nb=0;
+      len=0;
+      while(fgets(nist_line,NIST_MAX_LINE,fp)!=NULL && nb<SHA256_MULTI_TEST_NB)
+	{
+	  if(0==strncmp(nist_line,"Len = ",6))
+	    len=atoi(&nist_line[6])/8;
+	  if(0==strncmp(nist_line,"Msg = ",6))
+	    nist_read_hexa(msgs_buffer[nb],nist_line);
+	  if(0==strncmp(nist_line,"MD = ",5))
+	    {
+	      nist_read_hexa(expected[nb],nist_line);
+	      lens[nb]=len;
+	      nb++;
+	    }
+	}
+      fclose(fp);
+      for(j=0;j<3;j++)
+	{
+	  if(SOSCL_OK!=soscl_sha512_multi_set_implementation(implementations[j]))
+	    continue;
+	  soscl_memset(digests,0,sizeof(digests));
+	  if(SOSCL_OK!=multi[a](hashes,msgs,lens,nb))
+	    return(SOSCL_ERROR);
+	  for(i=0;i<nb;i++)
+	    if(0!=memcmp(digests[i],expected[i],size))
+	      return(SOSCL_ERROR);
+	}
+      //lengths from 0 to 511 bytes, around the padding boundaries
+      for(i=0;i<SHA256_MULTI_TEST_NB;i++)
+	{
+	  lens[i]=(i*53)%(SOSCL_SHA512_BYTE_BLOCKSIZE*4);
+	  for(j=0;j<lens[i];j++)
+	    msgs_buffer[i][j]=(uint8_t)(i+5*j);
+	  soscl_sha(expected[i],msgs[i],lens[i],algos[a]);
+	}
+      for(j=0;j<3;j++)
+	{
+	  if(SOSCL_OK!=soscl_sha512_multi_set_implementation(implementations[j]))
+	    continue;
+	  for(nb=1;nb<=SHA256_MULTI_TEST_NB;nb+=23)
+	    {
+	      soscl_memset(digests,0,sizeof(digests));
+	      if(SOSCL_OK!=multi[a](hashes,msgs,lens,nb))
+		return(SOSCL_ERROR);
+	      for(i=0;i<nb;i++)
+		if(0!=memcmp(digests[i],expected[i],size))
+		  return(SOSCL_ERROR);
+	    }
+	}
+    }
+  soscl_sha512_multi_select_implementation();
+  return(SOSCL_OK);
+}
 #endif//HASH